@@ -0,0 +1,95 @@
+// Copyright (c) 2016-2019 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// Measures the cost of a mouse move event on a dispatcher holding many key listeners and a few
+// mouse listeners, with typed, category and catch-all subscriptions.
+
+#include <kiwano/event/EventDispatcher.h>
+#include <kiwano/event/KeyEvent.h>
+#include <kiwano/event/MouseEvent.h>
+#include <chrono>
+#include <cstdio>
+
+using namespace kiwano;
+
+namespace
+{
+
+enum class Subscription
+{
+    Typed,
+    Category,
+    CatchAll,
+};
+
+const int key_listener_count   = 1000;
+const int mouse_listener_count = 10;
+const int event_count          = 100000;
+
+int handled = 0;
+
+RefPtr<EventListener> MakeListener(Subscription subscription, EventType type, EventType category)
+{
+    RefPtr<EventListener> listener = EventListener::Create([](Event* evt) { ++handled; });
+    if (subscription == Subscription::Typed)
+        listener->Subscribe(type);
+    else if (subscription == Subscription::Category)
+        listener->Subscribe(category);
+    return listener;
+}
+
+double Run(Subscription subscription)
+{
+    EventDispatcher dispatcher;
+    for (int i = 0; i < key_listener_count; ++i)
+    {
+        dispatcher.AddListener(MakeListener(subscription, KGE_EVENT(KeyDownEvent), KGE_EVENT(KeyEvent)));
+    }
+    for (int i = 0; i < mouse_listener_count; ++i)
+    {
+        dispatcher.AddListener(MakeListener(subscription, KGE_EVENT(MouseMoveEvent), KGE_EVENT(MouseEvent)));
+    }
+
+    MouseMoveEvent evt;
+    handled = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < event_count; ++i)
+    {
+        dispatcher.DispatchEvent(&evt);
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::nano>(end - start).count() / event_count;
+}
+
+}  // namespace
+
+int main()
+{
+    const char* names[] = { "typed", "category", "catch-all" };
+
+    for (auto subscription : { Subscription::Typed, Subscription::Category, Subscription::CatchAll })
+    {
+        const double ns = Run(subscription);
+        std::printf("%-10s %10.1f ns/event %8d handler calls\n", names[int(subscription)], ns, handled);
+    }
+    return 0;
+}
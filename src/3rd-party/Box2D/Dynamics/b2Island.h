@@ -27,6 +27,7 @@ class b2Contact;
 class b2Joint;
 class b2StackAllocator;
 class b2ContactListener;
+struct b2ContactImpulse;
 struct b2ContactVelocityConstraint;
 struct b2Profile;
 
@@ -35,7 +36,7 @@ class b2Island
 {
 public:
 	b2Island(int32 bodyCapacity, int32 contactCapacity, int32 jointCapacity,
-			b2StackAllocator* allocator, b2ContactListener* listener);
+			b2StackAllocator* allocator, b2ContactListener* listener, int32 staticCapacity = 0);
 	~b2Island();
 
 	void Clear()
@@ -57,6 +58,18 @@ public:
 		++m_bodyCount;
 	}
 
+	/// Static bodies may be shared by islands that are solved in parallel, so they are not
+	/// added to the body list. Their index is negative and given by the world, each island
+	/// only gets a private copy of their state in front of the state buffers.
+	void AddStatic(b2Body* body)
+	{
+		b2Assert(body->m_islandIndex < 0 && -body->m_islandIndex <= m_staticCapacity);
+		m_positions[body->m_islandIndex].c = body->m_sweep.c;
+		m_positions[body->m_islandIndex].a = body->m_sweep.a;
+		m_velocities[body->m_islandIndex].v = body->m_linearVelocity;
+		m_velocities[body->m_islandIndex].w = body->m_angularVelocity;
+	}
+
 	void Add(b2Contact* contact)
 	{
 		b2Assert(m_contactCount < m_contactCapacity);
@@ -74,6 +87,9 @@ public:
 	b2StackAllocator* m_allocator;
 	b2ContactListener* m_listener;
 
+	/// If not null, Report stores the impulses here instead of calling the listener.
+	b2ContactImpulse* m_impulses;
+
 	b2Body** m_bodies;
 	b2Contact** m_contacts;
 	b2Joint** m_joints;
@@ -88,6 +104,7 @@ public:
 	int32 m_bodyCapacity;
 	int32 m_contactCapacity;
 	int32 m_jointCapacity;
+	int32 m_staticCapacity;
 };
 
 #endif
@@ -32,6 +32,7 @@
 #include "Box2D/Collision/b2TimeOfImpact.h"
 #include "Box2D/Common/b2Draw.h"
 #include "Box2D/Common/b2Timer.h"
+#include <atomic>
 #include <new>
 
 b2World::b2World(const b2Vec2& gravity)
@@ -39,6 +40,10 @@ b2World::b2World(const b2Vec2& gravity)
 	m_destructionListener = nullptr;
 	m_debugDraw = nullptr;
 
+	m_taskExecutor = nullptr;
+	m_threadAllocators = nullptr;
+	m_threadAllocatorCount = 0;
+
 	m_bodyList = nullptr;
 	m_jointList = nullptr;
 
@@ -82,6 +87,12 @@ b2World::~b2World()
 
 		b = bNext;
 	}
+
+	for (int32 i = 0; i < m_threadAllocatorCount; ++i)
+	{
+		m_threadAllocators[i].~b2StackAllocator();
+	}
+	b2Free(m_threadAllocators);
 }
 
 void b2World::SetDestructionListener(b2DestructionListener* listener)
@@ -99,6 +110,11 @@ void b2World::SetContactListener(b2ContactListener* listener)
 	m_contactManager.m_contactListener = listener;
 }
 
+void b2World::SetTaskExecutor(b2TaskExecutor* executor)
+{
+	m_taskExecutor = executor;
+}
+
 void b2World::SetDebugDraw(b2Draw* debugDraw)
 {
 	m_debugDraw = debugDraw;
@@ -389,6 +405,45 @@ void b2World::Solve(const b2TimeStep& step)
 	m_profile.solveVelocity = 0.0f;
 	m_profile.solvePosition = 0.0f;
 
+	int32 threadCount = m_taskExecutor ? m_taskExecutor->GetThreadCount() : 1;
+	if (threadCount > 1)
+	{
+		SolveIslandsParallel(step, threadCount);
+	}
+	else
+	{
+		SolveIslands(step);
+	}
+
+	{
+		b2Timer timer;
+		// Synchronize fixtures, check for out of range bodies.
+		for (b2Body* b = m_bodyList; b; b = b->GetNext())
+		{
+			// If a body was not in an island then it did not move.
+			if ((b->m_flags & b2Body::e_islandFlag) == 0)
+			{
+				continue;
+			}
+
+			if (b->GetType() == b2_staticBody)
+			{
+				continue;
+			}
+
+			// Update fixtures (for broad-phase).
+			b->SynchronizeFixtures();
+		}
+
+		// Look for new contacts.
+		m_contactManager.FindNewContacts();
+		m_profile.broadphase = timer.GetMilliseconds();
+	}
+}
+
+// Build and solve the islands one after another.
+void b2World::SolveIslands(const b2TimeStep& step)
+{
 	// Size the island for the worst case.
 	b2Island island(m_bodyCount,
 					m_contactManager.m_contactCount,
@@ -546,31 +601,457 @@ void b2World::Solve(const b2TimeStep& step)
 	}
 
 	m_stackAllocator.Free(stack);
+}
+
+// A slice of the flat arrays built by SolveIslandsParallel.
+struct b2IslandRange
+{
+	int32 bodyStart;
+	int32 bodyCount;
+	int32 contactStart;
+	int32 contactCount;
+	int32 jointStart;
+	int32 jointCount;
+	int32 staticStart;
+	int32 staticCount;
+	int32 staticCapacity;
+};
+
+// Static bodies are shared by islands that are solved at the same time, so a static body keeps
+// the same index in every island that reaches it. The indices are colored to be unique within
+// each island and as small as possible, so an island only keeps a copy of about as many static
+// bodies as it touches. On entry m_islandIndex holds -1 - id with ids numbered from 0.
+void b2World::AssignStaticIndices(b2IslandRange* islands, int32 islandCount, b2Body** statics, int32 staticCount)
+{
+	b2StackAllocator* allocator = &m_stackAllocator;
+
+	const b2IslandRange& last = islands[islandCount - 1];
+	int32 refCount = last.staticStart + last.staticCount;
+
+	int32* ids = (int32*)allocator->Allocate(refCount * sizeof(int32));
+	int32* refStart = (int32*)allocator->Allocate((staticCount + 1) * sizeof(int32));
+	int32* refIslands = (int32*)allocator->Allocate(refCount * sizeof(int32));
+	int32* colors = (int32*)allocator->Allocate(staticCount * sizeof(int32));
+	int32* usedBy = (int32*)allocator->Allocate(staticCount * sizeof(int32));
 
+	// List the islands that reach each static body.
+	memset(refStart, 0, (staticCount + 1) * sizeof(int32));
+	for (int32 i = 0; i < refCount; ++i)
 	{
-		b2Timer timer;
-		// Synchronize fixtures, check for out of range bodies.
-		for (b2Body* b = m_bodyList; b; b = b->GetNext())
+		ids[i] = -statics[i]->m_islandIndex - 1;
+		++refStart[ids[i] + 1];
+	}
+	for (int32 i = 0; i < staticCount; ++i)
+	{
+		refStart[i + 1] += refStart[i];
+		colors[i] = refStart[i];
+	}
+	for (int32 i = 0; i < islandCount; ++i)
+	{
+		const b2IslandRange& range = islands[i];
+		for (int32 j = range.staticStart; j < range.staticStart + range.staticCount; ++j)
 		{
-			// If a body was not in an island then it did not move.
-			if ((b->m_flags & b2Body::e_islandFlag) == 0)
+			refIslands[colors[ids[j]]++] = i;
+		}
+	}
+
+	for (int32 i = 0; i < staticCount; ++i)
+	{
+		colors[i] = -1;
+		usedBy[i] = -1;
+	}
+
+	// Greedy coloring, a body takes the lowest color no body sharing an island with it has.
+	for (int32 s = 0; s < staticCount; ++s)
+	{
+		for (int32 k = refStart[s]; k < refStart[s + 1]; ++k)
+		{
+			const b2IslandRange& range = islands[refIslands[k]];
+			for (int32 j = range.staticStart; j < range.staticStart + range.staticCount; ++j)
 			{
-				continue;
+				int32 color = colors[ids[j]];
+				if (color >= 0)
+				{
+					usedBy[color] = s;
+				}
+			}
+		}
+
+		int32 color = 0;
+		while (usedBy[color] == s)
+		{
+			++color;
+		}
+		colors[s] = color;
+	}
+
+	for (int32 i = 0; i < islandCount; ++i)
+	{
+		b2IslandRange& range = islands[i];
+		range.staticCapacity = 0;
+		for (int32 j = range.staticStart; j < range.staticStart + range.staticCount; ++j)
+		{
+			int32 color = colors[ids[j]];
+			statics[j]->m_islandIndex = -(color + 1);
+			range.staticCapacity = b2Max(range.staticCapacity, color + 1);
+		}
+	}
+
+	allocator->Free(usedBy);
+	allocator->Free(colors);
+	allocator->Free(refIslands);
+	allocator->Free(refStart);
+	allocator->Free(ids);
+}
+
+// Islands are claimed from a shared counter, so a thread that gets small islands takes more of them.
+class b2IslandSolveTask : public b2Task
+{
+public:
+	void Execute(int32 index) override
+	{
+		b2StackAllocator* allocator = allocators + index;
+		b2Profile* profile = profiles + index;
+
+		for (;;)
+		{
+			int32 i = next.fetch_add(1, std::memory_order_relaxed);
+			if (i >= islandCount)
+			{
+				break;
+			}
+
+			const b2IslandRange& range = islands[i];
+			b2Island island(range.bodyCount, range.contactCount, range.jointCount, allocator, nullptr, range.staticCapacity);
+
+			for (int32 j = 0; j < range.bodyCount; ++j)
+			{
+				island.Add(bodies[range.bodyStart + j]);
+			}
+			for (int32 j = 0; j < range.contactCount; ++j)
+			{
+				island.Add(contacts[range.contactStart + j]);
+			}
+			for (int32 j = 0; j < range.jointCount; ++j)
+			{
+				island.Add(joints[range.jointStart + j]);
+			}
+			for (int32 j = 0; j < range.staticCount; ++j)
+			{
+				island.AddStatic(statics[range.staticStart + j]);
+			}
+
+			if (impulses)
+			{
+				island.m_impulses = impulses + range.contactStart;
 			}
 
+			b2Profile islandProfile;
+			island.Solve(&islandProfile, *step, gravity, allowSleep);
+			profile->solveInit += islandProfile.solveInit;
+			profile->solveVelocity += islandProfile.solveVelocity;
+			profile->solvePosition += islandProfile.solvePosition;
+		}
+	}
+
+	const b2TimeStep* step;
+	b2Vec2 gravity;
+	bool allowSleep;
+
+	b2StackAllocator* allocators;
+	b2Profile* profiles;
+
+	const b2IslandRange* islands;
+	int32 islandCount;
+	b2Body** bodies;
+	b2Contact** contacts;
+	b2Joint** joints;
+	b2Body** statics;
+	b2ContactImpulse* impulses;
+
+	std::atomic<int32> next;
+};
+
+// Build all islands first, then solve them on several threads. Static bodies are shared
+// by islands, so each of them gets a negative index and every island solves with a private
+// copy of the static bodies it touches. Islands do not depend on each other, so the result is the same as
+// SolveIslands whatever the thread count.
+void b2World::SolveIslandsParallel(const b2TimeStep& step, int32 threadCount)
+{
+	b2ContactListener* listener = m_contactManager.m_contactListener;
+	int32 contactCapacity = m_contactManager.m_contactCount;
+
+	// Clear all the island flags.
+	for (b2Body* b = m_bodyList; b; b = b->m_next)
+	{
+		b->m_flags &= ~b2Body::e_islandFlag;
+		b->m_islandIndex = 0;
+	}
+	for (b2Contact* c = m_contactManager.m_contactList; c; c = c->m_next)
+	{
+		c->m_flags &= ~b2Contact::e_islandFlag;
+	}
+	for (b2Joint* j = m_jointList; j; j = j->m_next)
+	{
+		j->m_islandFlag = false;
+	}
+
+	// Sized for the worst case. A static body is added once for every edge that reaches it.
+	b2IslandRange* islands = (b2IslandRange*)m_stackAllocator.Allocate(m_bodyCount * sizeof(b2IslandRange));
+	b2Body** bodies = (b2Body**)m_stackAllocator.Allocate(m_bodyCount * sizeof(b2Body*));
+	b2Contact** contacts = (b2Contact**)m_stackAllocator.Allocate(contactCapacity * sizeof(b2Contact*));
+	b2Joint** joints = (b2Joint**)m_stackAllocator.Allocate(m_jointCount * sizeof(b2Joint*));
+	b2Body** statics = (b2Body**)m_stackAllocator.Allocate((contactCapacity + m_jointCount) * sizeof(b2Body*));
+
+	int32 islandCount = 0;
+	int32 bodyCount = 0;
+	int32 contactCount = 0;
+	int32 jointCount = 0;
+	int32 staticRefCount = 0;
+	int32 staticCount = 0;
+
+	// Build all awake islands.
+	int32 stackSize = m_bodyCount;
+	b2Body** stack = (b2Body**)m_stackAllocator.Allocate(stackSize * sizeof(b2Body*));
+	for (b2Body* seed = m_bodyList; seed; seed = seed->m_next)
+	{
+		if (seed->m_flags & b2Body::e_islandFlag)
+		{
+			continue;
+		}
+
+		if (seed->IsAwake() == false || seed->IsActive() == false)
+		{
+			continue;
+		}
+
+		// The seed can be dynamic or kinematic.
+		if (seed->GetType() == b2_staticBody)
+		{
+			continue;
+		}
+
+		b2IslandRange* range = islands + islandCount++;
+		range->bodyStart = bodyCount;
+		range->contactStart = contactCount;
+		range->jointStart = jointCount;
+		range->staticStart = staticRefCount;
+
+		int32 stackCount = 0;
+		stack[stackCount++] = seed;
+		seed->m_flags |= b2Body::e_islandFlag;
+
+		// Perform a depth first search (DFS) on the constraint graph.
+		while (stackCount > 0)
+		{
+			b2Body* b = stack[--stackCount];
+			b2Assert(b->IsActive() == true);
+
+			// Make sure the body is awake (without resetting sleep timer).
+			b->m_flags |= b2Body::e_awakeFlag;
+
+			// To keep islands as small as possible, we don't
+			// propagate islands across static bodies.
 			if (b->GetType() == b2_staticBody)
 			{
+				if (b->m_islandIndex == 0)
+				{
+					b->m_islandIndex = -(++staticCount);
+				}
+				statics[staticRefCount++] = b;
 				continue;
 			}
 
-			// Update fixtures (for broad-phase).
-			b->SynchronizeFixtures();
+			bodies[bodyCount++] = b;
+
+			// Search all contacts connected to this body.
+			for (b2ContactEdge* ce = b->m_contactList; ce; ce = ce->next)
+			{
+				b2Contact* contact = ce->contact;
+
+				// Has this contact already been added to an island?
+				if (contact->m_flags & b2Contact::e_islandFlag)
+				{
+					continue;
+				}
+
+				// Is this contact solid and touching?
+				if (contact->IsEnabled() == false ||
+					contact->IsTouching() == false)
+				{
+					continue;
+				}
+
+				// Skip sensors.
+				bool sensorA = contact->m_fixtureA->m_isSensor;
+				bool sensorB = contact->m_fixtureB->m_isSensor;
+				if (sensorA || sensorB)
+				{
+					continue;
+				}
+
+				contacts[contactCount++] = contact;
+				contact->m_flags |= b2Contact::e_islandFlag;
+
+				b2Body* other = ce->other;
+
+				// Was the other body already added to this island?
+				if (other->m_flags & b2Body::e_islandFlag)
+				{
+					continue;
+				}
+
+				b2Assert(stackCount < stackSize);
+				stack[stackCount++] = other;
+				other->m_flags |= b2Body::e_islandFlag;
+			}
+
+			// Search all joints connect to this body.
+			for (b2JointEdge* je = b->m_jointList; je; je = je->next)
+			{
+				if (je->joint->m_islandFlag == true)
+				{
+					continue;
+				}
+
+				b2Body* other = je->other;
+
+				// Don't simulate joints connected to inactive bodies.
+				if (other->IsActive() == false)
+				{
+					continue;
+				}
+
+				joints[jointCount++] = je->joint;
+				je->joint->m_islandFlag = true;
+
+				if (other->m_flags & b2Body::e_islandFlag)
+				{
+					continue;
+				}
+
+				b2Assert(stackCount < stackSize);
+				stack[stackCount++] = other;
+				other->m_flags |= b2Body::e_islandFlag;
+			}
 		}
 
-		// Look for new contacts.
-		m_contactManager.FindNewContacts();
-		m_profile.broadphase = timer.GetMilliseconds();
+		range->bodyCount = bodyCount - range->bodyStart;
+		range->contactCount = contactCount - range->contactStart;
+		range->jointCount = jointCount - range->jointStart;
+		range->staticCount = staticRefCount - range->staticStart;
+		range->staticCapacity = 0;
+
+		// Allow static bodies to participate in other islands.
+		for (int32 i = range->staticStart; i < staticRefCount; ++i)
+		{
+			statics[i]->m_flags &= ~b2Body::e_islandFlag;
+		}
+	}
+
+	m_stackAllocator.Free(stack);
+
+	if (staticCount > 0)
+	{
+		AssignStaticIndices(islands, islandCount, statics, staticCount);
+	}
+
+	// Contact listener callbacks are deferred until all islands are solved.
+	b2ContactImpulse* impulses = nullptr;
+	if (listener)
+	{
+		impulses = (b2ContactImpulse*)m_stackAllocator.Allocate(contactCount * sizeof(b2ContactImpulse));
+	}
+
+	threadCount = b2Max(b2Min(threadCount, islandCount), 1);
+	if (m_threadAllocatorCount < threadCount)
+	{
+		for (int32 i = 0; i < m_threadAllocatorCount; ++i)
+		{
+			m_threadAllocators[i].~b2StackAllocator();
+		}
+		b2Free(m_threadAllocators);
+
+		m_threadAllocators = (b2StackAllocator*)b2Alloc(threadCount * sizeof(b2StackAllocator));
+		for (int32 i = 0; i < threadCount; ++i)
+		{
+			new (m_threadAllocators + i) b2StackAllocator();
+		}
+		m_threadAllocatorCount = threadCount;
+	}
+
+	b2Profile* profiles = (b2Profile*)m_stackAllocator.Allocate(threadCount * sizeof(b2Profile));
+	memset(profiles, 0, threadCount * sizeof(b2Profile));
+
+	b2IslandSolveTask task;
+	task.step = &step;
+	task.gravity = m_gravity;
+	task.allowSleep = m_allowSleep;
+	task.allocators = m_threadAllocators;
+	task.profiles = profiles;
+	task.islands = islands;
+	task.islandCount = islandCount;
+	task.bodies = bodies;
+	task.contacts = contacts;
+	task.joints = joints;
+	task.statics = statics;
+	task.impulses = impulses;
+	task.next = 0;
+
+	if (threadCount > 1)
+	{
+		m_taskExecutor->Run(&task, threadCount);
+	}
+	else
+	{
+		task.Execute(0);
+	}
+
+	for (int32 i = 0; i < threadCount; ++i)
+	{
+		m_profile.solveInit += profiles[i].solveInit;
+		m_profile.solveVelocity += profiles[i].solveVelocity;
+		m_profile.solvePosition += profiles[i].solvePosition;
+	}
+
+	// Report contacts and update shared static bodies in island order, as SolveIslands does.
+	for (int32 i = 0; i < islandCount; ++i)
+	{
+		const b2IslandRange& range = islands[i];
+
+		if (listener)
+		{
+			for (int32 j = range.contactStart; j < range.contactStart + range.contactCount; ++j)
+			{
+				listener->PostSolve(contacts[j], impulses + j);
+			}
+		}
+
+		// The seed is never static, it tells whether the island went to sleep.
+		bool awake = bodies[range.bodyStart]->IsAwake();
+		for (int32 j = range.staticStart; j < range.staticStart + range.staticCount; ++j)
+		{
+			if (awake)
+			{
+				statics[j]->m_flags |= b2Body::e_awakeFlag;
+			}
+			else
+			{
+				statics[j]->SetAwake(false);
+			}
+		}
+	}
+
+	m_stackAllocator.Free(profiles);
+	if (impulses)
+	{
+		m_stackAllocator.Free(impulses);
 	}
+	m_stackAllocator.Free(statics);
+	m_stackAllocator.Free(joints);
+	m_stackAllocator.Free(contacts);
+	m_stackAllocator.Free(bodies);
+	m_stackAllocator.Free(islands);
 }
 
 // Find TOI contacts and solve them.
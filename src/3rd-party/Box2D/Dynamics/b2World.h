@@ -29,6 +29,7 @@
 struct b2AABB;
 struct b2BodyDef;
 struct b2Color;
+struct b2IslandRange;
 struct b2JointDef;
 class b2Body;
 class b2Draw;
@@ -61,6 +62,10 @@ public:
 	/// remain in scope.
 	void SetContactListener(b2ContactListener* listener);
 
+	/// Register a task executor to solve islands on several threads. The executor is
+	/// owned by you and must remain in scope. Pass nullptr to solve on the stepping thread.
+	void SetTaskExecutor(b2TaskExecutor* executor);
+
 	/// Register a routine for debug drawing. The debug draw functions are called
 	/// inside with b2World::DrawDebugData method. The debug draw object is owned
 	/// by you and must remain in scope.
@@ -225,6 +230,9 @@ private:
 	friend class b2Controller;
 
 	void Solve(const b2TimeStep& step);
+	void SolveIslands(const b2TimeStep& step);
+	void SolveIslandsParallel(const b2TimeStep& step, int32 threadCount);
+	void AssignStaticIndices(b2IslandRange* islands, int32 islandCount, b2Body** statics, int32 staticCount);
 	void SolveTOI(const b2TimeStep& step);
 
 	void DrawJoint(b2Joint* joint);
@@ -249,6 +257,11 @@ private:
 	b2DestructionListener* m_destructionListener;
 	b2Draw* m_debugDraw;
 
+	// Each thread of the parallel solver gets its own stack allocator.
+	b2TaskExecutor* m_taskExecutor;
+	b2StackAllocator* m_threadAllocators;
+	int32 m_threadAllocatorCount;
+
 	// This is used to compute the time step ratio to
 	// support a variable time step.
 	float32 m_inv_dt0;
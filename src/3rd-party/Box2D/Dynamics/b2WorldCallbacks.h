@@ -152,4 +152,33 @@ public:
 									const b2Vec2& normal, float32 fraction) = 0;
 };
 
+/// A piece of work that can be split across threads.
+/// See b2TaskExecutor
+class b2Task
+{
+public:
+	virtual ~b2Task() {}
+
+	/// Called once for every index in [0, count) passed to b2TaskExecutor::Run.
+	/// No two calls with the same index run at the same time.
+	virtual void Execute(int32 index) = 0;
+};
+
+/// Implement this class to let the world solve independent islands on several threads.
+/// The results do not depend on the thread count, and contact listener callbacks are
+/// still made on the stepping thread in the same order as a single threaded solve.
+class b2TaskExecutor
+{
+public:
+	virtual ~b2TaskExecutor() {}
+
+	/// The number of tasks the world may split its work into. A count less than two
+	/// solves on the stepping thread.
+	virtual int32 GetThreadCount() const = 0;
+
+	/// Call task->Execute(i) for every i in [0, count), possibly on other threads,
+	/// and return once all of them have finished.
+	virtual void Run(b2Task* task, int32 count) = 0;
+};
+
 #endif
@@ -19,11 +19,54 @@
 // THE SOFTWARE.
 
 #include <kiwano-audio/AudioData.h>
+#include <cstring>
 
 namespace kiwano
 {
 namespace audio
 {
+
+namespace
+{
+
+class PCMAudioData : public AudioData
+{
+public:
+    PCMAudioData(Vector<uint8_t>&& raw, const AudioMeta& meta)
+        : raw_(std::move(raw))
+    {
+        data_ = BinaryData{ raw_.data(), uint32_t(raw_.size()) };
+        meta_ = meta;
+    }
+
+    Vector<uint8_t> raw_;
+};
+
+// Samples are handled as signed 16-bit values, 8-bit PCM is unsigned
+inline int ReadSample(const uint8_t* ptr, uint16_t bits_per_sample)
+{
+    if (bits_per_sample == 8)
+        return (int(*ptr) - 128) << 8;
+
+    int16_t value;
+    ::memcpy(&value, ptr, sizeof(value));
+    return value;
+}
+
+inline void WriteSample(uint8_t* ptr, uint16_t bits_per_sample, int value)
+{
+    if (bits_per_sample == 8)
+    {
+        *ptr = uint8_t((value >> 8) + 128);
+        return;
+    }
+
+    const int16_t sample = int16_t(value);
+    ::memcpy(ptr, &sample, sizeof(sample));
+}
+
+}  // namespace
+
 AudioData::AudioData(const BinaryData& data, const AudioMeta& meta)
     : data_(data)
     , meta_(meta)
@@ -40,5 +83,66 @@ BinaryData AudioData::GetData() const
     return data_;
 }
 
+bool AudioData::IsStreaming() const
+{
+    return false;
+}
+
+RefPtr<AudioStream> AudioData::OpenStream() const
+{
+    return nullptr;
+}
+
+RefPtr<AudioData> AudioData::ConvertPCM(uint16_t channels, uint16_t bits_per_sample) const
+{
+    if (meta_.format != AudioFormat::PCM || IsStreaming() || !data_.IsValid())
+        return nullptr;
+
+    if ((meta_.bits_per_sample != 8 && meta_.bits_per_sample != 16) || (bits_per_sample != 8 && bits_per_sample != 16))
+        return nullptr;
+
+    if (channels != 1 && channels != meta_.channels)
+        return nullptr;
+
+    if (channels == meta_.channels && bits_per_sample == meta_.bits_per_sample)
+        return nullptr;
+
+    AudioMeta meta       = meta_;
+    meta.channels        = channels;
+    meta.bits_per_sample = bits_per_sample;
+    meta.block_align     = uint16_t(channels * bits_per_sample / 8);
+
+    const uint32_t frame_count  = data_.size / meta_.block_align;
+    const uint32_t sample_bytes = meta_.bits_per_sample / 8;
+
+    Vector<uint8_t> raw(size_t(frame_count) * meta.block_align);
+
+    const uint8_t* src = static_cast<const uint8_t*>(data_.buffer);
+    uint8_t*       dst = raw.data();
+    for (uint32_t i = 0; i < frame_count; ++i)
+    {
+        if (channels == 1 && meta_.channels > 1)
+        {
+            int sum = 0;
+            for (uint16_t c = 0; c < meta_.channels; ++c)
+                sum += ReadSample(src + c * sample_bytes, meta_.bits_per_sample);
+
+            WriteSample(dst, bits_per_sample, sum / meta_.channels);
+        }
+        else
+        {
+            for (uint16_t c = 0; c < channels; ++c)
+            {
+                const int sample = ReadSample(src + c * sample_bytes, meta_.bits_per_sample);
+                WriteSample(dst + c * bits_per_sample / 8, bits_per_sample, sample);
+            }
+        }
+
+        src += meta_.block_align;
+        dst += meta.block_align;
+    }
+    return new PCMAudioData(std::move(raw), meta);
+}
+
 }  // namespace audio
 }  // namespace kiwano
@@ -60,6 +60,27 @@ struct AudioMeta
     }
 };
 
+/**
+ * \~chinese
+ * @brief Ƶ
+ * @details ν PCM ԴʽƵΪÿƵ󵥶һƵ
+ */
+class KGE_API AudioStream : public ObjectBase
+{
+public:
+    /// \~chinese
+    /// @brief ȡ PCM 
+    /// @param buffer 
+    /// @param size СΪ
+    /// @return ʵʶȡֽСڻСΪ 0 ʱʾѵĩβ
+    virtual size_t Read(void* buffer, size_t size) = 0;
+
+    /// \~chinese
+    /// @brief תָλ
+    /// @param frame ֡λ
+    virtual bool Seek(uint64_t frame) = 0;
+};
+
 /**
  * \~chinese
  * @brief Ƶ
@@ -81,6 +102,24 @@ public:
     /// @brief ȡ
     BinaryData GetData() const;
 
+    /// \~chinese
+    /// @brief ǷΪʽƵ
+    /// @details ʽƵݲ PCM ݣʱƵ߽߲
+    virtual bool IsStreaming() const;
+
+    /// \~chinese
+    /// @brief Ƶ
+    /// @details ÿεöᴴһµƵʽƵݷؿ
+    virtual RefPtr<AudioStream> OpenStream() const;
+
+    /// \~chinese
+    /// @brief ת PCM ݵĴ洢ʽ
+    /// @details Ϊʱȡƽֵλ֧ 8 λ 16 λ
+    /// @param channels ֻΪ 1 ԭ
+    /// @param bits_per_sample λֻΪ 8  16
+    /// @return תƵݣҪת޷תʱؿ
+    RefPtr<AudioData> ConvertPCM(uint16_t channels, uint16_t bits_per_sample) const;
+
 protected:
     AudioData() = default;
 
@@ -21,6 +21,7 @@
 #include <kiwano/utils/Logger.h>
 #include <kiwano/platform/FileSystem.h>
 #include <kiwano-audio/Module.h>
+#include <kiwano-audio/SoundStream.h>
 #include <kiwano-audio/libraries.h>
 #include <kiwano-audio/MediaFoundation/MFTranscoder.h>
 #include <kiwano-audio/Ogg/OggTranscoder.h>
@@ -42,9 +43,12 @@ public:
 
     ~VoiceCallback() {}
 
+    // Streamed buffers carry a context, whole buffers submitted by Sound::Play do not
+
     STDMETHOD_(void, OnBufferStart(void* pBufferContext))
     {
-        cb->OnStart(nullptr);
+        if (!pBufferContext || SoundStream::OnBufferStart(pBufferContext))
+            cb->OnStart(nullptr);
     }
 
     STDMETHOD_(void, OnLoopEnd(void* pBufferContext))
@@ -54,7 +58,17 @@ public:
 
     STDMETHOD_(void, OnBufferEnd(void* pBufferContext))
     {
-        cb->OnEnd(nullptr);
+        if (!pBufferContext)
+        {
+            cb->OnEnd(nullptr);
+            return;
+        }
+
+        const uint8_t flags = SoundStream::OnBufferEnd(pBufferContext);
+        if (flags & SoundStream::LoopEndBuffer)
+            cb->OnLoopEnd(nullptr);
+        if (flags & SoundStream::LastBuffer)
+            cb->OnEnd(nullptr);
     }
 
     STDMETHOD_(void, OnStreamEnd()) {}
@@ -82,10 +96,15 @@ WORD ConvertWaveFormat(AudioFormat format)
 Module::Module()
     : x_audio2_(nullptr)
     , mastering_voice_(nullptr)
+    , stream_event_(nullptr)
+    , stream_running_(false)
 {
 }
 
-Module::~Module() {}
+Module::~Module()
+{
+    StopStreamWorker();
+}
 
 void Module::SetupModule()
 {
@@ -111,6 +130,8 @@ void Module::DestroyModule()
 {
     KGE_DEBUG_LOGF("Destroying audio resources");
 
+    StopStreamWorker();
+
     if (mastering_voice_)
     {
         mastering_voice_->DestroyVoice();
@@ -200,6 +221,11 @@ RefPtr<Transcoder> Module::GetTranscoder(StringView ext)
 }
 
 RefPtr<AudioData> Module::Decode(StringView file_path)
+{
+    return Decode(file_path, Duration());
+}
+
+RefPtr<AudioData> Module::Decode(StringView file_path, Duration stream_threshold)
 {
     if (!FileSystem::GetInstance().IsFileExists(file_path))
     {
@@ -215,18 +241,113 @@ RefPtr<AudioData> Module::Decode(StringView file_path)
         return nullptr;
     }
     String full_path = FileSystem::GetInstance().GetFullPathForFile(file_path);
+
+    if (!stream_threshold.IsZero())
+    {
+        RefPtr<AudioData> data = transcoder->Stream(full_path, stream_threshold);
+        if (data)
+        {
+            return data;
+        }
+    }
     return transcoder->Decode(full_path);
 }
 
 RefPtr<AudioData> Module::Decode(const Resource& res, StringView ext)
+{
+    return Decode(res, ext, Duration());
+}
+
+RefPtr<AudioData> Module::Decode(const Resource& res, StringView ext, Duration stream_threshold)
 {
     auto transcoder = GetTranscoder(ext);
     if (!transcoder)
     {
         return nullptr;
     }
+
+    if (!stream_threshold.IsZero())
+    {
+        RefPtr<AudioData> data = transcoder->Stream(res, stream_threshold);
+        if (data)
+        {
+            return data;
+        }
+    }
     return transcoder->Decode(res);
 }
 
+void Module::AddStream(SoundStream* stream)
+{
+    std::lock_guard<std::mutex> lock(stream_mutex_);
+
+    if (!stream_running_)
+    {
+        // Started on demand, most games never stream anything
+        stream_event_   = ::CreateEvent(nullptr, FALSE, FALSE, nullptr);
+        stream_running_ = true;
+        stream_worker_  = std::thread(&Module::StreamWorkerMain, this);
+
+        for (auto registered : streams_)
+        {
+            registered->SetWakeEvent(stream_event_);
+        }
+    }
+
+    stream->SetWakeEvent(stream_event_);
+    streams_.push_back(stream);
+}
+
+void Module::RemoveStream(SoundStream* stream)
+{
+    // Once the lock is taken the worker is not decoding into this stream anymore
+    std::lock_guard<std::mutex> lock(stream_mutex_);
+
+    auto iter = std::find(streams_.begin(), streams_.end(), stream);
+    if (iter != streams_.end())
+    {
+        streams_.erase(iter);
+    }
+}
+
+void Module::StopStreamWorker()
+{
+    if (!stream_running_)
+        return;
+
+    stream_running_ = false;
+    ::SetEvent(stream_event_);
+    stream_worker_.join();
+
+    {
+        std::lock_guard<std::mutex> lock(stream_mutex_);
+        for (auto stream : streams_)
+        {
+            stream->SetWakeEvent(nullptr);
+        }
+    }
+    ::CloseHandle(stream_event_);
+    stream_event_ = nullptr;
+}
+
+void Module::StreamWorkerMain()
+{
+    while (true)
+    {
+        // The event is set by XAudio2 callbacks whenever a buffer is released, an auto-reset event
+        // never blocks the audio thread and cannot lose a wakeup
+        ::WaitForSingleObject(stream_event_, INFINITE);
+
+        if (!stream_running_)
+            break;
+
+        std::lock_guard<std::mutex> lock(stream_mutex_);
+        for (auto stream : streams_)
+        {
+            stream->Update();
+        }
+    }
+}
+
 }  // namespace audio
 }  // namespace kiwano
@@ -19,6 +19,9 @@
 // THE SOFTWARE.
 
 #pragma once
+#include <atomic>
+#include <mutex>
+#include <thread>
 #include <kiwano-audio/Sound.h>
 #include <kiwano-audio/Transcoder.h>
 #include <kiwano/core/Common.h>
@@ -29,6 +32,7 @@ namespace kiwano
 {
 namespace audio
 {
+class SoundStream;
 
 /**
  * \~chinese
@@ -49,6 +53,7 @@ class KGE_API Module
     , public kiwano::Module
 {
     friend Singleton<Module>;
+    friend class Sound;
 
 public:
     /// \~chinese
@@ -74,12 +79,25 @@ public:
     /// @param file_path Ƶļ·
     RefPtr<AudioData> Decode(StringView file_path);
 
+    /// \~chinese
+    /// @brief ƵϳƵʽ
+    /// @param file_path Ƶļ·
+    /// @param stream_threshold ʱСڸֵƵʽ򿪣Ϊ 0 ʱʹ
+    RefPtr<AudioData> Decode(StringView file_path, Duration stream_threshold);
+
     /// \~chinese
     /// @brief Ƶ
     /// @param res ƵԴ
     /// @param ext Ƶͣʹúֽ
     RefPtr<AudioData> Decode(const Resource& res, StringView ext = "");
 
+    /// \~chinese
+    /// @brief ƵϳƵʽ
+    /// @param res ƵԴ
+    /// @param ext Ƶͣʹúֽ
+    /// @param stream_threshold ʱСڸֵƵʽ򿪣Ϊ 0 ʱʹ
+    RefPtr<AudioData> Decode(const Resource& res, StringView ext, Duration stream_threshold);
+
     /// \~chinese
     /// @brief Ƶ
     bool CreateSound(Sound& sound, RefPtr<AudioData> data);
@@ -94,10 +112,24 @@ public:
 private:
     Module();
 
+    void AddStream(SoundStream* stream);
+
+    void RemoveStream(SoundStream* stream);
+
+    void StopStreamWorker();
+
+    void StreamWorkerMain();
+
 private:
     IXAudio2*               x_audio2_;
     IXAudio2MasteringVoice* mastering_voice_;
 
+    HANDLE               stream_event_;
+    std::atomic<bool>    stream_running_;
+    std::thread          stream_worker_;
+    std::mutex           stream_mutex_;
+    Vector<SoundStream*> streams_;
+
     UnorderedMap<String, RefPtr<Transcoder>> registered_transcoders_;
 };
 
@@ -40,28 +40,100 @@ public:
     std::vector<char> raw_;
 };
 
-RefPtr<AudioData> OggTranscoder::Decode(StringView file_path)
+namespace
 {
-    OggVorbis_File vf;
 
-    int err = ov_fopen(file_path.data(), &vf);
-    if (err != 0)
+// Compressed bytes in memory, libvorbis pulls them page by page through the callbacks below
+// so the data is never copied as a whole
+struct OggMemorySource
+{
+    const char* data;
+    size_t      size;
+    size_t      pos;
+};
+
+size_t ReadMemory(void* ptr, size_t size, size_t nmemb, void* datasource)
+{
+    auto source = static_cast<OggMemorySource*>(datasource);
+    if (size == 0)
+        return 0;
+
+    const size_t count = std::min(nmemb, (source->size - source->pos) / size);
+    ::memcpy(ptr, source->data + source->pos, count * size);
+    source->pos += count * size;
+    return count;
+}
+
+int SeekMemory(void* datasource, ogg_int64_t offset, int whence)
+{
+    auto source = static_cast<OggMemorySource*>(datasource);
+
+    ogg_int64_t base = 0;
+    switch (whence)
     {
-        KGE_ERROR(strings::Format("%s failed (%d): %s", __FUNCTION__, err, "Open ogg audio failed"));
-        return nullptr;
+    case SEEK_SET:
+        base = 0;
+        break;
+    case SEEK_CUR:
+        base = ogg_int64_t(source->pos);
+        break;
+    case SEEK_END:
+        base = ogg_int64_t(source->size);
+        break;
+    default:
+        return -1;
     }
 
-    // read metadata
-    vorbis_info* vi = ov_info(&vf, -1);
+    const ogg_int64_t pos = base + offset;
+    if (pos < 0 || pos > ogg_int64_t(source->size))
+        return -1;
+
+    source->pos = size_t(pos);
+    return 0;
+}
+
+long TellMemory(void* datasource)
+{
+    return long(static_cast<OggMemorySource*>(datasource)->pos);
+}
+
+int OpenMemory(OggMemorySource* source, const BinaryData& data, OggVorbis_File* vf)
+{
+    source->data = static_cast<const char*>(data.buffer);
+    source->size = data.size;
+    source->pos  = 0;
+
+    // The memory is owned by the caller, so there is nothing to close
+    const ov_callbacks callbacks = { ReadMemory, SeekMemory, nullptr, TellMemory };
+    return ov_open_callbacks(source, vf, nullptr, 0, callbacks);
+}
+
+AudioMeta ReadMeta(OggVorbis_File* vf)
+{
+    vorbis_info* vi = ov_info(vf, -1);
 
     AudioMeta meta;
     meta.samples_per_sec = uint32_t(vi->rate);
     meta.channels        = uint16_t(vi->channels);
     meta.bits_per_sample = uint16_t(16);  // the 'word' param of ov_read sets to 2, which means 16-bits samples.
     meta.block_align     = uint16_t(meta.channels * meta.bits_per_sample / 8);
+    return meta;
+}
+
+bool IsLongEnough(OggVorbis_File* vf, Duration min_duration)
+{
+    // Short sounds are decoded as a whole, streaming them would only cost a worker wakeup per buffer
+    const double seconds = ov_time_total(vf, -1);
+    return seconds >= 0 && seconds * 1000 >= double(min_duration.GetMilliseconds());
+}
+
+RefPtr<AudioData> DecodeVorbis(OggVorbis_File* vf)
+{
+    // read metadata
+    AudioMeta meta = ReadMeta(vf);
 
     // Get the audio total duration (in microseconds)
-    auto duration = static_cast<std::uintmax_t>(math::Ceil(ov_time_total(&vf, -1) * 1e6));
+    auto duration = static_cast<std::uintmax_t>(math::Ceil(ov_time_total(vf, -1) * 1e6));
 
     // allocate buffer
     std::vector<char> data;
@@ -81,26 +153,200 @@ RefPtr<AudioData> OggTranscoder::Decode(StringView file_path)
         }
         const size_t buffer_size = std::min(step, data.size() - pos);
 
-        int bytes_read = ov_read(&vf, data.data() + pos, int(buffer_size), 0, 2, 1, &bitstream);
+        int bytes_read = ov_read(vf, data.data() + pos, int(buffer_size), 0, 2, 1, &bitstream);
         if (bytes_read == 0)
             break;
         if (bytes_read < 0)
         {
             KGE_ERROR(strings::Format("%s failed (%d): %s", __FUNCTION__, bytes_read, "Decode ogg audio failed"));
+            ov_clear(vf);
             return nullptr;
         }
         pos += bytes_read;
     }
-    ov_clear(&vf);
+    ov_clear(vf);
 
     RefPtr<AudioData> output = new OggAudioData(std::move(data), uint32_t(pos), meta);
     return output;
 }
 
+}  // namespace
+
+class OggAudioStream : public AudioStream
+{
+public:
+    OggAudioStream()
+        : opened_(false)
+        , source_{}
+    {
+    }
+
+    ~OggAudioStream()
+    {
+        if (opened_)
+            ov_clear(&vf_);
+    }
+
+    bool Open(StringView file_path)
+    {
+        int err = ov_fopen(file_path.data(), &vf_);
+        if (err != 0)
+        {
+            KGE_ERROR(strings::Format("%s failed (%d): %s", __FUNCTION__, err, "Open ogg audio failed"));
+            return false;
+        }
+        opened_ = true;
+        return true;
+    }
+
+    bool Open(const BinaryData& data)
+    {
+        int err = OpenMemory(&source_, data, &vf_);
+        if (err != 0)
+        {
+            KGE_ERROR(strings::Format("%s failed (%d): %s", __FUNCTION__, err, "Open ogg audio failed"));
+            return false;
+        }
+        opened_ = true;
+        return true;
+    }
+
+    size_t Read(void* buffer, size_t size) override
+    {
+        int bitstream  = 0;
+        int bytes_read = 0;
+        do
+        {
+            // OV_HOLE only reports an interruption in the data, decoding goes on after it
+            bytes_read = ov_read(&vf_, static_cast<char*>(buffer), int(size), 0, 2, 1, &bitstream);
+        } while (bytes_read == OV_HOLE);
+
+        if (bytes_read < 0)
+        {
+            KGE_ERROR(strings::Format("%s failed (%d): %s", __FUNCTION__, bytes_read, "Decode ogg audio failed"));
+            return 0;
+        }
+        return size_t(bytes_read);
+    }
+
+    bool Seek(uint64_t frame) override
+    {
+        // Only decodes from the page containing the frame
+        return ov_pcm_seek(&vf_, ogg_int64_t(frame)) == 0;
+    }
+
+    OggVorbis_File* GetFile()
+    {
+        return &vf_;
+    }
+
+private:
+    bool            opened_;
+    OggMemorySource source_;
+    OggVorbis_File  vf_;
+};
+
+class OggStreamData : public AudioData
+{
+public:
+    OggStreamData(StringView file_path, const AudioMeta& meta)
+        : file_path_(file_path)
+    {
+        meta_ = meta;
+    }
+
+    OggStreamData(const BinaryData& source, const AudioMeta& meta)
+        : source_(source)
+    {
+        meta_ = meta;
+    }
+
+    bool IsStreaming() const override
+    {
+        return true;
+    }
+
+    RefPtr<AudioStream> OpenStream() const override
+    {
+        auto stream = MakePtr<OggAudioStream>();
+
+        const bool opened = source_.IsValid() ? stream->Open(source_) : stream->Open(file_path_);
+        if (!opened)
+        {
+            return nullptr;
+        }
+        return stream;
+    }
+
+    String     file_path_;
+    BinaryData source_;
+};
+
+RefPtr<AudioData> OggTranscoder::Decode(StringView file_path)
+{
+    OggVorbis_File vf;
+
+    int err = ov_fopen(file_path.data(), &vf);
+    if (err != 0)
+    {
+        KGE_ERROR(strings::Format("%s failed (%d): %s", __FUNCTION__, err, "Open ogg audio failed"));
+        return nullptr;
+    }
+    return DecodeVorbis(&vf);
+}
+
 RefPtr<AudioData> OggTranscoder::Decode(const Resource& res)
 {
-    KGE_ERROR("Loading audio from memory resource is not supported for OggTranscoder");
-    return nullptr;
+    return Decode(res.GetData());
+}
+
+RefPtr<AudioData> OggTranscoder::Decode(const BinaryData& data)
+{
+    if (!data.IsValid())
+    {
+        KGE_ERROR("invalid audio data");
+        return nullptr;
+    }
+
+    OggMemorySource source;
+    OggVorbis_File  vf;
+
+    int err = OpenMemory(&source, data, &vf);
+    if (err != 0)
+    {
+        KGE_ERROR(strings::Format("%s failed (%d): %s", __FUNCTION__, err, "Open ogg audio failed"));
+        return nullptr;
+    }
+    return DecodeVorbis(&vf);
+}
+
+RefPtr<AudioData> OggTranscoder::Stream(StringView file_path, Duration min_duration)
+{
+    OggAudioStream stream;
+    if (!stream.Open(file_path) || !IsLongEnough(stream.GetFile(), min_duration))
+    {
+        return nullptr;
+    }
+
+    RefPtr<AudioData> output = new OggStreamData(file_path, ReadMeta(stream.GetFile()));
+    return output;
+}
+
+RefPtr<AudioData> OggTranscoder::Stream(const Resource& res, Duration min_duration)
+{
+    return Stream(res.GetData(), min_duration);
+}
+
+RefPtr<AudioData> OggTranscoder::Stream(const BinaryData& data, Duration min_duration)
+{
+    OggAudioStream stream;
+    if (!data.IsValid() || !stream.Open(data) || !IsLongEnough(stream.GetFile(), min_duration))
+    {
+        return nullptr;
+    }
+
+    RefPtr<AudioData> output = new OggStreamData(data, ReadMeta(stream.GetFile()));
+    return output;
 }
 
 }  // namespace audio
@@ -34,6 +34,7 @@ namespace audio
 /**
  * \~chinese
  * @brief Ogg Ƶ
+ * @details ڴеƵͨ ov_open_callbacks ֱӶȡḴѹ
  */
 class KGE_API OggTranscoder : public Transcoder
 {
@@ -41,6 +42,21 @@ public:
     RefPtr<AudioData> Decode(StringView file_path) override;
 
     RefPtr<AudioData> Decode(const Resource& res) override;
+
+    /// \~chinese
+    /// @brief ڴеƵ
+    /// @param data Ogg ƵݣԴеһ
+    RefPtr<AudioData> Decode(const BinaryData& data);
+
+    RefPtr<AudioData> Stream(StringView file_path, Duration min_duration) override;
+
+    RefPtr<AudioData> Stream(const Resource& res, Duration min_duration) override;
+
+    /// \~chinese
+    /// @brief ʽڴеƵ
+    /// @param data Ogg Ƶݣڼ뱣Ч
+    /// @param min_duration ƵʱСڸֵʱʹ
+    RefPtr<AudioData> Stream(const BinaryData& data, Duration min_duration);
 };
 
 /** @} */
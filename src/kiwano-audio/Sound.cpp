@@ -20,6 +20,7 @@
 
 #include <kiwano-audio/Module.h>
 #include <kiwano-audio/Sound.h>
+#include <kiwano-audio/SoundStream.h>
 #include <kiwano/utils/Logger.h>
 #include <xaudio2.h>
 
@@ -74,6 +75,20 @@ bool Sound::Load(RefPtr<AudioData> data)
         return false;
     }
 
+    if (data->IsStreaming())
+    {
+        // Every sound decodes its own stream, so streaming data can be shared by several sounds
+        RefPtr<AudioStream> stream = data->OpenStream();
+        if (!stream)
+        {
+            Close();
+            return false;
+        }
+
+        stream_.reset(new SoundStream(stream, data->GetMeta(), GetNative<IXAudio2SourceVoice*>()));
+        Module::GetInstance().AddStream(stream_.get());
+    }
+
     // reset volume
     ResetVolume();
 
@@ -99,18 +114,28 @@ void Sound::Play(int loop_count)
     if (state.BuffersQueued)
         Stop();
 
-    // clamp loop count
-    loop_count = (loop_count < 0) ? XAUDIO2_LOOP_INFINITE : std::min(loop_count, XAUDIO2_LOOP_INFINITE - 1);
+    HRESULT hr = S_OK;
+    if (stream_)
+    {
+        // the stream decodes and submits buffers by itself, and loops by rewinding
+        stream_->Start(loop_count);
+    }
+    else
+    {
+        // clamp loop count
+        loop_count = (loop_count < 0) ? XAUDIO2_LOOP_INFINITE : std::min(loop_count, XAUDIO2_LOOP_INFINITE - 1);
 
-    auto data = data_->GetData();
+        auto data = data_->GetData();
 
-    XAUDIO2_BUFFER xaudio2_buffer = { 0 };
-    xaudio2_buffer.pAudioData     = reinterpret_cast<BYTE*>(data.buffer);
-    xaudio2_buffer.Flags          = XAUDIO2_END_OF_STREAM;
-    xaudio2_buffer.AudioBytes     = UINT32(data.size);
-    xaudio2_buffer.LoopCount      = static_cast<uint32_t>(loop_count);
+        XAUDIO2_BUFFER xaudio2_buffer = { 0 };
+        xaudio2_buffer.pAudioData     = reinterpret_cast<BYTE*>(data.buffer);
+        xaudio2_buffer.Flags          = XAUDIO2_END_OF_STREAM;
+        xaudio2_buffer.AudioBytes     = UINT32(data.size);
+        xaudio2_buffer.LoopCount      = static_cast<uint32_t>(loop_count);
+
+        hr = voice->SubmitSourceBuffer(&xaudio2_buffer);
+    }
 
-    HRESULT hr = voice->SubmitSourceBuffer(&xaudio2_buffer);
     if (SUCCEEDED(hr))
     {
         hr = voice->Start();
@@ -159,6 +184,9 @@ void Sound::Stop()
     auto voice = GetNative<IXAudio2SourceVoice*>();
     KGE_ASSERT(voice != nullptr && "IXAudio2SourceVoice* is NULL");
 
+    if (stream_)
+        stream_->Stop();
+
     HRESULT hr = voice->Stop();
 
     if (SUCCEEDED(hr))
@@ -176,8 +204,50 @@ void Sound::Stop()
     }
 }
 
+bool Sound::Seek(Duration position)
+{
+    if (!opened_ || !stream_)
+    {
+        KGE_ERRORF("Only opened streaming sounds support seeking!");
+        return false;
+    }
+
+    auto voice = GetNative<IXAudio2SourceVoice*>();
+    KGE_ASSERT(voice != nullptr && "IXAudio2SourceVoice* is NULL");
+
+    const auto     meta  = data_->GetMeta();
+    const uint64_t frame = uint64_t(std::max<int64_t>(position.GetMilliseconds(), 0)) * meta.samples_per_sec / 1000;
+
+    // buffers decoded before the seek are dropped, the stream refills them from the new position
+    HRESULT hr = voice->Stop();
+    if (SUCCEEDED(hr))
+        hr = voice->FlushSourceBuffers();
+
+    if (FAILED(hr))
+    {
+        KGE_ERRORF("Seek voice failed with HRESULT of %08X", hr);
+        return false;
+    }
+
+    bool succeeded = stream_->Seek(frame);
+    if (playing_)
+    {
+        voice->Start();
+    }
+    return succeeded;
+}
+
+bool Sound::IsStreaming() const
+{
+    return stream_ != nullptr;
+}
+
 void Sound::Close()
 {
+    // the decode worker must let go of the stream before its voice is destroyed
+    if (stream_)
+        Module::GetInstance().RemoveStream(stream_.get());
+
     auto voice = GetNative<IXAudio2SourceVoice*>();
     if (voice)
     {
@@ -186,6 +256,7 @@ void Sound::Close()
         voice->DestroyVoice();
     }
 
+    stream_.reset();
     data_    = nullptr;
     opened_  = false;
     playing_ = false;
@@ -204,6 +275,11 @@ bool Sound::IsPlaying() const
 
         XAUDIO2_VOICE_STATE state;
         voice->GetState(&state);
+        if (stream_)
+        {
+            // the queue of a stream may run dry for a moment after seeking
+            return state.BuffersQueued || stream_->IsActive();
+        }
         return !!state.BuffersQueued;
     }
     return false;
@@ -19,7 +19,9 @@
 // THE SOFTWARE.
 
 #pragma once
+#include <memory>
 #include <kiwano/core/Resource.h>
+#include <kiwano/core/Duration.h>
 #include <kiwano-audio/AudioData.h>
 
 namespace kiwano
@@ -29,6 +31,7 @@ namespace audio
 class Module;
 class Sound;
 class SoundPlayer;
+class SoundStream;
 
 /**
  * \addtogroup Audio
@@ -125,6 +128,17 @@ public:
     /// @brief ֹͣ
     void Stop();
 
+    /// \~chinese
+    /// @brief תָλ
+    /// @details Żͣ״ֲ̬
+    /// @param position λ
+    /// @note ֧ʽƵǷתɹ
+    bool Seek(Duration position);
+
+    /// \~chinese
+    /// @brief ǷΪʽƵ
+    bool IsStreaming() const;
+
     /// \~chinese
     /// @brief رղԴ
     void Close();
@@ -167,6 +181,8 @@ private:
     float             volume_;
     RefPtr<AudioData> data_;
 
+    std::unique_ptr<SoundStream> stream_;
+
     RefPtr<SoundCallback>       callback_chain_;
     List<RefPtr<SoundCallback>> callbacks_;
 };
@@ -29,6 +29,10 @@ namespace audio
 
 SoundPlayer::SoundPlayer()
     : volume_(1.f)
+    , stream_threshold_(time::Second * 10)
+    , cache_budget_(64 * 1024 * 1024)
+    , cache_mono_(false)
+    , cache_bits_(0)
 {
     class SoundCallbackFunc : public SoundCallback
     {
@@ -58,14 +62,15 @@ SoundPlayer::~SoundPlayer() {}
 RefPtr<AudioData> SoundPlayer::Preload(StringView file_path)
 {
     size_t hash_code = std::hash<String>{}(file_path);
-    if (cache_.count(hash_code))
+    if (RefPtr<AudioData> cached = FindCache(hash_code))
     {
-        return cache_.at(hash_code);
+        return cached;
     }
-    RefPtr<AudioData> ptr = Module::GetInstance().Decode(file_path);
+    // Streaming data only remembers where the file is, every sound opens its own stream from it
+    RefPtr<AudioData> ptr = Module::GetInstance().Decode(file_path, stream_threshold_);
     if (ptr)
     {
-        cache_.insert(std::make_pair(hash_code, ptr));
+        ptr = AddCache(hash_code, ptr);
     }
     return ptr;
 }
@@ -73,14 +78,14 @@ RefPtr<AudioData> SoundPlayer::Preload(StringView file_path)
 RefPtr<AudioData> SoundPlayer::Preload(const Resource& res, StringView ext)
 {
     size_t hash_code = res.GetId();
-    if (cache_.count(hash_code))
+    if (RefPtr<AudioData> cached = FindCache(hash_code))
     {
-        return cache_.at(hash_code);
+        return cached;
     }
-    RefPtr<AudioData> ptr = Module::GetInstance().Decode(res, ext);
+    RefPtr<AudioData> ptr = Module::GetInstance().Decode(res, ext, stream_threshold_);
     if (ptr)
     {
-        cache_.insert(std::make_pair(hash_code, ptr));
+        ptr = AddCache(hash_code, ptr);
     }
     return ptr;
 }
@@ -147,9 +152,92 @@ void SoundPlayer::StopAll()
     }
 }
 
+void SoundPlayer::SetCacheBudget(size_t bytes)
+{
+    cache_budget_ = bytes;
+    TrimCache();
+}
+
+void SoundPlayer::SetCacheFormat(bool mono, uint16_t bits_per_sample)
+{
+    cache_mono_ = mono;
+    cache_bits_ = bits_per_sample;
+}
+
 void SoundPlayer::ClearCache()
 {
     cache_.clear();
+    cache_lru_.clear();
+    cache_stats_.count = 0;
+    cache_stats_.bytes = 0;
+}
+
+RefPtr<AudioData> SoundPlayer::FindCache(size_t key)
+{
+    auto iter = cache_.find(key);
+    if (iter == cache_.end())
+    {
+        ++cache_stats_.misses;
+        return nullptr;
+    }
+
+    ++cache_stats_.hits;
+    cache_lru_.splice(cache_lru_.begin(), cache_lru_, iter->second.lru);
+    return iter->second.data;
+}
+
+RefPtr<AudioData> SoundPlayer::AddCache(size_t key, RefPtr<AudioData> data)
+{
+    if (!data->IsStreaming() && (cache_mono_ || cache_bits_))
+    {
+        const auto meta = data->GetMeta();
+
+        RefPtr<AudioData> converted =
+            data->ConvertPCM(cache_mono_ ? 1 : meta.channels, cache_bits_ ? cache_bits_ : meta.bits_per_sample);
+        if (converted)
+        {
+            data = converted;
+        }
+    }
+
+    CacheEntry entry;
+    entry.data  = data;
+    entry.bytes = data->IsStreaming() ? 0 : data->GetData().size;
+
+    cache_lru_.push_front(key);
+    entry.lru = cache_lru_.begin();
+    cache_.insert(std::make_pair(key, entry));
+
+    ++cache_stats_.count;
+    cache_stats_.bytes += entry.bytes;
+
+    TrimCache();
+    return data;
+}
+
+void SoundPlayer::TrimCache()
+{
+    if (cache_budget_ == 0)
+        return;
+
+    // Walk from the least recently played end, data still held by a sound is pinned because
+    // dropping it would not free anything
+    auto iter = cache_lru_.end();
+    while (cache_stats_.bytes > cache_budget_ && iter != cache_lru_.begin())
+    {
+        --iter;
+
+        auto entry = cache_.find(*iter);
+        if (entry->second.data->GetRefCount() > 1)
+            continue;
+
+        cache_stats_.bytes -= entry->second.bytes;
+        --cache_stats_.count;
+        ++cache_stats_.evictions;
+
+        cache_.erase(entry);
+        iter = cache_lru_.erase(iter);
+    }
 }
 
 void SoundPlayer::OnEnd(Sound* sound)
@@ -199,6 +287,9 @@ void SoundPlayer::RemoveCallback(Sound* sound)
 void SoundPlayer::ClearTrash()
 {
     trash_.clear();
+
+    // Sounds that just finished no longer pin their data
+    TrimCache();
 }
 
 }  // namespace audio
@@ -40,17 +40,29 @@ class KGE_API SoundPlayer : public ObjectBase
 public:
     using SoundList = List<RefPtr<Sound>>;
 
+    /// \~chinese
+    /// @brief ͳ
+    struct CacheStats
+    {
+        size_t hits      = 0;  ///< д
+        size_t misses    = 0;  ///< δд
+        size_t evictions = 0;  ///< ̭
+        size_t count     = 0;  ///< Ƶ
+        size_t bytes     = 0;  ///<  PCM ݴСֽڣ
+    };
+
     SoundPlayer();
 
     ~SoundPlayer();
 
     /// \~chinese
     /// @brief ԤƵ
-    /// @details
+    /// @details ʱСʽֵƵʽ򿪣ʱν
     RefPtr<AudioData> Preload(StringView file_path);
 
     /// \~chinese
     /// @brief ԤƵԴ
+    /// @details ʱСʽֵƵʽ򿪣ʱֱӴԴν
     RefPtr<AudioData> Preload(const Resource& res, StringView ext = "");
 
     /// \~chinese
@@ -96,6 +108,39 @@ public:
     /// @param volume С1.0 Ϊԭʼ,  1 ΪŴ, 0 ΪС
     void SetVolume(float volume);
 
+    /// \~chinese
+    /// @brief ȡʽֵ
+    Duration GetStreamThreshold() const;
+
+    /// \~chinese
+    /// @brief ʽֵ
+    /// @details ԤƵʱʱСڸֵƵʽţֻռü뻺ڴ档
+    /// ĬΪ 10 룬Ϊ 0 ʱǽƵ뵽ڴ
+    /// @param threshold ʽֵ
+    void SetStreamThreshold(Duration threshold);
+
+    /// \~chinese
+    /// @brief ȡֽڣ
+    size_t GetCacheBudget() const;
+
+    /// \~chinese
+    /// @brief û
+    /// @details  PCM ݳʱ̭δŵƵԱƵеݲᱻ̭
+    /// ĬΪ 64 MBΪ 0 ʱ
+    /// @param bytes ֽڣ
+    void SetCacheBudget(size_t bytes);
+
+    /// \~chinese
+    /// @brief ûƵĴ洢ʽ
+    /// @details ЧλԼٳפڴ棬ֻ֮صķʽƵЧ
+    /// @param mono Ƿ񽫶ƵΪ
+    /// @param bits_per_sample λΪ 8  16Ϊ 0 ʱԭλ
+    void SetCacheFormat(bool mono, uint16_t bits_per_sample = 0);
+
+    /// \~chinese
+    /// @brief ȡͳ
+    const CacheStats& GetCacheStats() const;
+
     /// \~chinese
     /// @brief ջ
     void ClearCache();
@@ -111,13 +156,33 @@ protected:
 
     void ClearTrash();
 
+    RefPtr<AudioData> FindCache(size_t key);
+
+    RefPtr<AudioData> AddCache(size_t key, RefPtr<AudioData> data);
+
+    void TrimCache();
+
 protected:
+    struct CacheEntry
+    {
+        RefPtr<AudioData>      data;
+        size_t                 bytes;
+        List<size_t>::iterator lru;
+    };
+
     float                 volume_;
+    Duration              stream_threshold_;
     SoundList             sound_list_;
     SoundList             trash_;
     RefPtr<SoundCallback> callback_;
 
-    UnorderedMap<size_t, RefPtr<AudioData>> cache_;
+    size_t     cache_budget_;
+    bool       cache_mono_;
+    uint16_t   cache_bits_;
+    CacheStats cache_stats_;
+
+    List<size_t>                     cache_lru_;  // most recently played first
+    UnorderedMap<size_t, CacheEntry> cache_;
 };
 
 /** @} */
@@ -127,5 +192,25 @@ inline const SoundPlayer::SoundList& SoundPlayer::GetPlayingList() const
     return sound_list_;
 }
 
+inline size_t SoundPlayer::GetCacheBudget() const
+{
+    return cache_budget_;
+}
+
+inline const SoundPlayer::CacheStats& SoundPlayer::GetCacheStats() const
+{
+    return cache_stats_;
+}
+
+inline Duration SoundPlayer::GetStreamThreshold() const
+{
+    return stream_threshold_;
+}
+
+inline void SoundPlayer::SetStreamThreshold(Duration threshold)
+{
+    stream_threshold_ = threshold;
+}
+
 }  // namespace audio
 }  // namespace kiwano
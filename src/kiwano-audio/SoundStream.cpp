@@ -0,0 +1,215 @@
+// Copyright (c) 2016-2019 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <kiwano-audio/SoundStream.h>
+#include <kiwano/utils/Logger.h>
+#include <algorithm>
+
+namespace kiwano
+{
+namespace audio
+{
+
+SoundStream::SoundStream(RefPtr<AudioStream> stream, const AudioMeta& meta, IXAudio2SourceVoice* voice)
+    : stream_(stream)
+    , voice_(voice)
+    , wake_event_(nullptr)
+    , block_align_(std::max<uint32_t>(meta.block_align, 1))
+    , active_(false)
+    , eof_(false)
+    , first_(false)
+    , loops_left_(0)
+    , generation_(0)
+    , stopped_(true)
+    , end_reported_(true)
+{
+    // Decoders only write whole frames, so the buffers must hold a whole number of them
+    const uint32_t size = BufferSize / block_align_ * block_align_;
+    for (auto& buffer : buffers_)
+    {
+        buffer.owner = this;
+        buffer.data.resize(size);
+    }
+}
+
+SoundStream::~SoundStream() {}
+
+void SoundStream::SetWakeEvent(HANDLE wake_event)
+{
+    wake_event_ = wake_event;
+}
+
+void SoundStream::Start(int loop_count)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Buffers flushed by an earlier stop must not report anything for this playback
+    ++generation_;
+    active_       = stream_->Seek(0);
+    eof_          = false;
+    first_        = true;
+    loops_left_   = loop_count < 0 ? -1 : loop_count;
+    stopped_      = !active_;
+    end_reported_ = !active_;
+
+    // Decode the first buffers right away so the voice can start without waiting for the worker
+    Fill();
+}
+
+bool SoundStream::Seek(uint64_t frame)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Buffers submitted before the seek are being flushed, their flags must not be reported
+    ++generation_;
+    if (!stream_->Seek(frame))
+        return false;
+
+    if (active_)
+    {
+        eof_          = false;
+        end_reported_ = false;
+        Fill();
+    }
+    return true;
+}
+
+void SoundStream::Stop()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    active_  = false;
+    stopped_ = true;
+}
+
+bool SoundStream::IsActive() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return active_ && !eof_;
+}
+
+void SoundStream::Update()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Fill();
+}
+
+void SoundStream::Fill()
+{
+    for (auto& buffer : buffers_)
+    {
+        if (!active_ || eof_)
+            break;
+
+        if (buffer.queued.load(std::memory_order_acquire))
+            continue;
+
+        uint8_t flags   = first_ ? FirstBuffer : 0;
+        size_t  size    = 0;
+        bool    rewound = false;
+        while (size < buffer.data.size())
+        {
+            const size_t bytes_read = stream_->Read(buffer.data.data() + size, buffer.data.size() - size);
+            if (bytes_read > 0)
+            {
+                size += bytes_read;
+                rewound = false;
+                continue;
+            }
+
+            // Rewind for the next loop, a stream that is still empty after rewinding ends here
+            if (loops_left_ != 0 && !rewound && stream_->Seek(0))
+            {
+                if (loops_left_ > 0)
+                    --loops_left_;
+
+                flags |= LoopEndBuffer;
+                rewound = true;
+                continue;
+            }
+
+            eof_ = true;
+            flags |= LastBuffer;
+            break;
+        }
+
+        if (size == 0)
+        {
+            // XAudio2 does not accept empty buffers, end the stream with a frame of silence
+            size = block_align_;
+            std::fill_n(buffer.data.begin(), size, uint8_t(0));
+        }
+
+        XAUDIO2_BUFFER xaudio2_buffer = { 0 };
+        xaudio2_buffer.pAudioData     = buffer.data.data();
+        xaudio2_buffer.AudioBytes     = UINT32(size);
+        xaudio2_buffer.pContext       = &buffer;
+        if (flags & LastBuffer)
+            xaudio2_buffer.Flags = XAUDIO2_END_OF_STREAM;
+
+        buffer.flags      = flags;
+        buffer.generation = generation_;
+        buffer.queued.store(true, std::memory_order_release);
+
+        HRESULT hr = voice_->SubmitSourceBuffer(&xaudio2_buffer);
+        if (FAILED(hr))
+        {
+            buffer.queued.store(false, std::memory_order_release);
+            active_ = false;
+
+            KGE_ERRORF("Submitting stream buffer failed with HRESULT of %08X", hr);
+            break;
+        }
+        first_ = false;
+    }
+}
+
+uint8_t SoundStream::OnBufferStart(void* context)
+{
+    auto buffer = static_cast<Buffer*>(context);
+    if (buffer->generation != buffer->owner->generation_)
+        return 0;
+    return buffer->flags & FirstBuffer;
+}
+
+uint8_t SoundStream::OnBufferEnd(void* context)
+{
+    auto         buffer = static_cast<Buffer*>(context);
+    SoundStream* owner  = buffer->owner;
+
+    // Read the flags before releasing the buffer, the worker may refill it right after
+    uint8_t flags = 0;
+    if (buffer->generation == owner->generation_)
+    {
+        // A buffer flushed by Sound::Stop ends the playback just like the last one
+        flags = owner->stopped_ ? LastBuffer : buffer->flags & (LoopEndBuffer | LastBuffer);
+    }
+
+    if ((flags & LastBuffer) && owner->end_reported_.exchange(true))
+        flags &= ~LastBuffer;
+
+    buffer->queued.store(false, std::memory_order_release);
+    if (owner->wake_event_)
+        ::SetEvent(owner->wake_event_);
+    return flags;
+}
+
+}  // namespace audio
+}  // namespace kiwano
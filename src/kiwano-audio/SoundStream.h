@@ -0,0 +1,138 @@
+// Copyright (c) 2016-2019 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <atomic>
+#include <mutex>
+#include <kiwano-audio/AudioData.h>
+#include <xaudio2.h>
+
+namespace kiwano
+{
+namespace audio
+{
+
+/**
+ * \addtogroup Audio
+ * @{
+ */
+
+/**
+ * \~chinese
+ * @brief ʽƵ
+ * @details һƵһ̶СĻ߳̽Ƶ뵽еĻвύƵ豸
+ * ϺͷŲѽ̡߳ѭźתֻҪƶƵλã½Ƶ
+ * @note  Sound ڲʹ
+ */
+class SoundStream : Noncopyable
+{
+public:
+    /// \~chinese
+    /// @brief 
+    enum BufferFlag : uint8_t
+    {
+        FirstBuffer   = 1,  ///< ſʼĵһ
+        LoopEndBuffer = 2,  ///< ڰһѭĽβ
+        LastBuffer    = 4,  ///< һ
+    };
+
+    /// \~chinese
+    /// @brief 
+    static const int BufferCount = 4;
+
+    /// \~chinese
+    /// @brief ÿĴСֽڣ
+    static const uint32_t BufferSize = 32 * 1024;
+
+    SoundStream(RefPtr<AudioStream> stream, const AudioMeta& meta, IXAudio2SourceVoice* voice);
+
+    ~SoundStream();
+
+    /// \~chinese
+    /// @brief ûѽ̵߳¼
+    void SetWakeEvent(HANDLE wake_event);
+
+    /// \~chinese
+    /// @brief ͷʼ
+    /// @param loop_count ѭ-1 Ϊѭ
+    void Start(int loop_count);
+
+    /// \~chinese
+    /// @brief תָλ
+    /// @details ǰҪֹͣԴύĻ
+    /// @param frame ֡λ
+    bool Seek(uint64_t frame);
+
+    /// \~chinese
+    /// @brief ֹͣ
+    /// @details ֮յĻᱨһβŽ
+    void Stop();
+
+    /// \~chinese
+    /// @brief Ƿδ
+    bool IsActive() const;
+
+    /// \~chinese
+    /// @brief ݽ뵽еĻвύ
+    /// @note ڽ߳е
+    void Update();
+
+    /// \~chinese
+    /// @brief ʼʱ
+    /// @return ҪִеĻصӦĻ
+    static uint8_t OnBufferStart(void* context);
+
+    /// \~chinese
+    /// @brief ŽʱãͷŻѽ߳
+    /// @return ҪִеĻصӦĻ
+    static uint8_t OnBufferEnd(void* context);
+
+private:
+    struct Buffer
+    {
+        SoundStream*      owner      = nullptr;
+        uint32_t          generation = 0;
+        uint8_t           flags      = 0;
+        std::atomic<bool> queued{ false };
+        Vector<uint8_t>   data;
+    };
+
+    void Fill();
+
+private:
+    RefPtr<AudioStream>   stream_;
+    IXAudio2SourceVoice*  voice_;
+    HANDLE                wake_event_;
+    uint32_t              block_align_;
+    bool                  active_;
+    bool                  eof_;
+    bool                  first_;
+    int                   loops_left_;
+    std::atomic<uint32_t> generation_;
+    std::atomic<bool>     stopped_;
+    std::atomic<bool>     end_reported_;
+    mutable std::mutex    mutex_;
+    Buffer                buffers_[BufferCount];
+};
+
+/** @} */
+
+}  // namespace audio
+}  // namespace kiwano
@@ -20,6 +20,7 @@
 
 #pragma once
 #include <kiwano/core/Resource.h>
+#include <kiwano/core/Duration.h>
 #include <kiwano-audio/AudioData.h>
 
 namespace kiwano
@@ -46,6 +47,27 @@ public:
     virtual RefPtr<AudioData> Decode(StringView file_path) = 0;
 
     virtual RefPtr<AudioData> Decode(const Resource& res) = 0;
+
+    /// \~chinese
+    /// @brief ʽƵ
+    /// @details ʽƵڲʱν룬ҪƵ뵽ڴ
+    /// @param file_path Ƶļ·
+    /// @param min_duration ƵʱСڸֵʱʹ
+    /// @return ֧ʽŻƵʱʱؿ
+    virtual RefPtr<AudioData> Stream(StringView file_path, Duration min_duration)
+    {
+        return nullptr;
+    }
+
+    /// \~chinese
+    /// @brief ʽƵԴ
+    /// @param res ƵԴڼԴݱ뱣Ч
+    /// @param min_duration ƵʱСڸֵʱʹ
+    /// @return ֧ʽŻƵʱʱؿ
+    virtual RefPtr<AudioData> Stream(const Resource& res, Duration min_duration)
+    {
+        return nullptr;
+    }
 };
 
 /** @} */
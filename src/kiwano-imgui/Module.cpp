@@ -213,12 +213,12 @@ void Module::HandleEvent(EventModuleContext& ctx)
         {
             if (evt->IsType<MouseMoveEvent>())
             {
-                const auto& pos = dynamic_cast<MouseMoveEvent*>(evt)->pos;
+                const auto& pos = static_cast<MouseMoveEvent*>(evt)->pos;
                 io.AddMousePosEvent(pos.x, pos.y);
             }
             else if (evt->IsType<MouseDownEvent>())
             {
-                MouseButton button = dynamic_cast<MouseDownEvent*>(evt)->button;
+                MouseButton button = static_cast<MouseDownEvent*>(evt)->button;
                 int         index  = 0;
                 if (button == MouseButton::Left)
                     index = 0;
@@ -230,7 +230,7 @@ void Module::HandleEvent(EventModuleContext& ctx)
             }
             else if (evt->IsType<MouseUpEvent>())
             {
-                MouseButton button = dynamic_cast<MouseUpEvent*>(evt)->button;
+                MouseButton button = static_cast<MouseUpEvent*>(evt)->button;
                 int         index  = 0;
                 if (button == MouseButton::Left)
                     index = 0;
@@ -242,7 +242,7 @@ void Module::HandleEvent(EventModuleContext& ctx)
             }
             else if (evt->IsType<MouseWheelEvent>())
             {
-                float wheel = dynamic_cast<MouseWheelEvent*>(evt)->wheel;
+                float wheel = static_cast<MouseWheelEvent*>(evt)->wheel;
                 io.AddMouseWheelEvent(0.0f, wheel);
             }
         }
@@ -250,22 +250,22 @@ void Module::HandleEvent(EventModuleContext& ctx)
         {
             if (evt->IsType<KeyDownEvent>())
             {
-                KeyCode key = dynamic_cast<KeyDownEvent*>(evt)->code;
+                KeyCode key = static_cast<KeyDownEvent*>(evt)->code;
                 io.AddKeyEvent(KeyCodeToImGuiKey(key), true);
             }
             else if (evt->IsType<KeyUpEvent>())
             {
-                KeyCode key = dynamic_cast<KeyUpEvent*>(evt)->code;
+                KeyCode key = static_cast<KeyUpEvent*>(evt)->code;
                 io.AddKeyEvent(KeyCodeToImGuiKey(key), false);
             }
             else if (evt->IsType<KeyCharEvent>())
             {
-                char ch = dynamic_cast<KeyCharEvent*>(evt)->value;
+                char ch = static_cast<KeyCharEvent*>(evt)->value;
                 io.AddInputCharacter(static_cast<ImWchar>(ch));
             }
             else if (evt->IsType<IMEInputEvent>())
             {
-                const auto& str      = dynamic_cast<IMEInputEvent*>(evt)->value;
+                const auto& str      = static_cast<IMEInputEvent*>(evt)->value;
                 const auto  utf8_str = strings::WideToUTF8(strings::NarrowToWide(str));
                 io.AddInputCharactersUTF8(utf8_str.c_str());
             }
@@ -274,7 +274,7 @@ void Module::HandleEvent(EventModuleContext& ctx)
         {
             if (evt->IsType<WindowFocusChangedEvent>())
             {
-                bool focus = dynamic_cast<WindowFocusChangedEvent*>(evt)->focus;
+                bool focus = static_cast<WindowFocusChangedEvent*>(evt)->focus;
                 io.AddFocusEvent(focus);
             }
         }
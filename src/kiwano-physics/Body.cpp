@@ -29,6 +29,15 @@ namespace physics
 Body::Body(b2Body* body, b2World* world)
     : b2body_(body)
     , b2world_(world)
+    , world_(nullptr)
+    , registry_index_(0)
+    , parent_(nullptr)
+    , depth_(0)
+    , interpolating_(false)
+    , prev_angle_(0.0f)
+    , prev_position_(0.0f, 0.0f)
+    , synced_(false)
+    , rotation_cached_(0.0f)
 {
     SetName(KGE_COMP_PHYSIC_BODY);
 
@@ -41,24 +50,48 @@ void Body::InitComponent(Actor* actor)
 {
     Component::InitComponent(actor);
 
+    // Bodies bound before their world are registered when the world is bound,
+    // and bodies added to the world later are picked up before the next simulation
+    if (World* world = FindWorld(actor->GetParent()))
+    {
+        world->AddToRegistry(this);
+    }
+
     UpdateFromActor(actor);
 }
 
 void Body::DestroyComponent()
 {
+    if (world_)
+    {
+        world_->RemoveFromRegistry(this);
+    }
+
     // Detach from actor first
     Component::DestroyComponent();
 
     if (b2body_ && b2world_)
     {
         b2world_->DestroyBody(b2body_);
+
+        // Contact events may keep this component alive after the body is gone
+        b2body_ = nullptr;
     }
 }
 
 void Body::BeforeSimulation(Actor* actor, const Matrix3x2& parent_to_world, const Matrix3x2& actor_to_world,
                                   float parent_rotation)
 {
-    UpdateFromActor(actor, actor_to_world, parent_rotation + actor->GetRotation());
+    const float rotation = parent_rotation + actor->GetRotation();
+    if (synced_)
+    {
+        // With interpolation the actor lags behind the body, so only the change is pushed
+        ApplyActorChange(actor, actor_to_world, rotation);
+    }
+    else
+    {
+        UpdateFromActor(actor, actor_to_world, rotation);
+    }
 
     /*if (actor->GetAnchor() != Vec2(0.5f, 0.5f))
     {
@@ -68,18 +101,51 @@ void Body::BeforeSimulation(Actor* actor, const Matrix3x2& parent_to_world, cons
     }*/
 }
 
-void Body::AfterSimulation(Actor* actor, const Matrix3x2& parent_to_world, float parent_rotation)
+bool Body::AfterSimulation(Actor* actor, const Matrix3x2& world_to_parent, float parent_rotation, float alpha)
 {
-    Point position_in_parent = WorldToLocal(b2body_->GetPosition());
-    if (position_cached_ != position_in_parent)
+    bool moved = false;
+
+    b2Vec2 position = b2body_->GetPosition();
+    float  angle    = b2body_->GetAngle();
+    if (alpha < 1.0f)
+    {
+        position = (1.0f - alpha) * prev_position_ + alpha * position;
+        angle    = prev_angle_ + alpha * (angle - prev_angle_);
+    }
+
+    Point position_in_world = WorldToLocal(position);
+    if (position_cached_ != position_in_world)
     {
         /*position_in_parent = parent_to_world.Invert().Transform(position_in_parent);
         actor->SetPosition(position_in_parent - offset_);*/
 
-        position_in_parent = parent_to_world.Invert().Transform(position_in_parent);
-        actor->SetPosition(position_in_parent);
+        position_cached_ = position_in_world;
+        actor->SetPosition(world_to_parent.Transform(position_in_world));
+        moved = true;
     }
-    actor->SetRotation(math::Radian2Degree(b2body_->GetAngle()) -parent_rotation);
+
+    rotation_cached_ = math::Radian2Degree(angle);
+
+    float rotation = rotation_cached_ - parent_rotation;
+    if (actor->GetRotation() != rotation)
+    {
+        actor->SetRotation(rotation);
+        moved = true;
+    }
+    return moved;
+}
+
+World* Body::FindWorld(Actor* actor) const
+{
+    for (Actor* ptr = actor; ptr; ptr = ptr->GetParent())
+    {
+        auto world = dynamic_cast<World*>(ptr->GetComponent(KGE_COMP_PHYSIC_WORLD));
+        if (world && world->GetB2World() == b2body_->GetWorld())
+        {
+            return world;
+        }
+    }
+    return nullptr;
 }
 
 void Body::UpdateFromActor(Actor* actor)
@@ -116,6 +182,45 @@ void Body::UpdateFromActor(Actor* actor, const Matrix3x2& actor_to_world, float
     b2body_->SetTransform(LocalToWorld(position), math::Degree2Radian(rotation));
 
     position_cached_ = WorldToLocal(b2body_->GetPosition());
+    rotation_cached_ = rotation;
+    synced_          = true;
+
+    // Teleported, nothing to interpolate from
+    SavePreviousTransform();
+}
+
+void Body::ApplyActorChange(Actor* actor, const Matrix3x2& actor_to_world, float rotation)
+{
+    KGE_ASSERT(b2body_);
+
+    Point anchor   = actor->GetAnchor();
+    Point size     = actor->GetSize();
+    Point position = actor_to_world.Transform(Point(anchor.x * size.x, anchor.y * size.y));
+
+    // Writing the pose back and reading it again through the matrices is not exact
+    const float epsilon = 1e-3f;
+
+    Vec2  offset = position - position_cached_;
+    float delta  = rotation - rotation_cached_;
+    if (std::abs(offset.x) < epsilon && std::abs(offset.y) < epsilon && std::abs(delta) < epsilon)
+        return;
+
+    b2Vec2 b2offset = LocalToWorld(offset);
+    float  b2delta  = math::Degree2Radian(delta);
+    b2body_->SetTransform(b2body_->GetPosition() + b2offset, b2body_->GetAngle() + b2delta);
+
+    // Moved together with the previous state, so the interpolation goes on
+    prev_position_ += b2offset;
+    prev_angle_ += b2delta;
+
+    position_cached_ = position;
+    rotation_cached_ = rotation;
+}
+
+void Body::SavePreviousTransform()
+{
+    prev_position_ = b2body_->GetPosition();
+    prev_angle_    = b2body_->GetAngle();
 }
 
 Point Body::GetLocalPoint(const Point& world) const
@@ -89,17 +89,53 @@ protected:
 
     /// \~chinese
     /// @brief ǰ
+    /// @details ֻͽɫϴд̬ı仯岻ᱻصֵ̬
     void BeforeSimulation(Actor* actor, const Matrix3x2& parent_to_world, const Matrix3x2& actor_to_world,
                           float parent_rotation);
 
+    /// \~chinese
+    /// @brief ɫģ֮ı仯ӵ
+    /// @param actor 󶨵Ľɫ
+    /// @param actor_to_world ɫı任
+    /// @param rotation ɫеתǶ
+    void ApplyActorChange(Actor* actor, const Matrix3x2& actor_to_world, float rotation);
+
     /// \~chinese
     /// @brief 
-    void AfterSimulation(Actor* actorconst, const Matrix3x2& parent_to_world, float parent_rotation);
+    /// @param actor 󶨵Ľɫ
+    /// @param world_to_parent 絽ɫı任
+    /// @param parent_rotation ɫеתǶ
+    /// @param alpha һ״̬뵱ǰ״̬֮Ĳֵϵ
+    /// @return ɫǷƶ
+    bool AfterSimulation(Actor* actor, const Matrix3x2& world_to_parent, float parent_rotation, float alpha);
+
+    /// \~chinese
+    /// @brief 浱ǰ״̬ڲֵ
+    void SavePreviousTransform();
+
+    /// \~chinese
+    /// @brief ڵ
+    World* FindWorld(Actor* actor) const;
 
 private:
     b2World* b2world_;
     b2Body*  b2body_;
 
+    // Registered while bound to an actor under the world
+    World*   world_;
+    size_t   registry_index_;
+    Actor*   parent_;
+    uint32_t depth_;
+
+    // State before the last step, used for interpolation
+    bool   interpolating_;
+    float  prev_angle_;
+    b2Vec2 prev_position_;
+
+    // Pose last written to the actor, changes are measured against it
+    bool  synced_;
+    float rotation_cached_;
+
     // Point offset_;
     Point position_cached_;
 };
@@ -31,44 +31,6 @@ namespace physics
  * @{
  */
 
-/// \~chinese
-/// @brief Ӵʼ¼
-class KGE_API ContactBeginEvent : public Event
-{
-public:
-    b2Contact* contact;  ///< ĽӴ
-
-    ContactBeginEvent()
-        : ContactBeginEvent(nullptr)
-    {
-    }
-
-    ContactBeginEvent(b2Contact* contact)
-        : Event(KGE_EVENT(ContactBeginEvent))
-        , contact(contact)
-    {
-    }
-};
-
-/// \~chinese
-/// @brief Ӵ¼
-class KGE_API ContactEndEvent : public Event
-{
-public:
-    b2Contact* contact;  ///< ĽӴ
-
-    ContactEndEvent()
-        : ContactEndEvent(nullptr)
-    {
-    }
-
-    ContactEndEvent(b2Contact* contact)
-        : Event(KGE_EVENT(ContactEndEvent))
-        , contact(contact)
-    {
-    }
-};
-
 /// \~chinese
 /// @brief Ӵб
 class ContactList
@@ -0,0 +1,162 @@
+// Copyright (c) 2018-2019 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <kiwano-physics/ContactEvents.h>
+
+namespace kiwano
+{
+namespace physics
+{
+
+ContactFixture::ContactFixture()
+    : user_data(nullptr)
+    , category_bits(0)
+    , sensor(false)
+{
+}
+
+ContactFixture::ContactFixture(b2Fixture* fixture)
+    : body(static_cast<Body*>(fixture->GetBody()->GetUserData()))
+    , user_data(fixture->GetUserData())
+    , category_bits(fixture->GetFilterData().categoryBits)
+    , sensor(fixture->IsSensor())
+{
+}
+
+ContactEventStream::ContactEventStream()
+    : mask_bits_(0xFFFF)
+    , pending_end_(0)
+    , step_start_(0)
+{
+}
+
+void ContactEventStream::Clear()
+{
+    // Keep the capacity, the next update usually has about as many contacts
+    types_.clear();
+    fixtures_a_.clear();
+    fixtures_b_.clear();
+    normals_.clear();
+    impulses_.clear();
+    contacts_.clear();
+    pending_.clear();
+    pending_end_ = 0;
+    step_start_  = 0;
+
+    // Contacts that ended since the last update open the new one
+    for (size_t i = 0; i < deferred_a_.size(); ++i)
+    {
+        types_.push_back(ContactEventType::End);
+        fixtures_a_.push_back(std::move(deferred_a_[i]));
+        fixtures_b_.push_back(std::move(deferred_b_[i]));
+        normals_.emplace_back();
+        impulses_.push_back(0.0f);
+        contacts_.push_back(nullptr);
+    }
+    deferred_a_.clear();
+    deferred_b_.clear();
+}
+
+void ContactEventStream::BeginStep()
+{
+    // Contacts of earlier steps may have been destroyed and their memory reused
+    step_start_  = types_.size();
+    pending_end_ = step_start_;
+    pending_.clear();
+}
+
+bool ContactEventStream::Accept(b2Contact* contact) const
+{
+    const uint16_t category_a = contact->GetFixtureA()->GetFilterData().categoryBits;
+    const uint16_t category_b = contact->GetFixtureB()->GetFilterData().categoryBits;
+    return ((category_a | category_b) & mask_bits_) != 0;
+}
+
+void ContactEventStream::AddBegin(b2Contact* contact)
+{
+    b2WorldManifold manifold;
+    manifold.normal.SetZero();
+    if (contact->GetManifold()->pointCount > 0)
+    {
+        contact->GetWorldManifold(&manifold);
+    }
+
+    types_.push_back(ContactEventType::Begin);
+    fixtures_a_.emplace_back(contact->GetFixtureA());
+    fixtures_b_.emplace_back(contact->GetFixtureB());
+    normals_.emplace_back(manifold.normal.x, manifold.normal.y);
+    impulses_.push_back(0.0f);
+    contacts_.push_back(contact);
+}
+
+void ContactEventStream::AddEnd(b2Contact* contact)
+{
+    types_.push_back(ContactEventType::End);
+    fixtures_a_.emplace_back(contact->GetFixtureA());
+    fixtures_b_.emplace_back(contact->GetFixtureB());
+    normals_.emplace_back();
+    impulses_.push_back(0.0f);
+    contacts_.push_back(contact);
+}
+
+void ContactEventStream::AddDeferredEnd(b2Contact* contact)
+{
+    // Snapshots are taken now, the fixtures are about to be destroyed
+    deferred_a_.emplace_back(contact->GetFixtureA());
+    deferred_b_.emplace_back(contact->GetFixtureB());
+}
+
+void ContactEventStream::AddImpulse(b2Contact* contact, const b2ContactImpulse* impulse)
+{
+    // Every touching contact is reported after solving, but only those that began in this step are recorded
+    if (types_.size() == step_start_)
+        return;
+
+    if (pending_end_ != types_.size())
+    {
+        // New events since the last lookup, index the begin events of this step by contact
+        pending_.clear();
+        for (size_t i = step_start_; i < types_.size(); ++i)
+        {
+            if (types_[i] == ContactEventType::Begin)
+                pending_.push_back(static_cast<uint32_t>(i));
+        }
+
+        std::sort(pending_.begin(), pending_.end(),
+                  [this](uint32_t lhs, uint32_t rhs) { return std::less<b2Contact*>()(contacts_[lhs], contacts_[rhs]); });
+        pending_end_ = types_.size();
+    }
+
+    auto iter = std::lower_bound(pending_.begin(), pending_.end(), contact, [this](uint32_t index, b2Contact* contact) {
+        return std::less<b2Contact*>()(contacts_[index], contact);
+    });
+    if (iter == pending_.end() || contacts_[*iter] != contact)
+        return;
+
+    float max_impulse = 0.0f;
+    for (int32 i = 0; i < impulse->count; ++i)
+    {
+        max_impulse = std::max(max_impulse, impulse->normalImpulses[i]);
+    }
+    impulses_[*iter] = std::max(impulses_[*iter], max_impulse);
+}
+
+}  // namespace physics
+}  // namespace kiwano
@@ -0,0 +1,238 @@
+// Copyright (c) 2018-2019 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <kiwano-physics/Body.h>
+
+namespace kiwano
+{
+namespace physics
+{
+
+class ContactListener;
+class World;
+
+/**
+ * \addtogroup Physics
+ * @{
+ */
+
+/// \~chinese
+/// @brief Ӵ¼
+enum class ContactEventType : uint8_t
+{
+    Begin,  ///< Ӵʼ
+    End,    ///< Ӵ
+};
+
+/**
+ * \~chinese
+ * @brief Ӵ¼еļо߿
+ * @details ¼ʱ¼о¼ַǰٺȻЧ
+ */
+struct ContactFixture
+{
+    RefPtr<Body> body;           ///< о壬ûа Body ʱΪ
+    void*        user_data;      ///< оߵû
+    uint16_t     category_bits;  ///< оߵ
+    bool         sensor;         ///< оǷǴ
+
+    ContactFixture();
+
+    ContactFixture(b2Fixture* fixture);
+};
+
+/**
+ * \~chinese
+ * @brief Ӵ¼
+ * @details ڼĽӴ¼д洢У½ͳһַ
+ * ¼´θǰЧ
+ * ڸ֮оʱĽӴҲӴ¼Щ¼´θʱַ
+ * ÿӴʼ¼жӦĽӴ¼
+ */
+class KGE_API ContactEventStream : Noncopyable
+{
+    friend class World;
+    friend class ContactListener;
+
+public:
+    ContactEventStream();
+
+    /// \~chinese
+    /// @brief ȡ¼
+    size_t GetCount() const;
+
+    /// \~chinese
+    /// @brief Ƿû¼
+    bool IsEmpty() const;
+
+    /// \~chinese
+    /// @brief ȡ¼
+    ContactEventType GetType(size_t index) const;
+
+    /// \~chinese
+    /// @brief ȡӴļоA
+    const ContactFixture& GetFixtureA(size_t index) const;
+
+    /// \~chinese
+    /// @brief ȡӴļоB
+    const ContactFixture& GetFixtureB(size_t index) const;
+
+    /// \~chinese
+    /// @brief ȡоA壬ûа Body ʱΪ
+    Body* GetBodyA(size_t index) const;
+
+    /// \~chinese
+    /// @brief ȡоB壬ûа Body ʱΪ
+    Body* GetBodyB(size_t index) const;
+
+    /// \~chinese
+    /// @brief ȡӴߣɼоAָоB
+    /// @details Ӵ¼ʹķΪ
+    const Vec2& GetNormal(size_t index) const;
+
+    /// \~chinese
+    /// @brief ȡӴʼʱķ
+    /// @details Ӵʼʱ䲽ʩӵжײǿȣӴ¼Ϊ 0
+    float GetImpulse(size_t index) const;
+
+    /// \~chinese
+    /// @brief 
+    /// @details ֻ¼һоߵнĽӴĬϼ¼нӴ
+    void SetMaskBits(uint16_t mask_bits);
+
+    /// \~chinese
+    /// @brief ȡ
+    uint16_t GetMaskBits() const;
+
+private:
+    void Clear();
+
+    void BeginStep();
+
+    bool Accept(b2Contact* contact) const;
+
+    void AddBegin(b2Contact* contact);
+
+    void AddEnd(b2Contact* contact);
+
+    void AddDeferredEnd(b2Contact* contact);
+
+    void AddImpulse(b2Contact* contact, const b2ContactImpulse* impulse);
+
+private:
+    uint16_t mask_bits_;
+
+    Vector<ContactEventType> types_;
+    Vector<ContactFixture>   fixtures_a_;
+    Vector<ContactFixture>   fixtures_b_;
+    Vector<Vec2>             normals_;
+    Vector<float>            impulses_;
+
+    // Only valid during a step, used to find the begin event of a solved contact
+    Vector<b2Contact*> contacts_;
+    Vector<uint32_t>   pending_;
+    size_t             pending_end_;
+    size_t             step_start_;
+
+    // Contacts ended outside of a step, delivered with the next update
+    Vector<ContactFixture> deferred_a_;
+    Vector<ContactFixture> deferred_b_;
+};
+
+/// \~chinese
+/// @brief Ӵ¼
+/// @details º˽Ӵ¼ڵĽɫϷַһ
+class KGE_API ContactBatchEvent : public Event
+{
+public:
+    const ContactEventStream* events;  ///< θ²ĽӴ¼
+
+    ContactBatchEvent()
+        : ContactBatchEvent(nullptr)
+    {
+    }
+
+    ContactBatchEvent(const ContactEventStream* events)
+        : Event(KGE_EVENT(ContactBatchEvent))
+        , events(events)
+    {
+    }
+};
+
+/** @} */
+
+inline size_t ContactEventStream::GetCount() const
+{
+    return types_.size();
+}
+
+inline bool ContactEventStream::IsEmpty() const
+{
+    return types_.empty();
+}
+
+inline ContactEventType ContactEventStream::GetType(size_t index) const
+{
+    return types_[index];
+}
+
+inline const ContactFixture& ContactEventStream::GetFixtureA(size_t index) const
+{
+    return fixtures_a_[index];
+}
+
+inline const ContactFixture& ContactEventStream::GetFixtureB(size_t index) const
+{
+    return fixtures_b_[index];
+}
+
+inline Body* ContactEventStream::GetBodyA(size_t index) const
+{
+    return fixtures_a_[index].body.Get();
+}
+
+inline Body* ContactEventStream::GetBodyB(size_t index) const
+{
+    return fixtures_b_[index].body.Get();
+}
+
+inline const Vec2& ContactEventStream::GetNormal(size_t index) const
+{
+    return normals_[index];
+}
+
+inline float ContactEventStream::GetImpulse(size_t index) const
+{
+    return impulses_[index];
+}
+
+inline void ContactEventStream::SetMaskBits(uint16_t mask_bits)
+{
+    mask_bits_ = mask_bits;
+}
+
+inline uint16_t ContactEventStream::GetMaskBits() const
+{
+    return mask_bits_;
+}
+
+}  // namespace physics
+}  // namespace kiwano
@@ -19,13 +19,197 @@
 // THE SOFTWARE.
 
 #include <kiwano-physics/World.h>
+#include <kiwano/platform/Application.h>
+#include <kiwano/base/JobSystem.h>
 
 namespace kiwano
 {
 namespace physics
 {
 
-const float FIXED_TIMESTEP = 1.f / 60.f;
+SimulationStats::SimulationStats()
+    : steps(0)
+    , dropped_steps(0)
+    , dropped_seconds(0.0f)
+{
+}
+
+QueryFilter::QueryFilter()
+    : QueryFilter(0xFFFF, false)
+{
+}
+
+QueryFilter::QueryFilter(uint16_t mask_bits, bool include_sensors)
+    : mask_bits(mask_bits)
+    , include_sensors(include_sensors)
+{
+}
+
+bool QueryFilter::Accept(const b2Fixture* fixture) const
+{
+    if (!include_sensors && fixture->IsSensor())
+        return false;
+    return (fixture->GetFilterData().categoryBits & mask_bits) != 0;
+}
+
+Ray::Ray() {}
+
+Ray::Ray(const Point& begin, const Point& end)
+    : begin(begin)
+    , end(end)
+{
+}
+
+RayCastResult::RayCastResult()
+    : fixture(nullptr)
+    , body(nullptr)
+    , fraction(1.0f)
+{
+}
+
+namespace
+{
+
+// The query callbacks below are called by b2BroadPhase through templates, so each proxy costs no virtual call
+
+void FillRayCastResult(RayCastResult& result, b2Fixture* fixture, const b2RayCastInput& input,
+                       const b2RayCastOutput& output)
+{
+    result.fixture  = fixture;
+    result.body     = static_cast<Body*>(fixture->GetBody()->GetUserData());
+    result.point    = WorldToLocal((1.0f - output.fraction) * input.p1 + output.fraction * input.p2);
+    result.normal   = Vec2(output.normal.x, output.normal.y);
+    result.fraction = output.fraction;
+}
+
+class ClosestRayCastCallback
+{
+public:
+    ClosestRayCastCallback(const b2BroadPhase& broad_phase, const QueryFilter& filter)
+        : broad_phase_(broad_phase)
+        , filter_(filter)
+        , fixture(nullptr)
+    {
+    }
+
+    float32 RayCastCallback(const b2RayCastInput& input, int32 proxy_id)
+    {
+        auto proxy = static_cast<b2FixtureProxy*>(broad_phase_.GetUserData(proxy_id));
+        if (!filter_.Accept(proxy->fixture))
+            return input.maxFraction;
+
+        b2RayCastOutput hit;
+        if (!proxy->fixture->RayCast(&hit, input, proxy->childIndex))
+            return input.maxFraction;
+
+        fixture = proxy->fixture;
+        output  = hit;
+
+        // Clip the ray so that farther proxies are skipped
+        return hit.fraction;
+    }
+
+    b2Fixture*      fixture;
+    b2RayCastOutput output;
+
+private:
+    const b2BroadPhase& broad_phase_;
+    const QueryFilter&  filter_;
+};
+
+class AllRayCastCallback
+{
+public:
+    AllRayCastCallback(const b2BroadPhase& broad_phase, const QueryFilter& filter, Vector<RayCastResult>& results)
+        : broad_phase_(broad_phase)
+        , filter_(filter)
+        , results_(results)
+    {
+    }
+
+    float32 RayCastCallback(const b2RayCastInput& input, int32 proxy_id)
+    {
+        auto proxy = static_cast<b2FixtureProxy*>(broad_phase_.GetUserData(proxy_id));
+        if (!filter_.Accept(proxy->fixture))
+            return input.maxFraction;
+
+        b2RayCastOutput output;
+        if (proxy->fixture->RayCast(&output, input, proxy->childIndex))
+        {
+            results_.emplace_back();
+            FillRayCastResult(results_.back(), proxy->fixture, input, output);
+        }
+        return input.maxFraction;
+    }
+
+private:
+    const b2BroadPhase&    broad_phase_;
+    const QueryFilter&     filter_;
+    Vector<RayCastResult>& results_;
+};
+
+class OverlapQueryCallback
+{
+public:
+    OverlapQueryCallback(const b2BroadPhase& broad_phase, const QueryFilter& filter, const b2AABB& aabb,
+                         Vector<b2Fixture*>& fixtures)
+        : broad_phase_(broad_phase)
+        , filter_(filter)
+        , aabb_(aabb)
+        , fixtures_(fixtures)
+        , shape_(nullptr)
+    {
+    }
+
+    // Also test the query shape, not only the bounding box
+    void SetShape(const b2Shape* shape, const b2Transform& xf)
+    {
+        shape_ = shape;
+        xf_    = xf;
+    }
+
+    bool QueryCallback(int32 proxy_id)
+    {
+        auto       proxy   = static_cast<b2FixtureProxy*>(broad_phase_.GetUserData(proxy_id));
+        b2Fixture* fixture = proxy->fixture;
+
+        // The tree holds fattened boxes, test the tight one first
+        if (!filter_.Accept(fixture) || !b2TestOverlap(proxy->aabb, aabb_))
+            return true;
+
+        // Chain shapes have a proxy for every edge
+        if (fixture->GetShape()->GetChildCount() > 1
+            && std::find(fixtures_.begin(), fixtures_.end(), fixture) != fixtures_.end())
+            return true;
+
+        if (shape_)
+        {
+            const b2Transform& xf = fixture->GetBody()->GetTransform();
+
+            bool overlapped = false;
+            for (int32 i = 0; i < shape_->GetChildCount() && !overlapped; ++i)
+            {
+                overlapped = b2TestOverlap(shape_, i, fixture->GetShape(), proxy->childIndex, xf_, xf);
+            }
+
+            if (!overlapped)
+                return true;
+        }
+
+        fixtures_.push_back(fixture);
+        return true;
+    }
+
+private:
+    const b2BroadPhase& broad_phase_;
+    const QueryFilter&  filter_;
+    b2AABB              aabb_;
+    Vector<b2Fixture*>& fixtures_;
+    const b2Shape*      shape_;
+    b2Transform         xf_;
+};
+
+}  // namespace
 
 class World::DebugDrawer : public b2Draw
 {
@@ -138,34 +322,40 @@ private:
     RefPtr<CanvasRenderContext> ctx_;
 };
 
+// Contacts are only recorded during the step, and delivered once the step is finished
 class ContactListener : public b2ContactListener
 {
-    Function<void(Event*)> dispatcher_;
+    ContactEventStream& events_;
 
 public:
-    ContactListener(Function<void(Event*)> dispatcher)
-        : dispatcher_(dispatcher)
+    ContactListener(ContactEventStream& events)
+        : events_(events)
     {
     }
 
     void BeginContact(b2Contact* b2contact) override
     {
-        RefPtr<ContactBeginEvent> evt = new ContactBeginEvent(b2contact);
-        dispatcher_(evt.Get());
+        if (events_.Accept(b2contact))
+        {
+            events_.AddBegin(b2contact);
+        }
     }
 
     void EndContact(b2Contact* b2contact) override
     {
-        Body* body_a = static_cast<Body*>(b2contact->GetFixtureA()->GetBody()->GetUserData());
-        Body* body_b = static_cast<Body*>(b2contact->GetFixtureB()->GetBody()->GetUserData());
-        if (!body_a || !body_b || !body_a->GetBoundActor() || !body_b->GetBoundActor())
-        {
-            // Don't dispatch contact event after the body has been detached
+        if (!events_.Accept(b2contact))
             return;
-        }
 
-        RefPtr<ContactEndEvent> evt = new ContactEndEvent(b2contact);
-        dispatcher_(evt.Get());
+        // Outside of a step the contact ends because a body or fixture is being destroyed,
+        // the event is delivered with the next update so that begin and end events stay paired
+        if (b2contact->GetFixtureA()->GetBody()->GetWorld()->IsLocked())
+        {
+            events_.AddEnd(b2contact);
+        }
+        else
+        {
+            events_.AddDeferredEnd(b2contact);
+        }
     }
 
     void PreSolve(b2Contact* contact, const b2Manifold* oldManifold) override
@@ -176,8 +366,36 @@ public:
 
     void PostSolve(b2Contact* contact, const b2ContactImpulse* impulse) override
     {
-        KGE_NOT_USED(contact);
-        KGE_NOT_USED(impulse);
+        events_.AddImpulse(contact, impulse);
+    }
+};
+
+class JobSystemExecutor : public b2TaskExecutor
+{
+    int32 thread_count_;
+
+public:
+    JobSystemExecutor(int32 thread_count)
+        : thread_count_(thread_count)
+    {
+    }
+
+    int32 GetThreadCount() const override
+    {
+        return thread_count_;
+    }
+
+    void Run(b2Task* task, int32 count) override
+    {
+        JobSystem::GetInstance().ParallelFor(
+            size_t(count),
+            [task](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    task->Execute(int32(i));
+                }
+            },
+            1);
     }
 };
 
@@ -185,17 +403,28 @@ World::World(const b2Vec2& gravity)
     : world_(gravity)
     , vel_iter_(6)
     , pos_iter_(2)
+    , max_steps_(5)
+    , interpolation_(false)
+    , fixed_timestep_(1.f / 60.f)
     , fixed_acc_(0.f)
+    , bodies_unsorted_(false)
+    , worker_count_(1)
 {
     SetName(KGE_COMP_PHYSIC_WORLD);
 
-    contact_listener_ = std::make_unique<ContactListener>(Closure(this, &World::DispatchEvent));
+    contact_listener_ = std::make_unique<ContactListener>(contact_events_);
     world_.SetContactListener(contact_listener_.get());
 }
 
 World::~World()
 {
     world_.SetContactListener(nullptr);
+    world_.SetTaskExecutor(nullptr);
+
+    for (auto body : bodies_)
+    {
+        body->world_ = nullptr;
+    }
 }
 
 RefPtr<Body> World::AddBody(b2BodyDef* def)
@@ -224,39 +453,166 @@ ContactList World::GetContactList()
     return ContactList(world_.GetContactList());
 }
 
+bool World::RayCast(const Point& begin, const Point& end, RayCastResult& result, const QueryFilter& filter) const
+{
+    result = RayCastResult();
+
+    b2RayCastInput input;
+    input.p1          = LocalToWorld(begin);
+    input.p2          = LocalToWorld(end);
+    input.maxFraction = 1.0f;
+    if (input.p1 == input.p2)
+        return false;
+
+    const b2BroadPhase&    broad_phase = world_.GetContactManager().m_broadPhase;
+    ClosestRayCastCallback callback(broad_phase, filter);
+    broad_phase.RayCast(&callback, input);
+
+    if (!callback.fixture)
+        return false;
+
+    FillRayCastResult(result, callback.fixture, input, callback.output);
+    return true;
+}
+
+size_t World::RayCastAll(const Point& begin, const Point& end, Vector<RayCastResult>& results,
+                         const QueryFilter& filter) const
+{
+    results.clear();
+
+    b2RayCastInput input;
+    input.p1          = LocalToWorld(begin);
+    input.p2          = LocalToWorld(end);
+    input.maxFraction = 1.0f;
+    if (input.p1 == input.p2)
+        return 0;
+
+    const b2BroadPhase& broad_phase = world_.GetContactManager().m_broadPhase;
+    AllRayCastCallback  callback(broad_phase, filter, results);
+    broad_phase.RayCast(&callback, input);
+
+    std::sort(results.begin(), results.end(),
+              [](const RayCastResult& lhs, const RayCastResult& rhs) { return lhs.fraction < rhs.fraction; });
+    return results.size();
+}
+
+void World::RayCastBatch(const Vector<Ray>& rays, Vector<RayCastResult>& results, const QueryFilter& filter) const
+{
+    results.resize(rays.size());
+
+    auto cast = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            RayCast(rays[i].begin, rays[i].end, results[i], filter);
+        }
+    };
+
+    // The broad phase is only read here, and a single ray is too cheap to be a job of its own
+    JobSystem&   job_system = JobSystem::GetInstance();
+    const size_t grain_size = std::max<size_t>(rays.size() / ((job_system.GetWorkerCount() + 1) * 4), 64);
+    job_system.ParallelFor(rays.size(), cast, grain_size);
+}
+
+size_t World::QueryAABB(const Rect& rect, Vector<b2Fixture*>& fixtures, const QueryFilter& filter) const
+{
+    fixtures.clear();
+
+    b2AABB aabb;
+    aabb.lowerBound = LocalToWorld(rect.left_top);
+    aabb.upperBound = LocalToWorld(rect.right_bottom);
+
+    const b2BroadPhase&  broad_phase = world_.GetContactManager().m_broadPhase;
+    OverlapQueryCallback callback(broad_phase, filter, aabb, fixtures);
+    broad_phase.Query(&callback, aabb);
+    return fixtures.size();
+}
+
+size_t World::OverlapShape(const b2Shape& shape, const Point& position, float rotation, Vector<b2Fixture*>& fixtures,
+                           const QueryFilter& filter) const
+{
+    fixtures.clear();
+
+    b2Transform xf(LocalToWorld(position), b2Rot(math::Degree2Radian(rotation)));
+
+    b2AABB aabb;
+    shape.ComputeAABB(&aabb, xf, 0);
+    for (int32 i = 1; i < shape.GetChildCount(); ++i)
+    {
+        b2AABB child;
+        shape.ComputeAABB(&child, xf, i);
+        aabb.Combine(child);
+    }
+
+    const b2BroadPhase&  broad_phase = world_.GetContactManager().m_broadPhase;
+    OverlapQueryCallback callback(broad_phase, filter, aabb, fixtures);
+    callback.SetShape(&shape, xf);
+    broad_phase.Query(&callback, aabb);
+    return fixtures.size();
+}
+
+size_t World::OverlapCircle(const Point& center, float radius, Vector<b2Fixture*>& fixtures,
+                            const QueryFilter& filter) const
+{
+    b2CircleShape circle;
+    circle.m_radius = LocalToWorld(radius);
+    return OverlapShape(circle, center, 0.0f, fixtures, filter);
+}
+
 void World::InitComponent(Actor* actor)
 {
     Component::InitComponent(actor);
 
+    // Bodies bound before the world was
+    RegisterBodies(actor);
+
     // Update body status
-    Actor* world_actor = GetBoundActor();
-    BeforeSimulation(world_actor, Matrix3x2(), 0.0f);
+    BeforeSimulation(true);
 }
 
 void World::OnUpdate(Duration dt)
 {
-    Actor* world_actor = GetBoundActor();
+    BeforeSimulation(false);
 
-    BeforeSimulation(world_actor, Matrix3x2(), 0.0f);
+    contact_events_.Clear();
 
     // Update physic world
     // The implementation referenced this article. https://www.unagames.com/blog/daniele/2010/06/fixed-time-step-implementation-box2d
-    const int MAX_STEPS = 5;
-
     fixed_acc_ += dt.GetSeconds();
-    const int steps = static_cast<int>(std::floor(fixed_acc_ / FIXED_TIMESTEP));
+    int steps = static_cast<int>(std::floor(fixed_acc_ / fixed_timestep_));
     if (steps > 0)
     {
-        fixed_acc_ -= steps * FIXED_TIMESTEP;
+        fixed_acc_ -= steps * fixed_timestep_;
     }
 
-    const int steps_clamped = std::min(steps, MAX_STEPS);
-    for (int i = 0; i < steps_clamped; ++i)
+    // Steps that cannot be caught up with are dropped, or every slow frame would make the next one slower
+    if (steps > max_steps_)
     {
-        world_.Step(FIXED_TIMESTEP, vel_iter_, pos_iter_);
+        stats_.dropped_steps += steps - max_steps_;
+        stats_.dropped_seconds += (steps - max_steps_) * fixed_timestep_;
+        steps = max_steps_;
+    }
+    stats_.steps = steps;
+
+    for (int i = 0; i < steps; ++i)
+    {
+        if (interpolation_ && i == steps - 1)
+        {
+            SavePreviousTransforms();
+        }
+        contact_events_.BeginStep();
+        world_.Step(fixed_timestep_, vel_iter_, pos_iter_);
     }
 
-    AfterSimulation(world_actor, Matrix3x2(), 0.0f);
+    // The leftover time blends the last two states, so actors move on frames without a step too
+    AfterSimulation(interpolation_ ? fixed_acc_ / fixed_timestep_ : 1.0f);
+
+    DispatchContactEvents();
+}
+
+void World::SetFixedTimestep(float timestep)
+{
+    KGE_ASSERT(timestep > 0.0f && "The fixed timestep must be positive");
+    fixed_timestep_ = timestep;
 }
 
 void World::OnRender(RenderContext& ctx)
@@ -280,37 +636,286 @@ void World::DispatchEvent(Event* evt)
     }
 }
 
-void World::BeforeSimulation(Actor* parent, const Matrix3x2& parent_to_world, float parent_rotation)
+void World::DispatchContactEvents()
+{
+    if (contact_events_.IsEmpty())
+        return;
+
+    auto evt = Application::GetInstance().CreateFrameEvent<ContactBatchEvent>(&contact_events_);
+    DispatchEvent(evt);
+}
+
+void World::BeforeSimulation(bool force)
 {
-    for (auto child : parent->GetAllChildren())
+    RegisterPendingBodies();
+
+    Actor*    last_parent = nullptr;
+    Matrix3x2 parent_to_world;
+    float     parent_rotation = 0.0f;
+    bool      parent_dirty    = false;
+    bool      in_world        = false;
+    uint32_t  depth           = 0;
+
+    Vector<Body*> detached;
+    for (auto body : bodies_)
     {
-        Matrix3x2 child_to_world = child->GetTransformMatrixToParent() * parent_to_world;
+        Actor* actor  = body->GetBoundActor();
+        Actor* parent = actor->GetParent();
 
-        auto body = dynamic_cast<Body*>(child->GetComponent(KGE_COMP_PHYSIC_BODY));
-        if (body)
+        // Siblings are adjacent after sorting and share the parent chain
+        if (parent != last_parent || !last_parent)
         {
-            body->BeforeSimulation(child.Get(), parent_to_world, child_to_world, parent_rotation);
+            in_world    = ComputeParentTransform(parent, parent_to_world, parent_rotation, parent_dirty, depth);
+            last_parent = parent;
         }
 
-        float rotation = parent_rotation + child->GetRotation();
-        BeforeSimulation(child.Get(), child_to_world, rotation);
+        if (body->parent_ != parent || body->depth_ != depth + 1)
+        {
+            body->parent_    = parent;
+            body->depth_     = depth + 1;
+            bodies_unsorted_ = true;
+        }
+
+        if (!in_world)
+        {
+            detached.push_back(body);
+            continue;
+        }
+
+        if (force)
+        {
+            body->synced_ = false;
+        }
+
+        // SetTransform resynchronizes every fixture in the broad-phase, so bodies
+        // are only pushed when their actor was moved outside the simulation
+        if (!body->synced_ || parent_dirty || actor->IsTransformSyncDirty())
+        {
+            Matrix3x2 actor_to_world = actor->GetTransformMatrixToParent() * parent_to_world;
+            body->BeforeSimulation(actor, parent_to_world, actor_to_world, parent_rotation);
+        }
+    }
+
+    // Ancestors may be shared by several bodies, so flags are cleared afterwards
+    Actor* world_actor = GetBoundActor();
+    for (auto body : bodies_)
+    {
+        for (Actor* ptr = body->GetBoundActor(); ptr && ptr != world_actor; ptr = ptr->GetParent())
+        {
+            ptr->MarkTransformSynced();
+        }
+    }
+
+    // Removed from the world actor, registered again once they are added back
+    for (auto body : detached)
+    {
+        RemoveFromRegistry(body);
+    }
+
+    if (bodies_unsorted_)
+    {
+        SortBodies();
     }
 }
 
-void World::AfterSimulation(Actor* parent, const Matrix3x2& parent_to_world, float parent_rotation)
+void World::AfterSimulation(float alpha)
 {
-    for (auto child : parent->GetAllChildren())
+    Actor*    last_parent = nullptr;
+    Matrix3x2 parent_to_world;
+    Matrix3x2 world_to_parent;
+    float     parent_rotation = 0.0f;
+    bool      parent_moved    = false;
+    bool      in_world        = false;
+    bool      inverted        = false;
+    uint32_t  depth           = 0;
+
+    // Parents come first, so they are already in place when their children are read.
+    // During this pass a dirty ancestor is one that was moved by the simulation
+    for (auto body : bodies_)
+    {
+        Actor* actor  = body->GetBoundActor();
+        Actor* parent = actor->GetParent();
+
+        if (parent != last_parent || !last_parent)
+        {
+            in_world    = ComputeParentTransform(parent, parent_to_world, parent_rotation, parent_moved, depth);
+            inverted    = false;
+            last_parent = parent;
+        }
+
+        if (!in_world)
+            continue;
+
+        // A body that has just fallen asleep is read once more to end its interpolation
+        const bool awake = body->GetB2Body()->IsAwake();
+
+        bool moved = false;
+        if (awake || body->interpolating_)
+        {
+            // Shared by all siblings, and only needed when one of them is awake
+            if (!inverted)
+            {
+                world_to_parent = parent_to_world.Invert();
+                inverted        = true;
+            }
+            moved = body->AfterSimulation(actor, world_to_parent, parent_rotation, awake ? alpha : 1.0f);
+
+            body->interpolating_ = awake && alpha < 1.0f;
+        }
+
+        if (!moved && parent_moved)
+        {
+            // Carried along by a parent that was moved by the simulation
+            Matrix3x2 actor_to_world = actor->GetTransformMatrixToParent() * parent_to_world;
+            body->ApplyActorChange(actor, actor_to_world, parent_rotation + actor->GetRotation());
+        }
+    }
+
+    // Changes made by the simulation must not be pushed back to the bodies
+    for (auto body : bodies_)
+    {
+        body->GetBoundActor()->MarkTransformSynced();
+    }
+}
+
+void World::SavePreviousTransforms()
+{
+    for (auto body : bodies_)
+    {
+        if (body->GetB2Body()->IsAwake())
+        {
+            body->SavePreviousTransform();
+        }
+    }
+}
+
+bool World::ComputeParentTransform(Actor* parent, Matrix3x2& parent_to_world, float& parent_rotation,
+                                   bool& parent_dirty, uint32_t& depth) const
+{
+    Actor* world_actor = GetBoundActor();
+
+    parent_to_world = Matrix3x2();
+    parent_rotation = 0.0f;
+    parent_dirty    = false;
+    depth           = 0;
+
+    for (Actor* ptr = parent; ptr != world_actor; ptr = ptr->GetParent())
+    {
+        if (!ptr)
+        {
+            // Not a descendant of the world actor
+            return false;
+        }
+
+        parent_to_world = parent_to_world * ptr->GetTransformMatrixToParent();
+        parent_rotation += ptr->GetRotation();
+        parent_dirty = parent_dirty || ptr->IsTransformSyncDirty();
+        ++depth;
+    }
+    return true;
+}
+
+void World::AddToRegistry(Body* body)
+{
+    if (body->world_ == this)
+        return;
+
+    KGE_ASSERT(!body->world_ && "The body has been registered by another world");
+
+    body->world_          = this;
+    body->registry_index_ = bodies_.size();
+    body->parent_         = nullptr;
+    body->synced_         = false;
+    bodies_.push_back(body);
+    bodies_unsorted_ = true;
+}
+
+void World::RemoveFromRegistry(Body* body)
+{
+    KGE_ASSERT(body->world_ == this);
+
+    // Swap with the last one, the order is restored before the next simulation
+    const size_t index = body->registry_index_;
+    if (index + 1 < bodies_.size())
+    {
+        bodies_[index]                  = bodies_.back();
+        bodies_[index]->registry_index_ = index;
+        bodies_unsorted_                = true;
+    }
+    bodies_.pop_back();
+
+    body->world_ = nullptr;
+}
+
+void World::RegisterBodies(Actor* parent)
+{
+    ActorList&                children = parent->GetAllChildren();
+    ActorList::TraversalGuard guard(children);
+
+    for (Actor* child = children.GetFirstPtr(); child; child = ActorList::GetNextPtr(child))
     {
         auto body = dynamic_cast<Body*>(child->GetComponent(KGE_COMP_PHYSIC_BODY));
-        if (body)
+        if (body && body->GetB2Body()->GetWorld() == &world_)
         {
-            body->AfterSimulation(child.Get(), parent_to_world, parent_rotation);
+            AddToRegistry(body);
         }
+        RegisterBodies(child);
+    }
+}
+
+void World::RegisterPendingBodies()
+{
+    Actor* world_actor = GetBoundActor();
 
-        Matrix3x2 child_to_world = child->GetTransformMatrixToParent() * parent_to_world;
-        float     rotation       = parent_rotation + child->GetRotation();
-        AfterSimulation(child.Get(), child_to_world, rotation);
+    // Only bodies that are bound but not registered walk up their parent chain
+    for (b2Body* b2body = world_.GetBodyList(); b2body; b2body = b2body->GetNext())
+    {
+        auto body = static_cast<Body*>(b2body->GetUserData());
+        if (!body || body->world_)
+            continue;
+
+        Actor* actor = body->GetBoundActor();
+        if (!actor)
+            continue;
+
+        for (Actor* ptr = actor->GetParent(); ptr; ptr = ptr->GetParent())
+        {
+            if (ptr == world_actor)
+            {
+                AddToRegistry(body);
+                break;
+            }
+        }
+    }
+}
+
+void World::SortBodies()
+{
+    std::sort(bodies_.begin(), bodies_.end(), [](const Body* lhs, const Body* rhs) {
+        if (lhs->depth_ != rhs->depth_)
+            return lhs->depth_ < rhs->depth_;
+        return lhs->parent_ < rhs->parent_;
+    });
+
+    for (size_t i = 0; i < bodies_.size(); ++i)
+    {
+        bodies_[i]->registry_index_ = i;
+    }
+    bodies_unsorted_ = false;
+}
+
+void World::SetWorkerCount(int count)
+{
+    worker_count_ = std::max(count, 1);
+    if (worker_count_ > 1)
+    {
+        task_executor_ = std::make_unique<JobSystemExecutor>(worker_count_);
+    }
+    else
+    {
+        task_executor_.reset();
     }
+    world_.SetTaskExecutor(task_executor_.get());
 }
 
 void World::ShowDebugInfo(bool show)
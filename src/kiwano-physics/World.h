@@ -21,6 +21,7 @@
 #pragma once
 #include <kiwano-physics/Body.h>
 #include <kiwano-physics/Contact.h>
+#include <kiwano-physics/ContactEvents.h>
 
 #define KGE_COMP_PHYSIC_WORLD "__KGE_PHYSIC_WORLD__"
 
@@ -39,6 +40,66 @@ namespace physics
  * @{
  */
 
+/**
+ * \~chinese
+ * @brief ģͳϢ
+ */
+struct SimulationStats
+{
+    int   steps;            ///< һθִеģⲽ
+    int   dropped_steps;    ///< ۼƲ
+    float dropped_seconds;  ///< ۼģʱ䣨룩
+
+    SimulationStats();
+};
+
+/**
+ * \~chinese
+ * @brief ռѯ
+ */
+struct QueryFilter
+{
+    uint16_t mask_bits;        ///< ֻѯнļоߣĬϲѯ
+    bool     include_sensors;  ///< ǷѯĬϲѯ
+
+    QueryFilter();
+
+    QueryFilter(uint16_t mask_bits, bool include_sensors = false);
+
+    /// \~chinese
+    /// @brief оǷ
+    bool Accept(const b2Fixture* fixture) const;
+};
+
+/**
+ * \~chinese
+ * @brief 
+ */
+struct Ray
+{
+    Point begin;  ///< 
+    Point end;    ///< յ
+
+    Ray();
+
+    Ray(const Point& begin, const Point& end);
+};
+
+/**
+ * \~chinese
+ * @brief ߼
+ */
+struct RayCastResult
+{
+    b2Fixture* fixture;   ///< еļоߣδʱΪ
+    Body*      body;      ///< е壬ûа Body ʱΪ
+    Point      point;     ///< е
+    Vec2       normal;    ///< еı淨
+    float      fraction;  ///< еϵλñȡֵΧ [0, 1]
+
+    RayCastResult();
+};
+
 /**
  * \~chinese
  * @brief 
@@ -68,6 +129,72 @@ public:
     /// @brief ȡӴб
     ContactList GetContactList();
 
+    /// \~chinese
+    /// @brief ȡһθ²ĽӴ¼
+    ContactEventStream& GetContactEvents();
+
+    /// \~chinese
+    /// @brief ȡһθ²ĽӴ¼
+    const ContactEventStream& GetContactEvents() const;
+
+    /// \~chinese
+    /// @brief ߼⣬Ҿе
+    /// @param begin 
+    /// @param end յ
+    /// @param result н
+    /// @param filter 
+    /// @return Ƿ
+    bool RayCast(const Point& begin, const Point& end, RayCastResult& result,
+                 const QueryFilter& filter = QueryFilter()) const;
+
+    /// \~chinese
+    /// @brief ߼⣬е
+    /// @param begin 
+    /// @param end յ
+    /// @param results нɽԶԭݻᱻ
+    /// @param filter 
+    /// @return е
+    size_t RayCastAll(const Point& begin, const Point& end, Vector<RayCastResult>& results,
+                      const QueryFilter& filter = QueryFilter()) const;
+
+    /// \~chinese
+    /// @brief ߼⣬ÿ߲Ҿе
+    /// @details ߽϶ʱ JobSystem вм⣬ڼ
+    /// @param rays 
+    /// @param results һһӦнԭݻᱻ
+    /// @param filter 
+    void RayCastBatch(const Vector<Ray>& rays, Vector<RayCastResult>& results,
+                      const QueryFilter& filter = QueryFilter()) const;
+
+    /// \~chinese
+    /// @brief ѯΧཻļо
+    /// @param rect 
+    /// @param fixtures ѯԭݻᱻ
+    /// @param filter 
+    /// @return о
+    size_t QueryAABB(const Rect& rect, Vector<b2Fixture*>& fixtures, const QueryFilter& filter = QueryFilter()) const;
+
+    /// \~chinese
+    /// @brief ѯ״صļо
+    /// @param shape ״ʹ絥λ
+    /// @param position ״λ
+    /// @param rotation ״תǶ
+    /// @param fixtures ѯԭݻᱻ
+    /// @param filter 
+    /// @return о
+    size_t OverlapShape(const b2Shape& shape, const Point& position, float rotation, Vector<b2Fixture*>& fixtures,
+                        const QueryFilter& filter = QueryFilter()) const;
+
+    /// \~chinese
+    /// @brief ѯԲصļо
+    /// @param center Բ
+    /// @param radius 뾶
+    /// @param fixtures ѯԭݻᱻ
+    /// @param filter 
+    /// @return о
+    size_t OverlapCircle(const Point& center, float radius, Vector<b2Fixture*>& fixtures,
+                         const QueryFilter& filter = QueryFilter()) const;
+
     /// \~chinese
     /// @brief ٶȵ, ĬΪ 6
     void SetVelocityIterations(int vel_iter);
@@ -76,6 +203,47 @@ public:
     /// @brief λõ, ĬΪ 2
     void SetPositionIterations(int pos_iter);
 
+    /// \~chinese
+    /// @brief ù̶ʱ䲽룩, ĬΪ 1/60
+    void SetFixedTimestep(float timestep);
+
+    /// \~chinese
+    /// @brief ȡ̶ʱ䲽룩
+    float GetFixedTimestep() const;
+
+    /// \~chinese
+    /// @brief ÿθµģⲽ, ĬΪ 5
+    /// @details ģʱᱻ¼ͳϢУģʱԽԽ
+    void SetMaxSteps(int max_steps);
+
+    /// \~chinese
+    /// @brief ȡÿθµģⲽ
+    int GetMaxSteps() const;
+
+    /// \~chinese
+    /// @brief Ƿòֵ
+    /// @details úɫλһ뵱ǰ״ֵ̬֮
+    /// ֡ʸģƵʱɫҲƽƶʾ״̬ͺһʱ䲽
+    void SetInterpolationEnabled(bool enabled);
+
+    /// \~chinese
+    /// @brief Ƿòֵ
+    bool IsInterpolationEnabled() const;
+
+    /// \~chinese
+    /// @brief ȡģͳϢ
+    const SimulationStats& GetSimulationStats() const;
+
+    /// \~chinese
+    /// @brief ߳, ĬΪ 1
+    /// @details  1 ʱӴ飨 JobSystem в⣬뵥߳ͬ
+    /// Ӵص߳аԭ˳򴥷ʵʲж JobSystem ߳
+    void SetWorkerCount(int count);
+
+    /// \~chinese
+    /// @brief ȡ߳
+    int GetWorkerCount() const;
+
     /// \~chinese
     /// @brief ǷƵϢ
     void ShowDebugInfo(bool show);
@@ -105,24 +273,74 @@ protected:
     /// @brief ַ¼
     void DispatchEvent(Event* evt);
 
+    /// \~chinese
+    /// @brief ַθ²ĽӴ¼
+    void DispatchContactEvents();
+
     /// \~chinese
     /// @brief ǰ
-    void BeforeSimulation(Actor* parent, const Matrix3x2& parent_to_world, float parent_rotation);
+    /// @details ֻͬά任ϴͬ޸ĵĽɫ
+    /// @param force Ƿͬ
+    void BeforeSimulation(bool force);
 
     /// \~chinese
     /// @brief 
-    void AfterSimulation(Actor* parent, const Matrix3x2& parent_to_world, float parent_rotation);
+    /// @details ֻȡδߵ
+    /// @param alpha ֵϵΪ 1 ʱʹĵǰ״̬
+    void AfterSimulation(float alpha);
+
+    /// \~chinese
+    /// @brief һʱ䲽֮ǰ״̬ڲֵ
+    void SavePreviousTransforms();
+
+    /// \~chinese
+    /// @brief 㸸ɫı任
+    /// @return ɫǷ
+    bool ComputeParentTransform(Actor* parent, Matrix3x2& parent_to_world, float& parent_rotation, bool& parent_dirty,
+                                uint32_t& depth) const;
+
+    /// \~chinese
+    /// @brief Ǽ
+    void AddToRegistry(Body* body);
+
+    /// \~chinese
+    /// @brief ƳǼ
+    void RemoveFromRegistry(Body* body);
+
+    /// \~chinese
+    /// @brief Ǽǽɫڸ
+    void RegisterBodies(Actor* parent);
+
+    /// \~chinese
+    /// @brief Ǽǰ󶨺ű
+    void RegisterPendingBodies();
+
+    /// \~chinese
+    /// @brief 㼶˳壬ɫǰ
+    void SortBodies();
 
 private:
-    int     vel_iter_;
-    int     pos_iter_;
-    float   fixed_acc_;
-    b2World world_;
+    int             vel_iter_;
+    int             pos_iter_;
+    int             max_steps_;
+    bool            interpolation_;
+    float           fixed_timestep_;
+    float           fixed_acc_;
+    SimulationStats stats_;
+    b2World         world_;
+
+    // Bodies bound to actors, sorted by depth so parents are synchronized first
+    Vector<Body*> bodies_;
+    bool          bodies_unsorted_;
 
     class DebugDrawer;
     std::unique_ptr<DebugDrawer> drawer_;
 
+    ContactEventStream                 contact_events_;
     std::unique_ptr<b2ContactListener> contact_listener_;
+
+    int                             worker_count_;
+    std::unique_ptr<b2TaskExecutor> task_executor_;
 };
 
 /** @} */
@@ -137,5 +355,50 @@ inline void World::SetPositionIterations(int pos_iter)
     pos_iter_ = pos_iter;
 }
 
+inline float World::GetFixedTimestep() const
+{
+    return fixed_timestep_;
+}
+
+inline void World::SetMaxSteps(int max_steps)
+{
+    max_steps_ = max_steps;
+}
+
+inline int World::GetMaxSteps() const
+{
+    return max_steps_;
+}
+
+inline void World::SetInterpolationEnabled(bool enabled)
+{
+    interpolation_ = enabled;
+}
+
+inline bool World::IsInterpolationEnabled() const
+{
+    return interpolation_;
+}
+
+inline ContactEventStream& World::GetContactEvents()
+{
+    return contact_events_;
+}
+
+inline const ContactEventStream& World::GetContactEvents() const
+{
+    return contact_events_;
+}
+
+inline int World::GetWorkerCount() const
+{
+    return worker_count_;
+}
+
+inline const SimulationStats& World::GetSimulationStats() const
+{
+    return stats_;
+}
+
 }  // namespace physics
 }  // namespace kiwano
@@ -22,4 +22,5 @@
 
 #include <kiwano-physics/Body.h>
 #include <kiwano-physics/Contact.h>
+#include <kiwano-physics/ContactEvents.h>
 #include <kiwano-physics/World.h>
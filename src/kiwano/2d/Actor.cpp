@@ -55,6 +55,8 @@ Actor::Actor()
     , opacity_(1.f)
     , displayed_opacity_(1.f)
     , anchor_(default_anchor_x, default_anchor_y)
+    , transform_store_(nullptr)
+    , transform_index_(0)
 {
 }
 
@@ -72,15 +74,17 @@ void Actor::Update(Duration dt)
         return;
     }
 
+    ActorList::TraversalGuard guard(children_);
+
     // update children those are less than 0 in Z-Order
-    RefPtr<Actor> child = children_.GetFirst();
+    Actor* child = children_.GetFirstPtr();
     while (child)
     {
         if (child->GetZOrder() >= 0)
             break;
 
         child->Update(dt);
-        child = child->GetNext();
+        child = ActorList::GetNextPtr(child);
     }
 
     UpdateSelf(dt);
@@ -88,7 +92,7 @@ void Actor::Update(Duration dt)
     while (child)
     {
         child->Update(dt);
-        child = child->GetNext();
+        child = ActorList::GetNextPtr(child);
     }
 }
 
@@ -117,6 +121,12 @@ void Actor::Render(RenderContext& ctx)
     if (!visible_)
         return;
 
+    if (stage_ && stage_->IsCullingActive() && !stage_->IsSubtreeInView(this))
+    {
+        // Nothing in this subtree intersects the viewport
+        return;
+    }
+
     UpdateTransform();
     UpdateOpacity();
 
@@ -131,15 +141,17 @@ void Actor::Render(RenderContext& ctx)
     }
     else
     {
+        ActorList::TraversalGuard guard(children_);
+
         // render children those are less than 0 in Z-Order
-        RefPtr<Actor> child = children_.GetFirst();
+        Actor* child = children_.GetFirstPtr();
         while (child)
         {
             if (child->GetZOrder() >= 0)
                 break;
 
             child->Render(ctx);
-            child = child->GetNext();
+            child = ActorList::GetNextPtr(child);
         }
 
         if (CheckVisibility(ctx))
@@ -152,14 +164,14 @@ void Actor::Render(RenderContext& ctx)
         while (child)
         {
             child->Render(ctx);
-            child = child->GetNext();
+            child = ActorList::GetNextPtr(child);
         }
     }
 }
 
 void Actor::PrepareToRender(RenderContext& ctx)
 {
-    ctx.SetTransform(transform_matrix_);
+    ctx.SetTransform(GetCachedTransformMatrix());
     ctx.SetBrushOpacity(GetDisplayedOpacity());
 }
 
@@ -172,7 +184,7 @@ void Actor::RenderBorder(RenderContext& ctx)
     {
         Rect bounds = GetBounds();
 
-        ctx.SetTransform(transform_matrix_);
+        ctx.SetTransform(GetCachedTransformMatrix());
 
         ctx.SetCurrentBrush(GetStage()->GetBorderFillBrush());
         ctx.FillRectangle(bounds);
@@ -181,7 +193,9 @@ void Actor::RenderBorder(RenderContext& ctx)
         ctx.DrawRectangle(bounds);
     }
 
-    for (auto& child : children_)
+    ActorList::TraversalGuard guard(children_);
+
+    for (Actor* child = children_.GetFirstPtr(); child; child = ActorList::GetNextPtr(child))
     {
         child->RenderBorder(ctx);
     }
@@ -189,6 +203,12 @@ void Actor::RenderBorder(RenderContext& ctx)
 
 bool Actor::CheckVisibility(RenderContext& ctx) const
 {
+    if (stage_ && stage_->IsCullingActive())
+    {
+        // Already resolved by the stage with a single spatial query
+        return !size_.IsOrigin() && stage_->IsInView(this);
+    }
+
     if (dirty_flag_.Has(DirtyFlag::DirtyVisibility))
     {
         dirty_flag_.Unset(DirtyFlag::DirtyVisibility);
@@ -199,7 +219,7 @@ bool Actor::CheckVisibility(RenderContext& ctx) const
         }
         else
         {
-            visible_in_rt_ = ctx.CheckVisibility(GetBounds(), transform_matrix_ /* GetTransformMatrix() */);
+            visible_in_rt_ = ctx.CheckVisibility(GetBounds(), GetCachedTransformMatrix() /* GetTransformMatrix() */);
         }
     }
     return visible_in_rt_;
@@ -228,7 +248,7 @@ void Actor::DoDeserialize(Deserializer* deserializer)
 const Matrix3x2& Actor::GetTransformMatrix() const
 {
     UpdateTransformUpwards();
-    return transform_matrix_;
+    return GetCachedTransformMatrix();
 }
 
 const Matrix3x2& Actor::GetTransformInverseMatrix() const
@@ -237,7 +257,7 @@ const Matrix3x2& Actor::GetTransformInverseMatrix() const
     if (dirty_flag_.Has(DirtyFlag::DirtyTransformInverse))
     {
         dirty_flag_.Unset(DirtyFlag::DirtyTransformInverse);
-        transform_matrix_inverse_ = transform_matrix_.Invert();
+        transform_matrix_inverse_ = GetCachedTransformMatrix().Invert();
     }
     return transform_matrix_inverse_;
 }
@@ -245,30 +265,46 @@ const Matrix3x2& Actor::GetTransformInverseMatrix() const
 const Matrix3x2& Actor::GetTransformMatrixToParent() const
 {
     UpdateTransformUpwards();
+    if (transform_store_)
+        return transform_store_->GetLocalMatrix(transform_index_);
     return transform_matrix_to_parent_;
 }
 
-void Actor::UpdateTransform() const
+Matrix3x2 Actor::ComputeTransformMatrixToParent() const
 {
-    if (!dirty_flag_.Has(DirtyFlag::DirtyTransform))
-        return;
-
-    dirty_flag_.Unset(DirtyFlag::DirtyTransform);
-    dirty_flag_.Set(DirtyFlag::DirtyTransformInverse);
-    dirty_flag_.Set(DirtyFlag::DirtyVisibility);
-
+    Matrix3x2 matrix;
     if (transform_.IsFast())
     {
-        transform_matrix_to_parent_ = Matrix3x2::Translation(transform_.position);
+        matrix = Matrix3x2::Translation(transform_.position);
     }
     else
     {
         // matrix multiplication is optimized by expression template
-        transform_matrix_to_parent_ = transform_.ToMatrix();
+        matrix = transform_.ToMatrix();
     }
 
     Point anchor_offset(-size_.x * anchor_.x, -size_.y * anchor_.y);
-    transform_matrix_to_parent_.Translate(anchor_offset);
+    matrix.Translate(anchor_offset);
+    return matrix;
+}
+
+void Actor::UpdateTransform() const
+{
+    if (transform_store_)
+    {
+        // World matrices of the whole stage are updated in one pass
+        transform_store_->Update();
+        return;
+    }
+
+    if (!dirty_flag_.Has(DirtyFlag::DirtyTransform))
+        return;
+
+    dirty_flag_.Unset(DirtyFlag::DirtyTransform);
+    dirty_flag_.Set(DirtyFlag::DirtyTransformInverse);
+    dirty_flag_.Set(DirtyFlag::DirtyVisibility);
+
+    transform_matrix_to_parent_ = ComputeTransformMatrixToParent();
 
     transform_matrix_ = transform_matrix_to_parent_;
     if (parent_)
@@ -277,12 +313,18 @@ void Actor::UpdateTransform() const
     }
 
     // update children's transform
-    for (const auto& child : children_)
+    for (Actor* child = children_.GetFirstPtr(); child; child = ActorList::GetNextPtr(child))
         child->dirty_flag_.Set(DirtyFlag::DirtyTransform);
 }
 
 void Actor::UpdateTransformUpwards() const
 {
+    if (transform_store_)
+    {
+        transform_store_->Update();
+        return;
+    }
+
     if (parent_)
     {
         parent_->UpdateTransformUpwards();
@@ -312,7 +354,7 @@ void Actor::UpdateOpacity()
         displayed_opacity_ = opacity_;
     }
 
-    for (const auto& child : children_)
+    for (Actor* child = children_.GetFirstPtr(); child; child = ActorList::GetNextPtr(child))
         child->dirty_flag_.Set(DirtyFlag::DirtyOpacity);
 }
 
@@ -321,6 +363,8 @@ void Actor::SetStage(Stage* stage)
     if (stage_ != stage)
     {
         stage_ = stage;
+        AttachTransformStore(stage ? stage->GetTransformStore() : nullptr);
+
         for (auto& child : children_)
         {
             child->SetStage(stage);
@@ -328,8 +372,47 @@ void Actor::SetStage(Stage* stage)
     }
 }
 
+void Actor::SetTransformStore(TransformStore* store)
+{
+    AttachTransformStore(store);
+
+    for (Actor* child = children_.GetFirstPtr(); child; child = ActorList::GetNextPtr(child))
+    {
+        child->SetTransformStore(store);
+    }
+}
+
+void Actor::AttachTransformStore(TransformStore* store)
+{
+    if (transform_store_ == store)
+        return;
+
+    if (transform_store_)
+        transform_store_->SetStructureDirty();
+
+    transform_store_ = store;
+
+    if (transform_store_)
+        transform_store_->SetStructureDirty();
+
+    // Matrices cached by the actor are not maintained while a store is attached
+    dirty_flag_.Set(DirtyFlag::DirtyTransform);
+}
+
+void Actor::MarkTransformDirty()
+{
+    dirty_flag_.Set(DirtyFlag::DirtyTransform);
+    dirty_flag_.Set(DirtyFlag::DirtyTransformSync);
+
+    if (transform_store_)
+        transform_store_->SetDirty(transform_index_);
+}
+
 void Actor::Reorder()
 {
+    if (stage_)
+        stage_->SetRenderOrderDirty();
+
     if (parent_)
     {
         RefPtr<Actor> me = this;
@@ -393,7 +476,7 @@ void Actor::SetAnchor(const Vec2& anchor)
         return;
 
     anchor_ = anchor;
-    dirty_flag_.Set(DirtyFlag::DirtyTransform);
+    MarkTransformDirty();
 }
 
 void Actor::SetSize(const Size& size)
@@ -402,13 +485,13 @@ void Actor::SetSize(const Size& size)
         return;
 
     size_ = size;
-    dirty_flag_.Set(DirtyFlag::DirtyTransform);
+    MarkTransformDirty();
 }
 
 void Actor::SetTransform(const Transform& transform)
 {
     transform_ = transform;
-    dirty_flag_.Set(DirtyFlag::DirtyTransform);
+    MarkTransformDirty();
 }
 
 void Actor::SetVisible(bool val)
@@ -428,7 +511,7 @@ void Actor::SetPosition(const Point& pos)
         return;
 
     transform_.position = pos;
-    dirty_flag_.Set(DirtyFlag::DirtyTransform);
+    MarkTransformDirty();
 }
 
 void Actor::SetScale(const Vec2& scale)
@@ -437,7 +520,7 @@ void Actor::SetScale(const Vec2& scale)
         return;
 
     transform_.scale = scale;
-    dirty_flag_.Set(DirtyFlag::DirtyTransform);
+    MarkTransformDirty();
 }
 
 void Actor::SetSkew(const Vec2& skew)
@@ -446,7 +529,7 @@ void Actor::SetSkew(const Vec2& skew)
         return;
 
     transform_.skew = skew;
-    dirty_flag_.Set(DirtyFlag::DirtyTransform);
+    MarkTransformDirty();
 }
 
 void Actor::SetRotation(float angle)
@@ -455,7 +538,7 @@ void Actor::SetRotation(float angle)
         return;
 
     transform_.rotation = angle;
-    dirty_flag_.Set(DirtyFlag::DirtyTransform);
+    MarkTransformDirty();
 }
 
 void Actor::AddChild(RefPtr<Actor> child)
@@ -482,6 +565,7 @@ void Actor::AddChild(RefPtr<Actor> child)
         child->SetStage(this->stage_);
 
         child->dirty_flag_.Set(DirtyFlag::DirtyTransform);
+        child->dirty_flag_.Set(DirtyFlag::DirtyTransformSync);
         child->dirty_flag_.Set(DirtyFlag::DirtyOpacity);
         child->Reorder();
     }
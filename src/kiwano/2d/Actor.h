@@ -26,6 +26,7 @@
 #include <kiwano/event/EventDispatcher.h>
 #include <kiwano/utils/TaskScheduler.h>
 #include <kiwano/2d/animation/Animator.h>
+#include <kiwano/2d/TransformStore.h>
 
 namespace kiwano
 {
@@ -63,6 +64,8 @@ class KGE_API Actor
 {
     friend class Director;
     friend class Transition;
+    friend class Stage;
+    friend class TransformStore;
     friend IntrusiveList<RefPtr<Actor>>;
 
 public:
@@ -222,6 +225,15 @@ public:
     /// @brief ȡ任ɫĶά任
     const Matrix3x2& GetTransformMatrixToParent() const;
 
+    /// \~chinese
+    /// @brief ά任Ƿϴͬ޸
+    /// @details Ҫɫͬλõϵͳʹãɫı仯ӽɫ
+    bool IsTransformSyncDirty() const;
+
+    /// \~chinese
+    /// @brief Ƕά任ͬ
+    void MarkTransformSynced();
+
     /// \~chinese
     /// @brief ýɫǷɼ
     void SetVisible(bool val);
@@ -458,17 +470,36 @@ protected:
     /// @brief ýڵ̨
     void SetStage(Stage* stage);
 
+    /// \~chinese
+    /// @brief ԼӽɫʹõĶά任洢
+    void SetTransformStore(TransformStore* store);
+
+    /// \~chinese
+    /// @brief ȡѻĶά任󣬲ǷҪ
+    /// @details  UpdateTransform ֮ʹãȾ
+    const Matrix3x2& GetCachedTransformMatrix() const;
+
+    /// \~chinese
+    /// @brief 任ɫĶά任
+    Matrix3x2 ComputeTransformMatrixToParent() const;
+
     enum DirtyFlag : uint8_t
     {
         Clean                 = 0,
         DirtyTransform        = 1,
         DirtyTransformInverse = 1 << 1,
         DirtyOpacity          = 1 << 2,
-        DirtyVisibility       = 1 << 3
+        DirtyVisibility       = 1 << 3,
+        DirtyTransformSync    = 1 << 4
     };
 
     Flag<uint8_t>& GetDirtyFlag() const;
 
+private:
+    void AttachTransformStore(TransformStore* store);
+
+    void MarkTransformDirty();
+
 private:
     bool         visible_;
     bool         update_pausing_;
@@ -490,6 +521,9 @@ private:
     UpdateCallback cb_update_;
     Transform      transform_;
 
+    TransformStore* transform_store_;
+    uint32_t        transform_index_;
+
     mutable Matrix3x2 transform_matrix_;
     mutable Matrix3x2 transform_matrix_inverse_;
     mutable Matrix3x2 transform_matrix_to_parent_;
@@ -512,6 +546,23 @@ inline Flag<uint8_t>& Actor::GetDirtyFlag() const
     return dirty_flag_;
 }
 
+inline const Matrix3x2& Actor::GetCachedTransformMatrix() const
+{
+    if (transform_store_)
+        return transform_store_->GetWorldMatrix(transform_index_);
+    return transform_matrix_;
+}
+
+inline bool Actor::IsTransformSyncDirty() const
+{
+    return dirty_flag_.Has(DirtyFlag::DirtyTransformSync);
+}
+
+inline void Actor::MarkTransformSynced()
+{
+    dirty_flag_.Unset(DirtyFlag::DirtyTransformSync);
+}
+
 inline bool Actor::IsVisible() const
 {
     return visible_;
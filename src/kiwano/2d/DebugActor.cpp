@@ -108,6 +108,8 @@ void DebugActor::OnUpdate(Duration dt)
 
     ss << "Primitives / sec: " << std::fixed << status.primitives * frame_buffer_.Size() << std::endl;
 
+    ss << "Sprite batches: " << status.batches << " (" << status.batched_sprites << " sprites)" << std::endl;
+
     ss << "Memory: ";
     {
         PROCESS_MEMORY_COUNTERS_EX pmc;
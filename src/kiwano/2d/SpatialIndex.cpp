@@ -0,0 +1,270 @@
+// Copyright (c) 2016-2019 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <kiwano/2d/SpatialIndex.h>
+
+namespace kiwano
+{
+
+namespace
+{
+
+// Objects covering more cells than this are kept in a separate list and tested on every query
+const float max_cells_per_proxy = 64.f;
+
+// Keeps cell coordinates far away from the limits of int32_t
+const float max_cell_coord = 1e8f;
+
+}  // namespace
+
+SpatialIndex::SpatialIndex(float cell_size)
+    : cell_size_(cell_size)
+    , query_mark_(0)
+{
+    KGE_ASSERT(cell_size > 0.f);
+}
+
+void SpatialIndex::SetCellSize(float cell_size)
+{
+    KGE_ASSERT(cell_size > 0.f);
+
+    if (cell_size_ == cell_size)
+        return;
+
+    // Unlinking resets the state, so relink everything with the new cell size in a second pass
+    Vector<uint32_t> linked;
+    for (uint32_t id = 0; id < uint32_t(proxies_.size()); ++id)
+    {
+        if (proxies_[id].state != ProxyState::None)
+        {
+            Unlink(id);
+            linked.push_back(id);
+        }
+    }
+
+    cell_size_ = cell_size;
+    cells_.clear();
+
+    for (uint32_t id : linked)
+    {
+        Link(id);
+    }
+}
+
+void SpatialIndex::Update(uint32_t id, const Rect& bounds)
+{
+    if (id >= proxies_.size())
+    {
+        proxies_.resize(id + 1, Proxy{ Rect{}, CellRange{}, ProxyState::None, 0, 0 });
+    }
+
+    Proxy& proxy = proxies_[id];
+    if (proxy.state == ProxyState::Grid)
+    {
+        CellRange range;
+        if (ComputeCellRange(bounds, range) && range == proxy.cells)
+        {
+            // Still covers the same cells, nothing to relink
+            proxy.bounds = bounds;
+            return;
+        }
+    }
+
+    if (proxy.state != ProxyState::None)
+        Unlink(id);
+
+    proxy.bounds = bounds;
+    Link(id);
+}
+
+void SpatialIndex::Remove(uint32_t id)
+{
+    if (Contains(id))
+        Unlink(id);
+}
+
+void SpatialIndex::Clear()
+{
+    proxies_.clear();
+    large_.clear();
+
+    // Keep the buckets, most cells are reused when the index is filled again
+    for (auto& pair : cells_)
+        pair.second.clear();
+}
+
+void SpatialIndex::Query(const Point& point, Vector<uint32_t>& output) const
+{
+    CellRange range;
+    if (ComputeCellRange(Rect{ point, point }, range))
+    {
+        // Each object is linked to a cell at most once, so no duplicates can occur here
+        auto iter = cells_.find(MakeCellKey(range.min_x, range.min_y));
+        if (iter != cells_.end())
+        {
+            for (uint32_t id : iter->second)
+            {
+                if (proxies_[id].bounds.ContainsPoint(point))
+                    output.push_back(id);
+            }
+        }
+    }
+
+    for (uint32_t id : large_)
+    {
+        if (proxies_[id].bounds.ContainsPoint(point))
+            output.push_back(id);
+    }
+}
+
+void SpatialIndex::Query(const Rect& rect, Vector<uint32_t>& output) const
+{
+    CellRange range;
+    if (!ComputeCellRange(rect, range)
+        || float(range.max_x - range.min_x + 1) * float(range.max_y - range.min_y + 1) > float(proxies_.size()))
+    {
+        // Visiting the cells would cost more than testing every object
+        for (uint32_t id = 0; id < uint32_t(proxies_.size()); ++id)
+        {
+            const Proxy& proxy = proxies_[id];
+            if (proxy.state == ProxyState::Grid && proxy.bounds.Intersects(rect))
+                output.push_back(id);
+        }
+    }
+    else
+    {
+        if (++query_mark_ == 0)
+        {
+            for (auto& proxy : proxies_)
+                proxy.query_mark = 0;
+            query_mark_ = 1;
+        }
+
+        for (int32_t y = range.min_y; y <= range.max_y; ++y)
+        {
+            for (int32_t x = range.min_x; x <= range.max_x; ++x)
+            {
+                auto iter = cells_.find(MakeCellKey(x, y));
+                if (iter == cells_.end())
+                    continue;
+
+                for (uint32_t id : iter->second)
+                {
+                    const Proxy& proxy = proxies_[id];
+                    if (proxy.query_mark != query_mark_)
+                    {
+                        proxy.query_mark = query_mark_;
+                        if (proxy.bounds.Intersects(rect))
+                            output.push_back(id);
+                    }
+                }
+            }
+        }
+    }
+
+    for (uint32_t id : large_)
+    {
+        if (proxies_[id].bounds.Intersects(rect))
+            output.push_back(id);
+    }
+}
+
+bool SpatialIndex::ComputeCellRange(const Rect& bounds, CellRange& range) const
+{
+    const float min_x = std::floor(bounds.GetLeft() / cell_size_);
+    const float min_y = std::floor(bounds.GetTop() / cell_size_);
+    const float max_x = std::floor(bounds.GetRight() / cell_size_);
+    const float max_y = std::floor(bounds.GetBottom() / cell_size_);
+
+    if (!(min_x >= -max_cell_coord && min_y >= -max_cell_coord && max_x <= max_cell_coord && max_y <= max_cell_coord))
+        return false;
+
+    range.min_x = int32_t(min_x);
+    range.min_y = int32_t(min_y);
+    range.max_x = std::max(int32_t(max_x), range.min_x);
+    range.max_y = std::max(int32_t(max_y), range.min_y);
+    return true;
+}
+
+void SpatialIndex::Link(uint32_t id)
+{
+    Proxy& proxy = proxies_[id];
+
+    CellRange range;
+    if (ComputeCellRange(proxy.bounds, range)
+        && float(range.max_x - range.min_x + 1) * float(range.max_y - range.min_y + 1) <= max_cells_per_proxy)
+    {
+        proxy.state = ProxyState::Grid;
+        proxy.cells = range;
+
+        for (int32_t y = range.min_y; y <= range.max_y; ++y)
+        {
+            for (int32_t x = range.min_x; x <= range.max_x; ++x)
+            {
+                cells_[MakeCellKey(x, y)].push_back(id);
+            }
+        }
+    }
+    else
+    {
+        proxy.state       = ProxyState::Large;
+        proxy.large_index = uint32_t(large_.size());
+        large_.push_back(id);
+    }
+}
+
+void SpatialIndex::Unlink(uint32_t id)
+{
+    Proxy& proxy = proxies_[id];
+
+    if (proxy.state == ProxyState::Grid)
+    {
+        const CellRange& range = proxy.cells;
+        for (int32_t y = range.min_y; y <= range.max_y; ++y)
+        {
+            for (int32_t x = range.min_x; x <= range.max_x; ++x)
+            {
+                auto& cell = cells_[MakeCellKey(x, y)];
+                auto  iter = std::find(cell.begin(), cell.end(), id);
+                if (iter != cell.end())
+                {
+                    *iter = cell.back();
+                    cell.pop_back();
+                }
+            }
+        }
+    }
+    else if (proxy.state == ProxyState::Large)
+    {
+        const uint32_t last = large_.back();
+
+        large_[proxy.large_index]  = last;
+        proxies_[last].large_index = proxy.large_index;
+        large_.pop_back();
+    }
+    proxy.state = ProxyState::None;
+}
+
+uint64_t SpatialIndex::MakeCellKey(int32_t x, int32_t y)
+{
+    return (uint64_t(uint32_t(x)) << 32) | uint64_t(uint32_t(y));
+}
+
+}  // namespace kiwano
@@ -0,0 +1,144 @@
+// Copyright (c) 2016-2019 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <kiwano/math/Math.h>
+#include <kiwano/core/Common.h>
+
+namespace kiwano
+{
+
+/**
+ * \addtogroup Actors
+ * @{
+ */
+
+/**
+ * \~chinese
+ * @brief ռ
+ * @details ʹþ񱣴һΰΧУڿٲѯĳĳཻĶ
+ * ɵ÷ṩűʶԽĶ޴İΧУ棬ÿβѯ᷵
+ * @note ѯǰΧཻĺѡ󣬵÷Ҫȷ
+ */
+class KGE_API SpatialIndex : Noncopyable
+{
+public:
+    /// \~chinese
+    /// @brief ռ
+    /// @param cell_size ߳
+    SpatialIndex(float cell_size = 128.f);
+
+    /// \~chinese
+    /// @brief ȡ߳
+    float GetCellSize() const;
+
+    /// \~chinese
+    /// @brief ߳ж²
+    void SetCellSize(float cell_size);
+
+    /// \~chinese
+    /// @brief ¶İΧ
+    /// @param id 
+    /// @param bounds ϵµİΧ
+    void Update(uint32_t id, const Rect& bounds);
+
+    /// \~chinese
+    /// @brief Ƴ
+    /// @param id 
+    void Remove(uint32_t id);
+
+    /// \~chinese
+    /// @brief ж
+    void Clear();
+
+    /// \~chinese
+    /// @brief ж϶Ƿ
+    bool Contains(uint32_t id) const;
+
+    /// \~chinese
+    /// @brief ѯΧаָĶ
+    /// @param point ϵµĵ
+    /// @param output ţÿֻһΣ֤˳
+    void Query(const Point& point, Vector<uint32_t>& output) const;
+
+    /// \~chinese
+    /// @brief ѯΧָཻĶ
+    /// @param rect ϵµ
+    /// @param output ţÿֻһΣ֤˳
+    void Query(const Rect& rect, Vector<uint32_t>& output) const;
+
+private:
+    struct CellRange
+    {
+        int32_t min_x, min_y, max_x, max_y;
+
+        bool operator==(const CellRange& other) const;
+    };
+
+    enum class ProxyState : uint8_t
+    {
+        None,
+        Grid,
+        Large,
+    };
+
+    struct Proxy
+    {
+        Rect             bounds;
+        CellRange        cells;
+        ProxyState       state;
+        uint32_t         large_index;
+        mutable uint32_t query_mark;
+    };
+
+    bool ComputeCellRange(const Rect& bounds, CellRange& range) const;
+
+    void Link(uint32_t id);
+
+    void Unlink(uint32_t id);
+
+    static uint64_t MakeCellKey(int32_t x, int32_t y);
+
+private:
+    float                                    cell_size_;
+    mutable uint32_t                         query_mark_;
+    Vector<Proxy>                            proxies_;
+    Vector<uint32_t>                         large_;
+    UnorderedMap<uint64_t, Vector<uint32_t>> cells_;
+};
+
+/** @} */
+
+inline float SpatialIndex::GetCellSize() const
+{
+    return cell_size_;
+}
+
+inline bool SpatialIndex::Contains(uint32_t id) const
+{
+    return id < proxies_.size() && proxies_[id].state != ProxyState::None;
+}
+
+inline bool SpatialIndex::CellRange::operator==(const CellRange& other) const
+{
+    return min_x == other.min_x && min_y == other.min_y && max_x == other.max_x && max_y == other.max_y;
+}
+
+}  // namespace kiwano
@@ -102,10 +102,18 @@ void Sprite::OnRender(RenderContext& ctx)
 {
     if (frame_.IsValid())
     {
-        ctx.DrawTexture(*frame_.GetTexture(), &frame_.GetCropRect(), &GetBounds());
+        ctx.DrawSprite(*frame_.GetTexture(), frame_.GetCropRect(), GetBounds(), GetCachedTransformMatrix(),
+                       GetDisplayedOpacity());
     }
 }
 
+void Sprite::PrepareToRender(RenderContext& ctx)
+{
+    // Transform and opacity are submitted with the sprite batch, the context only picks them up
+    // when something else is drawn, such as components or primitives drawn by a subclass
+    ctx.DeferTransformAndOpacity(GetCachedTransformMatrix(), GetDisplayedOpacity());
+}
+
 bool Sprite::CheckVisibility(RenderContext& ctx) const
 {
     return frame_.IsValid() && Actor::CheckVisibility(ctx);
@@ -116,6 +116,8 @@ public:
 protected:
     bool CheckVisibility(RenderContext& ctx) const override;
 
+    void PrepareToRender(RenderContext& ctx) override;
+
 private:
     SpriteFrame frame_;
 };
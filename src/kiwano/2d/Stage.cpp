@@ -26,6 +26,14 @@ namespace kiwano
 {
 
 Stage::Stage()
+    : transform_store_enabled_(false)
+    , spatial_index_enabled_(false)
+    , render_order_dirty_(true)
+    , culling_(false)
+    , hit_cache_valid_(false)
+    , index_version_(0)
+    , cull_version_(0)
+    , cull_frame_(0)
 {
     SetStage(this);
 
@@ -33,7 +41,11 @@ Stage::Stage()
     SetSize(Renderer::GetInstance().GetOutputSize());
 }
 
-Stage::~Stage() {}
+Stage::~Stage()
+{
+    // Detach all actors before the store is destroyed
+    SetTransformStoreEnabled(false);
+}
 
 void Stage::OnEnter()
 {
@@ -45,6 +57,281 @@ void Stage::OnExit()
     KGE_DEBUG_LOGF("Stage exited");
 }
 
+void Stage::Update(Duration dt)
+{
+    Actor::Update(dt);
+    tween_batch_.Update(this, dt);
+}
+
+void Stage::SetTransformStoreEnabled(bool enabled)
+{
+    if (transform_store_enabled_ == enabled)
+        return;
+
+    if (!enabled)
+    {
+        // The spatial index is fed by the store
+        SetSpatialIndexEnabled(false);
+    }
+
+    transform_store_enabled_ = enabled;
+    transform_store_.SetRoot(enabled ? this : nullptr);
+
+    SetTransformStore(GetTransformStore());
+}
+
+void Stage::SetSpatialIndexEnabled(bool enabled)
+{
+    if (spatial_index_enabled_ == enabled)
+        return;
+
+    spatial_index_enabled_ = enabled;
+
+    if (enabled)
+    {
+        SetTransformStoreEnabled(true);
+
+        // Rebuild the store so that every actor is reported to the index
+        transform_store_.SetStructureDirty();
+    }
+
+    transform_store_.SetChangeTracking(enabled);
+    spatial_index_.Clear();
+
+    render_order_dirty_ = true;
+    hit_cache_valid_    = false;
+    hit_cache_.clear();
+    render_order_.clear();
+    in_view_frames_.clear();
+    subtree_frames_.clear();
+}
+
+void Stage::SetSpatialIndexCellSize(float cell_size)
+{
+    spatial_index_.SetCellSize(cell_size);
+}
+
+Vector<RefPtr<Actor>> Stage::QueryPoint(const Point& point)
+{
+    Vector<RefPtr<Actor>> hits;
+    if (!spatial_index_enabled_)
+    {
+        Vector<Actor*> actors;
+        CollectInRenderOrder(this, actors);
+
+        for (auto iter = actors.rbegin(); iter != actors.rend(); ++iter)
+        {
+            if ((*iter)->ContainsPoint(point))
+                hits.push_back(*iter);
+        }
+        return hits;
+    }
+
+    UpdateSpatialIndex();
+
+    query_result_.clear();
+    spatial_index_.Query(point, query_result_);
+    SortByRenderOrder(query_result_);
+
+    for (uint32_t index : query_result_)
+    {
+        Actor* actor = transform_store_.GetActor(index);
+        if (actor->ContainsPoint(point))
+            hits.push_back(actor);
+    }
+    return hits;
+}
+
+Vector<RefPtr<Actor>> Stage::QueryRect(const Rect& rect)
+{
+    Vector<RefPtr<Actor>> hits;
+    if (!spatial_index_enabled_)
+    {
+        Vector<Actor*> actors;
+        CollectInRenderOrder(this, actors);
+
+        for (auto iter = actors.rbegin(); iter != actors.rend(); ++iter)
+        {
+            Actor* actor = *iter;
+            if (!actor->GetSize().IsOrigin() && actor->GetBoundingBox().Intersects(rect))
+                hits.push_back(actor);
+        }
+        return hits;
+    }
+
+    UpdateSpatialIndex();
+
+    query_result_.clear();
+    spatial_index_.Query(rect, query_result_);
+    SortByRenderOrder(query_result_);
+
+    for (uint32_t index : query_result_)
+    {
+        // Candidates with unbounded boxes are actors without size
+        Actor* actor = transform_store_.GetActor(index);
+        if (!actor->GetSize().IsOrigin())
+            hits.push_back(actor);
+    }
+    return hits;
+}
+
+bool Stage::HitTest(const Actor* actor, const Point& point)
+{
+    KGE_ASSERT(actor);
+
+    if (!spatial_index_enabled_ || actor->GetStage() != this)
+        return actor->ContainsPoint(point);
+
+    UpdateSpatialIndex();
+
+    if (!hit_cache_valid_ || hit_point_ != point)
+    {
+        hit_cache_valid_ = true;
+        hit_point_       = point;
+
+        hit_cache_.clear();
+        spatial_index_.Query(point, hit_cache_);
+
+        auto iter = std::remove_if(hit_cache_.begin(), hit_cache_.end(), [this, &point](uint32_t index) {
+            return !transform_store_.GetActor(index)->ContainsPoint(point);
+        });
+        hit_cache_.erase(iter, hit_cache_.end());
+        std::sort(hit_cache_.begin(), hit_cache_.end());
+    }
+    return std::binary_search(hit_cache_.begin(), hit_cache_.end(), actor->transform_index_);
+}
+
+void Stage::Render(RenderContext& ctx)
+{
+    if (spatial_index_enabled_ && IsVisible() && UpdateCulling(ctx))
+    {
+        culling_ = true;
+        Actor::Render(ctx);
+        culling_ = false;
+    }
+    else
+    {
+        Actor::Render(ctx);
+    }
+}
+
+void Stage::UpdateSpatialIndex()
+{
+    transform_store_.Update();
+
+    if (index_version_ != transform_store_.GetVersion())
+    {
+        // Indices have been reassigned, all entries are reported as changed
+        index_version_      = transform_store_.GetVersion();
+        render_order_dirty_ = true;
+        spatial_index_.Clear();
+    }
+
+    const auto& changed = transform_store_.GetChangedEntries();
+    if (changed.empty())
+        return;
+
+    for (uint32_t index : changed)
+    {
+        Actor* actor = transform_store_.GetActor(index);
+        if (actor->GetSize().IsOrigin())
+        {
+            // Actors without size may still render something or hold visible children, they are never culled
+            spatial_index_.Update(index, Rect::Infinite());
+        }
+        else
+        {
+            spatial_index_.Update(index, actor->GetBoundingBox());
+        }
+    }
+
+    transform_store_.ClearChangedEntries();
+    hit_cache_valid_ = false;
+}
+
+void Stage::UpdateRenderOrder()
+{
+    if (!render_order_dirty_)
+        return;
+
+    render_order_dirty_ = false;
+
+    Vector<Actor*> actors;
+    actors.reserve(transform_store_.GetSize());
+    CollectInRenderOrder(this, actors);
+
+    render_order_.assign(transform_store_.GetSize(), 0);
+    for (uint32_t i = 0; i < uint32_t(actors.size()); ++i)
+    {
+        render_order_[actors[i]->transform_index_] = i;
+    }
+}
+
+void Stage::SortByRenderOrder(Vector<uint32_t>& indices)
+{
+    UpdateRenderOrder();
+
+    // Actors rendered last are on the top
+    std::sort(indices.begin(), indices.end(),
+              [this](uint32_t lhs, uint32_t rhs) { return render_order_[lhs] > render_order_[rhs]; });
+}
+
+bool Stage::UpdateCulling(RenderContext& ctx)
+{
+    const Matrix3x2& global_transform = ctx.GetGlobalTransform();
+    if (!global_transform.IsInvertible())
+        return false;
+
+    UpdateSpatialIndex();
+
+    const size_t count = transform_store_.GetSize();
+    if (++cull_frame_ == 0 || in_view_frames_.size() != count)
+    {
+        cull_frame_ = 1;
+        in_view_frames_.assign(count, 0);
+        subtree_frames_.assign(count, 0);
+    }
+    cull_version_ = transform_store_.GetVersion();
+
+    const Rect view = global_transform.Invert().Transform(Rect(Point(), ctx.GetSize()));
+
+    query_result_.clear();
+    spatial_index_.Query(view, query_result_);
+
+    for (uint32_t index : query_result_)
+    {
+        in_view_frames_[index] = cull_frame_;
+
+        // Mark the ancestors so that the traversal reaches this actor, stop at the first one already marked
+        int32_t i = int32_t(index);
+        while (i >= 0 && subtree_frames_[i] != cull_frame_)
+        {
+            subtree_frames_[i] = cull_frame_;
+            i                  = transform_store_.GetParentIndex(uint32_t(i));
+        }
+    }
+    return true;
+}
+
+void Stage::CollectInRenderOrder(Actor* actor, Vector<Actor*>& output)
+{
+    // Same order as Actor::Render
+    Actor* child = actor->children_.GetFirstPtr();
+    while (child && child->GetZOrder() < 0)
+    {
+        CollectInRenderOrder(child, output);
+        child = ActorList::GetNextPtr(child);
+    }
+
+    output.push_back(actor);
+
+    while (child)
+    {
+        CollectInRenderOrder(child, output);
+        child = ActorList::GetNextPtr(child);
+    }
+}
+
 void Stage::RenderBorder(RenderContext& ctx)
 {
     ctx.SetBrushOpacity(GetDisplayedOpacity());
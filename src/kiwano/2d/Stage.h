@@ -20,6 +20,8 @@
 
 #pragma once
 #include <kiwano/2d/Actor.h>
+#include <kiwano/2d/SpatialIndex.h>
+#include <kiwano/2d/animation/TweenBatch.h>
 #include <kiwano/render/Brush.h>
 
 namespace kiwano
@@ -38,6 +40,7 @@ namespace kiwano
  */
 class KGE_API Stage : public Actor
 {
+    friend class Actor;
     friend class Transition;
     friend class Director;
 
@@ -72,14 +75,114 @@ public:
     /// @brief ýɫ߽ˢ
     void SetBorderStrokeBrush(RefPtr<Brush> brush);
 
+    /// \~chinese
+    /// @brief ûöά任洢
+    /// @details ų́нɫĶά任бУȾǰͨһԱ£
+    /// ڽɫҴ󲿷־ֹĳ
+    void SetTransformStoreEnabled(bool enabled);
+
+    /// \~chinese
+    /// @brief Ƿ˶ά任洢
+    bool IsTransformStoreEnabled() const;
+
+    /// \~chinese
+    /// @brief ȡά任洢δʱؿָ
+    TransformStore* GetTransformStore();
+
+    /// \~chinese
+    /// @brief ûÿռ
+    /// @details ų́ʹþάнɫΧУΧά任һ¡
+    /// Ⱦʱͨһβѯ޳Ľɫ QueryPointQueryRect ⡣
+    /// ռά任洢ʱͬʱöά任洢
+    /// @note ޳ԽɫİΧΪ׼ݳΧеĽɫܱ޳ûдСĽɫᱻ޳
+    void SetSpatialIndexEnabled(bool enabled);
+
+    /// \~chinese
+    /// @brief Ƿ˿ռ
+    bool IsSpatialIndexEnabled() const;
+
+    /// \~chinese
+    /// @brief ÿռ߳ĬΪ 128
+    /// @details ߳ӽɫĴСʱѯЧ
+    void SetSpatialIndexCellSize(float cell_size);
+
+    /// \~chinese
+    /// @brief ѯָĽɫ
+    /// @param point ϵµĵ
+    /// @return Ⱦ˳ϵеĽɫɫǷɼ
+    Vector<RefPtr<Actor>> QueryPoint(const Point& point);
+
+    /// \~chinese
+    /// @brief ѯΧָཻĽɫ
+    /// @param rect ϵµ
+    /// @return Ⱦ˳ϵеĽɫɫǷɼ
+    Vector<RefPtr<Actor>> QueryRect(const Rect& rect);
+
+    /// \~chinese
+    /// @brief жϵǷ̨ϵĳɫ
+    /// @details  Actor::ContainsPoint ͬÿռʱͬһλõĶμ⹲һβѯ
+    /// @param actor ̨ϵĽɫ
+    /// @param point ϵµĵ
+    bool HitTest(const Actor* actor, const Point& point);
+
+    /// \~chinese
+    /// @brief ȡ
+    /// @details ɫִм򵥵λơš͸Ȼתʱʹ TweenAnimation
+    /// ̨ӽɫ֮ͳһ
+    TweenBatch& GetTweenBatch();
+
 protected:
+    /// \~chinese
+    /// @brief ӽɫ
+    void Update(Duration dt) override;
+
+    /// \~chinese
+    /// @brief Ⱦӽɫÿռʱ޳Ľɫ
+    void Render(RenderContext& ctx) override;
+
     /// \~chinese
     /// @brief ӽɫı߽
     void RenderBorder(RenderContext& ctx) override;
 
 private:
-    RefPtr<Brush> border_fill_brush_;
-    RefPtr<Brush> border_stroke_brush_;
+    void UpdateSpatialIndex();
+
+    void UpdateRenderOrder();
+
+    void SortByRenderOrder(Vector<uint32_t>& indices);
+
+    bool UpdateCulling(RenderContext& ctx);
+
+    bool IsCullingActive() const;
+
+    bool IsInView(const Actor* actor) const;
+
+    bool IsSubtreeInView(const Actor* actor) const;
+
+    void SetRenderOrderDirty();
+
+    static void CollectInRenderOrder(Actor* actor, Vector<Actor*>& output);
+
+private:
+    bool             transform_store_enabled_;
+    bool             spatial_index_enabled_;
+    bool             render_order_dirty_;
+    bool             culling_;
+    bool             hit_cache_valid_;
+    uint32_t         index_version_;
+    uint32_t         cull_version_;
+    uint32_t         cull_frame_;
+    Point            hit_point_;
+    RefPtr<Brush>    border_fill_brush_;
+    RefPtr<Brush>    border_stroke_brush_;
+    TransformStore   transform_store_;
+    SpatialIndex     spatial_index_;
+    TweenBatch       tween_batch_;
+    Vector<uint32_t> query_result_;
+    Vector<uint32_t> hit_cache_;
+    Vector<uint32_t> render_order_;
+    Vector<uint32_t> in_view_frames_;
+    Vector<uint32_t> subtree_frames_;
 };
 
 /** @} */
@@ -103,4 +206,45 @@ inline void Stage::SetBorderStrokeBrush(RefPtr<Brush> brush)
 {
     border_stroke_brush_ = brush;
 }
+
+inline bool Stage::IsTransformStoreEnabled() const
+{
+    return transform_store_enabled_;
+}
+
+inline TransformStore* Stage::GetTransformStore()
+{
+    return transform_store_enabled_ ? &transform_store_ : nullptr;
+}
+
+inline TweenBatch& Stage::GetTweenBatch()
+{
+    return tween_batch_;
+}
+
+inline bool Stage::IsSpatialIndexEnabled() const
+{
+    return spatial_index_enabled_;
+}
+
+inline bool Stage::IsCullingActive() const
+{
+    // Actors added during rendering have no valid index until the store is rebuilt
+    return culling_ && !transform_store_.IsStructureDirty() && transform_store_.GetVersion() == cull_version_;
+}
+
+inline bool Stage::IsInView(const Actor* actor) const
+{
+    return in_view_frames_[actor->transform_index_] == cull_frame_;
+}
+
+inline bool Stage::IsSubtreeInView(const Actor* actor) const
+{
+    return subtree_frames_[actor->transform_index_] == cull_frame_;
+}
+
+inline void Stage::SetRenderOrderDirty()
+{
+    render_order_dirty_ = true;
+}
 }  // namespace kiwano
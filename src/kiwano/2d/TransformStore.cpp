@@ -0,0 +1,167 @@
+// Copyright (c) 2016-2019 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <kiwano/2d/TransformStore.h>
+#include <kiwano/2d/Actor.h>
+
+namespace kiwano
+{
+
+namespace
+{
+
+const uint32_t invalid_index = uint32_t(-1);
+
+}  // namespace
+
+TransformStore::TransformStore()
+    : structure_dirty_(true)
+    , track_changes_(false)
+    , first_dirty_(invalid_index)
+    , version_(0)
+    , root_(nullptr)
+{
+}
+
+void TransformStore::SetRoot(Actor* root)
+{
+    root_ = root;
+    SetStructureDirty();
+}
+
+void TransformStore::SetStructureDirty()
+{
+    structure_dirty_ = true;
+}
+
+void TransformStore::SetChangeTracking(bool enabled)
+{
+    track_changes_ = enabled;
+    if (!enabled)
+        changed_.clear();
+}
+
+void TransformStore::SetDirty(uint32_t index)
+{
+    // Indices are reassigned by the next rebuild, which marks everything dirty anyway
+    if (structure_dirty_ || index >= flags_.size())
+        return;
+
+    flags_[index] |= EntryFlag::LocalDirty;
+    first_dirty_ = std::min(first_dirty_, index);
+}
+
+void TransformStore::Update()
+{
+    if (structure_dirty_)
+    {
+        Rebuild();
+    }
+
+    if (first_dirty_ == invalid_index)
+        return;
+
+    const uint32_t count = uint32_t(actors_.size());
+    for (uint32_t i = first_dirty_; i < count; ++i)
+    {
+        uint8_t       flags  = flags_[i];
+        const int32_t parent = parents_[i];
+
+        if (flags & EntryFlag::LocalDirty)
+        {
+            local_[i] = actors_[i]->ComputeTransformMatrixToParent();
+            flags |= EntryFlag::WorldChanged;
+        }
+        else if (parent >= 0 && (flags_[parent] & EntryFlag::WorldChanged))
+        {
+            flags |= EntryFlag::WorldChanged;
+        }
+
+        if (flags & EntryFlag::WorldChanged)
+        {
+            if (parent >= 0)
+            {
+                world_[i] = local_[i] * world_[parent];
+            }
+            else
+            {
+                world_[i] = local_[i];
+            }
+
+            actors_[i]->dirty_flag_.Set(Actor::DirtyFlag::DirtyTransformInverse);
+            actors_[i]->dirty_flag_.Set(Actor::DirtyFlag::DirtyVisibility);
+
+            if (track_changes_)
+                changed_.push_back(i);
+        }
+        flags_[i] = flags & EntryFlag::WorldChanged;
+    }
+
+    // Parents are always visited before their children, so the marks can be cleared afterwards
+    for (uint32_t i = first_dirty_; i < count; ++i)
+    {
+        flags_[i] = 0;
+    }
+    first_dirty_ = invalid_index;
+}
+
+void TransformStore::Rebuild()
+{
+    structure_dirty_ = false;
+    ++version_;
+
+    // Old indices are meaningless now, every entry is reported again by the next update
+    changed_.clear();
+    actors_.clear();
+    parents_.clear();
+
+    if (root_)
+    {
+        // Depth-first traversal, children are pushed in reverse so they are stored in list order
+        Vector<std::pair<Actor*, int32_t>> stack;
+        stack.emplace_back(root_, -1);
+
+        while (!stack.empty())
+        {
+            Actor*        actor  = stack.back().first;
+            const int32_t parent = stack.back().second;
+            stack.pop_back();
+
+            const int32_t index     = int32_t(actors_.size());
+            actor->transform_index_ = uint32_t(index);
+
+            actors_.push_back(actor);
+            parents_.push_back(parent);
+
+            for (Actor* child = actor->children_.GetLastPtr(); child; child = ActorList::GetPrevPtr(child))
+            {
+                stack.emplace_back(child, index);
+            }
+        }
+    }
+
+    const size_t count = actors_.size();
+    flags_.assign(count, EntryFlag::LocalDirty);
+    local_.resize(count);
+    world_.resize(count);
+    first_dirty_ = count ? 0 : invalid_index;
+}
+
+}  // namespace kiwano
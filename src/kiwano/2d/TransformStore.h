@@ -0,0 +1,184 @@
+// Copyright (c) 2016-2019 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <kiwano/math/Math.h>
+#include <kiwano/core/Common.h>
+
+namespace kiwano
+{
+class Actor;
+
+/**
+ * \addtogroup Actors
+ * @{
+ */
+
+/**
+ * \~chinese
+ * @brief ά任洢
+ * @details ˳̨нɫľֲ任ڵ任У
+ * ȾǰͨһԱ任ɫݹ¡
+ * ڸڵӽڵ֮ǰӽڵʱڵ任Ѿµ
+ */
+class KGE_API TransformStore : Noncopyable
+{
+public:
+    TransformStore();
+
+    /// \~chinese
+    /// @brief øɫ
+    void SetRoot(Actor* root);
+
+    /// \~chinese
+    /// @brief Ҫµ任
+    /// @details ڵṹ仯ʱؽ洢
+    void Update();
+
+    /// \~chinese
+    /// @brief ǽڵṹ仯´θʱؽ洢
+    void SetStructureDirty();
+
+    /// \~chinese
+    /// @brief ǽɫľֲ任仯
+    /// @param index ɫڴ洢е
+    void SetDirty(uint32_t index);
+
+    /// \~chinese
+    /// @brief ڵṹǷ˱仯δؽ
+    bool IsStructureDirty() const;
+
+    /// \~chinese
+    /// @brief ȡ洢İ汾ţÿؽ
+    /// @details 汾ű仯ʱнɫѾı
+    uint32_t GetVersion() const;
+
+    /// \~chinese
+    /// @brief û任ı仯¼
+    /// @details úÿθ¶¼任仯Ľɫֱ ClearChangedEntries
+    void SetChangeTracking(bool enabled);
+
+    /// \~chinese
+    /// @brief ȡ任仯Ľɫܰظ
+    const Vector<uint32_t>& GetChangedEntries() const;
+
+    /// \~chinese
+    /// @brief 任ı仯¼
+    void ClearChangedEntries();
+
+    /// \~chinese
+    /// @brief ȡɫ
+    size_t GetSize() const;
+
+    /// \~chinese
+    /// @brief ȡɫ
+    /// @param index ɫڴ洢е
+    Actor* GetActor(uint32_t index) const;
+
+    /// \~chinese
+    /// @brief ȡɫɫ -1
+    /// @param index ɫڴ洢е
+    int32_t GetParentIndex(uint32_t index) const;
+
+    /// \~chinese
+    /// @brief ȡֲ任Ҫ Update 
+    /// @param index ɫڴ洢е
+    const Matrix3x2& GetLocalMatrix(uint32_t index) const;
+
+    /// \~chinese
+    /// @brief ȡ任Ҫ Update 
+    /// @param index ɫڴ洢е
+    const Matrix3x2& GetWorldMatrix(uint32_t index) const;
+
+private:
+    void Rebuild();
+
+private:
+    enum EntryFlag : uint8_t
+    {
+        LocalDirty   = 1,
+        WorldChanged = 1 << 1,
+    };
+
+    bool              structure_dirty_;
+    bool              track_changes_;
+    uint32_t          first_dirty_;
+    uint32_t          version_;
+    Actor*            root_;
+    Vector<uint32_t>  changed_;
+    Vector<Actor*>    actors_;
+    Vector<int32_t>   parents_;
+    Vector<uint8_t>   flags_;
+    Vector<Matrix3x2> local_;
+    Vector<Matrix3x2> world_;
+};
+
+/** @} */
+
+inline bool TransformStore::IsStructureDirty() const
+{
+    return structure_dirty_;
+}
+
+inline uint32_t TransformStore::GetVersion() const
+{
+    return version_;
+}
+
+inline const Vector<uint32_t>& TransformStore::GetChangedEntries() const
+{
+    return changed_;
+}
+
+inline void TransformStore::ClearChangedEntries()
+{
+    changed_.clear();
+}
+
+inline size_t TransformStore::GetSize() const
+{
+    return actors_.size();
+}
+
+inline Actor* TransformStore::GetActor(uint32_t index) const
+{
+    KGE_ASSERT(index < actors_.size());
+    return actors_[index];
+}
+
+inline int32_t TransformStore::GetParentIndex(uint32_t index) const
+{
+    KGE_ASSERT(index < parents_.size());
+    return parents_[index];
+}
+
+inline const Matrix3x2& TransformStore::GetLocalMatrix(uint32_t index) const
+{
+    KGE_ASSERT(index < local_.size());
+    return local_[index];
+}
+
+inline const Matrix3x2& TransformStore::GetWorldMatrix(uint32_t index) const
+{
+    KGE_ASSERT(index < world_.size());
+    return world_[index];
+}
+
+}  // namespace kiwano
@@ -30,16 +30,21 @@ void Animator::Update(Actor* target, Duration dt)
     if (animations_.IsEmpty() || !target)
         return;
 
-    RefPtr<Animation> next;
-    for (auto animation = animations_.GetFirst(); animation; animation = next)
+    AnimationList::TraversalGuard guard(animations_);
+
+    Animation* next = nullptr;
+    for (auto animation = animations_.GetFirstPtr(); animation; animation = next)
     {
-        next = animation->GetNext();
+        next = AnimationList::GetNextPtr(animation);
 
         if (animation->IsRunning())
             animation->UpdateStep(target, dt);
 
         if (animation->IsRemoveable())
-            animations_.Remove(animation);
+        {
+            RefPtr<Animation> removed = animation;
+            animations_.Remove(removed);
+        }
     }
 }
 
@@ -24,61 +24,124 @@
 namespace kiwano
 {
 
-inline EaseFunc MakeEaseIn(float rate)
+namespace
 {
-    return std::bind(math::EaseIn, std::placeholders::_1, rate);
-}
-inline EaseFunc MakeEaseOut(float rate)
+
+// 512 intervals keep the linear interpolation error of the elastic curves below 5e-4
+const int EaseTableSize = 512;
+
+float ElasticIn(float step)
 {
-    return std::bind(math::EaseOut, std::placeholders::_1, rate);
+    return math::EaseElasticIn(step, 0.3f);
 }
-inline EaseFunc MakeEaseInOut(float rate)
+
+float ElasticOut(float step)
 {
-    return std::bind(math::EaseInOut, std::placeholders::_1, rate);
+    return math::EaseElasticOut(step, 0.3f);
 }
-inline EaseFunc MakeEaseElasticIn(float period)
+
+float ElasticInOut(float step)
 {
-    return std::bind(math::EaseElasticIn, std::placeholders::_1, period);
+    return math::EaseElasticInOut(step, 0.3f);
 }
-inline EaseFunc MakeEaseElasticOut(float period)
+
+struct EaseTables
 {
-    return std::bind(math::EaseElasticOut, std::placeholders::_1, period);
+    float samples[9][EaseTableSize + 1];
+
+    EaseTables()
+    {
+        float (*const funcs[9])(float) = {
+            math::EaseExponentialIn, math::EaseExponentialOut, math::EaseExponentialInOut,
+            ElasticIn,               ElasticOut,               ElasticInOut,
+            math::EaseSineIn,        math::EaseSineOut,        math::EaseSineInOut,
+        };
+
+        for (int i = 0; i < 9; ++i)
+        {
+            for (int j = 0; j <= EaseTableSize; ++j)
+                samples[i][j] = funcs[i](float(j) / EaseTableSize);
+        }
+    }
+};
+
+const EaseTables ease_tables;
+
+int GetEaseTableIndex(EaseCurve curve)
+{
+    switch (curve)
+    {
+    case EaseCurve::ExpoIn:
+    case EaseCurve::ExpoOut:
+    case EaseCurve::ExpoInOut:
+    case EaseCurve::ElasticIn:
+    case EaseCurve::ElasticOut:
+    case EaseCurve::ElasticInOut:
+        return int(curve) - int(EaseCurve::ExpoIn);
+    case EaseCurve::SineIn:
+    case EaseCurve::SineOut:
+    case EaseCurve::SineInOut:
+        return int(curve) - int(EaseCurve::SineIn) + 6;
+    default:
+        return -1;
+    }
 }
-inline EaseFunc MakeEaseElasticInOut(float period)
+
+}  // namespace
+
+namespace details
+{
+
+float SampleEaseTable(EaseCurve curve, float step)
 {
-    return std::bind(math::EaseElasticInOut, std::placeholders::_1, period);
+    const int index = GetEaseTableIndex(curve);
+    if (index < 0)
+        return EvaluateEase(curve, step);
+
+    const float* samples = ease_tables.samples[index];
+    if (step <= 0.f)
+        return samples[0];
+
+    const float pos = step * EaseTableSize;
+    const int   i   = static_cast<int>(pos);
+    if (i >= EaseTableSize)
+        return samples[EaseTableSize];
+
+    return samples[i] + (samples[i + 1] - samples[i]) * (pos - float(i));
 }
 
-KGE_API EaseFunc Ease::Linear       = math::Linear;
-KGE_API EaseFunc Ease::EaseIn       = MakeEaseIn(2.f);
-KGE_API EaseFunc Ease::EaseOut      = MakeEaseOut(2.f);
-KGE_API EaseFunc Ease::EaseInOut    = MakeEaseInOut(2.f);
-KGE_API EaseFunc Ease::ExpoIn       = math::EaseExponentialIn;
-KGE_API EaseFunc Ease::ExpoOut      = math::EaseExponentialOut;
-KGE_API EaseFunc Ease::ExpoInOut    = math::EaseExponentialInOut;
-KGE_API EaseFunc Ease::BounceIn     = math::EaseBounceIn;
-KGE_API EaseFunc Ease::BounceOut    = math::EaseBounceOut;
-KGE_API EaseFunc Ease::BounceInOut  = math::EaseBounceInOut;
-KGE_API EaseFunc Ease::ElasticIn    = MakeEaseElasticIn(0.3f);
-KGE_API EaseFunc Ease::ElasticOut   = MakeEaseElasticOut(0.3f);
-KGE_API EaseFunc Ease::ElasticInOut = MakeEaseElasticInOut(0.3f);
-KGE_API EaseFunc Ease::SineIn       = math::EaseSineIn;
-KGE_API EaseFunc Ease::SineOut      = math::EaseSineOut;
-KGE_API EaseFunc Ease::SineInOut    = math::EaseSineInOut;
-KGE_API EaseFunc Ease::BackIn       = math::EaseBackIn;
-KGE_API EaseFunc Ease::BackOut      = math::EaseBackOut;
-KGE_API EaseFunc Ease::BackInOut    = math::EaseBackInOut;
-KGE_API EaseFunc Ease::QuadIn       = math::EaseQuadIn;
-KGE_API EaseFunc Ease::QuadOut      = math::EaseQuadOut;
-KGE_API EaseFunc Ease::QuadInOut    = math::EaseQuadInOut;
-KGE_API EaseFunc Ease::CubicIn      = math::EaseCubicIn;
-KGE_API EaseFunc Ease::CubicOut     = math::EaseCubicOut;
-KGE_API EaseFunc Ease::CubicInOut   = math::EaseCubicInOut;
-KGE_API EaseFunc Ease::QuartIn      = math::EaseQuartIn;
-KGE_API EaseFunc Ease::QuartOut     = math::EaseQuartOut;
-KGE_API EaseFunc Ease::QuartInOut   = math::EaseQuartInOut;
-KGE_API EaseFunc Ease::QuintIn      = math::EaseQuintIn;
-KGE_API EaseFunc Ease::QuintOut     = math::EaseQuintOut;
-KGE_API EaseFunc Ease::QuintInOut   = math::EaseQuintInOut;
+}  // namespace details
+
+KGE_API EaseFunc Ease::Linear       = EaseCurve::Linear;
+KGE_API EaseFunc Ease::EaseIn       = EaseCurve::EaseIn;
+KGE_API EaseFunc Ease::EaseOut      = EaseCurve::EaseOut;
+KGE_API EaseFunc Ease::EaseInOut    = EaseCurve::EaseInOut;
+KGE_API EaseFunc Ease::ExpoIn       = EaseCurve::ExpoIn;
+KGE_API EaseFunc Ease::ExpoOut      = EaseCurve::ExpoOut;
+KGE_API EaseFunc Ease::ExpoInOut    = EaseCurve::ExpoInOut;
+KGE_API EaseFunc Ease::BounceIn     = EaseCurve::BounceIn;
+KGE_API EaseFunc Ease::BounceOut    = EaseCurve::BounceOut;
+KGE_API EaseFunc Ease::BounceInOut  = EaseCurve::BounceInOut;
+KGE_API EaseFunc Ease::ElasticIn    = EaseCurve::ElasticIn;
+KGE_API EaseFunc Ease::ElasticOut   = EaseCurve::ElasticOut;
+KGE_API EaseFunc Ease::ElasticInOut = EaseCurve::ElasticInOut;
+KGE_API EaseFunc Ease::SineIn       = EaseCurve::SineIn;
+KGE_API EaseFunc Ease::SineOut      = EaseCurve::SineOut;
+KGE_API EaseFunc Ease::SineInOut    = EaseCurve::SineInOut;
+KGE_API EaseFunc Ease::BackIn       = EaseCurve::BackIn;
+KGE_API EaseFunc Ease::BackOut      = EaseCurve::BackOut;
+KGE_API EaseFunc Ease::BackInOut    = EaseCurve::BackInOut;
+KGE_API EaseFunc Ease::QuadIn       = EaseCurve::QuadIn;
+KGE_API EaseFunc Ease::QuadOut      = EaseCurve::QuadOut;
+KGE_API EaseFunc Ease::QuadInOut    = EaseCurve::QuadInOut;
+KGE_API EaseFunc Ease::CubicIn      = EaseCurve::CubicIn;
+KGE_API EaseFunc Ease::CubicOut     = EaseCurve::CubicOut;
+KGE_API EaseFunc Ease::CubicInOut   = EaseCurve::CubicInOut;
+KGE_API EaseFunc Ease::QuartIn      = EaseCurve::QuartIn;
+KGE_API EaseFunc Ease::QuartOut     = EaseCurve::QuartOut;
+KGE_API EaseFunc Ease::QuartInOut   = EaseCurve::QuartInOut;
+KGE_API EaseFunc Ease::QuintIn      = EaseCurve::QuintIn;
+KGE_API EaseFunc Ease::QuintOut     = EaseCurve::QuintOut;
+KGE_API EaseFunc Ease::QuintInOut   = EaseCurve::QuintInOut;
 
 }  // namespace kiwano
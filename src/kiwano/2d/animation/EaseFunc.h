@@ -20,13 +20,185 @@
 
 #pragma once
 #include <kiwano/core/Common.h>
+#include <kiwano/math/EaseFunctions.h>
 
 namespace kiwano
 {
 
+/// \~chinese
+/// @brief û
+/// @details  Ease еͬһһӦҪͼ㻺ĳ
+enum class EaseCurve : uint8_t
+{
+    Linear,
+    EaseIn,
+    EaseOut,
+    EaseInOut,
+    ExpoIn,
+    ExpoOut,
+    ExpoInOut,
+    ElasticIn,
+    ElasticOut,
+    ElasticInOut,
+    BounceIn,
+    BounceOut,
+    BounceInOut,
+    BackIn,
+    BackOut,
+    BackInOut,
+    QuadIn,
+    QuadOut,
+    QuadInOut,
+    CubicIn,
+    CubicOut,
+    CubicInOut,
+    QuartIn,
+    QuartOut,
+    QuartInOut,
+    QuintIn,
+    QuintOut,
+    QuintInOut,
+    SineIn,
+    SineOut,
+    SineInOut,
+};
+
+namespace details
+{
+
+/// \~chinese
+/// @brief ָͨԺһ
+KGE_API float SampleEaseTable(EaseCurve curve, float step);
+
+}  // namespace details
+
+/// \~chinese
+/// @brief û
+/// @details ʽͷֱӼ㣬ָԺʹԤȲıԲֵƣ 5e-4
+/// @param curve 
+/// @param step ȣȡֵΧΪ [0, 1]
+inline float EvaluateEase(EaseCurve curve, float step)
+{
+    switch (curve)
+    {
+    case EaseCurve::Linear:
+        return step;
+    case EaseCurve::EaseIn:
+    case EaseCurve::QuadIn:
+        return math::EaseQuadIn(step);
+    case EaseCurve::EaseOut:
+        return math::Sqrt(step);
+    case EaseCurve::EaseInOut:
+    case EaseCurve::QuadInOut:
+        return math::EaseQuadInOut(step);
+    case EaseCurve::QuadOut:
+        return math::EaseQuadOut(step);
+    case EaseCurve::CubicIn:
+        return math::EaseCubicIn(step);
+    case EaseCurve::CubicOut:
+        return math::EaseCubicOut(step);
+    case EaseCurve::CubicInOut:
+        return math::EaseCubicInOut(step);
+    case EaseCurve::QuartIn:
+        return math::EaseQuartIn(step);
+    case EaseCurve::QuartOut:
+        return math::EaseQuartOut(step);
+    case EaseCurve::QuartInOut:
+        return math::EaseQuartInOut(step);
+    case EaseCurve::QuintIn:
+        return math::EaseQuintIn(step);
+    case EaseCurve::QuintOut:
+        return math::EaseQuintOut(step);
+    case EaseCurve::QuintInOut:
+        return math::EaseQuintInOut(step);
+    case EaseCurve::BackIn:
+        return math::EaseBackIn(step);
+    case EaseCurve::BackOut:
+        return math::EaseBackOut(step);
+    case EaseCurve::BackInOut:
+        return math::EaseBackInOut(step);
+    case EaseCurve::BounceIn:
+        return math::EaseBounceIn(step);
+    case EaseCurve::BounceOut:
+        return math::EaseBounceOut(step);
+    case EaseCurve::BounceInOut:
+        return math::EaseBounceInOut(step);
+    default:
+        return details::SampleEaseTable(curve, step);
+    }
+}
+
 /// \~chinese
 /// @brief 
-using EaseFunc = Function<float(float)>;
+/// @details ûߡָԶ庯ûֻöֵֵʱֱӷɣ
+/// ʱҲҪάü
+class KGE_API EaseFunc
+{
+public:
+    /// \~chinese
+    /// @brief Զ建
+    using Func = Function<float(float)>;
+
+    /// \~chinese
+    /// @brief ջ
+    EaseFunc();
+
+    /// \~chinese
+    /// @brief ջ
+    EaseFunc(std::nullptr_t);
+
+    /// \~chinese
+    /// @brief ʹû
+    EaseFunc(EaseCurve curve);
+
+    /// \~chinese
+    /// @brief ʹúָ
+    EaseFunc(float (*func)(float));
+
+    /// \~chinese
+    /// @brief ʹԶ庯
+    EaseFunc(const Func& func);
+
+    /// \~chinese
+    /// @brief ʹÿɵö
+    template <typename _Ty, typename = typename std::enable_if<details::IsCallable<_Ty, float, float>::value, int>::type>
+    EaseFunc(_Ty func);
+
+    /// \~chinese
+    /// @brief 㻺
+    /// @details ջԴ
+    float operator()(float step) const;
+
+    /// \~chinese
+    /// @brief ǷΪջ
+    bool IsEmpty() const;
+
+    /// \~chinese
+    /// @brief ǷΪû
+    bool IsCurve() const;
+
+    /// \~chinese
+    /// @brief ȡûߣ IsCurve  true ʱЧ
+    EaseCurve GetCurve() const;
+
+    operator bool() const;
+
+private:
+    enum class Type : uint8_t
+    {
+        Empty,
+        Curve,
+        Pointer,
+        Custom,
+    };
+
+    using RawFunc = float (*)(float);
+
+    Type      type_;
+    EaseCurve curve_;
+    RawFunc   pointer_;
+    Func      func_;
+};
 
 /// \~chinese
 /// @brief ö
@@ -66,4 +238,79 @@ struct Ease
     static KGE_API EaseFunc SineInOut;
 };
 
+inline EaseFunc::EaseFunc()
+    : type_(Type::Empty)
+    , curve_(EaseCurve::Linear)
+    , pointer_(nullptr)
+{
+}
+
+inline EaseFunc::EaseFunc(std::nullptr_t)
+    : EaseFunc()
+{
+}
+
+inline EaseFunc::EaseFunc(EaseCurve curve)
+    : type_(Type::Curve)
+    , curve_(curve)
+    , pointer_(nullptr)
+{
+}
+
+inline EaseFunc::EaseFunc(float (*func)(float))
+    : type_(func ? Type::Pointer : Type::Empty)
+    , curve_(EaseCurve::Linear)
+    , pointer_(func)
+{
+}
+
+inline EaseFunc::EaseFunc(const Func& func)
+    : type_(func ? Type::Custom : Type::Empty)
+    , curve_(EaseCurve::Linear)
+    , pointer_(nullptr)
+    , func_(func)
+{
+}
+
+template <typename _Ty, typename>
+inline EaseFunc::EaseFunc(_Ty func)
+    : EaseFunc(Func(std::move(func)))
+{
+}
+
+inline float EaseFunc::operator()(float step) const
+{
+    switch (type_)
+    {
+    case Type::Curve:
+        return EvaluateEase(curve_, step);
+    case Type::Pointer:
+        return pointer_(step);
+    case Type::Custom:
+        return func_(step);
+    default:
+        return step;
+    }
+}
+
+inline bool EaseFunc::IsEmpty() const
+{
+    return type_ == Type::Empty;
+}
+
+inline bool EaseFunc::IsCurve() const
+{
+    return type_ == Type::Curve;
+}
+
+inline EaseCurve EaseFunc::GetCurve() const
+{
+    return curve_;
+}
+
+inline EaseFunc::operator bool() const
+{
+    return type_ != Type::Empty;
+}
+
 }  // namespace kiwano
@@ -0,0 +1,832 @@
+// Copyright (c) 2016-2019 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#include <kiwano/2d/Actor.h>
+#include <kiwano/2d/animation/TweenBatch.h>
+#include <algorithm>
+#include <cmath>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__SSE__)
+#include <xmmintrin.h>
+#define KGE_TWEEN_BATCH_SSE
+#endif
+
+namespace kiwano
+{
+
+namespace
+{
+
+#ifdef KGE_TWEEN_BATCH_SSE
+
+// Four lanes that take the same expressions as a float, so one curve definition serves both paths
+struct Float4
+{
+    __m128 v;
+
+    Float4(__m128 v)
+        : v(v)
+    {
+    }
+
+    Float4(float f)
+        : v(_mm_set1_ps(f))
+    {
+    }
+};
+
+inline Float4 operator+(Float4 lhs, Float4 rhs)
+{
+    return _mm_add_ps(lhs.v, rhs.v);
+}
+
+inline Float4 operator-(Float4 lhs, Float4 rhs)
+{
+    return _mm_sub_ps(lhs.v, rhs.v);
+}
+
+inline Float4 operator*(Float4 lhs, Float4 rhs)
+{
+    return _mm_mul_ps(lhs.v, rhs.v);
+}
+
+inline Float4 Sqrt(Float4 x)
+{
+    return _mm_sqrt_ps(x.v);
+}
+
+inline Float4 SelectLess(Float4 x, float edge, Float4 less, Float4 other)
+{
+    const __m128 mask = _mm_cmplt_ps(x.v, _mm_set1_ps(edge));
+    return _mm_or_ps(_mm_and_ps(mask, less.v), _mm_andnot_ps(mask, other.v));
+}
+
+#endif
+
+inline float Sqrt(float x)
+{
+    return std::sqrt(x);
+}
+
+inline float SelectLess(float x, float edge, float less, float other)
+{
+    return x < edge ? less : other;
+}
+
+enum EaseShape
+{
+    ShapeIn,
+    ShapeOut,
+    ShapeInOut,
+};
+
+struct PowerCurve2
+{
+    template <typename _Ty>
+    static _Ty In(_Ty t)
+    {
+        return t * t;
+    }
+};
+
+struct PowerCurve3
+{
+    template <typename _Ty>
+    static _Ty In(_Ty t)
+    {
+        return t * t * t;
+    }
+};
+
+struct PowerCurve4
+{
+    template <typename _Ty>
+    static _Ty In(_Ty t)
+    {
+        const _Ty t2 = t * t;
+        return t2 * t2;
+    }
+};
+
+struct PowerCurve5
+{
+    template <typename _Ty>
+    static _Ty In(_Ty t)
+    {
+        const _Ty t2 = t * t;
+        return t2 * t2 * t;
+    }
+};
+
+template <typename _Ty>
+inline _Ty BackIn(_Ty t, float overshoot)
+{
+    return t * t * (t * (overshoot + 1) - overshoot);
+}
+
+struct BackCurve
+{
+    template <typename _Ty>
+    static _Ty In(_Ty t)
+    {
+        return BackIn(t, 1.70158f);
+    }
+};
+
+struct BackInOutCurve
+{
+    template <typename _Ty>
+    static _Ty In(_Ty t)
+    {
+        return BackIn(t, 1.70158f * 1.525f);
+    }
+};
+
+// Out and InOut are mirrored In curves, see math/EaseFunctions.h for the scalar originals
+template <typename _Curve, EaseShape _Shape, typename _Ty>
+inline _Ty Shape(_Ty t)
+{
+    if (_Shape == ShapeIn)
+        return _Curve::In(t);
+    if (_Shape == ShapeOut)
+        return _Ty(1.f) - _Curve::In(_Ty(1.f) - t);
+    return SelectLess(t, .5f, _Curve::In(t * 2.f) * .5f, _Ty(1.f) - _Curve::In(_Ty(2.f) - t * 2.f) * .5f);
+}
+
+struct EaseOutCurve
+{
+    template <typename _Ty>
+    static _Ty Eval(_Ty t)
+    {
+        // math::EaseOut with the rate of 2 used by Ease::EaseOut
+        return Sqrt(t);
+    }
+};
+
+template <typename _Curve, EaseShape _Shape>
+struct ShapedCurve
+{
+    template <typename _Ty>
+    static _Ty Eval(_Ty t)
+    {
+        return Shape<_Curve, _Shape>(t);
+    }
+};
+
+// Same as TweenAnimation::Interpolate, a finished loop always lands exactly on the end value
+template <typename _Curve>
+void EaseBatch(const float* in, float* out, size_t count)
+{
+    size_t i = 0;
+#ifdef KGE_TWEEN_BATCH_SSE
+    for (; i + 4 <= count; i += 4)
+    {
+        const Float4 t = _mm_loadu_ps(in + i);
+        _mm_storeu_ps(out + i, SelectLess(t, 1.f, _Curve::Eval(t), 1.f).v);
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        out[i] = SelectLess(in[i], 1.f, _Curve::Eval(in[i]), 1.f);
+    }
+}
+
+// Curves without a vector form are evaluated one by one, expo, elastic and sine come from sample tables
+void EaseBatchScalar(EaseCurve curve, const float* in, float* out, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        out[i] = in[i] < 1.f ? EvaluateEase(curve, in[i]) : 1.f;
+    }
+}
+
+void EvaluateEaseBatch(EaseCurve curve, const float* in, float* out, size_t count)
+{
+    switch (curve)
+    {
+    case EaseCurve::Linear:
+        std::copy(in, in + count, out);
+        break;
+    case EaseCurve::EaseIn:
+    case EaseCurve::QuadIn:
+        EaseBatch<ShapedCurve<PowerCurve2, ShapeIn>>(in, out, count);
+        break;
+    case EaseCurve::EaseOut:
+        EaseBatch<EaseOutCurve>(in, out, count);
+        break;
+    case EaseCurve::EaseInOut:
+    case EaseCurve::QuadInOut:
+        EaseBatch<ShapedCurve<PowerCurve2, ShapeInOut>>(in, out, count);
+        break;
+    case EaseCurve::QuadOut:
+        EaseBatch<ShapedCurve<PowerCurve2, ShapeOut>>(in, out, count);
+        break;
+    case EaseCurve::CubicIn:
+        EaseBatch<ShapedCurve<PowerCurve3, ShapeIn>>(in, out, count);
+        break;
+    case EaseCurve::CubicOut:
+        EaseBatch<ShapedCurve<PowerCurve3, ShapeOut>>(in, out, count);
+        break;
+    case EaseCurve::CubicInOut:
+        EaseBatch<ShapedCurve<PowerCurve3, ShapeInOut>>(in, out, count);
+        break;
+    case EaseCurve::QuartIn:
+        EaseBatch<ShapedCurve<PowerCurve4, ShapeIn>>(in, out, count);
+        break;
+    case EaseCurve::QuartOut:
+        EaseBatch<ShapedCurve<PowerCurve4, ShapeOut>>(in, out, count);
+        break;
+    case EaseCurve::QuartInOut:
+        EaseBatch<ShapedCurve<PowerCurve4, ShapeInOut>>(in, out, count);
+        break;
+    case EaseCurve::QuintIn:
+        EaseBatch<ShapedCurve<PowerCurve5, ShapeIn>>(in, out, count);
+        break;
+    case EaseCurve::QuintOut:
+        EaseBatch<ShapedCurve<PowerCurve5, ShapeOut>>(in, out, count);
+        break;
+    case EaseCurve::QuintInOut:
+        EaseBatch<ShapedCurve<PowerCurve5, ShapeInOut>>(in, out, count);
+        break;
+    case EaseCurve::BackIn:
+        EaseBatch<ShapedCurve<BackCurve, ShapeIn>>(in, out, count);
+        break;
+    case EaseCurve::BackOut:
+        EaseBatch<ShapedCurve<BackCurve, ShapeOut>>(in, out, count);
+        break;
+    case EaseCurve::BackInOut:
+        EaseBatch<ShapedCurve<BackInOutCurve, ShapeInOut>>(in, out, count);
+        break;
+    case EaseCurve::ExpoIn:
+    case EaseCurve::ExpoOut:
+    case EaseCurve::ExpoInOut:
+    case EaseCurve::ElasticIn:
+    case EaseCurve::ElasticOut:
+    case EaseCurve::ElasticInOut:
+    case EaseCurve::BounceIn:
+    case EaseCurve::BounceOut:
+    case EaseCurve::BounceInOut:
+    case EaseCurve::SineIn:
+    case EaseCurve::SineOut:
+    case EaseCurve::SineInOut:
+        EaseBatchScalar(curve, in, out, count);
+        break;
+    }
+}
+
+// out = start + delta * t
+void LerpBatch(const float* start, const float* delta, const float* t, float* out, size_t count)
+{
+    size_t i = 0;
+#ifdef KGE_TWEEN_BATCH_SSE
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 value = _mm_mul_ps(_mm_loadu_ps(delta + i), _mm_loadu_ps(t + i));
+        _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(start + i), value));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        out[i] = start[i] + delta[i] * t[i];
+    }
+}
+
+template <typename _Ty>
+void KeepEntries(Vector<_Ty>& values, const Vector<uint32_t>& kept)
+{
+    for (size_t i = 0; i < kept.size(); ++i)
+    {
+        if (kept[i] != i)
+            values[i] = std::move(values[kept[i]]);
+    }
+    values.erase(values.begin() + kept.size(), values.end());
+}
+
+}  // namespace
+
+TweenBatch::TweenBatch()
+    : updating_(false)
+    , size_(0)
+{
+}
+
+TweenBatch::~TweenBatch() {}
+
+TweenBatch::Handle TweenBatch::MoveBy(Actor* target, Duration duration, const Vec2& displacement, EaseCurve ease)
+{
+    return Add(target, Property::Position, ease, duration, displacement, false);
+}
+
+TweenBatch::Handle TweenBatch::MoveTo(Actor* target, Duration duration, const Point& distination, EaseCurve ease)
+{
+    return Add(target, Property::Position, ease, duration, distination, true);
+}
+
+TweenBatch::Handle TweenBatch::ScaleBy(Actor* target, Duration duration, const Vec2& scale, EaseCurve ease)
+{
+    return Add(target, Property::Scale, ease, duration, scale, false);
+}
+
+TweenBatch::Handle TweenBatch::ScaleTo(Actor* target, Duration duration, const Vec2& scale, EaseCurve ease)
+{
+    return Add(target, Property::Scale, ease, duration, scale, true);
+}
+
+TweenBatch::Handle TweenBatch::FadeTo(Actor* target, Duration duration, float opacity, EaseCurve ease)
+{
+    return Add(target, Property::Opacity, ease, duration, Vec2(opacity, 0), true);
+}
+
+TweenBatch::Handle TweenBatch::RotateBy(Actor* target, Duration duration, float rotation, EaseCurve ease)
+{
+    return Add(target, Property::Rotation, ease, duration, Vec2(rotation, 0), false);
+}
+
+TweenBatch::Handle TweenBatch::RotateTo(Actor* target, Duration duration, float rotation, EaseCurve ease)
+{
+    return Add(target, Property::Rotation, ease, duration, Vec2(rotation, 0), true);
+}
+
+bool TweenBatch::IsActive(Handle handle) const
+{
+    uint32_t index = 0;
+    Track*   track = FindTrack(handle, index);
+    return track && track->states[index] != State::Removeable;
+}
+
+void TweenBatch::SetDelay(Handle handle, Duration delay)
+{
+    uint32_t index = 0;
+    if (Track* track = FindTrack(handle, index))
+        track->delay[index] = delay.GetMilliseconds();
+}
+
+void TweenBatch::SetLoops(Handle handle, int loops)
+{
+    uint32_t index = 0;
+    if (Track* track = FindTrack(handle, index))
+        track->loops[index] = loops;
+}
+
+void TweenBatch::SetHandler(Handle handle, RefPtr<AnimationEventHandler> handler)
+{
+    uint32_t index = 0;
+    if (Track* track = FindTrack(handle, index))
+        track->handlers[index] = handler;
+}
+
+void TweenBatch::RemoveTargetWhenDone(Handle handle)
+{
+    uint32_t index = 0;
+    if (Track* track = FindTrack(handle, index))
+        track->flags[index] |= RemoveTarget;
+}
+
+void TweenBatch::Resume(Handle handle)
+{
+    uint32_t index = 0;
+    if (Track* track = FindTrack(handle, index))
+        track->flags[index] |= Running;
+}
+
+void TweenBatch::Pause(Handle handle)
+{
+    uint32_t index = 0;
+    if (Track* track = FindTrack(handle, index))
+        track->flags[index] &= ~Running;
+}
+
+void TweenBatch::Stop(Handle handle)
+{
+    uint32_t index = 0;
+    if (Track* track = FindTrack(handle, index))
+    {
+        if (track->states[index] != State::Removeable)
+            track->states[index] = State::Done;
+    }
+}
+
+void TweenBatch::StopAll(Actor* target)
+{
+    for (auto& track : tracks_)
+    {
+        for (size_t i = 0; i < track->targets.size(); ++i)
+        {
+            if (track->targets[i] == target && track->states[i] != State::Removeable)
+                track->states[i] = State::Done;
+        }
+    }
+}
+
+void TweenBatch::Clear()
+{
+    if (updating_)
+    {
+        // Called from an event handler, the arrays are compacted once the update is over
+        for (auto& track : tracks_)
+        {
+            for (uint32_t i = 0; i < track->targets.size(); ++i)
+                RemoveTween(*track, i);
+        }
+        return;
+    }
+
+    for (auto& track : tracks_)
+    {
+        for (uint32_t slot : track->slots)
+            FreeSlot(slot);
+    }
+    tracks_.clear();
+    size_ = 0;
+}
+
+void TweenBatch::Update(Stage* stage, Duration dt)
+{
+    if (size_ == 0)
+        return;
+
+    // Tracks and tweens added by event handlers start with the next update
+    updating_ = true;
+
+    const size_t track_count = tracks_.size();
+    for (size_t i = 0; i < track_count; ++i)
+    {
+        UpdateTrack(*tracks_[i], stage, dt);
+    }
+
+    updating_ = false;
+
+    for (auto& track : tracks_)
+    {
+        if (track->removed)
+            Compact(*track);
+    }
+}
+
+TweenBatch::Handle TweenBatch::Add(Actor* target, Property property, EaseCurve ease, Duration duration,
+                                   const Vec2& value, bool absolute)
+{
+    KGE_ASSERT(target && "TweenBatch failed, NULL pointer exception");
+
+    if (!target)
+        return Handle();
+
+    uint32_t track_index = 0;
+    while (track_index < tracks_.size())
+    {
+        if (tracks_[track_index]->property == property && tracks_[track_index]->ease == ease)
+            break;
+        ++track_index;
+    }
+
+    if (track_index == tracks_.size())
+    {
+        tracks_.emplace_back(new Track);
+        tracks_.back()->property = property;
+        tracks_.back()->ease     = ease;
+        tracks_.back()->removed  = 0;
+    }
+
+    uint32_t slot = 0;
+    if (!free_slots_.empty())
+    {
+        slot = free_slots_.back();
+        free_slots_.pop_back();
+    }
+    else
+    {
+        slot = uint32_t(slots_.size());
+        slots_.push_back(Slot{ 0, 0, 1 });
+    }
+
+    Track& track = *tracks_[track_index];
+
+    slots_[slot].track = track_index;
+    slots_[slot].index = uint32_t(track.targets.size());
+
+    track.targets.push_back(target);
+    track.handlers.emplace_back();
+    track.slots.push_back(slot);
+    track.states.push_back(State::NotStarted);
+    track.flags.push_back(uint8_t(absolute ? (Running | Absolute) : Running));
+    track.loops.push_back(0);
+    track.loops_done.push_back(0);
+    track.elapsed.push_back(0);
+    track.delay.push_back(0);
+    track.duration.push_back(duration.GetMilliseconds());
+    track.start_x.push_back(0);
+    track.start_y.push_back(0);
+    track.delta_x.push_back(absolute ? 0 : value.x);
+    track.delta_y.push_back(absolute ? 0 : value.y);
+    track.end_x.push_back(absolute ? value.x : 0);
+    track.end_y.push_back(absolute ? value.y : 0);
+    track.prev_x.push_back(0);
+    track.prev_y.push_back(0);
+
+    ++size_;
+    return Handle{ slot, slots_[slot].generation };
+}
+
+TweenBatch::Track* TweenBatch::FindTrack(Handle handle, uint32_t& index) const
+{
+    if (handle.slot >= slots_.size() || !handle.IsValid())
+        return nullptr;
+
+    const Slot& slot = slots_[handle.slot];
+    if (slot.generation != handle.generation)
+        return nullptr;
+
+    index = slot.index;
+    return tracks_[slot.track].get();
+}
+
+void TweenBatch::UpdateTrack(Track& track, Stage* stage, Duration dt)
+{
+    const uint32_t count = uint32_t(track.targets.size());
+    if (count == 0)
+        return;
+
+    track.progress.resize(count);
+    track.eased.resize(count);
+    track.value_x.resize(count);
+    track.value_y.resize(count);
+
+    // Advance the clocks, this mirrors Animation::UpdateStep and TweenAnimation::Update
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        track.progress[i] = -1.f;
+
+        if (track.states[i] == State::Removeable)
+            continue;
+
+        // Paused tweens are dropped too, or they would keep a detached actor alive
+        Actor* target = track.targets[i].Get();
+        if (target->GetStage() != stage)
+        {
+            RemoveTween(track, i);
+            continue;
+        }
+
+        if (!(track.flags[i] & Running))
+            continue;
+
+        track.elapsed[i] += dt.GetMilliseconds();
+
+        if (track.states[i] == State::NotStarted)
+        {
+            if (track.delay[i] == 0)
+            {
+                track.states[i] = State::Started;
+                EmitEvent(track, i, AnimationEvent::Started);
+            }
+            else
+            {
+                track.states[i] = State::Delayed;
+            }
+            InitTween(track, i);
+        }
+
+        switch (track.states[i])
+        {
+        case State::Delayed:
+            if (track.elapsed[i] >= track.delay[i])
+            {
+                track.states[i] = State::Started;
+                EmitEvent(track, i, AnimationEvent::Started);
+            }
+            break;
+
+        case State::Started:
+        {
+            float progress = 1.f;
+            if (track.duration[i] == 0)
+            {
+                CompleteLoop(track, i);
+            }
+            else
+            {
+                const float loops_done = float(track.elapsed[i] - track.delay[i]) / float(track.duration[i]);
+                while (track.states[i] != State::Removeable && track.loops_done[i] < static_cast<int>(loops_done))
+                {
+                    CompleteLoop(track, i);
+                }
+
+                if (track.states[i] != State::Done)
+                    progress = loops_done - static_cast<float>(track.loops_done[i]);
+            }
+
+            if (track.states[i] == State::Removeable)
+                break;
+
+            if (track.property == Property::Position)
+            {
+                // Keep the movement of other animations, like MoveByAnimation does
+                const Point pos = target->GetPosition();
+                track.start_x[i] += pos.x - track.prev_x[i];
+                track.start_y[i] += pos.y - track.prev_y[i];
+            }
+            track.progress[i] = progress;
+            break;
+        }
+
+        default:
+            break;
+        }
+    }
+
+    // Evaluate the whole track at once, tweens that are not written back are ignored below
+    EvaluateEaseBatch(track.ease, track.progress.data(), track.eased.data(), count);
+
+    LerpBatch(track.start_x.data(), track.delta_x.data(), track.eased.data(), track.value_x.data(), count);
+    if (track.property == Property::Position || track.property == Property::Scale)
+        LerpBatch(track.start_y.data(), track.delta_y.data(), track.eased.data(), track.value_y.data(), count);
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if (track.states[i] == State::Removeable || !(track.flags[i] & Running))
+            continue;
+
+        if (track.progress[i] >= 0)
+            WriteTween(track, i);
+
+        if (track.states[i] == State::Done)
+        {
+            RefPtr<Actor> target = track.targets[i];
+            EmitEvent(track, i, AnimationEvent::Done);
+
+            if (track.flags[i] & RemoveTarget)
+                target->RemoveFromParent();
+
+            RemoveTween(track, i);
+        }
+    }
+}
+
+void TweenBatch::InitTween(Track& track, uint32_t index)
+{
+    Actor* target = track.targets[index].Get();
+    switch (track.property)
+    {
+    case Property::Position:
+    {
+        const Point pos      = target->GetPosition();
+        track.start_x[index] = track.prev_x[index] = pos.x;
+        track.start_y[index] = track.prev_y[index] = pos.y;
+        break;
+    }
+    case Property::Scale:
+    {
+        const Point scale    = target->GetScale();
+        track.start_x[index] = scale.x;
+        track.start_y[index] = scale.y;
+        break;
+    }
+    case Property::Opacity:
+        track.start_x[index] = target->GetOpacity();
+        break;
+    case Property::Rotation:
+        track.start_x[index] = target->GetRotation();
+        break;
+    }
+
+    if (track.flags[index] & Absolute)
+    {
+        track.delta_x[index] = track.end_x[index] - track.start_x[index];
+        track.delta_y[index] = track.end_y[index] - track.start_y[index];
+    }
+}
+
+void TweenBatch::CompleteLoop(Track& track, uint32_t index)
+{
+    EmitEvent(track, index, AnimationEvent::LoopDone);
+
+    if (track.states[index] == State::Removeable)
+        return;
+
+    if (track.loops[index] >= 0 && track.loops_done[index] >= track.loops[index])
+    {
+        track.states[index] = State::Done;
+    }
+    else
+    {
+        InitTween(track, index);  // reinit when a loop is done
+    }
+
+    ++track.loops_done[index];
+}
+
+void TweenBatch::WriteTween(Track& track, uint32_t index)
+{
+    Actor* target = track.targets[index].Get();
+    switch (track.property)
+    {
+    case Property::Position:
+        target->SetPosition(track.value_x[index], track.value_y[index]);
+        track.prev_x[index] = track.value_x[index];
+        track.prev_y[index] = track.value_y[index];
+        break;
+    case Property::Scale:
+        target->SetScale(track.value_x[index], track.value_y[index]);
+        break;
+    case Property::Opacity:
+        target->SetOpacity(track.value_x[index]);
+        break;
+    case Property::Rotation:
+    {
+        float rotation = track.value_x[index];
+        if (rotation > 360.f)
+            rotation -= 360.f;
+
+        target->SetRotation(rotation);
+        break;
+    }
+    }
+}
+
+void TweenBatch::EmitEvent(Track& track, uint32_t index, AnimationEvent evt)
+{
+    // The handler may add tweens to this track, so nothing may point into its arrays
+    RefPtr<AnimationEventHandler> handler = track.handlers[index];
+    if (handler)
+    {
+        RefPtr<Actor> target = track.targets[index];
+        handler->Handle(nullptr, target.Get(), evt);
+    }
+}
+
+void TweenBatch::RemoveTween(Track& track, uint32_t index)
+{
+    if (track.states[index] != State::Removeable)
+    {
+        track.states[index] = State::Removeable;
+        ++track.removed;
+    }
+}
+
+void TweenBatch::FreeSlot(uint32_t slot)
+{
+    // Handles to the old tween never match again
+    if (++slots_[slot].generation == 0)
+        slots_[slot].generation = 1;
+    free_slots_.push_back(slot);
+}
+
+void TweenBatch::Compact(Track& track)
+{
+    Vector<uint32_t> kept;
+    kept.reserve(track.targets.size() - track.removed);
+
+    for (uint32_t i = 0; i < track.targets.size(); ++i)
+    {
+        if (track.states[i] == State::Removeable)
+        {
+            FreeSlot(track.slots[i]);
+            continue;
+        }
+
+        slots_[track.slots[i]].index = uint32_t(kept.size());
+        kept.push_back(i);
+    }
+
+    KeepEntries(track.targets, kept);
+    KeepEntries(track.handlers, kept);
+    KeepEntries(track.slots, kept);
+    KeepEntries(track.states, kept);
+    KeepEntries(track.flags, kept);
+    KeepEntries(track.loops, kept);
+    KeepEntries(track.loops_done, kept);
+    KeepEntries(track.elapsed, kept);
+    KeepEntries(track.delay, kept);
+    KeepEntries(track.duration, kept);
+    KeepEntries(track.start_x, kept);
+    KeepEntries(track.start_y, kept);
+    KeepEntries(track.delta_x, kept);
+    KeepEntries(track.delta_y, kept);
+    KeepEntries(track.end_x, kept);
+    KeepEntries(track.end_y, kept);
+    KeepEntries(track.prev_x, kept);
+    KeepEntries(track.prev_y, kept);
+
+    size_ -= track.removed;
+    track.removed = 0;
+}
+
+}  // namespace kiwano
@@ -0,0 +1,274 @@
+// Copyright (c) 2016-2019 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#pragma once
+#include <memory>
+#include <kiwano/2d/animation/Animation.h>
+#include <kiwano/2d/animation/EaseFunc.h>
+
+namespace kiwano
+{
+class Stage;
+
+/**
+ * \addtogroup Animation
+ * @{
+ */
+
+/**
+ * \~chinese
+ * @brief 
+ * @details Ϊ򵥲ƵĶϵͳ䲻󣬶ǰԺͻ߷鱣С
+ * ÿ֡ƽвʱ䣬ٶ鲹㻺ߣһдؽɫԣ
+ * 麯úͻá
+ * ʱѭ¼ TweenAnimation һ£¼յĶΪָ
+ * @note ÿ̨ӵһ䣬ͨ Stage::GetTweenBatch ȡĿɫ뿪̨ʱ䲹ᱻֱƳ¼
+ */
+class KGE_API TweenBatch : Noncopyable
+{
+public:
+    /// \~chinese
+    /// @brief 
+    /// @details Ƴ󣬾ԶʧЧ
+    struct Handle
+    {
+        uint32_t slot       = 0;
+        uint32_t generation = 0;
+
+        /// \~chinese
+        /// @brief Ƿָ
+        bool IsValid() const;
+    };
+
+    TweenBatch();
+
+    ~TweenBatch();
+
+    /// \~chinese
+    /// @brief λƲ
+    /// @param target Ŀɫ
+    /// @param duration ʱ
+    /// @param displacement λ
+    /// @param ease 
+    Handle MoveBy(Actor* target, Duration duration, const Vec2& displacement, EaseCurve ease = EaseCurve::Linear);
+
+    /// \~chinese
+    /// @brief λƲ
+    /// @param target Ŀɫ
+    /// @param duration ʱ
+    /// @param distination Ŀ
+    /// @param ease 
+    Handle MoveTo(Actor* target, Duration duration, const Point& distination, EaseCurve ease = EaseCurve::Linear);
+
+    /// \~chinese
+    /// @brief Ų
+    /// @param target Ŀɫ
+    /// @param duration ʱ
+    /// @param scale Ա仯ֵ
+    /// @param ease 
+    Handle ScaleBy(Actor* target, Duration duration, const Vec2& scale, EaseCurve ease = EaseCurve::Linear);
+
+    /// \~chinese
+    /// @brief Ų
+    /// @param target Ŀɫ
+    /// @param duration ʱ
+    /// @param scale Ŀֵ
+    /// @param ease 
+    Handle ScaleTo(Actor* target, Duration duration, const Vec2& scale, EaseCurve ease = EaseCurve::Linear);
+
+    /// \~chinese
+    /// @brief ͸Ƚ䲹
+    /// @param target Ŀɫ
+    /// @param duration ʱ
+    /// @param opacity Ŀ͸
+    /// @param ease 
+    Handle FadeTo(Actor* target, Duration duration, float opacity, EaseCurve ease = EaseCurve::Linear);
+
+    /// \~chinese
+    /// @brief ת
+    /// @param target Ŀɫ
+    /// @param duration ʱ
+    /// @param rotation ǶԱ仯ֵ
+    /// @param ease 
+    Handle RotateBy(Actor* target, Duration duration, float rotation, EaseCurve ease = EaseCurve::Linear);
+
+    /// \~chinese
+    /// @brief ת
+    /// @param target Ŀɫ
+    /// @param duration ʱ
+    /// @param rotation ĿǶ
+    /// @param ease 
+    Handle RotateTo(Actor* target, Duration duration, float rotation, EaseCurve ease = EaseCurve::Linear);
+
+    /// \~chinese
+    /// @brief Ƿ
+    bool IsActive(Handle handle) const;
+
+    /// \~chinese
+    /// @brief òʱ
+    void SetDelay(Handle handle, Duration delay);
+
+    /// \~chinese
+    /// @brief ѭ
+    /// @param loops ѭ-1 Ϊѭ
+    void SetLoops(Handle handle, int loops);
+
+    /// \~chinese
+    /// @brief ò¼
+    void SetHandler(Handle handle, RefPtr<AnimationEventHandler> handler);
+
+    /// \~chinese
+    /// @brief ʱƳĿɫ
+    void RemoveTargetWhenDone(Handle handle);
+
+    /// \~chinese
+    /// @brief 
+    void Resume(Handle handle);
+
+    /// \~chinese
+    /// @brief ͣ
+    void Pause(Handle handle);
+
+    /// \~chinese
+    /// @brief ֹͣ
+    /// @details  Animation::Stop ͬ´θʱ¼
+    void Stop(Handle handle);
+
+    /// \~chinese
+    /// @brief ֹͣĿɫв
+    void StopAll(Actor* target);
+
+    /// \~chinese
+    /// @brief Ƴв䣬¼
+    void Clear();
+
+    /// \~chinese
+    /// @brief ȡ
+    size_t GetSize() const;
+
+    /// \~chinese
+    /// @brief в
+    /// @param stage ڵ̨Ŀɫڸ̨ϵĲᱻƳ
+    /// @param dt ʱ
+    void Update(Stage* stage, Duration dt);
+
+private:
+    enum class Property : uint8_t
+    {
+        Position,
+        Scale,
+        Opacity,
+        Rotation,
+    };
+
+    enum class State : uint8_t
+    {
+        NotStarted,
+        Delayed,
+        Started,
+        Done,
+        Removeable,
+    };
+
+    enum Flag : uint8_t
+    {
+        Running      = 1,
+        Absolute     = 1 << 1,
+        RemoveTarget = 1 << 2,
+    };
+
+    struct Track
+    {
+        Property                              property;
+        EaseCurve                             ease;
+        size_t                                removed;
+        Vector<RefPtr<Actor>>                 targets;
+        Vector<RefPtr<AnimationEventHandler>> handlers;
+        Vector<uint32_t>                      slots;
+        Vector<State>                         states;
+        Vector<uint8_t>                       flags;
+        Vector<int>                           loops;
+        Vector<int>                           loops_done;
+        Vector<int64_t>                       elapsed;
+        Vector<int64_t>                       delay;
+        Vector<int64_t>                       duration;
+        Vector<float>                         start_x;
+        Vector<float>                         start_y;
+        Vector<float>                         delta_x;
+        Vector<float>                         delta_y;
+        Vector<float>                         end_x;
+        Vector<float>                         end_y;
+        Vector<float>                         prev_x;
+        Vector<float>                         prev_y;
+        Vector<float>                         progress;
+        Vector<float>                         eased;
+        Vector<float>                         value_x;
+        Vector<float>                         value_y;
+    };
+
+    struct Slot
+    {
+        uint32_t track;
+        uint32_t index;
+        uint32_t generation;
+    };
+
+    Handle Add(Actor* target, Property property, EaseCurve ease, Duration duration, const Vec2& value, bool absolute);
+
+    Track* FindTrack(Handle handle, uint32_t& index) const;
+
+    void UpdateTrack(Track& track, Stage* stage, Duration dt);
+
+    void InitTween(Track& track, uint32_t index);
+
+    void CompleteLoop(Track& track, uint32_t index);
+
+    void WriteTween(Track& track, uint32_t index);
+
+    void EmitEvent(Track& track, uint32_t index, AnimationEvent evt);
+
+    void RemoveTween(Track& track, uint32_t index);
+
+    void FreeSlot(uint32_t slot);
+
+    void Compact(Track& track);
+
+private:
+    bool                           updating_;
+    size_t                         size_;
+    Vector<std::unique_ptr<Track>> tracks_;
+    Vector<Slot>                   slots_;
+    Vector<uint32_t>               free_slots_;
+};
+
+/** @} */
+
+inline bool TweenBatch::Handle::IsValid() const
+{
+    return generation != 0;
+}
+
+inline size_t TweenBatch::GetSize() const
+{
+    return size_;
+}
+
+}  // namespace kiwano
@@ -22,6 +22,7 @@
 #include <kiwano/2d/DebugActor.h>
 #include <kiwano/2d/Stage.h>
 #include <kiwano/base/Director.h>
+#include <algorithm>
 
 namespace kiwano
 {
@@ -114,7 +115,7 @@ void Director::ShowDebugInfo(bool show)
 
 void Director::ClearStages()
 {
-    dispatcher_list_.Clear();
+    ClearEventDispatchers();
     stages_ = Stack<RefPtr<Stage>>();
 
     current_stage_.Reset();
@@ -125,12 +126,45 @@ void Director::ClearStages()
 
 void Director::PushEventDispatcher(EventDispatcher* dispatcher)
 {
-    dispatcher_list_.PushBack(dispatcher);
+    // Buckets hold indices in the update order, so merging two of them keeps that order
+    const size_t index = dispatchers_.size();
+    dispatchers_.push_back(dispatcher);
+
+    // Dispatchers with category listeners are visited by every event in their categories
+    if (dispatcher->HasWildcardListeners())
+        wildcard_dispatchers_.push_back(WildcardDispatcher{ index, 0 });
+    else if (uint64_t categories = dispatcher->GetListenedCategories())
+        wildcard_dispatchers_.push_back(WildcardDispatcher{ index, categories });
+
+    listened_types_.clear();
+    dispatcher->GetListenedTypes(listened_types_);
+    for (const auto& type : listened_types_)
+    {
+        auto iter = std::find_if(dispatcher_buckets_.begin(), dispatcher_buckets_.end(),
+                                 [&](const DispatcherBucket& bucket) { return bucket.type == type; });
+        if (iter == dispatcher_buckets_.end())
+        {
+            dispatcher_buckets_.push_back(DispatcherBucket{ type });
+            iter = dispatcher_buckets_.end() - 1;
+        }
+        iter->dispatchers.push_back(index);
+    }
+}
+
+void Director::ClearEventDispatchers()
+{
+    // Buckets are kept with their capacity, the set of event types in a game is small
+    dispatchers_.clear();
+    wildcard_dispatchers_.clear();
+    for (auto& bucket : dispatcher_buckets_)
+    {
+        bucket.dispatchers.clear();
+    }
 }
 
 void Director::OnUpdate(UpdateModuleContext& ctx)
 {
-    dispatcher_list_.Clear();
+    ClearEventDispatchers();
 
     if (transition_)
     {
@@ -187,9 +221,45 @@ void Director::OnRender(RenderModuleContext& ctx)
 
 void Director::HandleEvent(EventModuleContext& ctx)
 {
-    for (auto dispatcher : dispatcher_list_)
+    const EventType& type = ctx.evt->GetType();
+
+    const Vector<size_t>* typed = nullptr;
+    for (const auto& bucket : dispatcher_buckets_)
     {
-        dispatcher->DispatchEvent(ctx.evt);
+        if (bucket.type == type)
+        {
+            typed = &bucket.dispatchers;
+            break;
+        }
+    }
+
+    // Merge dispatchers listening to this type with the catch-all ones, sizes are checked at every
+    // step because a handler may clear the stages
+    const auto&    wildcard = wildcard_dispatchers_;
+    const uint64_t mask     = type.GetCategoryMask();
+    size_t         i = 0, j = 0;
+    while (true)
+    {
+        while (j < wildcard.size() && wildcard[j].category_mask && !(wildcard[j].category_mask & mask))
+            ++j;
+
+        const bool has_typed    = typed && i < typed->size();
+        const bool has_wildcard = j < wildcard.size();
+        if (!has_typed && !has_wildcard)
+            break;
+
+        size_t index = 0;
+        if (has_typed && (!has_wildcard || (*typed)[i] <= wildcard[j].index))
+        {
+            index = (*typed)[i++];
+            if (has_wildcard && wildcard[j].index == index)
+                ++j;
+        }
+        else
+        {
+            index = wildcard[j++].index;
+        }
+        dispatchers_[index]->DispatchEvent(ctx.evt);
     }
 }
 
@@ -92,6 +92,8 @@ public:
     /**
      * \~chinese
      * @brief ¼ַһ֡Զ
+     * @details ַ¼ͽ¼ֻ˸͵ķַ
+     * ӺŶ͵ļһ֡ʼո͵¼
      * @param dispatcher ¼ַ
      */
     void PushEventDispatcher(EventDispatcher* dispatcher);
@@ -110,7 +112,21 @@ public:
 private:
     Director();
 
+    void ClearEventDispatchers();
+
 private:
+    struct DispatcherBucket
+    {
+        EventType      type;
+        Vector<size_t> dispatchers;
+    };
+
+    struct WildcardDispatcher
+    {
+        size_t   index;
+        uint64_t category_mask;  // Zero when the dispatcher has catch-all listeners
+    };
+
     bool                 render_border_enabled_;
     Stack<RefPtr<Stage>> stages_;
     RefPtr<Stage>        current_stage_;
@@ -118,7 +134,10 @@ private:
     RefPtr<Actor>        debug_actor_;
     RefPtr<Transition>   transition_;
 
-    IntrusiveList<EventDispatcher*> dispatcher_list_;
+    Vector<EventDispatcher*>   dispatchers_;
+    Vector<WildcardDispatcher> wildcard_dispatchers_;
+    Vector<DispatcherBucket>   dispatcher_buckets_;
+    Vector<EventType>          listened_types_;
 };
 
 
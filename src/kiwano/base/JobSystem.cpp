@@ -0,0 +1,342 @@
+// Copyright (c) 2016-2019 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <kiwano/base/JobSystem.h>
+#include <kiwano/utils/Logger.h>
+
+namespace kiwano
+{
+
+namespace
+{
+
+// Queue 0 belongs to the main thread and any other thread that is not a worker
+thread_local uint32_t current_queue = 0;
+
+}  // namespace
+
+JobCounter::JobCounter()
+    : value_(0)
+{
+}
+
+JobCounter::~JobCounter()
+{
+    KGE_ASSERT(waiting_.empty() && "JobCounter destroyed while jobs are waiting on it");
+}
+
+bool JobCounter::IsDone() const
+{
+    // Taking the lock ensures the finishing worker no longer touches this counter
+    std::lock_guard<std::mutex> lock(mutex_);
+    return value_ == 0;
+}
+
+int JobCounter::GetValue() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return value_;
+}
+
+JobSystem::JobSystem()
+    : setup_(false)
+    , worker_count_(0)
+    , running_(false)
+    , pending_jobs_(0)
+    , queued_jobs_(0)
+    , next_queue_(0)
+    , queues_(new JobQueue[1])
+    , queue_count_(1)
+{
+}
+
+JobSystem::~JobSystem()
+{
+    StopWorkers();
+}
+
+void JobSystem::SetupModule()
+{
+    setup_ = true;
+    StartWorkers();
+}
+
+void JobSystem::DestroyModule()
+{
+    StopWorkers();
+    setup_ = false;
+}
+
+void JobSystem::BeforeRender(RenderModuleContext& ctx)
+{
+    // Jobs dispatched during the update must not overlap rendering
+    WaitAll();
+}
+
+void JobSystem::SetWorkerCount(uint32_t count)
+{
+    worker_count_ = count;
+    if (setup_)
+    {
+        StopWorkers();
+        StartWorkers();
+    }
+}
+
+void JobSystem::Run(JobFunc func, JobCounter* counter)
+{
+    KGE_ASSERT(func && "Run failed, the job function is empty");
+
+    ++pending_jobs_;
+    if (counter)
+    {
+        std::lock_guard<std::mutex> lock(counter->mutex_);
+        ++counter->value_;
+    }
+
+    Push(details::Job{ std::move(func), counter });
+}
+
+void JobSystem::Run(JobFunc func, JobCounter* counter, JobCounter& dependency)
+{
+    KGE_ASSERT(func && "Run failed, the job function is empty");
+
+    ++pending_jobs_;
+    if (counter)
+    {
+        std::lock_guard<std::mutex> lock(counter->mutex_);
+        ++counter->value_;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(dependency.mutex_);
+        if (dependency.value_ > 0)
+        {
+            // Pushed by whoever brings the dependency down to zero
+            dependency.waiting_.push_back(details::Job{ std::move(func), counter });
+            return;
+        }
+    }
+
+    Push(details::Job{ std::move(func), counter });
+}
+
+void JobSystem::ParallelFor(size_t count, const RangeFunc& func, size_t grain_size)
+{
+    if (count == 0)
+        return;
+
+    if (grain_size == 0)
+    {
+        // A few chunks per thread keeps the load balanced when chunks take different time
+        grain_size = std::max<size_t>(count / (queue_count_ * 4), 1);
+    }
+
+    if (grain_size >= count)
+    {
+        func(0, count);
+        return;
+    }
+
+    JobCounter counter;
+    for (size_t begin = 0; begin < count; begin += grain_size)
+    {
+        const size_t end = std::min(begin + grain_size, count);
+        Run([&func, begin, end]() { func(begin, end); }, &counter);
+    }
+    Wait(counter);
+}
+
+void JobSystem::Wait(JobCounter& counter)
+{
+    while (!counter.IsDone())
+    {
+        details::Job job;
+        if (Pop(job))
+            Execute(job);
+        else
+            std::this_thread::yield();
+    }
+}
+
+void JobSystem::WaitAll()
+{
+    while (pending_jobs_ > 0)
+    {
+        details::Job job;
+        if (Pop(job))
+            Execute(job);
+        else
+            std::this_thread::yield();
+    }
+}
+
+void JobSystem::StartWorkers()
+{
+    uint32_t count = worker_count_;
+    if (count == 0)
+    {
+        // The main thread helps while waiting, so leave one core to it
+        count = std::max(std::thread::hardware_concurrency(), 1u) - 1;
+    }
+
+    queues_.reset(new JobQueue[count + 1]);
+    queue_count_ = count + 1;
+    running_     = true;
+
+    workers_.reserve(count);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        workers_.emplace_back(&JobSystem::WorkerMain, this, i + 1);
+    }
+}
+
+void JobSystem::StopWorkers()
+{
+    WaitAll();
+
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        running_ = false;
+    }
+    sleep_cond_.notify_all();
+
+    for (auto& worker : workers_)
+    {
+        worker.join();
+    }
+    workers_.clear();
+
+    queues_.reset(new JobQueue[1]);
+    queue_count_ = 1;
+}
+
+void JobSystem::WorkerMain(uint32_t index)
+{
+    current_queue = index;
+
+    while (running_)
+    {
+        details::Job job;
+        if (Pop(job))
+        {
+            Execute(job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        sleep_cond_.wait(lock, [this]() { return !running_ || queued_jobs_ > 0; });
+    }
+}
+
+void JobSystem::Push(details::Job&& job)
+{
+    uint32_t index = current_queue;
+    if (index >= queue_count_)
+        index = next_queue_++ % queue_count_;
+
+    {
+        JobQueue&                   queue = queues_[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(std::move(job));
+        ++queued_jobs_;
+    }
+
+    {
+        // Pairs with the predicate check in WorkerMain so the wakeup cannot be lost
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+    }
+    sleep_cond_.notify_one();
+}
+
+bool JobSystem::Pop(details::Job& job)
+{
+    if (queued_jobs_ == 0)
+        return false;
+
+    const uint32_t self = current_queue < queue_count_ ? current_queue : 0;
+
+    // Newest job of our own queue first, its data is most likely still in cache
+    {
+        JobQueue&                   queue = queues_[self];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.jobs.empty())
+        {
+            job = std::move(queue.jobs.back());
+            queue.jobs.pop_back();
+            --queued_jobs_;
+            return true;
+        }
+    }
+
+    // Steal the oldest job from other queues
+    for (uint32_t i = 1; i < queue_count_; ++i)
+    {
+        JobQueue&                   queue = queues_[(self + i) % queue_count_];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.jobs.empty())
+        {
+            job = std::move(queue.jobs.front());
+            queue.jobs.pop_front();
+            --queued_jobs_;
+            return true;
+        }
+    }
+    return false;
+}
+
+void JobSystem::Execute(details::Job& job)
+{
+    try
+    {
+        job.func();
+    }
+    catch (std::exception& e)
+    {
+        KGE_ERRORF("Job failed with exception: %s", e.what());
+    }
+    catch (...)
+    {
+        KGE_ERROR("Job failed with an unknown exception");
+    }
+
+    Finish(job.counter);
+    --pending_jobs_;
+}
+
+void JobSystem::Finish(JobCounter* counter)
+{
+    if (!counter)
+        return;
+
+    Vector<details::Job> ready;
+    {
+        std::lock_guard<std::mutex> lock(counter->mutex_);
+        if (--counter->value_ == 0)
+            ready.swap(counter->waiting_);
+    }
+
+    for (auto& job : ready)
+    {
+        Push(std::move(job));
+    }
+}
+
+}  // namespace kiwano
@@ -0,0 +1,191 @@
+// Copyright (c) 2016-2019 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <kiwano/core/Common.h>
+#include <kiwano/base/Module.h>
+
+namespace kiwano
+{
+
+class JobCounter;
+
+namespace details
+{
+
+struct Job
+{
+    Function<void()> func;
+    JobCounter*      counter;
+};
+
+}  // namespace details
+
+/**
+ * \~chinese
+ * @brief ҵ
+ * @details ҵύʱһִϺһʾҵȫɡ
+ * ҲΪҵҵڼŻῪʼִ
+ * @note ڱ볤ڹҵͨ JobSystem::Wait غ
+ */
+class KGE_API JobCounter : Noncopyable
+{
+    friend class JobSystem;
+
+public:
+    JobCounter();
+
+    ~JobCounter();
+
+    /// \~chinese
+    /// @brief ҵǷȫ
+    bool IsDone() const;
+
+    /// \~chinese
+    /// @brief ȡδɵҵ
+    int GetValue() const;
+
+private:
+    int                  value_;
+    mutable std::mutex   mutex_;
+    Vector<details::Job> waiting_;
+};
+
+/**
+ * \~chinese
+ * @brief ҵϵͳģ
+ * @details ÿ߳ӵһҵУִ߳Լβҵʱͷȡҵ
+ * ߳ڵȴҵʱҲִСҵϵͳȾǰȴҵɣ˿ OnUpdate зַҵ
+ * @note ûøģʱᴴ̣߳ҵڵ Wait ִ߳
+ */
+class KGE_API JobSystem
+    : public Singleton<JobSystem>
+    , public Module
+{
+    friend Singleton<JobSystem>;
+
+public:
+    /// \~chinese
+    /// @brief ҵ
+    using JobFunc = Function<void()>;
+
+    /// \~chinese
+    /// @brief ҵ
+    /// @details Ϊҿ [begin, end)
+    using RangeFunc = Function<void(size_t /* begin */, size_t /* end */)>;
+
+    /// \~chinese
+    /// @brief ù߳
+    /// @param count ߳Ϊ 0 ʱʹ CPU һ
+    /// @details ģûȴҵɲ´߳
+    void SetWorkerCount(uint32_t count);
+
+    /// \~chinese
+    /// @brief ȡ߳
+    uint32_t GetWorkerCount() const;
+
+    /// \~chinese
+    /// @brief ύҵ
+    /// @param func ҵ
+    /// @param counter ҵΪ
+    /// @note Function ṵ̈߳ȫģҵᱻƶҵУҪ̹߳ͬһ
+    void Run(JobFunc func, JobCounter* counter = nullptr);
+
+    /// \~chinese
+    /// @brief ύҵҵ
+    /// @param func ҵ
+    /// @param counter ҵΪ
+    /// @param dependency ļҵŻῪʼִ
+    void Run(JobFunc func, JobCounter* counter, JobCounter& dependency);
+
+    /// \~chinese
+    /// @brief ִҵ
+    /// @details  [0, count) ֳɶβִУʱжִ
+    /// @param count 䳤
+    /// @param func ҵ
+    /// @param grain_size ÿεСȣΪ 0 ʱԶ
+    void ParallelFor(size_t count, const RangeFunc& func, size_t grain_size = 0);
+
+    /// \~chinese
+    /// @brief ȴ
+    /// @details ȴڼ䵱ǰִ̻߳жеҵ
+    void Wait(JobCounter& counter);
+
+    /// \~chinese
+    /// @brief ȴҵ
+    void WaitAll();
+
+public:
+    void SetupModule() override;
+
+    void DestroyModule() override;
+
+    void BeforeRender(RenderModuleContext& ctx) override;
+
+    ~JobSystem();
+
+private:
+    JobSystem();
+
+    void StartWorkers();
+
+    void StopWorkers();
+
+    void WorkerMain(uint32_t index);
+
+    void Push(details::Job&& job);
+
+    bool Pop(details::Job& job);
+
+    void Execute(details::Job& job);
+
+    void Finish(JobCounter* counter);
+
+private:
+    struct JobQueue
+    {
+        std::mutex               mutex;
+        std::deque<details::Job> jobs;
+    };
+
+    bool                        setup_;
+    uint32_t                    worker_count_;
+    std::atomic<bool>           running_;
+    std::atomic<int>            pending_jobs_;
+    std::atomic<int>            queued_jobs_;
+    std::atomic<uint32_t>       next_queue_;
+    std::unique_ptr<JobQueue[]> queues_;
+    uint32_t                    queue_count_;
+    Vector<std::thread>         workers_;
+    std::mutex                  sleep_mutex_;
+    std::condition_variable     sleep_cond_;
+};
+
+inline uint32_t JobSystem::GetWorkerCount() const
+{
+    return static_cast<uint32_t>(workers_.size());
+}
+
+}  // namespace kiwano
@@ -59,9 +59,10 @@ void* RefObject::operator new(size_t size)
     return ptr;
 }
 
-void RefObject::operator delete(void* ptr)
+void RefObject::operator delete(void* ptr, size_t size)
 {
-    memory::Free(ptr);
+    // The size of the most derived type, so pooled allocators need no block header
+    memory::Free(ptr, size);
 }
 
 void* RefObject::operator new(size_t size, std::nothrow_t const&)
@@ -81,7 +82,8 @@ void RefObject::operator delete(void* ptr, std::nothrow_t const&)
 {
     try
     {
-        memory::Free(ptr);
+        // Only called when a constructor throws, the size is unknown here
+        memory::Free(ptr, 0);
     }
     catch (...)
     {
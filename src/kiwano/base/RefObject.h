@@ -25,6 +25,8 @@
 namespace kiwano
 {
 
+class Application;
+
 /**
  * \~chinese
  * @brief ü
@@ -46,7 +48,7 @@ public:
 
     static void* operator new(size_t size);
 
-    static void operator delete(void* ptr);
+    static void operator delete(void* ptr, size_t size);
 
     static void* operator new(size_t size, std::nothrow_t const&) noexcept;
 
@@ -62,6 +64,8 @@ protected:
     RefObject();
 
 private:
+    friend class Application;
+
     std::atomic<uint32_t> ref_count_;
 };
 
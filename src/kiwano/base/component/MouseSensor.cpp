@@ -19,7 +19,8 @@
 // THE SOFTWARE.
 
 #include <kiwano/base/component/MouseSensor.h>
-#include <kiwano/2d/Actor.h>
+#include <kiwano/2d/Stage.h>
+#include <kiwano/platform/Application.h>
 
 namespace kiwano
 {
@@ -37,6 +38,9 @@ void MouseSensor::InitComponent(Actor* actor)
 
     listener_ = EventListener::Create("__KGE_MOUSE_SENSOR_LISTENER__",
                                       std::bind(&MouseSensor::HandleEvent, this, std::placeholders::_1));
+    listener_->Subscribe(KGE_EVENT(MouseMoveEvent));
+    listener_->Subscribe(KGE_EVENT(MouseDownEvent));
+    listener_->Subscribe(KGE_EVENT(MouseUpEvent));
     actor->AddListener(listener_);
 }
 
@@ -51,24 +55,27 @@ void MouseSensor::HandleEvent(Event* evt)
     Actor* target = GetBoundActor();
     if (evt->IsType<MouseMoveEvent>())
     {
-        auto mouse_evt = dynamic_cast<MouseMoveEvent*>(evt);
-        bool contains  = target->ContainsPoint(mouse_evt->pos);
+        auto   mouse_evt = static_cast<MouseMoveEvent*>(evt);
+        Stage* stage     = target->GetStage();
+
+        // Sensors on the same stage share one spatial query per mouse position
+        bool contains = stage ? stage->HitTest(target, mouse_evt->pos) : target->ContainsPoint(mouse_evt->pos);
         if (!hover_ && contains)
         {
             hover_ = true;
 
-            RefPtr<MouseHoverEvent> hover = new MouseHoverEvent;
-            hover->pos                    = mouse_evt->pos;
-            GetBoundActor()->DispatchEvent(hover.Get());
+            auto hover = Application::GetInstance().CreateFrameEvent<MouseHoverEvent>();
+            hover->pos = mouse_evt->pos;
+            GetBoundActor()->DispatchEvent(hover);
         }
         else if (hover_ && !contains)
         {
             hover_   = false;
             pressed_ = false;
 
-            RefPtr<MouseOutEvent> out = new MouseOutEvent;
-            out->pos                  = mouse_evt->pos;
-            GetBoundActor()->DispatchEvent(out.Get());
+            auto out = Application::GetInstance().CreateFrameEvent<MouseOutEvent>();
+            out->pos = mouse_evt->pos;
+            GetBoundActor()->DispatchEvent(out);
         }
     }
 
@@ -81,12 +88,12 @@ void MouseSensor::HandleEvent(Event* evt)
     {
         pressed_ = false;
 
-        auto mouse_up_evt = dynamic_cast<MouseUpEvent*>(evt);
+        auto mouse_up_evt = static_cast<MouseUpEvent*>(evt);
 
-        RefPtr<MouseClickEvent> click = new MouseClickEvent;
-        click->pos                    = mouse_up_evt->pos;
-        click->button                 = mouse_up_evt->button;
-        GetBoundActor()->DispatchEvent(click.Get());
+        auto click    = Application::GetInstance().CreateFrameEvent<MouseClickEvent>();
+        click->pos    = mouse_up_evt->pos;
+        click->button = mouse_up_evt->button;
+        GetBoundActor()->DispatchEvent(click);
     }
 }
 
@@ -22,3 +22,7 @@
 
 //---- Define to enable DirectX debug layer
 // #define KGE_ENABLE_DX_DEBUG
+
+//---- Define to use the software rasterizer by default instead of the GPU, e.g. for rendering on CI servers.
+//     Both renderers are built on Windows, Settings::renderer picks one at runtime
+// #define KGE_USE_SOFTWARE_RENDERER
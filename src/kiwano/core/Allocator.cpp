@@ -19,6 +19,10 @@
 // THE SOFTWARE.
 
 #include <kiwano/core/Allocator.h>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <unordered_set>
 
 namespace kiwano
 {
@@ -37,8 +41,9 @@ MemoryAllocator* GetGlobalAllocator()
             return ::operator new(size);
         }
 
-        virtual void Free(void* ptr) override
+        virtual void Free(void* ptr, size_t size) override
         {
+            KGE_NOT_USED(size);
             ::operator delete(ptr);
         }
     };
@@ -62,5 +67,595 @@ void SetAllocator(MemoryAllocator* allocator)
     current_allocator_ = allocator;
 }
 
+namespace
+{
+
+const size_t pool_chunk_size = 64 * 1024;
+
+const size_t arena_alignment = alignof(std::max_align_t);
+
+inline size_t AlignArenaSize(size_t size)
+{
+    return (size + arena_alignment - 1) & ~(arena_alignment - 1);
+}
+
+// Thread caches outlive the pools they refer to, so pools are identified by an id that is never reused
+struct PoolRegistry
+{
+    std::mutex                   mutex;
+    std::unordered_set<uint64_t> alive;
+    uint64_t                     next_id;
+    std::atomic<uint64_t>        destroyed;
+
+    PoolRegistry()
+        : next_id(1)
+        , destroyed(0)
+    {
+    }
+};
+
+PoolRegistry& GetPoolRegistry()
+{
+    static PoolRegistry registry;
+    return registry;
+}
+
+}  // namespace
+
+//-------------------------------------------------------
+// PoolThreadCache
+//-------------------------------------------------------
+
+class PoolThreadCache
+{
+public:
+    // A thread rarely uses more than one pool, further pools go to their shared lists directly
+    static const size_t MaxAllocators = 4;
+
+    struct Entry
+    {
+        PoolAllocator*            owner;
+        uint64_t                  id;
+        PoolAllocator::FreeBlock* heads[PoolAllocator::SizeClassCount];
+        size_t                    counts[PoolAllocator::SizeClassCount];
+    };
+
+    PoolThreadCache()
+        : entry_count_(0)
+        , destroyed_seen_(0)
+    {
+    }
+
+    ~PoolThreadCache()
+    {
+        // Held while flushing, so that no pool is destroyed in between
+        PoolRegistry&               registry = GetPoolRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        for (size_t i = 0; i < entry_count_; ++i)
+        {
+            if (registry.alive.count(entries_[i].id))
+                Flush(entries_[i]);
+        }
+    }
+
+    static PoolThreadCache& GetInstance()
+    {
+        thread_local PoolThreadCache cache;
+        return cache;
+    }
+
+    Entry* GetEntry(PoolAllocator* owner)
+    {
+        for (size_t i = 0; i < entry_count_; ++i)
+        {
+            if (entries_[i].owner == owner)
+            {
+                // A new pool at the address of a destroyed one, the cached blocks were freed with it
+                if (entries_[i].id != owner->id_)
+                    ResetEntry(entries_[i], owner);
+                return &entries_[i];
+            }
+        }
+
+        if (entry_count_ == MaxAllocators)
+        {
+            RemoveDestroyedEntries();
+            if (entry_count_ == MaxAllocators)
+                return nullptr;
+        }
+
+        Entry& entry = entries_[entry_count_++];
+        ResetEntry(entry, owner);
+        return &entry;
+    }
+
+    void RemoveEntry(PoolAllocator* owner)
+    {
+        for (size_t i = 0; i < entry_count_; ++i)
+        {
+            if (entries_[i].owner == owner)
+            {
+                entries_[i] = entries_[--entry_count_];
+                return;
+            }
+        }
+    }
+
+    static void* Pop(Entry& entry, size_t size_class)
+    {
+        PoolAllocator::FreeBlock* block = entry.heads[size_class];
+        if (!block)
+        {
+            size_t count = PoolAllocator::GetBatchSize(size_class);
+
+            block = entry.owner->Fetch(size_class, count);
+            if (!block)
+                return nullptr;
+
+            entry.counts[size_class] = count;
+        }
+
+        entry.heads[size_class] = block->next;
+        --entry.counts[size_class];
+        return block;
+    }
+
+    static void Push(Entry& entry, size_t size_class, PoolAllocator::FreeBlock* block)
+    {
+        block->next             = entry.heads[size_class];
+        entry.heads[size_class] = block;
+
+        const size_t batch = PoolAllocator::GetBatchSize(size_class);
+        if (++entry.counts[size_class] >= batch * 2)
+        {
+            // Give a batch back so that blocks freed on this thread can be reused by others
+            PoolAllocator::FreeBlock* first = entry.heads[size_class];
+            PoolAllocator::FreeBlock* last  = first;
+            for (size_t i = 1; i < batch; ++i)
+                last = last->next;
+
+            entry.heads[size_class] = last->next;
+            entry.counts[size_class] -= batch;
+            entry.owner->Return(size_class, first, last, batch);
+        }
+    }
+
+private:
+    static void ResetEntry(Entry& entry, PoolAllocator* owner)
+    {
+        entry.owner = owner;
+        entry.id    = owner->id_;
+        std::fill(std::begin(entry.heads), std::end(entry.heads), nullptr);
+        std::fill(std::begin(entry.counts), std::end(entry.counts), 0);
+    }
+
+    void RemoveDestroyedEntries()
+    {
+        PoolRegistry& registry  = GetPoolRegistry();
+        uint64_t      destroyed = registry.destroyed.load(std::memory_order_acquire);
+        if (destroyed == destroyed_seen_)
+            return;
+
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (size_t i = 0; i < entry_count_;)
+        {
+            if (!registry.alive.count(entries_[i].id))
+                entries_[i] = entries_[--entry_count_];
+            else
+                ++i;
+        }
+        destroyed_seen_ = destroyed;
+    }
+
+    static void Flush(Entry& entry)
+    {
+        for (size_t size_class = 0; size_class < PoolAllocator::SizeClassCount; ++size_class)
+        {
+            PoolAllocator::FreeBlock* first = entry.heads[size_class];
+            if (!first)
+                continue;
+
+            PoolAllocator::FreeBlock* last = first;
+            while (last->next)
+                last = last->next;
+
+            entry.owner->Return(size_class, first, last, entry.counts[size_class]);
+            entry.heads[size_class]  = nullptr;
+            entry.counts[size_class] = 0;
+        }
+    }
+
+private:
+    size_t   entry_count_;
+    uint64_t destroyed_seen_;
+    Entry    entries_[MaxAllocators];
+};
+
+//-------------------------------------------------------
+// PoolAllocator
+//-------------------------------------------------------
+
+PoolAllocator::PoolAllocator(MemoryAllocator* upstream)
+    : upstream_(upstream ? upstream : GetGlobalAllocator())
+{
+    for (auto& central : central_)
+    {
+        central.head  = nullptr;
+        central.count = 0;
+    }
+
+    PoolRegistry&               registry = GetPoolRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    id_ = registry.next_id++;
+    registry.alive.insert(id_);
+}
+
+PoolAllocator::~PoolAllocator()
+{
+    // Caches of other threads drop their entries for this pool once they see it is gone
+    {
+        PoolRegistry&               registry = GetPoolRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.alive.erase(id_);
+        registry.destroyed.fetch_add(1, std::memory_order_release);
+    }
+
+    // Blocks cached by the current thread belong to the chunks released below
+    PoolThreadCache::GetInstance().RemoveEntry(this);
+
+    for (const auto& chunk : chunks_)
+    {
+        upstream_->Free(chunk.data, pool_chunk_size);
+    }
+}
+
+void* PoolAllocator::Alloc(size_t size)
+{
+    if (size > MaxPooledSize)
+        return upstream_->Alloc(size);
+
+    const size_t size_class = GetSizeClass(size);
+
+    PoolThreadCache::Entry* entry = PoolThreadCache::GetInstance().GetEntry(this);
+    if (entry)
+        return PoolThreadCache::Pop(*entry, size_class);
+
+    size_t count = 1;
+    return Fetch(size_class, count);
+}
+
+void PoolAllocator::Free(void* ptr, size_t size)
+{
+    if (!ptr)
+        return;
+
+    size_t size_class = 0;
+    if (size == 0)
+    {
+        // Only happens when a constructor throws, find out where the block came from
+        if (!FindSizeClass(ptr, size_class))
+        {
+            upstream_->Free(ptr, size);
+            return;
+        }
+    }
+    else if (size > MaxPooledSize)
+    {
+        upstream_->Free(ptr, size);
+        return;
+    }
+    else
+    {
+        size_class = GetSizeClass(size);
+    }
+
+    FreeBlock* block = static_cast<FreeBlock*>(ptr);
+
+    PoolThreadCache::Entry* entry = PoolThreadCache::GetInstance().GetEntry(this);
+    if (entry)
+    {
+        PoolThreadCache::Push(*entry, size_class, block);
+    }
+    else
+    {
+        block->next = nullptr;
+        Return(size_class, block, block, 1);
+    }
+}
+
+PoolAllocator::FreeBlock* PoolAllocator::Fetch(size_t size_class, size_t& count)
+{
+    CentralList& central = central_[size_class];
+
+    std::lock_guard<std::mutex> lock(central.mutex);
+    if (!central.head)
+    {
+        AllocChunk(size_class);
+        if (!central.head)
+            return nullptr;
+    }
+
+    FreeBlock* first = central.head;
+    FreeBlock* last  = first;
+    size_t     taken = 1;
+    while (taken < count && last->next)
+    {
+        last = last->next;
+        ++taken;
+    }
+
+    central.head = last->next;
+    central.count -= taken;
+    last->next = nullptr;
+
+    count = taken;
+    return first;
+}
+
+void PoolAllocator::Return(size_t size_class, FreeBlock* first, FreeBlock* last, size_t count)
+{
+    CentralList& central = central_[size_class];
+
+    std::lock_guard<std::mutex> lock(central.mutex);
+    last->next   = central.head;
+    central.head = first;
+    central.count += count;
+}
+
+void PoolAllocator::AllocChunk(size_t size_class)
+{
+    char* data = static_cast<char*>(upstream_->Alloc(pool_chunk_size));
+    if (!data)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(chunk_mutex_);
+        chunks_.push_back(Chunk{ data, size_class });
+    }
+
+    // Link the blocks in address order
+    CentralList& central    = central_[size_class];
+    const size_t block_size = GetClassSize(size_class);
+    const size_t count      = pool_chunk_size / block_size;
+    for (size_t i = count; i > 0; --i)
+    {
+        FreeBlock* block = reinterpret_cast<FreeBlock*>(data + (i - 1) * block_size);
+        block->next      = central.head;
+        central.head     = block;
+    }
+    central.count += count;
+}
+
+bool PoolAllocator::FindSizeClass(void* ptr, size_t& size_class)
+{
+    std::lock_guard<std::mutex> lock(chunk_mutex_);
+    for (const auto& chunk : chunks_)
+    {
+        if (ptr >= chunk.data && ptr < chunk.data + pool_chunk_size)
+        {
+            size_class = chunk.size_class;
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t PoolAllocator::GetSizeClass(size_t size)
+{
+    // 16-byte steps up to 256 bytes, then 64-byte steps up to 1024 bytes
+    size = std::max<size_t>(size, 1);
+    if (size <= 256)
+        return (size + 15) / 16 - 1;
+    return 16 + (size - 256 + 63) / 64 - 1;
+}
+
+size_t PoolAllocator::GetClassSize(size_t size_class)
+{
+    if (size_class < 16)
+        return (size_class + 1) * 16;
+    return 256 + (size_class - 15) * 64;
+}
+
+size_t PoolAllocator::GetBatchSize(size_t size_class)
+{
+    return std::min<size_t>(std::max<size_t>(8192 / GetClassSize(size_class), 4), 64);
+}
+
+//-------------------------------------------------------
+// ArenaAllocator
+//-------------------------------------------------------
+
+ArenaAllocator::ArenaAllocator(size_t block_size, MemoryAllocator* upstream)
+    : upstream_(upstream ? upstream : GetGlobalAllocator())
+    , block_size_(AlignArenaSize(block_size))
+    , current_block_(0)
+    , offset_(0)
+    , used_bytes_(0)
+    , reserved_bytes_(0)
+{
+    KGE_ASSERT(block_size > 0);
+}
+
+ArenaAllocator::~ArenaAllocator()
+{
+    Reset();
+
+    for (const auto& block : blocks_)
+    {
+        upstream_->Free(block.data, block.size);
+    }
+}
+
+void* ArenaAllocator::Alloc(size_t size)
+{
+    size = AlignArenaSize(std::max<size_t>(size, 1));
+
+    if (size > block_size_)
+    {
+        char* data = static_cast<char*>(upstream_->Alloc(size));
+        if (!data)
+            return nullptr;
+
+        large_blocks_.push_back(Block{ data, size });
+        reserved_bytes_ += size;
+        used_bytes_ += size;
+        return data;
+    }
+
+    while (current_block_ < blocks_.size() && offset_ + size > blocks_[current_block_].size)
+    {
+        ++current_block_;
+        offset_ = 0;
+    }
+
+    if (current_block_ == blocks_.size())
+    {
+        char* data = static_cast<char*>(upstream_->Alloc(block_size_));
+        if (!data)
+            return nullptr;
+
+        blocks_.push_back(Block{ data, block_size_ });
+        reserved_bytes_ += block_size_;
+    }
+
+    char* ptr = blocks_[current_block_].data + offset_;
+    offset_ += size;
+    used_bytes_ += size;
+    return ptr;
+}
+
+void ArenaAllocator::Free(void* ptr, size_t size)
+{
+    if (!ptr || size == 0 || current_block_ >= blocks_.size())
+        return;
+
+    // Only the latest allocation can be given back, everything else waits for Reset
+    size = AlignArenaSize(size);
+    if (offset_ >= size && blocks_[current_block_].data + offset_ - size == ptr)
+    {
+        offset_ -= size;
+        used_bytes_ -= size;
+    }
+}
+
+void ArenaAllocator::Reset()
+{
+    for (const auto& block : large_blocks_)
+    {
+        upstream_->Free(block.data, block.size);
+        reserved_bytes_ -= block.size;
+    }
+    large_blocks_.clear();
+
+    current_block_ = 0;
+    offset_        = 0;
+    used_bytes_    = 0;
+}
+
+bool ArenaAllocator::Detach(void* ptr)
+{
+    auto contains = [ptr](const Block& block) {
+        return static_cast<char*>(ptr) >= block.data && static_cast<char*>(ptr) < block.data + block.size;
+    };
+
+    auto iter = std::find_if(large_blocks_.begin(), large_blocks_.end(), contains);
+    if (iter != large_blocks_.end())
+    {
+        reserved_bytes_ -= iter->size;
+        large_blocks_.erase(iter);
+        return true;
+    }
+
+    iter = std::find_if(blocks_.begin(), blocks_.end(), contains);
+    if (iter == blocks_.end())
+        return false;
+
+    // Later allocations move on to the next block, the detached one is never handed out again
+    const size_t index = size_t(iter - blocks_.begin());
+    if (index < current_block_)
+    {
+        --current_block_;
+    }
+    else if (index == current_block_)
+    {
+        offset_ = 0;
+    }
+    reserved_bytes_ -= iter->size;
+    blocks_.erase(iter);
+    return true;
+}
+
+//-------------------------------------------------------
+// DebugAllocator
+//-------------------------------------------------------
+
+DebugAllocator::DebugAllocator(MemoryAllocator* upstream)
+    : upstream_(upstream ? upstream : GetGlobalAllocator())
+    , stats_()
+{
+}
+
+void* DebugAllocator::Alloc(size_t size)
+{
+    void* ptr = upstream_->Alloc(size);
+    if (!ptr)
+        return nullptr;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    live_[ptr] = size;
+
+    ++stats_.alloc_count;
+    stats_.total_bytes += size;
+    stats_.current_bytes += size;
+    stats_.peak_bytes = std::max(stats_.peak_bytes, stats_.current_bytes);
+    return ptr;
+}
+
+void DebugAllocator::Free(void* ptr, size_t size)
+{
+    if (!ptr)
+        return;
+
+    size_t alloc_size = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto iter = live_.find(ptr);
+        if (iter == live_.end())
+        {
+            ++stats_.invalid_frees;
+            KGE_ASSERT(false && "Freeing a pointer that is not allocated or has been freed");
+            return;
+        }
+
+        alloc_size = iter->second;
+        if (size != 0 && size != alloc_size)
+        {
+            ++stats_.invalid_frees;
+            KGE_ASSERT(false && "Freeing a pointer with a different size from the allocation");
+        }
+
+        live_.erase(iter);
+        ++stats_.free_count;
+        stats_.current_bytes -= alloc_size;
+    }
+
+    // Pass the recorded size, the upstream allocator may rely on it
+    upstream_->Free(ptr, alloc_size);
+}
+
+AllocatorStats DebugAllocator::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+size_t DebugAllocator::GetLiveAllocationCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return live_.size();
+}
+
 }  // namespace memory
 }  // namespace kiwano
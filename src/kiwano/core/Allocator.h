@@ -22,6 +22,9 @@
 #include <utility>  // std::forward
 #include <limits>   // std::numeric_limits
 #include <memory>   // std::addressof
+#include <mutex>
+#include <vector>
+#include <unordered_map>
 #include <kiwano/macros.h>
 
 namespace kiwano
@@ -34,21 +37,31 @@ namespace memory
 class KGE_API MemoryAllocator
 {
 public:
+    virtual ~MemoryAllocator() {}
+
     /// \~chinese
     /// @brief ڴ
     virtual void* Alloc(size_t size) = 0;
 
     /// \~chinese
     /// @brief ͷڴ
-    virtual void Free(void* ptr) = 0;
+    /// @param ptr ڴָ
+    /// @param size ʱڴСΪ 0 ʱʾСδ֪
+    virtual void Free(void* ptr, size_t size) = 0;
 };
 
+/// \~chinese
+/// @brief ȡȫڴ
+/// @details ȫڴֱʹ ::operator new  ::operator delete
+MemoryAllocator* GetGlobalAllocator();
+
 /// \~chinese
 /// @brief ȡǰڴ
 MemoryAllocator* GetAllocator();
 
 /// \~chinese
 /// @brief õǰڴ
+/// @note ʱķͷţҪڴκζ֮ǰ
 void SetAllocator(MemoryAllocator* allocator);
 
 /// \~chinese
@@ -60,9 +73,206 @@ inline void* Alloc(size_t size)
 
 /// \~chinese
 /// @brief ʹõǰڴͷڴ
-inline void Free(void* ptr)
+/// @param ptr ڴָ
+/// @param size ʱڴСΪ 0 ʱʾСδ֪
+inline void Free(void* ptr, size_t size)
+{
+    memory::GetAllocator()->Free(ptr, size);
+}
+
+/// \~chinese
+/// @brief ڴͳ
+struct AllocatorStats
+{
+    size_t alloc_count;    ///< 
+    size_t free_count;     ///< ͷŴ
+    size_t invalid_frees;  ///< ЧͷŴظͷŻСƥ
+    size_t current_bytes;  ///< ǰռõֽ
+    size_t peak_bytes;     ///< ռֽķֵ
+    size_t total_bytes;    ///< ۼֽ
+};
+
+/**
+ * \~chinese
+ * @brief ڴط
+ * @details  MaxPooledSize ֽڵ밴Сּÿһάһڴη 64KB
+ * 롣ÿ̻߳һֿڴ飬󲿷ͷŲҪֱתη
+ * @note ڴڷǰ黹ηʱ̲߳ʹЩ̻߳ڴ֮
+ */
+class KGE_API PoolAllocator : public MemoryAllocator
+{
+public:
+    /// \~chinese
+    /// @brief ڴعС
+    static const size_t MaxPooledSize = 1024;
+
+    /// \~chinese
+    /// @brief ڴط
+    /// @param upstream ηΪʱʹȫڴ
+    PoolAllocator(MemoryAllocator* upstream = nullptr);
+
+    virtual ~PoolAllocator();
+
+    void* Alloc(size_t size) override;
+
+    void Free(void* ptr, size_t size) override;
+
+    PoolAllocator(const PoolAllocator&) = delete;
+
+    PoolAllocator& operator=(const PoolAllocator&) = delete;
+
+private:
+    friend class PoolThreadCache;
+
+    static const size_t SizeClassCount = 28;
+
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    struct CentralList
+    {
+        std::mutex mutex;
+        FreeBlock* head;
+        size_t     count;
+    };
+
+    struct Chunk
+    {
+        char*  data;
+        size_t size_class;
+    };
+
+    FreeBlock* Fetch(size_t size_class, size_t& count);
+
+    void Return(size_t size_class, FreeBlock* first, FreeBlock* last, size_t count);
+
+    void AllocChunk(size_t size_class);
+
+    bool FindSizeClass(void* ptr, size_t& size_class);
+
+    static size_t GetSizeClass(size_t size);
+
+    static size_t GetClassSize(size_t size_class);
+
+    static size_t GetBatchSize(size_t size_class);
+
+private:
+    uint64_t           id_;
+    MemoryAllocator*   upstream_;
+    CentralList        central_[SizeClassCount];
+    std::mutex         chunk_mutex_;
+    std::vector<Chunk> chunks_;
+};
+
+/**
+ * \~chinese
+ * @brief Է
+ * @details ڴ˳ڴ棬ͷŲֻܻһ룬 Reset һԻڴ档
+ * ڲһ֡ʱ
+ * @note Է̰߳ȫ
+ */
+class KGE_API ArenaAllocator : public MemoryAllocator
+{
+public:
+    /// \~chinese
+    /// @brief Է
+    /// @param block_size ڴС
+    /// @param upstream ηΪʱʹȫڴ
+    ArenaAllocator(size_t block_size = 64 * 1024, MemoryAllocator* upstream = nullptr);
+
+    virtual ~ArenaAllocator();
+
+    void* Alloc(size_t size) override;
+
+    void Free(void* ptr, size_t size) override;
+
+    /// \~chinese
+    /// @brief ڴ
+    /// @details ͨڴ鱣Ա㸴ãڴСռõڴ黹η
+    void Reset();
+
+    /// \~chinese
+    /// @brief ָڵڴ
+    /// @details ڴӷƳٸãҲ黹ηеĶԼ
+    /// @param ptr ɸ÷ָ
+    /// @return ҵָڵڴʱ true
+    bool Detach(void* ptr);
+
+    /// \~chinese
+    /// @brief ȡѷֽ
+    size_t GetUsedBytes() const;
+
+    /// \~chinese
+    /// @brief ȡѴηֽ
+    size_t GetReservedBytes() const;
+
+    ArenaAllocator(const ArenaAllocator&) = delete;
+
+    ArenaAllocator& operator=(const ArenaAllocator&) = delete;
+
+private:
+    struct Block
+    {
+        char*  data;
+        size_t size;
+    };
+
+    MemoryAllocator*   upstream_;
+    size_t             block_size_;
+    size_t             current_block_;
+    size_t             offset_;
+    size_t             used_bytes_;
+    size_t             reserved_bytes_;
+    std::vector<Block> blocks_;
+    std::vector<Block> large_blocks_;
+};
+
+/**
+ * \~chinese
+ * @brief Է
+ * @details תηͬʱͳڴظͷšͷδָ֪ͷŴСƥȴ
+ */
+class KGE_API DebugAllocator : public MemoryAllocator
+{
+public:
+    /// \~chinese
+    /// @brief Է
+    /// @param upstream ηΪʱʹȫڴ
+    DebugAllocator(MemoryAllocator* upstream = nullptr);
+
+    void* Alloc(size_t size) override;
+
+    void Free(void* ptr, size_t size) override;
+
+    /// \~chinese
+    /// @brief ȡڴͳ
+    AllocatorStats GetStats() const;
+
+    /// \~chinese
+    /// @brief ȡδͷŵ
+    size_t GetLiveAllocationCount() const;
+
+    DebugAllocator(const DebugAllocator&) = delete;
+
+    DebugAllocator& operator=(const DebugAllocator&) = delete;
+
+private:
+    MemoryAllocator*                  upstream_;
+    mutable std::mutex                mutex_;
+    AllocatorStats                    stats_;
+    std::unordered_map<void*, size_t> live_;
+};
+
+inline size_t ArenaAllocator::GetUsedBytes() const
+{
+    return used_bytes_;
+}
+
+inline size_t ArenaAllocator::GetReservedBytes() const
 {
-    memory::GetAllocator()->Free(ptr);
+    return reserved_bytes_;
 }
 
 }  // namespace memory
@@ -113,7 +323,7 @@ public:
 
     inline void deallocate(void* ptr, size_t count)
     {
-        memory::Free(ptr /*, sizeof(_Ty) * count */);
+        memory::Free(ptr, sizeof(_Ty) * count);
     }
 
     template <typename _UTy, typename... _Args>
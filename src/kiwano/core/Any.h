@@ -133,7 +133,7 @@ public:
         static_assert(!std::is_void<_Ty>::value, "oc::Any cannot contain void");
 
         const std::type_info* const info = GetTypeinfo();
-        if (info && (*info == typeid(std::decay<_Ty>::type)))
+        if (info && (*info == typeid(typename std::decay<_Ty>::type)))
         {
             if (HasSmallType())
             {
@@ -21,7 +21,9 @@
 #pragma once
 #include <type_traits>
 #include <iterator>
+#include <memory>
 #include <stdexcept>
+#include <vector>
 #include <kiwano/macros.h>
 
 namespace kiwano
@@ -33,21 +35,101 @@ template <typename _PtrTy>
 class IntrusiveList
 {
 public:
-    using value_type = typename std::pointer_traits<_PtrTy>::pointer;
-    using pointer    = value_type*;
-    using reference  = value_type&;
+    using value_type   = typename std::pointer_traits<_PtrTy>::pointer;
+    using element_type = typename std::pointer_traits<_PtrTy>::element_type;
+    using pointer      = value_type*;
+    using reference    = value_type&;
 
     IntrusiveList()
         : first_()
         , last_()
+        , traversal_depth_(0)
     {
     }
 
     ~IntrusiveList()
     {
+        KGE_ASSERT(traversal_depth_ == 0 && "IntrusiveList destroyed while being traversed");
         Clear();
     }
 
+    /// \~chinese
+    /// @brief 
+    /// @details ڼƳĶӳٵ㱣ʱͷţ
+    /// ˿ʹ GetFirstPtrGetNextPtr ָӿڱΪÿԪü
+    /// бƳԪصǰָᱻգʱǰ
+    class TraversalGuard
+    {
+    public:
+        explicit TraversalGuard(IntrusiveList& list)
+            : list_(list)
+        {
+            ++list_.traversal_depth_;
+        }
+
+        ~TraversalGuard()
+        {
+            if (--list_.traversal_depth_ == 0 && !list_.deferred_.empty())
+            {
+                // Releasing may destroy objects that modify this list, so swap the storage out first
+                std::vector<value_type> deferred;
+                deferred.swap(list_.deferred_);
+            }
+        }
+
+        TraversalGuard(const TraversalGuard&) = delete;
+
+        TraversalGuard& operator=(const TraversalGuard&) = delete;
+
+    private:
+        IntrusiveList& list_;
+    };
+
+    /// \~chinese
+    /// @brief ȡԪصָ
+    element_type* GetFirstPtr() const
+    {
+        return ToRawPtr(first_);
+    }
+
+    /// \~chinese
+    /// @brief ȡβԪصָ
+    element_type* GetLastPtr() const
+    {
+        return ToRawPtr(last_);
+    }
+
+    /// \~chinese
+    /// @brief ȡһԪصָ
+    static element_type* GetNextPtr(const element_type* child)
+    {
+        return ToRawPtr(child->GetNext());
+    }
+
+    /// \~chinese
+    /// @brief ȡǰһԪصָ
+    static element_type* GetPrevPtr(const element_type* child)
+    {
+        return ToRawPtr(child->GetPrev());
+    }
+
+    /// \~chinese
+    /// @brief ʹָ
+    /// @details صп԰ȫƳԪأǰԪ
+    /// @param func صΪԪصָ
+    template <typename _Func>
+    void ForEach(_Func&& func)
+    {
+        TraversalGuard guard(*this);
+
+        element_type* next = nullptr;
+        for (element_type* child = GetFirstPtr(); child; child = next)
+        {
+            next = GetNextPtr(child);
+            func(child);
+        }
+    }
+
     /// \~chinese
     /// @brief ȡԪ
     const value_type& GetFirst() const
@@ -173,6 +255,12 @@ public:
     /// @brief Ƴ
     void Remove(reference child)
     {
+        if (traversal_depth_)
+        {
+            // Keep the object alive until the traversal ends
+            deferred_.push_back(child);
+        }
+
         if (child->GetNext())
         {
             child->GetNext()->GetPrev() = child->GetPrev();
@@ -206,6 +294,9 @@ public:
             p              = p->GetNext();
             if (tmp)
             {
+                if (traversal_depth_)
+                    deferred_.push_back(tmp);
+
                 tmp->GetNext() = nullptr;
                 tmp->GetPrev() = nullptr;
             }
@@ -423,8 +514,16 @@ public:
     }
 
 private:
-    value_type first_;
-    value_type last_;
+    static element_type* ToRawPtr(const value_type& ptr)
+    {
+        return ptr ? const_cast<element_type*>(std::addressof(*ptr)) : nullptr;
+    }
+
+private:
+    value_type              first_;
+    value_type              last_;
+    uint32_t                traversal_depth_;
+    std::vector<value_type> deferred_;
 };
 
 /// \~chinese
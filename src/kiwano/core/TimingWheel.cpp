@@ -0,0 +1,260 @@
+// Copyright (c) 2016-2019 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <kiwano/core/TimingWheel.h>
+#include <algorithm>
+#include <limits>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace kiwano
+{
+
+namespace
+{
+
+inline int CountTrailingZeros(uint64_t value)
+{
+#if defined(_MSC_VER)
+    unsigned long index = 0;
+    if (_BitScanForward(&index, static_cast<unsigned long>(value)))
+        return int(index);
+    _BitScanForward(&index, static_cast<unsigned long>(value >> 32));
+    return int(index) + 32;
+#else
+    return __builtin_ctzll(value);
+#endif
+}
+
+}  // namespace
+
+TimingWheelNode::TimingWheelNode()
+    : wheel_(nullptr)
+    , next_(nullptr)
+    , pprev_(nullptr)
+    , expires_(0)
+{
+}
+
+TimingWheelNode::~TimingWheelNode()
+{
+    Unlink();
+}
+
+void TimingWheelNode::Unlink()
+{
+    if (!wheel_)
+        return;
+
+    *pprev_ = next_;
+    if (next_)
+        next_->pprev_ = pprev_;
+
+    --wheel_->size_;
+    wheel_ = nullptr;
+    next_  = nullptr;
+    pprev_ = nullptr;
+}
+
+TimingWheel::TimingWheel()
+    : current_(0)
+    , size_(0)
+    , occupied_()
+{
+}
+
+TimingWheel::~TimingWheel()
+{
+    Clear();
+}
+
+void TimingWheel::Schedule(TimingWheelNode* node, int64_t expires)
+{
+    KGE_ASSERT(node);
+
+    node->Unlink();
+    node->expires_ = expires;
+
+    if (!slots_)
+    {
+        // Most schedulers never get a task, so the slots are allocated on demand
+        slots_.reset(new TimingWheelNode*[LevelCount * SlotCount + 1]());
+    }
+
+    Insert(node);
+    node->wheel_ = this;
+    ++size_;
+}
+
+void TimingWheel::Cancel(TimingWheelNode* node)
+{
+    KGE_ASSERT(node && (!node->wheel_ || node->wheel_ == this));
+    node->Unlink();
+}
+
+void TimingWheel::Advance(int64_t now, Vector<TimingWheelNode*>& expired)
+{
+    if (size_ == 0)
+    {
+        current_ = std::max(current_, now);
+        return;
+    }
+
+    // Nodes that were already due when they were scheduled
+    TimingWheelNode*& due = slots_[LevelCount * SlotCount];
+    Collect(due, expired);
+
+    while (current_ < now)
+    {
+        // Jump to the next tick that has a due slot or an upper slot to cascade, the ticks in between have no work
+        int64_t next = now;
+        for (int level = 0; level < LevelCount; ++level)
+        {
+            next = std::min(next, GetNextTime(level));
+        }
+        current_ = next;
+
+        // Move the nodes of the next upper slot down whenever a lower level wraps around
+        for (int level = 1; level < LevelCount; ++level)
+        {
+            if ((current_ & ((int64_t(1) << (level * SlotBits)) - 1)) != 0)
+                break;
+            Cascade(level);
+        }
+
+        // Cascading may drop nodes that expire right now into the due list
+        Collect(due, expired);
+
+        TimingWheelNode*& head = slots_[current_ & (SlotCount - 1)];
+        while (head)
+        {
+            TimingWheelNode* node = head;
+            if (node->expires_ <= current_)
+            {
+                node->Unlink();
+                expired.push_back(node);
+            }
+            else
+            {
+                // Clamped into the top level earlier, put it where it belongs now
+                node->Unlink();
+                Schedule(node, node->expires_);
+            }
+        }
+    }
+}
+
+void TimingWheel::Clear()
+{
+    if (!slots_)
+        return;
+
+    for (int i = 0; i < LevelCount * SlotCount + 1; ++i)
+    {
+        while (slots_[i])
+            slots_[i]->Unlink();
+    }
+    std::fill(occupied_, occupied_ + LevelCount, 0);
+}
+
+void TimingWheel::Insert(TimingWheelNode* node)
+{
+    int64_t delta = node->expires_ - current_;
+    if (delta < 1)
+    {
+        // Already due, goes out with the next advance even if the time does not move
+        TimingWheelNode*& due = slots_[LevelCount * SlotCount];
+        Link(node, due);
+        return;
+    }
+
+    // Nodes too far away are clamped into the top level
+    const int64_t max_delta = (int64_t(1) << (LevelCount * SlotBits)) - 1;
+    if (delta > max_delta)
+        delta = max_delta;
+
+    const int64_t expires = current_ + delta;
+
+    int level = 0;
+    while (level < LevelCount - 1 && delta >= (int64_t(1) << ((level + 1) * SlotBits)))
+        ++level;
+
+    const int64_t index = (expires >> (level * SlotBits)) & (SlotCount - 1);
+    Link(node, slots_[level * SlotCount + index]);
+    occupied_[level] |= uint64_t(1) << index;
+}
+
+void TimingWheel::Link(TimingWheelNode* node, TimingWheelNode*& head)
+{
+    node->next_  = head;
+    node->pprev_ = &head;
+    if (head)
+        head->pprev_ = &node->next_;
+    head = node;
+}
+
+void TimingWheel::Collect(TimingWheelNode*& head, Vector<TimingWheelNode*>& expired)
+{
+    while (head)
+    {
+        TimingWheelNode* node = head;
+        node->Unlink();
+        expired.push_back(node);
+    }
+}
+
+int64_t TimingWheel::GetNextTime(int level)
+{
+    // Slots of a level are reached one every 64^level ticks, the next one to reach is the slot after the current
+    const int     shift = level * SlotBits;
+    const int64_t first = (current_ >> shift) + 1;
+
+    uint64_t& occupied = occupied_[level];
+    while (occupied)
+    {
+        const int      offset  = int(first & (SlotCount - 1));
+        const uint64_t rotated = offset ? (occupied >> offset) | (occupied << (SlotCount - offset)) : occupied;
+        const int      step    = CountTrailingZeros(rotated);
+        const int      index   = (offset + step) & (SlotCount - 1);
+        if (slots_[level * SlotCount + index])
+            return (first + step) << shift;
+
+        // Emptied by cancelled nodes, the bit is only cleared lazily
+        occupied &= ~(uint64_t(1) << index);
+    }
+    return std::numeric_limits<int64_t>::max();
+}
+
+void TimingWheel::Cascade(int level)
+{
+    const int64_t     index = (current_ >> (level * SlotBits)) & (SlotCount - 1);
+    TimingWheelNode*& head  = slots_[level * SlotCount + index];
+
+    while (head)
+    {
+        TimingWheelNode* node = head;
+        node->Unlink();
+        Schedule(node, node->expires_);
+    }
+}
+
+}  // namespace kiwano
@@ -0,0 +1,161 @@
+// Copyright (c) 2016-2019 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <memory>
+#include <kiwano/core/Common.h>
+
+namespace kiwano
+{
+
+class TimingWheel;
+
+/**
+ * \~chinese
+ * @brief ʱֽڵ
+ * @details ڵʱԶʱƳ
+ */
+class KGE_API TimingWheelNode
+{
+    friend class TimingWheel;
+
+public:
+    TimingWheelNode();
+
+    ~TimingWheelNode();
+
+    /// \~chinese
+    /// @brief ڵǷʱ
+    bool IsScheduled() const;
+
+    /// \~chinese
+    /// @brief ȡʱ䣨룩
+    int64_t GetExpireTime() const;
+
+    TimingWheelNode(const TimingWheelNode&) = delete;
+
+    TimingWheelNode& operator=(const TimingWheelNode&) = delete;
+
+private:
+    void Unlink();
+
+private:
+    TimingWheel*      wheel_;
+    TimingWheelNode*  next_;
+    TimingWheelNode** pprev_;
+    int64_t           expires_;
+};
+
+/**
+ * \~chinese
+ * @brief ֲʱ
+ * @details ԺΪ̶ȣ 5 㣬ÿ 64 ۣɱʾԼ 12 ڵĵʱ䣬ԶĽڵڵǰ·ֲ㡣
+ * ȡĸӶΪ O(1)ƽʱʱֻʵڵĽڵҪ½һĽڵ㣬ûнڵĿ̶Ȼᱻֱ
+ */
+class KGE_API TimingWheel : Noncopyable
+{
+    friend class TimingWheelNode;
+
+public:
+    TimingWheel();
+
+    ~TimingWheel();
+
+    /// \~chinese
+    /// @brief ȡǰʱ䣨룩
+    int64_t GetCurrentTime() const;
+
+    /// \~chinese
+    /// @brief ȡʱеĽڵ
+    size_t GetSize() const;
+
+    /// \~chinese
+    /// @brief ʱǷΪ
+    bool IsEmpty() const;
+
+    /// \~chinese
+    /// @brief ӽڵ
+    /// @param node ڵ㣬ʱеĽڵᱻ°
+    /// @param expires ʱ䣨룩ڵǰʱĽڵ´ƽʱʱ
+    void Schedule(TimingWheelNode* node, int64_t expires);
+
+    /// \~chinese
+    /// @brief Ƴڵ
+    void Cancel(TimingWheelNode* node);
+
+    /// \~chinese
+    /// @brief ƽʱ
+    /// @param now µĵǰʱ䣨룩
+    /// @param expired ڵĽڵ㣬ڵѴʱƳڵĿ̶Ⱥ
+    /// @note ʹʱûб仯ѵڵĽڵҲᱻ
+    void Advance(int64_t now, Vector<TimingWheelNode*>& expired);
+
+    /// \~chinese
+    /// @brief Ƴнڵ
+    void Clear();
+
+private:
+    void Insert(TimingWheelNode* node);
+
+    void Link(TimingWheelNode* node, TimingWheelNode*& head);
+
+    void Cascade(int level);
+
+    void Collect(TimingWheelNode*& head, Vector<TimingWheelNode*>& expired);
+
+    int64_t GetNextTime(int level);
+
+private:
+    static const int SlotBits   = 6;
+    static const int SlotCount  = 1 << SlotBits;
+    static const int LevelCount = 5;
+
+    int64_t                             current_;
+    size_t                              size_;
+    uint64_t                            occupied_[LevelCount];
+    std::unique_ptr<TimingWheelNode*[]> slots_;
+};
+
+inline bool TimingWheelNode::IsScheduled() const
+{
+    return wheel_ != nullptr;
+}
+
+inline int64_t TimingWheelNode::GetExpireTime() const
+{
+    return expires_;
+}
+
+inline int64_t TimingWheel::GetCurrentTime() const
+{
+    return current_;
+}
+
+inline size_t TimingWheel::GetSize() const
+{
+    return size_;
+}
+
+inline bool TimingWheel::IsEmpty() const
+{
+    return size_ == 0;
+}
+
+}  // namespace kiwano
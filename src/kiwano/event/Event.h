@@ -42,8 +42,14 @@ namespace kiwano
 class KGE_API Event : public RefObject
 {
 public:
+    /// \~chinese
+    /// @brief ¼
+    /// @details ΪΪ¼𣬿 IsType ж¼Ƿڸ
+    using EventCategory = Event;
+
     /// \~chinese
     /// @brief ¼
+    /// @param type ¼ͣ¼
     Event(const EventType& type);
 
     virtual ~Event();
@@ -54,6 +60,7 @@ public:
 
     /// \~chinese
     /// @brief ж¼
+    /// @details ¼ƥڸ¼
     /// @return ¼ͬtrue򷵻false
     template <typename _Ty>
     bool IsType() const;
@@ -74,6 +81,38 @@ private:
     const EventType type_;
 };
 
+namespace details
+{
+
+template <typename _Ty, bool _IsCategory = std::is_same<_Ty, typename _Ty::EventCategory>::value>
+struct EventTypeMatcher
+{
+    static inline bool Match(const EventType& type)
+    {
+        return type == KGE_EVENT(_Ty);
+    }
+};
+
+template <typename _Ty>
+struct EventTypeMatcher<_Ty, true>
+{
+    static inline bool Match(const EventType& type)
+    {
+        return type.IsKindOf(KGE_EVENT(_Ty));
+    }
+};
+
+template <>
+struct EventTypeMatcher<Event, true>
+{
+    static inline bool Match(const EventType& type)
+    {
+        return true;
+    }
+};
+
+}  // namespace details
+
 /// \~chinese
 /// @brief ¼ԣж¼Ƿͬ
 template <typename _Ty>
@@ -82,7 +121,7 @@ struct IsSameEventType
     inline bool operator()(const Event* evt) const
     {
         static_assert(std::is_base_of<Event, _Ty>::value, "_Ty is not an event type.");
-        return evt->GetType() == KGE_EVENT(_Ty);
+        return details::EventTypeMatcher<_Ty>::Match(evt->GetType());
     }
 };
 
@@ -111,7 +150,9 @@ inline _Ty* Event::Cast()
 {
     if (!this->IsType<_Ty>())
         return nullptr;
-    return dynamic_cast<_Ty*>(this);
+
+    // Events are constructed with their own type, so a matching type proves the dynamic type
+    return static_cast<_Ty*>(this);
 }
 
 }  // namespace kiwano
@@ -20,24 +20,80 @@
 
 #include <kiwano/event/EventDispatcher.h>
 #include <kiwano/utils/Logger.h>
+#include <algorithm>
 
 namespace kiwano
 {
+EventDispatcher::EventDispatcher()
+    : dispatch_depth_(0)
+    , compact_pending_(false)
+    , remove_pending_(false)
+    , category_mask_(0)
+{
+}
+
+EventDispatcher::~EventDispatcher()
+{
+    for (auto& listener : listeners_)
+    {
+        listener->dispatcher_ = nullptr;
+    }
+}
+
 bool EventDispatcher::DispatchEvent(Event* evt)
 {
     if (listeners_.IsEmpty())
         return true;
 
-    RefPtr<EventListener> next;
-    for (auto listener = listeners_.GetFirst(); listener; listener = next)
+    ListenerList::TraversalGuard guard(listeners_);
+
+    const EventType& type = evt->GetType();
+
+    int bucket = FindBucket(type);
+    if (bucket < 0 && (type.GetCategoryMask() & category_mask_))
     {
-        next = listener->GetNext();
+        // First event of this type for the category listeners
+        bucket = CreateBucket(type);
+    }
+
+    ++dispatch_depth_;
+    const bool result = DispatchToBucket(bucket, evt);
+
+    // Removed listeners stay alive until the guard is released, so drop them from the buckets first
+    if (--dispatch_depth_ == 0)
+    {
+        if (remove_pending_)
+            RemoveFlaggedListeners();
+        else if (compact_pending_)
+            CompactBuckets();
+    }
+    return result;
+}
+
+bool EventDispatcher::DispatchToBucket(int bucket, Event* evt)
+{
+    // Handlers may add listeners, so the bucket is looked up again at every step
+    for (size_t i = 0;; ++i)
+    {
+        const auto& listeners = bucket < 0 ? wildcard_listeners_ : buckets_[bucket].listeners;
+        if (i >= listeners.size())
+            break;
+
+        EventListener* listener = listeners[i];
+        if (listener->dispatcher_ != this)
+            continue;
 
         if (listener->IsRunning())
             listener->Handle(evt);
 
         if (listener->IsRemoveable())
-            listeners_.Remove(listener);
+        {
+            listener->dispatcher_ = nullptr;
+            compact_pending_      = true;
+
+            RefPtr<EventListener> removed = listener;
+            listeners_.Remove(removed);
+        }
 
         if (listener->IsSwallowEnabled())
             return false;
@@ -45,13 +101,152 @@ bool EventDispatcher::DispatchEvent(Event* evt)
     return true;
 }
 
+int EventDispatcher::FindBucket(const EventType& type) const
+{
+    // A dispatcher rarely listens to more than a handful of types, a linear scan beats hashing
+    for (size_t i = 0; i < buckets_.size(); ++i)
+    {
+        if (buckets_[i].type == type)
+            return int(i);
+    }
+    return -1;
+}
+
+int EventDispatcher::CreateBucket(const EventType& type)
+{
+    // Collected from the listener list, so that catch-all, typed and category listeners keep the adding order
+    ListenerBucket bucket{ type };
+    for (EventListener* listener = listeners_.GetFirstPtr(); listener; listener = ListenerList::GetNextPtr(listener))
+    {
+        if (listener->dispatcher_ != this)
+            continue;
+
+        const auto& types = listener->GetSubscribedTypes();
+        if (types.empty() || std::any_of(types.begin(), types.end(), [&](const EventType& t) { return t.Match(type); }))
+        {
+            bucket.listeners.push_back(listener);
+        }
+    }
+
+    buckets_.push_back(std::move(bucket));
+    return int(buckets_.size()) - 1;
+}
+
+void EventDispatcher::CompactBuckets()
+{
+    auto is_removed = [this](EventListener* listener) { return listener->dispatcher_ != this; };
+    auto is_typed   = [](EventListener* listener) { return !listener->GetSubscribedTypes().empty(); };
+
+    wildcard_listeners_.erase(std::remove_if(wildcard_listeners_.begin(), wildcard_listeners_.end(), is_removed),
+                              wildcard_listeners_.end());
+
+    for (auto& bucket : buckets_)
+    {
+        auto& listeners = bucket.listeners;
+        listeners.erase(std::remove_if(listeners.begin(), listeners.end(), is_removed), listeners.end());
+    }
+
+    // A bucket left with catch-all listeners only is served by the wildcard list
+    buckets_.erase(std::remove_if(buckets_.begin(), buckets_.end(),
+                                  [&](const ListenerBucket& bucket) {
+                                      return std::none_of(bucket.listeners.begin(), bucket.listeners.end(), is_typed);
+                                  }),
+                   buckets_.end());
+
+    category_mask_ = 0;
+    for (EventListener* listener = listeners_.GetFirstPtr(); listener; listener = ListenerList::GetNextPtr(listener))
+    {
+        if (listener->dispatcher_ != this)
+            continue;
+
+        for (const auto& type : listener->GetSubscribedTypes())
+        {
+            if (type.IsCategory())
+                category_mask_ |= type.GetCategoryMask();
+        }
+    }
+
+    compact_pending_ = false;
+}
+
+void EventDispatcher::OnListenerRemoved()
+{
+    // A typed listener is only visited by events of its own type, so it is not left for a dispatch to unlink
+    if (dispatch_depth_ == 0)
+        RemoveFlaggedListeners();
+    else
+        remove_pending_ = true;
+}
+
+void EventDispatcher::RemoveFlaggedListeners()
+{
+    // Buckets hold raw pointers, so the listeners are released after the buckets are compacted
+    ListenerList::TraversalGuard guard(listeners_);
+
+    EventListener* next = nullptr;
+    for (EventListener* listener = listeners_.GetFirstPtr(); listener; listener = next)
+    {
+        next = ListenerList::GetNextPtr(listener);
+        if (listener->IsRemoveable())
+        {
+            listener->dispatcher_ = nullptr;
+
+            RefPtr<EventListener> removed = listener;
+            listeners_.Remove(removed);
+        }
+    }
+
+    remove_pending_ = false;
+    CompactBuckets();
+}
+
 EventListener* EventDispatcher::AddListener(RefPtr<EventListener> listener)
 {
     KGE_ASSERT(listener && "AddListener failed, NULL pointer exception");
 
     if (listener)
     {
+        KGE_ASSERT(!listener->dispatcher_ && "AddListener failed, the listener already belongs to a dispatcher");
+
         listeners_.PushBack(listener);
+        listener->dispatcher_ = this;
+
+        EventListener* ptr   = listener.Get();
+        const auto&    types = ptr->GetSubscribedTypes();
+        if (types.empty())
+        {
+            wildcard_listeners_.push_back(ptr);
+
+            // Catch-all listeners take their place in every bucket to keep the adding order
+            for (auto& bucket : buckets_)
+            {
+                bucket.listeners.push_back(ptr);
+            }
+        }
+        else
+        {
+            for (const auto& type : types)
+            {
+                if (type.IsCategory())
+                {
+                    // Buckets of event types in this category are created on the first dispatch
+                    category_mask_ |= type.GetCategoryMask();
+                    for (auto& bucket : buckets_)
+                    {
+                        if (type.Match(bucket.type) && bucket.listeners.back() != ptr)
+                            bucket.listeners.push_back(ptr);
+                    }
+                    continue;
+                }
+
+                // A new bucket already has the listener, it is the last one in the list
+                int index = FindBucket(type);
+                if (index < 0)
+                    CreateBucket(type);
+                else if (buckets_[index].listeners.back() != ptr)
+                    buckets_[index].listeners.push_back(ptr);
+            }
+        }
     }
     return listener.Get();
 }
@@ -96,9 +291,10 @@ void EventDispatcher::RemoveListeners(StringView name)
     {
         if (listener->IsName(name))
         {
-            listener->Remove();
+            listener->removeable_ = true;
         }
     }
+    OnListenerRemoved();
 }
 
 void EventDispatcher::StartAllListeners()
@@ -121,8 +317,9 @@ void EventDispatcher::RemoveAllListeners()
 {
     for (auto& listener : listeners_)
     {
-        listener->Remove();
+        listener->removeable_ = true;
     }
+    OnListenerRemoved();
 }
 
 const ListenerList& EventDispatcher::GetAllListeners() const
@@ -130,4 +327,22 @@ const ListenerList& EventDispatcher::GetAllListeners() const
     return listeners_;
 }
 
+void EventDispatcher::GetListenedTypes(Vector<EventType>& types) const
+{
+    for (const auto& bucket : buckets_)
+    {
+        types.push_back(bucket.type);
+    }
+}
+
+uint64_t EventDispatcher::GetListenedCategories() const
+{
+    return category_mask_;
+}
+
+bool EventDispatcher::HasWildcardListeners() const
+{
+    return !wildcard_listeners_.empty();
+}
+
 }  // namespace kiwano
@@ -31,12 +31,18 @@ typedef IntrusiveList<RefPtr<EventListener>> ListenerList;
 /**
  * \~chinese
  * @brief ¼ַ
+ * @details ĵ¼ͷͰַ¼ʱֻʶ˸ͻļͽ¼ļ
+ * ˳˳һ
  */
-class KGE_API EventDispatcher : protected IntrusiveListValue<EventDispatcher*>
+class KGE_API EventDispatcher
 {
-    friend IntrusiveList<EventDispatcher*>;
+    friend class EventListener;
 
 public:
+    EventDispatcher();
+
+    virtual ~EventDispatcher();
+
     /// \~chinese
     /// @brief Ӽ
     EventListener* AddListener(RefPtr<EventListener> listener);
@@ -108,6 +114,19 @@ public:
     /// @brief ȡм
     const ListenerList& GetAllListeners() const;
 
+    /// \~chinese
+    /// @brief ȡĵ¼
+    /// @details ¼ļͶĵ¼
+    void GetListenedTypes(Vector<EventType>& types) const;
+
+    /// \~chinese
+    /// @brief ȡĵ¼
+    uint64_t GetListenedCategories() const;
+
+    /// \~chinese
+    /// @brief Ƿн¼ļ
+    bool HasWildcardListeners() const;
+
     /// \~chinese
     /// @brief ַ¼
     /// @param evt ¼
@@ -115,6 +134,31 @@ public:
     virtual bool DispatchEvent(Event* evt);
 
 private:
-    ListenerList listeners_;
+    struct ListenerBucket
+    {
+        EventType              type;
+        Vector<EventListener*> listeners;
+    };
+
+    int FindBucket(const EventType& type) const;
+
+    int CreateBucket(const EventType& type);
+
+    bool DispatchToBucket(int bucket, Event* evt);
+
+    void CompactBuckets();
+
+    void OnListenerRemoved();
+
+    void RemoveFlaggedListeners();
+
+private:
+    int                    dispatch_depth_;
+    bool                   compact_pending_;
+    bool                   remove_pending_;
+    uint64_t               category_mask_;
+    ListenerList           listeners_;
+    Vector<EventListener*> wildcard_listeners_;
+    Vector<ListenerBucket> buckets_;
 };
 }  // namespace kiwano
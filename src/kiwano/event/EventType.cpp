@@ -0,0 +1,96 @@
+#include <kiwano/event/Event.h>
+#include <mutex>
+
+namespace kiwano
+{
+
+namespace
+{
+
+struct EventTypeEntry
+{
+    std::type_index type;
+    uint64_t        category_mask;
+    bool            category;
+};
+
+struct EventTypeRegistry
+{
+    std::mutex                              mutex;
+    UnorderedMap<std::type_index, uint32_t> ids;
+    UnorderedMap<std::type_index, uint64_t> category_bits;
+    Vector<EventTypeEntry>                  types;
+
+    static EventTypeRegistry& Get()
+    {
+        static EventTypeRegistry registry;
+        return registry;
+    }
+};
+
+}  // namespace
+
+EventType::EventType(const std::type_index& type)
+    : id_(0)
+    , category_(false)
+    , category_mask_(0)
+{
+    if (type == typeid(void))
+        return;
+
+    // Types registered through EventType::Of keep their category, others get a plain ID
+    *this = Register(type, typeid(Event));
+}
+
+std::type_index EventType::GetType() const
+{
+    if (id_ == 0)
+        return typeid(void);
+
+    auto&                       registry = EventTypeRegistry::Get();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    return registry.types[id_ - 1].type;
+}
+
+EventType EventType::Register(const std::type_index& type, const std::type_index& category)
+{
+    auto&                       registry = EventTypeRegistry::Get();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    EventType result;
+
+    auto iter = registry.ids.find(type);
+    if (iter != registry.ids.end())
+    {
+        const auto& entry = registry.types[iter->second - 1];
+
+        result.id_            = iter->second;
+        result.category_      = entry.category;
+        result.category_mask_ = entry.category_mask;
+        return result;
+    }
+
+    uint64_t mask = 0;
+    if (category != typeid(Event))
+    {
+        auto bit = registry.category_bits.find(category);
+        if (bit == registry.category_bits.end())
+        {
+            const size_t count = registry.category_bits.size();
+            KGE_ASSERT(count < 64 && "Too many event categories");
+
+            bit = registry.category_bits.insert(std::make_pair(category, uint64_t(1) << count)).first;
+        }
+        mask = bit->second;
+    }
+
+    registry.types.push_back(EventTypeEntry{ type, mask, type == category });
+    registry.ids.insert(std::make_pair(type, uint32_t(registry.types.size())));
+
+    result.id_            = uint32_t(registry.types.size());
+    result.category_      = type == category;
+    result.category_mask_ = mask;
+    return result;
+}
+
+}  // namespace kiwano
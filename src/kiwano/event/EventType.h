@@ -25,6 +25,8 @@
 
 namespace kiwano
 {
+class Event;
+
 /**
  * \addtogroup Event
  * @{
@@ -32,18 +34,50 @@ namespace kiwano
 
 /// \~chinese
 /// @brief ¼
-class EventType
+/// @details ÿ¼״ʹʱעһ IDȽ¼ֻȽ
+/// ¼ EventCategory Ϊ¼Ϊ¼¼ͻ¼
+class KGE_API EventType
 {
 public:
     EventType();
 
     EventType(const std::type_index& type);
 
+    /// \~chinese
+    /// @brief ȡ¼
+    /// @tparam _Ty ¼
+    template <typename _Ty>
+    static const EventType& Of();
+
     /// \~chinese
     /// @brief Ƿǿ
     bool IsNull() const;
 
-    const std::type_index& GetType() const;
+    /// \~chinese
+    /// @brief ȡ¼ ID
+    /// @details ID  1 ʼ䣬Ϊ 0
+    uint32_t GetId() const;
+
+    /// \~chinese
+    /// @brief ȡ¼
+    uint64_t GetCategoryMask() const;
+
+    /// \~chinese
+    /// @brief Ƿ¼
+    bool IsCategory() const;
+
+    /// \~chinese
+    /// @brief Ƿĳ¼
+    /// @param category ¼
+    bool IsKindOf(const EventType& category) const;
+
+    /// \~chinese
+    /// @brief Ƿƥ¼
+    /// @details ¼ƥڸ¼ͣEvent ƥ¼
+    /// @param type ¼
+    bool Match(const EventType& type) const;
+
+    std::type_index GetType() const;
 
     bool operator==(const EventType& rhs) const;
     bool operator!=(const EventType& rhs) const;
@@ -53,61 +87,96 @@ public:
     bool operator>=(const EventType& rhs) const;
 
 private:
-    std::type_index type_;
+    static EventType Register(const std::type_index& type, const std::type_index& category);
+
+private:
+    uint32_t id_;
+    bool     category_;
+    uint64_t category_mask_;
 };
 
 /** @} */
 
-#define KGE_EVENT(EVENT_TYPE) ::kiwano::EventType(typeid(EVENT_TYPE))
+#define KGE_EVENT(EVENT_TYPE) ::kiwano::EventType::Of<EVENT_TYPE>()
 
-inline EventType::EventType()
-    : type_(typeid(void))
+template <typename _Ty>
+inline const EventType& EventType::Of()
 {
+    // Every module keeps its own copy of this static, the registry hands out the same ID to all of them
+    static const EventType type = EventType::Register(typeid(_Ty), typeid(typename _Ty::EventCategory));
+    return type;
 }
 
-inline EventType::EventType(const std::type_index& type)
-    : type_(type)
+inline EventType::EventType()
+    : id_(0)
+    , category_(false)
+    , category_mask_(0)
 {
 }
 
 inline bool EventType::IsNull() const
 {
-    return type_ == typeid(void);
+    return id_ == 0;
+}
+
+inline uint32_t EventType::GetId() const
+{
+    return id_;
+}
+
+inline uint64_t EventType::GetCategoryMask() const
+{
+    return category_mask_;
+}
+
+inline bool EventType::IsCategory() const
+{
+    return category_;
+}
+
+inline bool EventType::IsKindOf(const EventType& category) const
+{
+    return (category_mask_ & category.category_mask_) != 0;
 }
 
-inline const std::type_index& EventType::GetType() const
+inline bool EventType::Match(const EventType& type) const
 {
-    return type_;
+    if (category_)
+    {
+        // Event itself is the only category without a mask
+        return category_mask_ == 0 || type.IsKindOf(*this);
+    }
+    return id_ == type.id_;
 }
 
 inline bool EventType::operator==(const EventType& rhs) const
 {
-    return type_ == rhs.type_;
+    return id_ == rhs.id_;
 }
 
 inline bool EventType::operator!=(const EventType& rhs) const
 {
-    return type_ != rhs.type_;
+    return id_ != rhs.id_;
 }
 
 inline bool EventType::operator<(const EventType& rhs) const
 {
-    return type_ < rhs.type_;
+    return id_ < rhs.id_;
 }
 
 inline bool EventType::operator<=(const EventType& rhs) const
 {
-    return type_ <= rhs.type_;
+    return id_ <= rhs.id_;
 }
 
 inline bool EventType::operator>(const EventType& rhs) const
 {
-    return type_ > rhs.type_;
+    return id_ > rhs.id_;
 }
 
 inline bool EventType::operator>=(const EventType& rhs) const
 {
-    return type_ >= rhs.type_;
+    return id_ >= rhs.id_;
 }
 
 }  // namespace kiwano
@@ -35,6 +35,8 @@ namespace kiwano
 class KGE_API KeyEvent : public Event
 {
 public:
+    using EventCategory = KeyEvent;
+
     KeyEvent(const EventType& type);
 };
 
@@ -78,16 +80,6 @@ public:
     IMEInputEvent();
 };
 
-template <>
-struct IsSameEventType<KeyEvent>
-{
-    inline bool operator()(const Event* evt) const
-    {
-        return evt->GetType() == KGE_EVENT(KeyDownEvent) || evt->GetType() == KGE_EVENT(KeyUpEvent)
-               || evt->GetType() == KGE_EVENT(KeyCharEvent) || evt->GetType() == KGE_EVENT(IMEInputEvent);
-    }
-};
-
 /** @} */
 
 }  // namespace kiwano
@@ -36,6 +36,8 @@ namespace kiwano
 class KGE_API MouseEvent : public Event
 {
 public:
+    using EventCategory = MouseEvent;
+
     Point pos;  ///< λ
 
     MouseEvent(const EventType& type);
@@ -105,18 +107,6 @@ public:
     MouseWheelEvent();
 };
 
-template <>
-struct IsSameEventType<MouseEvent>
-{
-    inline bool operator()(const Event* evt) const
-    {
-        return evt->GetType() == KGE_EVENT(MouseMoveEvent) || evt->GetType() == KGE_EVENT(MouseDownEvent)
-               || evt->GetType() == KGE_EVENT(MouseUpEvent) || evt->GetType() == KGE_EVENT(MouseClickEvent)
-               || evt->GetType() == KGE_EVENT(MouseHoverEvent) || evt->GetType() == KGE_EVENT(MouseOutEvent)
-               || evt->GetType() == KGE_EVENT(MouseWheelEvent);
-    }
-};
-
 /** @} */
 
 }  // namespace kiwano
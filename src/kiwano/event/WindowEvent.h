@@ -36,6 +36,8 @@ class Window;
 class KGE_API WindowEvent : public Event
 {
 public:
+    using EventCategory = WindowEvent;
+
     Window* window;  ///< 
 
     WindowEvent(const EventType& type);
@@ -91,18 +93,6 @@ public:
     WindowClosedEvent();
 };
 
-template <>
-struct IsSameEventType<WindowEvent>
-{
-    inline bool operator()(const Event* evt) const
-    {
-        return evt->GetType() == KGE_EVENT(WindowMovedEvent) || evt->GetType() == KGE_EVENT(WindowResizedEvent)
-               || evt->GetType() == KGE_EVENT(WindowFocusChangedEvent)
-               || evt->GetType() == KGE_EVENT(WindowTitleChangedEvent)
-               || evt->GetType() == KGE_EVENT(WindowClosedEvent);
-    }
-};
-
 /** @} */
 
 }  // namespace kiwano
@@ -20,6 +20,7 @@
 
 #pragma once
 #include <kiwano/event/listener/EventListener.h>
+#include <kiwano/event/EventDispatcher.h>
 
 namespace kiwano
 {
@@ -28,11 +29,42 @@ EventListener::EventListener()
     : running_(true)
     , removeable_(false)
     , swallow_(false)
+    , dispatcher_(nullptr)
 {
 }
 
 EventListener::~EventListener() {}
 
+void EventListener::Remove()
+{
+    removeable_ = true;
+
+    // May release this listener, nothing is touched afterwards
+    if (dispatcher_)
+        dispatcher_->OnListenerRemoved();
+}
+
+void EventListener::Subscribe(EventType type)
+{
+    KGE_ASSERT(!dispatcher_ && "Subscribe must be called before the listener is added to a dispatcher");
+
+    // Event matches every type, the listener stays a catch-all one
+    if (type.IsNull() || (type.IsCategory() && type.GetCategoryMask() == 0))
+        return;
+
+    if (std::find(types_.begin(), types_.end(), type) == types_.end())
+    {
+        types_.push_back(type);
+    }
+}
+
+void EventListener::Unsubscribe(EventType type)
+{
+    KGE_ASSERT(!dispatcher_ && "Unsubscribe must be called before the listener is added to a dispatcher");
+
+    types_.erase(std::remove(types_.begin(), types_.end(), type), types_.end());
+}
+
 class CallbackEventListener : public EventListener
 {
 public:
@@ -40,11 +72,12 @@ public:
         : type_(type)
         , cb_(cb)
     {
+        Subscribe(type);
     }
 
     void Handle(Event* evt) override
     {
-        if (type_.IsNull() || type_ == evt->GetType())
+        if (type_.IsNull() || type_.Match(evt->GetType()))
         {
             if (cb_)
             {
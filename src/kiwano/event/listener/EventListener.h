@@ -111,14 +111,33 @@ public:
     /// @param enabled Ƿ
     void SetSwallowEnabled(bool enabled);
 
+    /// \~chinese
+    /// @brief ¼
+    /// @details ַֻѶĵ¼δκ͵ļ¼
+    /// ¼ʱڸ¼
+    /// @note Ҫӵַ֮ǰ
+    void Subscribe(EventType type);
+
+    /// \~chinese
+    /// @brief ȡ¼
+    /// @details ȡжĺ¼
+    /// @note Ҫӵַ֮ǰ
+    void Unsubscribe(EventType type);
+
+    /// \~chinese
+    /// @brief ȡĵ¼
+    const Vector<EventType>& GetSubscribedTypes() const;
+
     /// \~chinese
     /// @brief Ϣ
     virtual void Handle(Event* evt) = 0;
 
 private:
-    bool running_;
-    bool removeable_;
-    bool swallow_;
+    bool              running_;
+    bool              removeable_;
+    bool              swallow_;
+    EventDispatcher*  dispatcher_;
+    Vector<EventType> types_;
 };
 
 /** @} */
@@ -133,11 +152,6 @@ inline void EventListener::Stop()
     running_ = false;
 }
 
-inline void EventListener::Remove()
-{
-    removeable_ = true;
-}
-
 inline bool EventListener::IsRunning() const
 {
     return running_;
@@ -158,4 +172,9 @@ inline void EventListener::SetSwallowEnabled(bool enabled)
     swallow_ = enabled;
 }
 
+inline const Vector<EventType>& EventListener::GetSubscribedTypes() const
+{
+    return types_;
+}
+
 }  // namespace kiwano
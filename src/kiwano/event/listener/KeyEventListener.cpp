@@ -24,6 +24,12 @@
 namespace kiwano
 {
 
+KeyEventListener::KeyEventListener()
+{
+    // The whole category, so that subclasses overriding Handle still get KeyCharEvent and the others
+    Subscribe(KGE_EVENT(KeyEvent));
+}
+
 void KeyEventListener::Handle(Event* evt)
 {
     if (auto key_evt = evt->Cast<KeyDownEvent>())
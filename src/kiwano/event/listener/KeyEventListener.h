@@ -33,10 +33,13 @@ namespace kiwano
 /**
  * \~chinese
  * @brief ¼
+ * @details Ĭ϶İ¼д Handle ¼ʱҪĶӦ¼
  */
 class KGE_API KeyEventListener : public EventListener
 {
 public:
+    KeyEventListener();
+
     /// \~chinese
     /// @brief ʱ
     /// @param key ֵ
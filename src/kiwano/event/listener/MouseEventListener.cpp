@@ -24,6 +24,12 @@
 namespace kiwano
 {
 
+MouseEventListener::MouseEventListener()
+{
+    // The whole category, so that subclasses overriding Handle still get MouseClickEvent and the others
+    Subscribe(KGE_EVENT(MouseEvent));
+}
+
 void MouseEventListener::Handle(Event* evt)
 {
     if (auto mouse_evt = evt->Cast<MouseMoveEvent>())
@@ -48,6 +54,7 @@ MouseDragEventListener::MouseDragEventListener()
     : is_dragging_{ false, false, false }
     , drag_point_{}
 {
+    Subscribe(KGE_EVENT(MouseEvent));
 }
 
 void MouseDragEventListener::Handle(Event* evt)
@@ -33,10 +33,13 @@ namespace kiwano
 /**
  * \~chinese
  * @brief ¼
+ * @details Ĭ϶¼д Handle ¼ʱҪĶӦ¼
  */
 class KGE_API MouseEventListener : public EventListener
 {
 public:
+    MouseEventListener();
+
     /// \~chinese
     /// @brief ƶʱ
     /// @param pos λ
@@ -68,6 +71,7 @@ public:
 /**
  * \~chinese
  * @brief ϶¼
+ * @details Ĭ϶¼д Handle ¼ʱҪĶӦ¼
  */
 class KGE_API MouseDragEventListener : public EventListener
 {
@@ -71,6 +71,7 @@
 #include <kiwano/base/ObjectBase.h>
 #include <kiwano/base/Director.h>
 #include <kiwano/base/Module.h>
+#include <kiwano/base/JobSystem.h>
 #include <kiwano/base/component/Component.h>
 #include <kiwano/base/component/ComponentManager.h>
 #include <kiwano/base/component/MouseSensor.h>
@@ -124,6 +125,7 @@
 #include <kiwano/2d/animation/DelayAnimation.h>
 #include <kiwano/2d/animation/AnimationGroup.h>
 #include <kiwano/2d/animation/TweenAnimation.h>
+#include <kiwano/2d/animation/TweenBatch.h>
 #include <kiwano/2d/animation/PathAnimation.h>
 #include <kiwano/2d/animation/FrameSequence.h>
 #include <kiwano/2d/animation/FrameAnimation.h>
@@ -69,6 +69,7 @@
 #define KGE_RENDER_ENGINE_OPENGL 1
 #define KGE_RENDER_ENGINE_OPENGLES 2
 #define KGE_RENDER_ENGINE_DIRECTX 3
+#define KGE_RENDER_ENGINE_SOFTWARE 4
 #define KGE_RENDER_ENGINE KGE_RENDER_ENGINE_NONE
 
 /////////////////////////////////////////////////////////////
@@ -181,6 +182,11 @@ KGE_SUPPRESS_WARNING(4251)
 
 #else
 
+#if KGE_RENDER_ENGINE == KGE_RENDER_ENGINE_NONE
+#undef KGE_RENDER_ENGINE
+#define KGE_RENDER_ENGINE KGE_RENDER_ENGINE_SOFTWARE
+#endif
+
 #if KGE_RENDER_ENGINE == KGE_RENDER_ENGINE_DIRECTX
 #error "DirectX render engine is not supported on current platform"
 #endif
@@ -23,6 +23,7 @@
 #include <kiwano/base/Director.h>
 #include <kiwano/render/Renderer.h>
 #include <kiwano/utils/Logger.h>
+#include <kiwano/utils/ResourceLoader.h>
 
 namespace kiwano
 {
@@ -136,10 +137,14 @@ void Application::UpdateFrame(Duration dt)
 {
     this->Render();
     this->Update(dt);
+    this->ClearFrameEvents();
 }
 
 void Application::Destroy()
 {
+    // Loader threads post their results to this application, stop them before it is torn down
+    ResourceLoader::StopAsyncLoading();
+
     if (runner_)
     {
         runner_->OnDestroy();
@@ -153,6 +158,9 @@ void Application::Destroy()
     }
     modules_.clear();
 
+    // Clear transient events
+    ClearFrameEvents();
+
     // Clear device resources
     Renderer::GetInstance().Destroy();
 }
@@ -231,10 +239,31 @@ void Application::Render()
     renderer.Present();
 }
 
+void Application::ClearFrameEvents()
+{
+    for (auto evt : frame_events_)
+    {
+        // Only the reference taken by CreateFrameEvent may be left, any other one would dangle after the reset
+        KGE_ASSERT(evt->GetRefCount() == 1 && "A frame event is still referenced at the end of the frame");
+        if (evt->GetRefCount() != 1)
+        {
+            // Leak the event together with its block, the reference taken by CreateFrameEvent is never
+            // given back so the holder can not delete it from the arena either
+            KGE_ERRORF("A frame event of type %s is still referenced at the end of the frame and is leaked",
+                       evt->GetType().GetType().name());
+            frame_allocator_.Detach(evt);
+            continue;
+        }
+        evt->~Event();
+    }
+    frame_events_.clear();
+    frame_allocator_.Reset();
+}
+
 void Application::PerformInMainThread(Function<void()> func)
 {
     std::lock_guard<std::mutex> lock(perform_mutex_);
-    functions_to_perform_.push(func);
+    functions_to_perform_.push(std::move(func));
 }
 
 }  // namespace kiwano
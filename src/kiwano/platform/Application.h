@@ -144,6 +144,24 @@ public:
      */
     void PerformInMainThread(Function<void()> func);
 
+    /**
+     * \~chinese
+     * @brief ȡ֡ڴ
+     * @details ֡ڴеڴÿ֡½ͳһգ߳ʹ
+     */
+    memory::ArenaAllocator& GetFrameAllocator();
+
+    /**
+     * \~chinese
+     * @brief ֡ʱ¼
+     * @details ¼֡ڴй죬ȫڴҲҪüÿ֡½Զ
+     * @param args ¼
+     * @warning ¼ڲܳǰַ֡Ҫи¼֡ʱԱõ¼ᴥԣ
+     * δʱ¼ڵڴᱻй©߷ѻյڴ
+     */
+    template <typename _Ty, typename... _Args>
+    _Ty* CreateFrameEvent(_Args&&... args);
+
     /**
      * \~chinese
      * @brief һ֡
@@ -171,6 +189,12 @@ private:
      */
     void Render();
 
+    /**
+     * \~chinese
+     * @brief ֡ʱ¼֡ڴ
+     */
+    void ClearFrameEvents();
+
 private:
     bool                    running_;
     bool                    is_paused_;
@@ -180,6 +204,8 @@ private:
     ModuleList              modules_;
     std::mutex              perform_mutex_;
     Queue<Function<void()>> functions_to_perform_;
+    memory::ArenaAllocator  frame_allocator_;
+    Vector<Event*>          frame_events_;
 };
 
 inline RefPtr<Runner> Application::GetRunner() const
@@ -199,4 +225,29 @@ inline bool Application::IsPaused() const
     return is_paused_;
 }
 
+inline memory::ArenaAllocator& Application::GetFrameAllocator()
+{
+    return frame_allocator_;
+}
+
+template <typename _Ty, typename... _Args>
+inline _Ty* Application::CreateFrameEvent(_Args&&... args)
+{
+    static_assert(std::is_base_of<Event, _Ty>::value, "_Ty is not an event type.");
+
+    void* ptr = frame_allocator_.Alloc(sizeof(_Ty));
+    if (!ptr)
+    {
+        throw std::bad_alloc();
+    }
+
+    _Ty* evt = new (ptr) _Ty(std::forward<_Args>(args)...);
+
+    // Hold one reference so that a temporary RefPtr never deletes the event, the event is not shared
+    // with any thread yet so a plain store is enough
+    evt->ref_count_.store(1, std::memory_order_relaxed);
+    frame_events_.push_back(evt);
+    return evt;
+}
+
 }  // namespace kiwano
@@ -139,26 +139,26 @@ void Input::HandleEvent(EventModuleContext& ctx)
     {
         if (evt->IsType<MouseMoveEvent>())
         {
-            UpdateMousePos(dynamic_cast<MouseMoveEvent*>(evt)->pos);
+            UpdateMousePos(static_cast<MouseMoveEvent*>(evt)->pos);
         }
         else if (evt->IsType<MouseDownEvent>())
         {
-            UpdateButton(dynamic_cast<MouseDownEvent*>(evt)->button, true);
+            UpdateButton(static_cast<MouseDownEvent*>(evt)->button, true);
         }
         else if (evt->IsType<MouseUpEvent>())
         {
-            UpdateButton(dynamic_cast<MouseUpEvent*>(evt)->button, false);
+            UpdateButton(static_cast<MouseUpEvent*>(evt)->button, false);
         }
     }
     else if (evt->IsType<KeyEvent>())
     {
         if (evt->IsType<KeyDownEvent>())
         {
-            UpdateKey(dynamic_cast<KeyDownEvent*>(evt)->code, true);
+            UpdateKey(static_cast<KeyDownEvent*>(evt)->code, true);
         }
         else if (evt->IsType<KeyUpEvent>())
         {
-            UpdateKey(dynamic_cast<KeyUpEvent*>(evt)->code, false);
+            UpdateKey(static_cast<KeyUpEvent*>(evt)->code, false);
         }
     }
 }
@@ -45,12 +45,33 @@ void Runner::InitSettings()
         Logger::GetInstance().ShowConsole(true);
     }
 
-    // Create game window
-    RefPtr<Window> window = Window::Create(settings_.window);
-    SetWindow(window);
+    // Select the renderer before anything touches it
+    RendererType renderer_type = settings_.renderer;
+    if (renderer_type == RendererType::Auto && settings_.headless)
+    {
+        renderer_type = RendererType::Software;
+    }
+
+    if (!Renderer::SetType(renderer_type))
+    {
+        KGE_WARN("The renderer could not be switched, it is already in use or not supported on this platform");
+    }
+
+    if (settings_.headless)
+    {
+        // Render to an offscreen target instead of a window
+        Renderer::GetInstance().MakeOffscreenContext(PixelSize(settings_.window.width, settings_.window.height));
+    }
+    else
+    {
+        // Create game window
+        RefPtr<Window> window = Window::Create(settings_.window);
+        SetWindow(window);
+
+        Renderer::GetInstance().MakeContextForWindow(window);
+    }
 
     // Update renderer settings
-    Renderer::GetInstance().MakeContextForWindow(window);
     Renderer::GetInstance().SetClearColor(settings_.bg_color);
     Renderer::GetInstance().SetVSyncEnabled(settings_.vsync_enabled);
 
@@ -75,24 +96,28 @@ void Runner::InitSettings()
 
 bool Runner::MainLoop(Duration dt)
 {
-    if (!main_window_)
-        return false;
+    Application& app = Application::GetInstance();
 
-    if (main_window_->ShouldClose())
+    if (main_window_)
     {
-        if (this->OnClose())
-            return false;
-
-        main_window_->SetShouldClose(false);
-    }
+        if (main_window_->ShouldClose())
+        {
+            if (this->OnClose())
+                return false;
 
-    Application& app = Application::GetInstance();
+            main_window_->SetShouldClose(false);
+        }
 
-    // Poll events
-    main_window_->PumpEvents();
-    while (RefPtr<Event> evt = main_window_->PollEvent())
+        // Poll events
+        main_window_->PumpEvents();
+        while (RefPtr<Event> evt = main_window_->PollEvent())
+        {
+            app.DispatchEvent(evt.Get());
+        }
+    }
+    else if (!settings_.headless)
     {
-        app.DispatchEvent(evt.Get());
+        return false;
     }
 
     if (frame_ticker_)
@@ -23,6 +23,7 @@
 #include <kiwano/core/Time.h>
 #include <kiwano/platform/Window.h>
 #include <kiwano/render/Color.h>
+#include <kiwano/render/Renderer.h>
 #include <kiwano/render/Texture.h>
 #include <kiwano/utils/Ticker.h>
 
@@ -42,12 +43,16 @@ struct Settings
     Duration     frame_interval;  ///< ֡
     bool         vsync_enabled;   ///< ֱͬ
     bool         debug_mode;      ///< ģʽ
+    bool         headless;        ///< ͷģʽڣõĴСȾλͼ
+    RendererType renderer;        ///< Ⱦͣͷģʽ Auto ѡȾ
 
     Settings()
         : bg_color(Color::Black)
         , frame_interval(0)
         , vsync_enabled(true)
         , debug_mode(false)
+        , headless(false)
+        , renderer(RendererType::Auto)
     {
     }
 };
@@ -93,6 +98,7 @@ public:
 
     /// \~chinese
     /// @brief ȡ
+    /// @details ͷģʽ·ؿָ
     RefPtr<Window> GetWindow() const;
 
     /// \~chinese
@@ -19,6 +19,7 @@
 // THE SOFTWARE.
 
 #include <kiwano/platform/Window.h>
+#include <kiwano/event/Events.h>
 
 namespace kiwano
 {
@@ -35,22 +36,222 @@ Window::Window()
     , min_height_(0)
     , max_width_(0)
     , max_height_(0)
+    , coalescing_(false)
+    , history_stale_(false)
+    , event_head_(0)
+    , event_count_(0)
+    , event_ring_(256)
 {
 }
 
 Window::~Window() {}
 
+Window::EventRecord::EventRecord()
+    : button()
+    , wheel(0.f)
+    , code()
+    , value(0)
+    , x(0)
+    , y(0)
+    , width(0)
+    , height(0)
+    , focus(false)
+{
+}
+
+Window::EventRecord::EventRecord(const EventType& type)
+    : EventRecord()
+{
+    this->type = type;
+}
+
 RefPtr<Event> Window::PollEvent()
 {
-    RefPtr<Event> evt;
-    if (!event_queue_.empty())
+    if (event_count_ == 0)
     {
-        evt = event_queue_.front();
-        event_queue_.pop();
+        // The history of this batch stays readable until new events arrive
+        history_stale_ = true;
+        return nullptr;
     }
+
+    EventRecord& record = event_ring_[event_head_];
+    event_head_         = (event_head_ + 1) & (event_ring_.size() - 1);
+    --event_count_;
+
+    RefPtr<Event> evt = MakeEvent(record);
+    record.object     = nullptr;
     return evt;
 }
 
+void Window::SetEventCoalescing(bool enabled)
+{
+    coalescing_ = enabled;
+}
+
+void Window::PushEventRecord(EventRecord&& record)
+{
+    if (history_stale_)
+    {
+        mouse_history_.clear();
+        history_stale_ = false;
+    }
+
+    const bool is_move = !record.object && record.type == KGE_EVENT(MouseMoveEvent);
+    if (is_move)
+        mouse_history_.push_back(record.pos);
+
+    const size_t mask = event_ring_.size() - 1;
+    if (coalescing_ && event_count_ > 0 && !record.object)
+    {
+        EventRecord& last = event_ring_[(event_head_ + event_count_ - 1) & mask];
+        if (!last.object && last.type == record.type)
+        {
+            if (is_move)
+            {
+                last.pos = record.pos;
+                return;
+            }
+
+            if (record.type == KGE_EVENT(MouseWheelEvent))
+            {
+                last.pos = record.pos;
+                last.wheel += record.wheel;
+                return;
+            }
+        }
+    }
+
+    if (event_count_ == event_ring_.size())
+        GrowEventRing();
+
+    event_ring_[(event_head_ + event_count_) & (event_ring_.size() - 1)] = std::move(record);
+    ++event_count_;
+}
+
+void Window::GrowEventRing()
+{
+    // Only a frame that overflows the preallocated ring pays for this
+    Vector<EventRecord> ring(event_ring_.size() * 2);
+    for (size_t i = 0; i < event_count_; ++i)
+    {
+        ring[i] = std::move(event_ring_[(event_head_ + i) & (event_ring_.size() - 1)]);
+    }
+    event_ring_.swap(ring);
+    event_head_ = 0;
+}
+
+template <typename _Ty>
+_Ty* Window::AcquireEvent()
+{
+    const uint32_t id = KGE_EVENT(_Ty).GetId();
+    if (event_cache_.size() <= id)
+        event_cache_.resize(id + 1);
+
+    // The event polled last time is refilled once no listener holds it anymore
+    RefPtr<Event>& cached = event_cache_[id];
+    if (!cached || cached->GetRefCount() > 1)
+        cached = new _Ty;
+    return static_cast<_Ty*>(cached.Get());
+}
+
+RefPtr<Event> Window::MakeEvent(EventRecord& record)
+{
+    if (record.object)
+        return std::move(record.object);
+
+    const EventType& type = record.type;
+    if (type == KGE_EVENT(MouseMoveEvent))
+    {
+        auto evt = AcquireEvent<MouseMoveEvent>();
+        evt->pos = record.pos;
+        return evt;
+    }
+    if (type == KGE_EVENT(MouseDownEvent))
+    {
+        auto evt    = AcquireEvent<MouseDownEvent>();
+        evt->pos    = record.pos;
+        evt->button = record.button;
+        return evt;
+    }
+    if (type == KGE_EVENT(MouseUpEvent))
+    {
+        auto evt    = AcquireEvent<MouseUpEvent>();
+        evt->pos    = record.pos;
+        evt->button = record.button;
+        return evt;
+    }
+    if (type == KGE_EVENT(MouseWheelEvent))
+    {
+        auto evt   = AcquireEvent<MouseWheelEvent>();
+        evt->pos   = record.pos;
+        evt->wheel = record.wheel;
+        return evt;
+    }
+    if (type == KGE_EVENT(KeyDownEvent))
+    {
+        auto evt  = AcquireEvent<KeyDownEvent>();
+        evt->code = record.code;
+        return evt;
+    }
+    if (type == KGE_EVENT(KeyUpEvent))
+    {
+        auto evt  = AcquireEvent<KeyUpEvent>();
+        evt->code = record.code;
+        return evt;
+    }
+    if (type == KGE_EVENT(KeyCharEvent))
+    {
+        auto evt   = AcquireEvent<KeyCharEvent>();
+        evt->value = record.value;
+        return evt;
+    }
+    if (type == KGE_EVENT(IMEInputEvent))
+    {
+        auto evt   = AcquireEvent<IMEInputEvent>();
+        evt->value = std::move(record.text);
+        return evt;
+    }
+    if (type == KGE_EVENT(WindowMovedEvent))
+    {
+        auto evt    = AcquireEvent<WindowMovedEvent>();
+        evt->window = this;
+        evt->x      = record.x;
+        evt->y      = record.y;
+        return evt;
+    }
+    if (type == KGE_EVENT(WindowResizedEvent))
+    {
+        auto evt    = AcquireEvent<WindowResizedEvent>();
+        evt->window = this;
+        evt->width  = record.width;
+        evt->height = record.height;
+        return evt;
+    }
+    if (type == KGE_EVENT(WindowFocusChangedEvent))
+    {
+        auto evt    = AcquireEvent<WindowFocusChangedEvent>();
+        evt->window = this;
+        evt->focus  = record.focus;
+        return evt;
+    }
+    if (type == KGE_EVENT(WindowTitleChangedEvent))
+    {
+        auto evt    = AcquireEvent<WindowTitleChangedEvent>();
+        evt->window = this;
+        evt->title  = std::move(record.text);
+        return evt;
+    }
+    if (type == KGE_EVENT(WindowClosedEvent))
+    {
+        auto evt    = AcquireEvent<WindowClosedEvent>();
+        evt->window = this;
+        return evt;
+    }
+
+    KGE_ASSERT(false && "Unknown window event record");
+    return nullptr;
+}
+
 String Window::GetTitle() const
 {
     return title_;
@@ -103,7 +304,12 @@ void Window::SetShouldClose(bool should)
 
 void Window::PushEvent(RefPtr<Event> evt)
 {
-    event_queue_.push(evt);
+    if (evt)
+    {
+        EventRecord record(evt->GetType());
+        record.object = evt;
+        PushEventRecord(std::move(record));
+    }
 }
 
 }  // namespace kiwano
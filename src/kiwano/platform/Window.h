@@ -22,6 +22,7 @@
 #include <kiwano/core/Common.h>
 #include <kiwano/base/ObjectBase.h>
 #include <kiwano/event/Event.h>
+#include <kiwano/platform/Keys.h>
 #include <kiwano/math/Math.h>
 
 namespace kiwano
@@ -99,8 +100,9 @@ struct WindowConfig
     uint32_t height = 480;            ///< ڸ߶
     String   title  = "Kiwano Game";  ///< ڱ
     Icon     icon;                    ///< ͼ
-    bool     resizable  = false;      ///< ڴСɵ
-    bool     fullscreen = false;      ///< ȫ
+    bool     resizable      = false;  ///< ڴСɵ
+    bool     fullscreen     = false;  ///< ȫ
+    bool     coalesce_input = false;  ///< ϲƶ͹¼
 };
 
 #if defined(KGE_PLATFORM_WINDOWS)
@@ -231,6 +233,8 @@ public:
     /**
      * \~chinese
      * @brief ѯ¼
+     * @details ڲ¼ֵͼ¼ڶУѯʱ䵽¼
+     * ϴѯõ¼ڲٱúᱻظʹ
      * @return ¼еĵһ¼ӶƳ, Ϊ򷵻ؿָ
      */
     RefPtr<Event> PollEvent();
@@ -248,6 +252,27 @@ public:
      */
     virtual void PumpEvents() = 0;
 
+    /**
+     * \~chinese
+     * @brief û¼ϲ
+     * @details úĩβƶ¼ᱻµƶ¼ǣĹ¼ۼӹֵ
+     * ¼֮˳򲻱
+     */
+    void SetEventCoalescing(bool enabled);
+
+    /**
+     * \~chinese
+     * @brief Ƿ¼ϲ
+     */
+    bool IsEventCoalescing() const;
+
+    /**
+     * \~chinese
+     * @brief ȡƶԭʼλü¼
+     * @details ¼ϴ¼бȡ֮յλã¼ϲӰ
+     */
+    const Vector<Point>& GetMouseMoveHistory() const;
+
     /**
      * \~chinese
      * @brief ǷҪر
@@ -271,6 +296,41 @@ protected:
 
     virtual ~Window();
 
+    /// \~chinese
+    /// @brief ¼¼
+    struct EventRecord
+    {
+        EventType     type;
+        Point         pos;     ///< λ
+        MouseButton   button;  ///< ֵ
+        float         wheel;   ///< ֵ
+        KeyCode       code;    ///< ֵ
+        char          value;   ///< ַ
+        int           x;       ///< ںλ
+        int           y;       ///< λ
+        uint32_t      width;   ///< ڿ
+        uint32_t      height;  ///< ڸ߶
+        bool          focus;   ///< Ƿȡ
+        String        text;    ///< ݻ򴰿ڱ
+        RefPtr<Event> object;  ///< Զʽе¼
+
+        EventRecord();
+
+        EventRecord(const EventType& type);
+    };
+
+    /// \~chinese
+    /// @brief ¼¼
+    void PushEventRecord(EventRecord&& record);
+
+private:
+    RefPtr<Event> MakeEvent(EventRecord& record);
+
+    template <typename _Ty>
+    _Ty* AcquireEvent();
+
+    void GrowEventRing();
+
 protected:
     bool                      should_close_;
     bool                      is_fullscreen_;
@@ -285,7 +345,25 @@ protected:
     Resolution                resolution_;
     WindowHandle              handle_;
     String                    title_;
-    std::queue<RefPtr<Event>> event_queue_;
+
+private:
+    bool                  coalescing_;
+    bool                  history_stale_;
+    size_t                event_head_;
+    size_t                event_count_;
+    Vector<EventRecord>   event_ring_;
+    Vector<RefPtr<Event>> event_cache_;
+    Vector<Point>         mouse_history_;
 };
 
+inline bool Window::IsEventCoalescing() const
+{
+    return coalescing_;
+}
+
+inline const Vector<Point>& Window::GetMouseMoveHistory() const
+{
+    return mouse_history_;
+}
+
 }  // namespace kiwano
@@ -56,11 +56,11 @@ struct ComPolicy
             const auto& native = object->GetNative();
             if (native.HasValue())
             {
-                auto ptr = native.Cast<ComPtr<IUnknown>>();
-                if (ptr)
+                auto ptr = native.CastPtr<ComPtr<IUnknown>>();
+                if (ptr && *ptr)
                 {
                     ComPtr<_Ty> native;
-                    if (SUCCEEDED(ptr->QueryInterface<_Ty>(&native)))
+                    if (SUCCEEDED((*ptr)->QueryInterface<_Ty>(&native)))
                         return native;
                 }
             }
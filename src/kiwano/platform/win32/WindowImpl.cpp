@@ -273,6 +273,7 @@ void WindowWin32Impl::Init(const WindowConfig& config)
     height_        = win_height;
     resizable_     = config.resizable;
     is_fullscreen_ = config.fullscreen;
+    SetEventCoalescing(config.coalesce_input);
 
     handle_ = ::CreateWindowExA(0, "KiwanoAppWnd", config.title.c_str(), GetStyle(), left, top, width_, height_,
                                 nullptr, nullptr, hinst, nullptr);
@@ -527,9 +528,9 @@ LRESULT WindowWin32Impl::MessageProc(HWND hwnd, UINT32 msg, WPARAM wparam, LPARA
         KeyCode key = this->key_map_[size_t(wparam)];
         if (key != KeyCode::Unknown)
         {
-            RefPtr<KeyDownEvent> evt = new KeyDownEvent;
-            evt->code                = key;
-            this->PushEvent(evt);
+            EventRecord record(KGE_EVENT(KeyDownEvent));
+            record.code = key;
+            this->PushEventRecord(std::move(record));
         }
     }
     break;
@@ -540,18 +541,18 @@ LRESULT WindowWin32Impl::MessageProc(HWND hwnd, UINT32 msg, WPARAM wparam, LPARA
         KeyCode key = this->key_map_[size_t(wparam)];
         if (key != KeyCode::Unknown)
         {
-            RefPtr<KeyUpEvent> evt = new KeyUpEvent;
-            evt->code              = key;
-            this->PushEvent(evt);
+            EventRecord record(KGE_EVENT(KeyUpEvent));
+            record.code = key;
+            this->PushEventRecord(std::move(record));
         }
     }
     break;
 
     case WM_CHAR:
     {
-        RefPtr<KeyCharEvent> evt = new KeyCharEvent;
-        evt->value               = char(wparam);
-        this->PushEvent(evt);
+        EventRecord record(KGE_EVENT(KeyCharEvent));
+        record.value = char(wparam);
+        this->PushEventRecord(std::move(record));
     }
     break;
 
@@ -579,9 +580,9 @@ LRESULT WindowWin32Impl::MessageProc(HWND hwnd, UINT32 msg, WPARAM wparam, LPARA
                 ::ImmGetCompositionStringA(hIMC, GCS_RESULTSTR, const_cast<char*>(buf.data()), dwSize);
                 ::ImmReleaseContext(hwnd, hIMC);
 
-                RefPtr<IMEInputEvent> evt = new IMEInputEvent;
-                evt->value                = std::move(buf);
-                this->PushEvent(evt);
+                EventRecord record(KGE_EVENT(IMEInputEvent));
+                record.text = std::move(buf);
+                this->PushEventRecord(std::move(record));
                 return TRUE;
             }
         }
@@ -594,27 +595,27 @@ LRESULT WindowWin32Impl::MessageProc(HWND hwnd, UINT32 msg, WPARAM wparam, LPARA
     case WM_MBUTTONDOWN:
     case WM_MBUTTONDBLCLK:
     {
-        RefPtr<MouseDownEvent> evt = new MouseDownEvent;
-        evt->pos                   = Point((float)GET_X_LPARAM(lparam), (float)GET_Y_LPARAM(lparam));
+        EventRecord record(KGE_EVENT(MouseDownEvent));
+        record.pos = Point((float)GET_X_LPARAM(lparam), (float)GET_Y_LPARAM(lparam));
 
         if (msg == WM_LBUTTONDOWN || msg == WM_LBUTTONDBLCLK)
         {
-            evt->button = MouseButton::Left;
+            record.button = MouseButton::Left;
         }
         else if (msg == WM_RBUTTONDOWN || msg == WM_RBUTTONDBLCLK)
         {
-            evt->button = MouseButton::Right;
+            record.button = MouseButton::Right;
         }
         else if (msg == WM_MBUTTONDOWN || msg == WM_MBUTTONDBLCLK)
         {
-            evt->button = MouseButton::Middle;
+            record.button = MouseButton::Middle;
         }
 
         if (mouse_flag_ == 0 && ::GetCapture() == nullptr)
             ::SetCapture(hwnd);
-        mouse_flag_ |= 1 << int(evt->button);
+        mouse_flag_ |= 1 << int(record.button);
 
-        this->PushEvent(evt);
+        this->PushEventRecord(std::move(record));
     }
     break;
 
@@ -622,44 +623,44 @@ LRESULT WindowWin32Impl::MessageProc(HWND hwnd, UINT32 msg, WPARAM wparam, LPARA
     case WM_MBUTTONUP:
     case WM_RBUTTONUP:
     {
-        RefPtr<MouseUpEvent> evt = new MouseUpEvent;
-        evt->pos                 = Point((float)GET_X_LPARAM(lparam), (float)GET_Y_LPARAM(lparam));
+        EventRecord record(KGE_EVENT(MouseUpEvent));
+        record.pos = Point((float)GET_X_LPARAM(lparam), (float)GET_Y_LPARAM(lparam));
 
         if (msg == WM_LBUTTONUP)
         {
-            evt->button = MouseButton::Left;
+            record.button = MouseButton::Left;
         }
         else if (msg == WM_RBUTTONUP)
         {
-            evt->button = MouseButton::Right;
+            record.button = MouseButton::Right;
         }
         else if (msg == WM_MBUTTONUP)
         {
-            evt->button = MouseButton::Middle;
+            record.button = MouseButton::Middle;
         }
 
-        mouse_flag_ &= ~(1 << int(evt->button));
+        mouse_flag_ &= ~(1 << int(record.button));
         if (mouse_flag_ == 0 && ::GetCapture() == hwnd)
             ::ReleaseCapture();
 
-        this->PushEvent(evt);
+        this->PushEventRecord(std::move(record));
     }
     break;
 
     case WM_MOUSEMOVE:
     {
-        RefPtr<MouseMoveEvent> evt = new MouseMoveEvent;
-        evt->pos                   = Point((float)GET_X_LPARAM(lparam), (float)GET_Y_LPARAM(lparam));
-        this->PushEvent(evt);
+        EventRecord record(KGE_EVENT(MouseMoveEvent));
+        record.pos = Point((float)GET_X_LPARAM(lparam), (float)GET_Y_LPARAM(lparam));
+        this->PushEventRecord(std::move(record));
     }
     break;
 
     case WM_MOUSEWHEEL:
     {
-        RefPtr<MouseWheelEvent> evt = new MouseWheelEvent;
-        evt->pos                    = Point((float)GET_X_LPARAM(lparam), (float)GET_Y_LPARAM(lparam));
-        evt->wheel                  = GET_WHEEL_DELTA_WPARAM(wparam) / (float)WHEEL_DELTA;
-        this->PushEvent(evt);
+        EventRecord record(KGE_EVENT(MouseWheelEvent));
+        record.pos   = Point((float)GET_X_LPARAM(lparam), (float)GET_Y_LPARAM(lparam));
+        record.wheel = GET_WHEEL_DELTA_WPARAM(wparam) / (float)WHEEL_DELTA;
+        this->PushEventRecord(std::move(record));
     }
     break;
 
@@ -712,11 +713,10 @@ LRESULT WindowWin32Impl::MessageProc(HWND hwnd, UINT32 msg, WPARAM wparam, LPARA
             this->width_  = ((uint32_t)(short)LOWORD(lparam));
             this->height_ = ((uint32_t)(short)HIWORD(lparam));
 
-            RefPtr<WindowResizedEvent> evt = new WindowResizedEvent;
-            evt->window                    = this;
-            evt->width                     = this->GetWidth();
-            evt->height                    = this->GetHeight();
-            this->PushEvent(evt);
+            EventRecord record(KGE_EVENT(WindowResizedEvent));
+            record.width  = this->GetWidth();
+            record.height = this->GetHeight();
+            this->PushEventRecord(std::move(record));
 
             KGE_DEBUG_LOGF("Window resized to (%d, %d)", this->width_, this->height_);
         }
@@ -748,11 +748,10 @@ LRESULT WindowWin32Impl::MessageProc(HWND hwnd, UINT32 msg, WPARAM wparam, LPARA
             this->width_  = client_width;
             this->height_ = client_height;
 
-            RefPtr<WindowResizedEvent> evt = new WindowResizedEvent;
-            evt->window                    = this;
-            evt->width                     = client_width;
-            evt->height                    = client_height;
-            this->PushEvent(evt);
+            EventRecord record(KGE_EVENT(WindowResizedEvent));
+            record.width  = client_width;
+            record.height = client_height;
+            this->PushEventRecord(std::move(record));
         }
 
         RECT window_rect = { 0 };
@@ -767,11 +766,10 @@ LRESULT WindowWin32Impl::MessageProc(HWND hwnd, UINT32 msg, WPARAM wparam, LPARA
             this->pos_x_ = window_x;
             this->pos_y_ = window_y;
 
-            RefPtr<WindowMovedEvent> evt = new WindowMovedEvent;
-            evt->window                  = this;
-            evt->x                       = window_x;
-            evt->y                       = window_y;
-            this->PushEvent(evt);
+            EventRecord record(KGE_EVENT(WindowMovedEvent));
+            record.x = window_x;
+            record.y = window_y;
+            this->PushEventRecord(std::move(record));
         }
         return 0;
     }
@@ -806,11 +804,10 @@ LRESULT WindowWin32Impl::MessageProc(HWND hwnd, UINT32 msg, WPARAM wparam, LPARA
             this->pos_x_ = window_x;
             this->pos_y_ = window_y;
 
-            RefPtr<WindowMovedEvent> evt = new WindowMovedEvent;
-            evt->window                  = this;
-            evt->x                       = window_x;
-            evt->y                       = window_y;
-            this->PushEvent(evt);
+            EventRecord record(KGE_EVENT(WindowMovedEvent));
+            record.x = window_x;
+            record.y = window_y;
+            this->PushEventRecord(std::move(record));
         }
     }
     break;
@@ -826,10 +823,9 @@ LRESULT WindowWin32Impl::MessageProc(HWND hwnd, UINT32 msg, WPARAM wparam, LPARA
     {
         bool active = (LOWORD(wparam) != WA_INACTIVE);
 
-        RefPtr<WindowFocusChangedEvent> evt = new WindowFocusChangedEvent;
-        evt->window                         = this;
-        evt->focus                          = active;
-        this->PushEvent(evt);
+        EventRecord record(KGE_EVENT(WindowFocusChangedEvent));
+        record.focus = active;
+        this->PushEventRecord(std::move(record));
     }
     break;
 
@@ -857,10 +853,9 @@ LRESULT WindowWin32Impl::MessageProc(HWND hwnd, UINT32 msg, WPARAM wparam, LPARA
 
         this->title_ = strings::WideToNarrow(reinterpret_cast<LPCWSTR>(lparam));
 
-        RefPtr<WindowTitleChangedEvent> evt = new WindowTitleChangedEvent;
-        evt->window                         = this;
-        evt->title                          = this->title_;
-        this->PushEvent(evt);
+        EventRecord record(KGE_EVENT(WindowTitleChangedEvent));
+        record.text = this->title_;
+        this->PushEventRecord(std::move(record));
     }
     break;
 
@@ -886,9 +881,8 @@ LRESULT WindowWin32Impl::MessageProc(HWND hwnd, UINT32 msg, WPARAM wparam, LPARA
     {
         KGE_DEBUG_LOGF("Window is closing");
 
-        RefPtr<WindowClosedEvent> evt = new WindowClosedEvent;
-        evt->window                   = this;
-        this->PushEvent(evt);
+        EventRecord record(KGE_EVENT(WindowClosedEvent));
+        this->PushEventRecord(std::move(record));
         this->SetShouldClose(true);
         return 0;
     }
@@ -22,6 +22,9 @@
 #include <kiwano/render/Brush.h>
 #include <kiwano/render/Renderer.h>
 
+#include <kiwano/render/Software/Paint.h>
+#include <kiwano/render/Software/helper.h>
+
 #if KGE_RENDER_ENGINE == KGE_RENDER_ENGINE_DIRECTX
 #include <kiwano/render/DirectX/helper.h>
 #endif
@@ -124,16 +127,20 @@ void Brush::SetTransform(const Transform& transform)
 void Brush::SetTransform(const Matrix3x2& transform)
 {
 #if KGE_RENDER_ENGINE == KGE_RENDER_ENGINE_DIRECTX
-    auto native = ComPolicy::Get<ID2D1Brush>(this);
+    if (auto native = ComPolicy::Get<ID2D1Brush>(this))
+    {
+        native->SetTransform(DX::ConvertToMatrix3x2F(transform));
+        return;
+    }
+#endif
+
+    auto native = graphics::software::SoftwarePolicy::Get<graphics::software::Paint>(this);
     KGE_ASSERT(native);
 
     if (native)
     {
-        native->SetTransform(DX::ConvertToMatrix3x2F(transform));
+        native->SetTransform(transform);
     }
-#else
-    // not supported
-#endif
 }
 
 }  // namespace kiwano
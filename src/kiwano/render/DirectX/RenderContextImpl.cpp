@@ -105,6 +105,8 @@ void RenderContextImpl::EndDraw()
 {
     KGE_ASSERT(render_ctx_ && "Render target has not been initialized!");
 
+    FlushSprites();
+
     HRESULT hr = render_ctx_->EndDraw();
     KGE_THROW_IF_FAILED(hr, "ID2D1RenderTarget EndDraw failed");
 
@@ -133,6 +135,8 @@ void RenderContextImpl::DrawTexture(const Texture& texture, const Rect* src_rect
 {
     KGE_ASSERT(render_ctx_ && "Render target has not been initialized!");
 
+    FlushSprites();
+
     if (texture.IsValid())
     {
         D2D1_BITMAP_INTERPOLATION_MODE mode;
@@ -153,11 +157,53 @@ void RenderContextImpl::DrawTexture(const Texture& texture, const Rect* src_rect
     }
 }
 
+void RenderContextImpl::DrawTextureBatch(const Texture& texture, const SpriteQuad* quads, size_t count)
+{
+    KGE_ASSERT(render_ctx_ && "Render target has not been initialized!");
+
+    if (!texture.IsValid() || count == 0)
+        return;
+
+    D2D1_BITMAP_INTERPOLATION_MODE mode;
+    if (texture.GetBitmapInterpolationMode() == InterpolationMode::Linear)
+    {
+        mode = D2D1_BITMAP_INTERPOLATION_MODE_LINEAR;
+    }
+    else
+    {
+        mode = D2D1_BITMAP_INTERPOLATION_MODE_NEAREST_NEIGHBOR;
+    }
+
+    // Set the device transform directly to bypass the state tracking of SetTransform
+    auto bitmap = ComPolicy::Get<ID2D1Bitmap>(texture);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const SpriteQuad& quad = quads[i];
+        if (fast_global_transform_)
+        {
+            render_ctx_->SetTransform(DX::ConvertToMatrix3x2F(&quad.transform));
+        }
+        else
+        {
+            Matrix3x2 result = quad.transform * global_transform_;
+            render_ctx_->SetTransform(DX::ConvertToMatrix3x2F(&result));
+        }
+
+        render_ctx_->DrawBitmap(bitmap.Get(), DX::ConvertToRectF(&quad.dest_rect), quad.opacity, mode,
+                                DX::ConvertToRectF(&quad.src_rect));
+    }
+
+    brush_opacity_ = quads[count - 1].opacity;
+    IncreasePrimitivesCount(uint32_t(count));
+}
+
 void RenderContextImpl::DrawTextLayout(const TextLayout& layout, const Point& offset,
                                        RefPtr<Brush> current_outline_brush)
 {
     KGE_ASSERT(text_renderer_ && "Text renderer has not been initialized!");
 
+    FlushSprites();
+
     if (layout.IsValid())
     {
         auto  native         = ComPolicy::Get<IDWriteTextLayout>(layout);
@@ -200,6 +246,8 @@ void RenderContextImpl::DrawShape(const Shape& shape)
     KGE_ASSERT(render_ctx_ && "Render target has not been initialized!");
     KGE_ASSERT(current_brush_ && "The brush used for rendering has not been set!");
 
+    FlushSprites();
+
     if (shape.IsValid())
     {
         auto  geometry     = ComPolicy::Get<ID2D1Geometry>(shape);
@@ -218,6 +266,8 @@ void RenderContextImpl::DrawLine(const Point& point1, const Point& point2)
     KGE_ASSERT(render_ctx_ && "Render target has not been initialized!");
     KGE_ASSERT(current_brush_ && "The brush used for rendering has not been set!");
 
+    FlushSprites();
+
     auto  brush        = ComPolicy::Get<ID2D1Brush>(current_brush_);
     auto  stroke_style = ComPolicy::Get<ID2D1StrokeStyle>(current_stroke_);
     float stroke_width = current_stroke_ ? current_stroke_->GetWidth() : 1.0f;
@@ -233,6 +283,8 @@ void RenderContextImpl::DrawRectangle(const Rect& rect)
     KGE_ASSERT(render_ctx_ && "Render target has not been initialized!");
     KGE_ASSERT(current_brush_ && "The brush used for rendering has not been set!");
 
+    FlushSprites();
+
     auto  brush        = ComPolicy::Get<ID2D1Brush>(current_brush_);
     auto  stroke_style = ComPolicy::Get<ID2D1StrokeStyle>(current_stroke_);
     float stroke_width = current_stroke_ ? current_stroke_->GetWidth() : 1.0f;
@@ -247,6 +299,8 @@ void RenderContextImpl::DrawRoundedRectangle(const Rect& rect, const Vec2& radiu
     KGE_ASSERT(render_ctx_ && "Render target has not been initialized!");
     KGE_ASSERT(current_brush_ && "The brush used for rendering has not been set!");
 
+    FlushSprites();
+
     auto  brush        = ComPolicy::Get<ID2D1Brush>(current_brush_);
     auto  stroke_style = ComPolicy::Get<ID2D1StrokeStyle>(current_stroke_);
     float stroke_width = current_stroke_ ? current_stroke_->GetWidth() : 1.0f;
@@ -262,6 +316,8 @@ void RenderContextImpl::DrawEllipse(const Point& center, const Vec2& radius)
     KGE_ASSERT(render_ctx_ && "Render target has not been initialized!");
     KGE_ASSERT(current_brush_ && "The brush used for rendering has not been set!");
 
+    FlushSprites();
+
     auto  brush        = ComPolicy::Get<ID2D1Brush>(current_brush_);
     auto  stroke_style = ComPolicy::Get<ID2D1StrokeStyle>(current_stroke_);
     float stroke_width = current_stroke_ ? current_stroke_->GetWidth() : 1.0f;
@@ -277,6 +333,8 @@ void RenderContextImpl::FillShape(const Shape& shape)
     KGE_ASSERT(render_ctx_ && "Render target has not been initialized!");
     KGE_ASSERT(current_brush_ && "The brush used for rendering has not been set!");
 
+    FlushSprites();
+
     if (shape.IsValid())
     {
         auto brush    = ComPolicy::Get<ID2D1Brush>(current_brush_);
@@ -292,6 +350,8 @@ void RenderContextImpl::FillRectangle(const Rect& rect)
     KGE_ASSERT(render_ctx_ && "Render target has not been initialized!");
     KGE_ASSERT(current_brush_ && "The brush used for rendering has not been set!");
 
+    FlushSprites();
+
     auto brush = ComPolicy::Get<ID2D1Brush>(current_brush_);
     render_ctx_->FillRectangle(DX::ConvertToRectF(rect), brush.Get());
 
@@ -303,6 +363,8 @@ void RenderContextImpl::FillRoundedRectangle(const Rect& rect, const Vec2& radiu
     KGE_ASSERT(render_ctx_ && "Render target has not been initialized!");
     KGE_ASSERT(current_brush_ && "The brush used for rendering has not been set!");
 
+    FlushSprites();
+
     auto brush = ComPolicy::Get<ID2D1Brush>(current_brush_);
     render_ctx_->FillRoundedRectangle(D2D1::RoundedRect(DX::ConvertToRectF(rect), radius.x, radius.y), brush.Get());
 
@@ -314,6 +376,8 @@ void RenderContextImpl::FillEllipse(const Point& center, const Vec2& radius)
     KGE_ASSERT(render_ctx_ && "Render target has not been initialized!");
     KGE_ASSERT(current_brush_ && "The brush used for rendering has not been set!");
 
+    FlushSprites();
+
     auto brush = ComPolicy::Get<ID2D1Brush>(current_brush_);
     render_ctx_->FillEllipse(D2D1::Ellipse(DX::ConvertToPoint2F(center), radius.x, radius.y), brush.Get());
 
@@ -324,6 +388,8 @@ void RenderContextImpl::PushClipRect(const Rect& clip_rect)
 {
     KGE_ASSERT(render_ctx_ && "Render target has not been initialized!");
 
+    FlushSprites();
+
     D2D1_ANTIALIAS_MODE mode;
     if (antialias_)
     {
@@ -339,6 +405,8 @@ void RenderContextImpl::PushClipRect(const Rect& clip_rect)
 void RenderContextImpl::PopClipRect()
 {
     KGE_ASSERT(render_ctx_ && "Render target has not been initialized!");
+
+    FlushSprites();
     render_ctx_->PopAxisAlignedClip();
 }
 
@@ -346,6 +414,8 @@ void RenderContextImpl::PushLayer(Layer& layer)
 {
     KGE_ASSERT(render_ctx_ && "Render target has not been initialized!");
 
+    FlushSprites();
+
     auto mask   = ComPolicy::Get<ID2D1Geometry>(layer.mask);
     auto params = D2D1::LayerParameters1(DX::ConvertToRectF(layer.bounds), mask.Get(),
                                          antialias_ ? D2D1_ANTIALIAS_MODE_PER_PRIMITIVE : D2D1_ANTIALIAS_MODE_ALIASED,
@@ -358,18 +428,24 @@ void RenderContextImpl::PushLayer(Layer& layer)
 void RenderContextImpl::PopLayer()
 {
     KGE_ASSERT(render_ctx_ && "Render target has not been initialized!");
+
+    FlushSprites();
     render_ctx_->PopLayer();
 }
 
 void RenderContextImpl::Clear()
 {
     KGE_ASSERT(render_ctx_ && "Render target has not been initialized!");
+
+    FlushSprites();
     render_ctx_->Clear();
 }
 
 void RenderContextImpl::Clear(const Color& clear_color)
 {
     KGE_ASSERT(render_ctx_ && "Render target has not been initialized!");
+
+    FlushSprites();
     render_ctx_->Clear(DX::ConvertToColorF(clear_color));
 }
 
@@ -413,6 +489,8 @@ void RenderContextImpl::SetTransform(const Matrix3x2& matrix)
 {
     KGE_ASSERT(render_ctx_ && "Render target has not been initialized!");
 
+    FlushSprites();
+
     if (fast_global_transform_)
     {
         render_ctx_->SetTransform(DX::ConvertToMatrix3x2F(&matrix));
@@ -427,6 +505,8 @@ void RenderContextImpl::SetTransform(const Matrix3x2& matrix)
 void RenderContextImpl::SetBlendMode(BlendMode blend)
 {
     KGE_ASSERT(render_ctx_ && "Render target has not been initialized!");
+
+    FlushSprites();
     render_ctx_->SetPrimitiveBlend(D2D1_PRIMITIVE_BLEND(blend));
 }
 
@@ -434,6 +514,8 @@ void RenderContextImpl::SetAntialiasMode(bool enabled)
 {
     KGE_ASSERT(render_ctx_ && "Render target has not been initialized!");
 
+    FlushSprites();
+
     render_ctx_->SetAntialiasMode(enabled ? D2D1_ANTIALIAS_MODE_PER_PRIMITIVE : D2D1_ANTIALIAS_MODE_ALIASED);
     antialias_ = enabled;
 }
@@ -442,6 +524,8 @@ void RenderContextImpl::SetTextAntialiasMode(TextAntialiasMode mode)
 {
     KGE_ASSERT(render_ctx_ && "Render target has not been initialized!");
 
+    FlushSprites();
+
     D2D1_TEXT_ANTIALIAS_MODE antialias_mode = D2D1_TEXT_ANTIALIAS_MODE_CLEARTYPE;
     switch (mode)
     {
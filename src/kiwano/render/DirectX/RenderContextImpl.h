@@ -100,6 +100,9 @@ public:
 
     RefPtr<Texture> GetTarget() const override;
 
+protected:
+    void DrawTextureBatch(const Texture& texture, const SpriteQuad* quads, size_t count) override;
+
 private:
     void DiscardDeviceResources();
 
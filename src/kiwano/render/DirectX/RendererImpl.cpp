@@ -67,11 +67,6 @@ inline const GUID& ConvertPixelFormat2WIC(PixelFormat format, UINT& stride)
     }
 }
 
-Renderer& Renderer::GetInstance()
-{
-    return RendererImpl::GetInstance();
-}
-
 RendererImpl& RendererImpl::GetInstance()
 {
     static RendererImpl instance;
@@ -380,6 +375,63 @@ void RendererImpl::CreateTexture(Texture& texture, const PixelSize& size, const
     KGE_SET_STATUS_IF_FAILED(hr, texture, "Load texture from memory failed");
 }
 
+bool RendererImpl::DecodeImage(const BinaryData& data, PixelSize& size, Vector<uint8_t>& pixels)
+{
+    // WIC objects are free-threaded, so decoding may run on any thread while the
+    // device context stays on the main thread
+    HRESULT hr = S_OK;
+    if (!d2d_res_)
+    {
+        hr = E_UNEXPECTED;
+    }
+
+    if (SUCCEEDED(hr))
+    {
+        hr = data.IsValid() ? S_OK : E_FAIL;
+    }
+
+    ComPtr<IWICBitmapDecoder> decoder;
+    if (SUCCEEDED(hr))
+    {
+        hr = d2d_res_->CreateBitmapDecoderFromResource(decoder, data.buffer, (DWORD)data.size);
+    }
+
+    ComPtr<IWICBitmapFrameDecode> source;
+    if (SUCCEEDED(hr))
+    {
+        hr = decoder->GetFrame(0, &source);
+    }
+
+    ComPtr<IWICFormatConverter> converter;
+    if (SUCCEEDED(hr))
+    {
+        hr = d2d_res_->CreateBitmapConverter(converter, source, GUID_WICPixelFormat32bppBGRA, WICBitmapDitherTypeNone,
+                                             nullptr, 0.f, WICBitmapPaletteTypeMedianCut);
+    }
+
+    UINT width = 0, height = 0;
+    if (SUCCEEDED(hr))
+    {
+        hr = converter->GetSize(&width, &height);
+    }
+
+    if (SUCCEEDED(hr))
+    {
+        const UINT stride = width * 4;
+        pixels.resize(size_t(stride) * height);
+        hr = converter->CopyPixels(nullptr, stride, UINT(pixels.size()), reinterpret_cast<BYTE*>(pixels.data()));
+    }
+
+    if (FAILED(hr))
+    {
+        pixels.clear();
+        return false;
+    }
+
+    size = { width, height };
+    return true;
+}
+
 /*
 void RendererImpl::CreateTexture(Texture& texture, const PixelSize& size, const BinaryData& data, PixelFormat format)
 {
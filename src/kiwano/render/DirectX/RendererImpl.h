@@ -37,6 +37,8 @@ public:
 
     void CreateTexture(Texture& texture, const PixelSize& size, const BinaryData& data, PixelFormat format) override;
 
+    bool DecodeImage(const BinaryData& data, PixelSize& size, Vector<uint8_t>& pixels) override;
+
     void CreateGifImage(GifImage& gif, StringView file_path) override;
 
     void CreateGifImage(GifImage& gif, const BinaryData& data) override;
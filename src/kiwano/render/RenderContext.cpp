@@ -31,8 +31,11 @@ RefPtr<RenderContext> RenderContext::Create(RefPtr<Texture> texture, const Pixel
 
 RenderContext::RenderContext()
     : collecting_status_(false)
+    , flushing_sprites_(false)
+    , state_deferred_(false)
     , fast_global_transform_(true)
     , brush_opacity_(1.0f)
+    , deferred_opacity_(1.0f)
     , antialias_(true)
     , text_antialias_(TextAntialiasMode::GrayScale)
 {
@@ -42,8 +45,10 @@ void RenderContext::BeginDraw()
 {
     if (collecting_status_)
     {
-        status_.start      = Time::Now();
-        status_.primitives = 0;
+        status_.start           = Time::Now();
+        status_.primitives      = 0;
+        status_.batches         = 0;
+        status_.batched_sprites = 0;
     }
 }
 
@@ -85,19 +90,87 @@ const Matrix3x2& RenderContext::GetGlobalTransform() const
 
 void RenderContext::SetBrushOpacity(float opacity)
 {
+    FlushSprites();
     brush_opacity_ = opacity;
 }
 
 void RenderContext::SetCurrentBrush(RefPtr<Brush> brush)
 {
+    FlushSprites();
     current_brush_ = brush;
 }
 
 void RenderContext::SetCurrentStrokeStyle(RefPtr<StrokeStyle> stroke)
 {
+    FlushSprites();
     current_stroke_ = stroke;
 }
 
+void RenderContext::DrawSprite(Texture& texture, const Rect& src_rect, const Rect& dest_rect,
+                               const Matrix3x2& transform, float opacity)
+{
+    if (!texture.IsValid())
+        return;
+
+    if (!sprite_batch_.IsCompatible(texture))
+    {
+        FlushSprites();
+    }
+    sprite_batch_.Add(texture, src_rect, dest_rect, transform, opacity);
+}
+
+void RenderContext::DeferTransformAndOpacity(const Matrix3x2& transform, float opacity)
+{
+    deferred_transform_ = transform;
+    deferred_opacity_   = opacity;
+    state_deferred_     = true;
+}
+
+void RenderContext::FlushSprites()
+{
+    // The batch may call back into state setters while it is being drawn
+    if (flushing_sprites_)
+        return;
+
+    if (!sprite_batch_.IsEmpty())
+        SubmitSprites();
+
+    // Restored before anything else is drawn, the setters come back here with nothing deferred
+    if (state_deferred_)
+    {
+        state_deferred_ = false;
+        SetTransform(deferred_transform_);
+        SetBrushOpacity(deferred_opacity_);
+    }
+}
+
+void RenderContext::SubmitSprites()
+{
+    flushing_sprites_ = true;
+
+    const auto& quads = sprite_batch_.GetQuads();
+    DrawTextureBatch(*sprite_batch_.GetTexture(), quads.data(), quads.size());
+
+    if (collecting_status_)
+    {
+        status_.batches += 1;
+        status_.batched_sprites += uint32_t(quads.size());
+    }
+
+    sprite_batch_.Clear();
+    flushing_sprites_ = false;
+}
+
+void RenderContext::DrawTextureBatch(const Texture& texture, const SpriteQuad* quads, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        SetTransform(quads[i].transform);
+        SetBrushOpacity(quads[i].opacity);
+        DrawTexture(texture, &quads[i].src_rect, &quads[i].dest_rect);
+    }
+}
+
 void RenderContext::DrawCircle(const Point& center, float radius)
 {
     this->DrawEllipse(center, Vec2(radius, radius));
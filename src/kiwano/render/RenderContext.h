@@ -23,6 +23,7 @@
 #include <kiwano/render/Brush.h>
 #include <kiwano/render/Shape.h>
 #include <kiwano/render/Layer.h>
+#include <kiwano/render/SpriteBatch.h>
 #include <kiwano/render/TextLayout.h>
 #include <kiwano/render/Texture.h>
 
@@ -89,6 +90,28 @@ public:
     virtual void DrawTexture(const Texture& texture, const Rect* src_rect = nullptr,
                              const Rect* dest_rect = nullptr) = 0;
 
+    /// \~chinese
+    /// @brief ƾ
+    /// @details ƵͬһľϲΪһΣȾ״̬ıͼԪʱͳһύ
+    /// @param texture 
+    /// @param src_rect Դü
+    /// @param dest_rect ƵĿ
+    /// @param transform ά任ĵǰĶά任
+    /// @param opacity ͸ȣĵǰĻˢ͸
+    void DrawSprite(Texture& texture, const Rect& src_rect, const Rect& dest_rect, const Matrix3x2& transform,
+                    float opacity);
+
+    /// \~chinese
+    /// @brief ӳöά任ͻˢ͸
+    /// @details һύλͼԪǰЧľ鲻Ϊ״̬ж
+    /// @param transform ά任
+    /// @param opacity ˢ͸
+    void DeferTransformAndOpacity(const Matrix3x2& transform, float opacity);
+
+    /// \~chinese
+    /// @brief ύǰľΣӦӳõ״̬
+    void FlushSprites();
+
     /// \~chinese
     /// @brief ı
     /// @param layout ı
@@ -250,9 +273,11 @@ public:
     /// @brief Ⱦ״̬
     struct Status
     {
-        uint32_t primitives;  ///< ȾͼԪ
-        Time     start;       ///< Ⱦʼʱ
-        Duration duration;    ///< Ⱦʱ
+        uint32_t primitives;       ///< ȾͼԪ
+        uint32_t batches;          ///< ύľ
+        uint32_t batched_sprites;  ///< ͨλƵľ
+        Time     start;            ///< Ⱦʼʱ
+        Duration duration;         ///< Ⱦʱ
 
         Status();
     };
@@ -272,16 +297,33 @@ protected:
     /// @brief ȾͼԪ
     void IncreasePrimitivesCount(uint32_t increase = 1) const;
 
+    /// \~chinese
+    /// @brief һ
+    /// @details Ĭʵöά任͸Ⱥ DrawTextureȾ˿ظúԼ״̬л
+    /// ɺĵĶά任ͻˢ͸ӦһͼԪһ
+    /// @param texture 
+    /// @param quads ͼԪ
+    /// @param count ͼԪ
+    virtual void DrawTextureBatch(const Texture& texture, const SpriteQuad* quads, size_t count);
+
+private:
+    void SubmitSprites();
+
 protected:
     bool                antialias_;
     bool                fast_global_transform_;
     mutable bool        collecting_status_;
+    bool                flushing_sprites_;
+    bool                state_deferred_;
     float               brush_opacity_;
+    float               deferred_opacity_;
     TextAntialiasMode   text_antialias_;
     RefPtr<Brush>       current_brush_;
     RefPtr<StrokeStyle> current_stroke_;
     Rect                visible_size_;
     Matrix3x2           global_transform_;
+    Matrix3x2           deferred_transform_;
+    SpriteBatch         sprite_batch_;
     mutable Status      status_;
 };
 
@@ -289,6 +331,8 @@ protected:
 
 inline RenderContext::Status::Status()
     : primitives(0)
+    , batches(0)
+    , batched_sprites(0)
 {
 }
 
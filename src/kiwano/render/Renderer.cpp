@@ -19,11 +19,70 @@
 // THE SOFTWARE.
 
 #include <kiwano/render/Renderer.h>
+#include <kiwano/render/Software/SoftwareRenderer.h>
 #include <kiwano/event/WindowEvent.h>
+#include <kiwano/utils/Logger.h>
+
+#if KGE_RENDER_ENGINE == KGE_RENDER_ENGINE_DIRECTX
+#include <kiwano/render/DirectX/RendererImpl.h>
+#endif
 
 namespace kiwano
 {
 
+namespace
+{
+
+RendererType renderer_type   = RendererType::Auto;
+bool         renderer_in_use = false;
+
+}  // namespace
+
+Renderer& Renderer::GetInstance()
+{
+    if (!renderer_in_use)
+    {
+        // The type is fixed once any resource may have been created by the renderer
+        renderer_in_use = true;
+
+        if (renderer_type == RendererType::Auto)
+        {
+#if KGE_RENDER_ENGINE == KGE_RENDER_ENGINE_DIRECTX && !defined(KGE_USE_SOFTWARE_RENDERER)
+            renderer_type = RendererType::DirectX;
+#else
+            renderer_type = RendererType::Software;
+#endif
+        }
+    }
+
+#if KGE_RENDER_ENGINE == KGE_RENDER_ENGINE_DIRECTX
+    if (renderer_type == RendererType::DirectX)
+    {
+        return RendererImpl::GetInstance();
+    }
+#endif
+    return SoftwareRenderer::GetInstance();
+}
+
+bool Renderer::SetType(RendererType type)
+{
+    if (renderer_in_use)
+        return type == renderer_type;
+
+#if KGE_RENDER_ENGINE != KGE_RENDER_ENGINE_DIRECTX
+    if (type == RendererType::DirectX)
+        return false;
+#endif
+
+    renderer_type = type;
+    return true;
+}
+
+RendererType Renderer::GetType()
+{
+    return renderer_type;
+}
+
 Renderer::Renderer()
     : vsync_(true)
     , auto_reset_resolution_(true)
@@ -46,6 +105,12 @@ void Renderer::ResetResolutionWhenWindowResized(bool enabled)
     auto_reset_resolution_ = enabled;
 }
 
+void Renderer::MakeOffscreenContext(const PixelSize& size)
+{
+    KGE_NOT_USED(size);
+    KGE_THROW("Offscreen rendering is not supported by the current render engine");
+}
+
 void Renderer::Destroy()
 {
     FontCache::GetInstance().Clear();
@@ -39,6 +39,17 @@ namespace kiwano
  * @{
  */
 
+/**
+ * \~chinese
+ * @brief Ⱦ
+ */
+enum class RendererType
+{
+    Auto,      ///< ԶѡWindows ƽ̨Ĭʹ DirectX KGE_USE_SOFTWARE_RENDERER ʱĬʹȾ
+    DirectX,   ///< DirectX Ⱦ Windows ƽ̨
+    Software,  ///< Ⱦ CPU ϹդԿ
+};
+
 /**
  * \~chinese
  * @brief Ⱦ
@@ -50,6 +61,16 @@ public:
     /// @brief ȡʵ
     static Renderer& GetInstance();
 
+    /// \~chinese
+    /// @brief Ⱦ
+    /// @details ڵһλȡȾʵ֮ǰ
+    /// @return ȾѾʹûǰƽָ̨֧ʱ false
+    static bool SetType(RendererType type);
+
+    /// \~chinese
+    /// @brief ȡȾͣȾʹú Auto ᱻ滻Ϊʵʵ
+    static RendererType GetType();
+
     /// \~chinese
     /// @brief ȡɫ
     virtual Color GetClearColor() const;
@@ -98,6 +119,15 @@ public:
     /// @param[in] format ظʽ
     virtual void CreateTexture(Texture& texture, const PixelSize& size, const BinaryData& data, PixelFormat format) = 0;
 
+    /// \~chinese
+    /// @brief ͼƬ
+    /// @details Ⱦ豸ں̵̨߳ãͨ CreateTexture 
+    /// @param[in] data ͼƬ
+    /// @param[out] size ͼƬС
+    /// @param[out] pixels Ԥ˵ BGRA 
+    /// @return Ƿɹ
+    virtual bool DecodeImage(const BinaryData& data, PixelSize& size, Vector<uint8_t>& pixels) = 0;
+
     /// \~chinese
     /// @brief GIFͼڲԴ
     /// @param[out] gif GIFͼ
@@ -229,6 +259,12 @@ public:
     /// @throw kiwano::SystemError ʧʱ׳
     virtual void MakeContextForWindow(RefPtr<Window> window) = 0;
 
+    /// \~chinese
+    /// @brief ڵȾģͷģʽ
+    /// @param size ȾС
+    /// @throw kiwano::RuntimeError ǰȾ治֧Ⱦʱ׳
+    virtual void MakeOffscreenContext(const PixelSize& size);
+
     /// \~chinese
     /// @brief ȾԴ
     virtual void Destroy();
@@ -22,6 +22,9 @@
 #include <kiwano/render/ShapeMaker.h>
 #include <kiwano/render/Renderer.h>
 
+#include <kiwano/render/Software/Geometry.h>
+#include <kiwano/render/Software/helper.h>
+
 #if KGE_RENDER_ENGINE == KGE_RENDER_ENGINE_DIRECTX
 #include <kiwano/render/DirectX/helper.h>
 #endif
@@ -39,99 +42,121 @@ void Shape::Clear()
 Rect Shape::GetBoundingBox() const
 {
 #if KGE_RENDER_ENGINE == KGE_RENDER_ENGINE_DIRECTX
-    Rect bounds;
-    auto geometry = ComPolicy::Get<ID2D1Geometry>(this);
-    if (geometry)
+    if (auto geometry = ComPolicy::Get<ID2D1Geometry>(this))
     {
+        Rect bounds;
         // no matter it failed or not
         geometry->GetBounds(nullptr, DX::ConvertToRectF(&bounds));
+        return bounds;
     }
-    return bounds;
-#else
-    return Rect();  // not supported
 #endif
+
+    auto geometry = graphics::software::SoftwarePolicy::Get<graphics::software::Geometry>(this);
+    if (geometry)
+    {
+        return geometry->GetBounds(nullptr);
+    }
+    return Rect();
 }
 
 Rect Shape::GetBoundingBox(const Matrix3x2& transform) const
 {
 #if KGE_RENDER_ENGINE == KGE_RENDER_ENGINE_DIRECTX
-    Rect bounds;
-    auto geometry = ComPolicy::Get<ID2D1Geometry>(this);
-    if (geometry)
+    if (auto geometry = ComPolicy::Get<ID2D1Geometry>(this))
     {
+        Rect bounds;
         // no matter it failed or not
         geometry->GetBounds(DX::ConvertToMatrix3x2F(transform), DX::ConvertToRectF(&bounds));
+        return bounds;
     }
-    return bounds;
-#else
-    return Rect();  // not supported
 #endif
+
+    auto geometry = graphics::software::SoftwarePolicy::Get<graphics::software::Geometry>(this);
+    if (geometry)
+    {
+        return geometry->GetBounds(&transform);
+    }
+    return Rect();
 }
 
 float Shape::GetLength() const
 {
 #if KGE_RENDER_ENGINE == KGE_RENDER_ENGINE_DIRECTX
-    float length   = 0.f;
-    auto  geometry = ComPolicy::Get<ID2D1Geometry>(this);
-    if (geometry)
+    if (auto geometry = ComPolicy::Get<ID2D1Geometry>(this))
     {
+        float length = 0.f;
         // no matter it failed or not
         geometry->ComputeLength(D2D1::Matrix3x2F::Identity(), &length);
+        return length;
     }
-    return length;
-#else
-    return 0.0f;  // not supported
 #endif
+
+    auto geometry = graphics::software::SoftwarePolicy::Get<graphics::software::Geometry>(this);
+    if (geometry)
+    {
+        return geometry->ComputeLength();
+    }
+    return 0.0f;
 }
 
 bool Shape::ComputePointAtLength(float length, Point& point, Vec2& tangent) const
 {
 #if KGE_RENDER_ENGINE == KGE_RENDER_ENGINE_DIRECTX
-    auto geometry = ComPolicy::Get<ID2D1Geometry>(this);
-    if (geometry)
+    if (auto geometry = ComPolicy::Get<ID2D1Geometry>(this))
     {
         HRESULT hr = geometry->ComputePointAtLength(length, D2D1::Matrix3x2F::Identity(), DX::ConvertToPoint2F(&point),
                                                     DX::ConvertToPoint2F(&tangent));
 
         return SUCCEEDED(hr);
     }
-    return false;
-#else
-    return false;  // not supported
 #endif
+
+    auto geometry = graphics::software::SoftwarePolicy::Get<graphics::software::Geometry>(this);
+    if (geometry)
+    {
+        return geometry->ComputePointAtLength(length, point, tangent);
+    }
+    return false;
 }
 
 float Shape::ComputeArea() const
 {
 #if KGE_RENDER_ENGINE == KGE_RENDER_ENGINE_DIRECTX
-    auto geometry = ComPolicy::Get<ID2D1Geometry>(this);
-    if (geometry)
+    if (auto geometry = ComPolicy::Get<ID2D1Geometry>(this))
     {
         float area = 0.f;
         // no matter it failed or not
         geometry->ComputeArea(D2D1::Matrix3x2F::Identity(), &area);
+        return area;
     }
-    return 0.f;
-#else
-    return 0.0f;  // not supported
 #endif
+
+    auto geometry = graphics::software::SoftwarePolicy::Get<graphics::software::Geometry>(this);
+    if (geometry)
+    {
+        return geometry->ComputeArea();
+    }
+    return 0.0f;
 }
 
 bool Shape::ContainsPoint(const Point& point, const Matrix3x2* transform) const
 {
 #if KGE_RENDER_ENGINE == KGE_RENDER_ENGINE_DIRECTX
-    auto geometry = ComPolicy::Get<ID2D1Geometry>(this);
+    if (auto geometry = ComPolicy::Get<ID2D1Geometry>(this))
+    {
+        BOOL ret = 0;
+        // no matter it failed or not
+        geometry->FillContainsPoint(DX::ConvertToPoint2F(point), DX::ConvertToMatrix3x2F(transform),
+                                    D2D1_DEFAULT_FLATTENING_TOLERANCE, &ret);
+        return !!ret;
+    }
+#endif
+
+    auto geometry = graphics::software::SoftwarePolicy::Get<graphics::software::Geometry>(this);
     if (!geometry)
         return false;
 
-    BOOL ret = 0;
-    // no matter it failed or not
-    geometry->FillContainsPoint(DX::ConvertToPoint2F(point), DX::ConvertToMatrix3x2F(transform),
-                                D2D1_DEFAULT_FLATTENING_TOLERANCE, &ret);
-    return !!ret;
-#else
-    return false;  // not supported
-#endif
+    return geometry->FillContainsPoint(point, transform);
 }
 
 RefPtr<Shape> Shape::CreateLine(const Point& begin, const Point& end)
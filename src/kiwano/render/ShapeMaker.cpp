@@ -21,6 +21,9 @@
 #include <kiwano/render/ShapeMaker.h>
 #include <kiwano/render/Renderer.h>
 
+#include <kiwano/render/Software/Geometry.h>
+#include <kiwano/render/Software/helper.h>
+
 #if KGE_RENDER_ENGINE == KGE_RENDER_ENGINE_DIRECTX
 #include <kiwano/render/DirectX/helper.h>
 #endif
@@ -59,11 +62,16 @@ void ShapeMaker::BeginPath(const Point& begin_pos)
     }
 
 #if KGE_RENDER_ENGINE == KGE_RENDER_ENGINE_DIRECTX
-    auto native = ComPolicy::Get<ID2D1GeometrySink>(this);
-    native->BeginFigure(DX::ConvertToPoint2F(begin_pos), D2D1_FIGURE_BEGIN_FILLED);
-#else
-    // not supported
+    if (auto native = ComPolicy::Get<ID2D1GeometrySink>(this))
+    {
+        native->BeginFigure(DX::ConvertToPoint2F(begin_pos), D2D1_FIGURE_BEGIN_FILLED);
+    }
 #endif
+
+    if (auto native = graphics::software::SoftwarePolicy::Get<graphics::software::GeometrySink>(this))
+    {
+        native->BeginFigure(begin_pos);
+    }
 }
 
 void ShapeMaker::EndPath(bool closed)
@@ -71,12 +79,17 @@ void ShapeMaker::EndPath(bool closed)
     KGE_ASSERT(IsStreamOpened());
 
 #if KGE_RENDER_ENGINE == KGE_RENDER_ENGINE_DIRECTX
-    auto native = ComPolicy::Get<ID2D1GeometrySink>(this);
-    native->EndFigure(closed ? D2D1_FIGURE_END_CLOSED : D2D1_FIGURE_END_OPEN);
-#else
-    // not supported
+    if (auto native = ComPolicy::Get<ID2D1GeometrySink>(this))
+    {
+        native->EndFigure(closed ? D2D1_FIGURE_END_CLOSED : D2D1_FIGURE_END_OPEN);
+    }
 #endif
 
+    if (auto native = graphics::software::SoftwarePolicy::Get<graphics::software::GeometrySink>(this))
+    {
+        native->EndFigure(closed);
+    }
+
     this->CloseStream();
 }
 
@@ -85,11 +98,16 @@ void ShapeMaker::AddLine(const Point& point)
     KGE_ASSERT(IsStreamOpened());
 
 #if KGE_RENDER_ENGINE == KGE_RENDER_ENGINE_DIRECTX
-    auto native = ComPolicy::Get<ID2D1GeometrySink>(this);
-    native->AddLine(DX::ConvertToPoint2F(point));
-#else
-    // not supported
+    if (auto native = ComPolicy::Get<ID2D1GeometrySink>(this))
+    {
+        native->AddLine(DX::ConvertToPoint2F(point));
+    }
 #endif
+
+    if (auto native = graphics::software::SoftwarePolicy::Get<graphics::software::GeometrySink>(this))
+    {
+        native->AddLine(point);
+    }
 }
 
 void ShapeMaker::AddLines(const Vector<Point>& points)
@@ -97,11 +115,16 @@ void ShapeMaker::AddLines(const Vector<Point>& points)
     KGE_ASSERT(IsStreamOpened());
 
 #if KGE_RENDER_ENGINE == KGE_RENDER_ENGINE_DIRECTX
-    auto native = ComPolicy::Get<ID2D1GeometrySink>(this);
-    native->AddLines(reinterpret_cast<const D2D_POINT_2F*>(&points[0]), static_cast<uint32_t>(points.size()));
-#else
-    // not supported
+    if (auto native = ComPolicy::Get<ID2D1GeometrySink>(this))
+    {
+        native->AddLines(reinterpret_cast<const D2D_POINT_2F*>(&points[0]), static_cast<uint32_t>(points.size()));
+    }
 #endif
+
+    if (auto native = graphics::software::SoftwarePolicy::Get<graphics::software::GeometrySink>(this))
+    {
+        native->AddLines(points.data(), points.size());
+    }
 }
 
 void kiwano::ShapeMaker::AddLines(const Point* points, size_t count)
@@ -109,11 +132,16 @@ void kiwano::ShapeMaker::AddLines(const Point* points, size_t count)
     KGE_ASSERT(IsStreamOpened());
 
 #if KGE_RENDER_ENGINE == KGE_RENDER_ENGINE_DIRECTX
-    auto native = ComPolicy::Get<ID2D1GeometrySink>(this);
-    native->AddLines(reinterpret_cast<const D2D_POINT_2F*>(points), UINT32(count));
-#else
-    // not supported
+    if (auto native = ComPolicy::Get<ID2D1GeometrySink>(this))
+    {
+        native->AddLines(reinterpret_cast<const D2D_POINT_2F*>(points), UINT32(count));
+    }
 #endif
+
+    if (auto native = graphics::software::SoftwarePolicy::Get<graphics::software::GeometrySink>(this))
+    {
+        native->AddLines(points, count);
+    }
 }
 
 void ShapeMaker::AddBezier(const Point& point1, const Point& point2, const Point& point3)
@@ -121,12 +149,17 @@ void ShapeMaker::AddBezier(const Point& point1, const Point& point2, const Point
     KGE_ASSERT(IsStreamOpened());
 
 #if KGE_RENDER_ENGINE == KGE_RENDER_ENGINE_DIRECTX
-    auto native = ComPolicy::Get<ID2D1GeometrySink>(this);
-    native->AddBezier(
-        D2D1::BezierSegment(DX::ConvertToPoint2F(point1), DX::ConvertToPoint2F(point2), DX::ConvertToPoint2F(point3)));
-#else
-    // not supported
+    if (auto native = ComPolicy::Get<ID2D1GeometrySink>(this))
+    {
+        native->AddBezier(
+            D2D1::BezierSegment(DX::ConvertToPoint2F(point1), DX::ConvertToPoint2F(point2), DX::ConvertToPoint2F(point3)));
+    }
 #endif
+
+    if (auto native = graphics::software::SoftwarePolicy::Get<graphics::software::GeometrySink>(this))
+    {
+        native->AddBezier(point1, point2, point3);
+    }
 }
 
 void ShapeMaker::AddArc(const Point& point, const Size& radius, float rotation, bool clockwise, bool is_small)
@@ -134,13 +167,18 @@ void ShapeMaker::AddArc(const Point& point, const Size& radius, float rotation,
     KGE_ASSERT(IsStreamOpened());
 
 #if KGE_RENDER_ENGINE == KGE_RENDER_ENGINE_DIRECTX
-    auto native = ComPolicy::Get<ID2D1GeometrySink>(this);
-    native->AddArc(D2D1::ArcSegment(DX::ConvertToPoint2F(point), DX::ConvertToSizeF(radius), rotation,
-                                    clockwise ? D2D1_SWEEP_DIRECTION_CLOCKWISE : D2D1_SWEEP_DIRECTION_COUNTER_CLOCKWISE,
-                                    is_small ? D2D1_ARC_SIZE_SMALL : D2D1_ARC_SIZE_LARGE));
-#else
-    // not supported
+    if (auto native = ComPolicy::Get<ID2D1GeometrySink>(this))
+    {
+        native->AddArc(D2D1::ArcSegment(DX::ConvertToPoint2F(point), DX::ConvertToSizeF(radius), rotation,
+                                        clockwise ? D2D1_SWEEP_DIRECTION_CLOCKWISE : D2D1_SWEEP_DIRECTION_COUNTER_CLOCKWISE,
+                                        is_small ? D2D1_ARC_SIZE_SMALL : D2D1_ARC_SIZE_LARGE));
+    }
 #endif
+
+    if (auto native = graphics::software::SoftwarePolicy::Get<graphics::software::GeometrySink>(this))
+    {
+        native->AddArc(point, radius, rotation, clockwise, is_small);
+    }
 }
 
 RefPtr<Shape> ShapeMaker::Combine(RefPtr<Shape> shape_a, RefPtr<Shape> shape_b, CombineMode mode,
@@ -149,22 +187,31 @@ RefPtr<Shape> ShapeMaker::Combine(RefPtr<Shape> shape_a, RefPtr<Shape> shape_b,
     ShapeMaker maker;
     maker.OpenStream();
 
-#if KGE_RENDER_ENGINE == KGE_RENDER_ENGINE_DIRECTX
     if (shape_a && shape_b)
     {
-        auto geo_a  = ComPolicy::Get<ID2D1Geometry>(shape_a);
-        auto geo_b  = ComPolicy::Get<ID2D1Geometry>(shape_b);
-        auto native = ComPolicy::Get<ID2D1GeometrySink>(maker);
+#if KGE_RENDER_ENGINE == KGE_RENDER_ENGINE_DIRECTX
+        if (auto native = ComPolicy::Get<ID2D1GeometrySink>(maker))
+        {
+            auto geo_a = ComPolicy::Get<ID2D1Geometry>(shape_a);
+            auto geo_b = ComPolicy::Get<ID2D1Geometry>(shape_b);
 
-        HRESULT hr = geo_a->CombineWithGeometry(geo_b.Get(), D2D1_COMBINE_MODE(mode), DX::ConvertToMatrix3x2F(matrix),
-                                                native.Get());
+            HRESULT hr = geo_a->CombineWithGeometry(geo_b.Get(), D2D1_COMBINE_MODE(mode),
+                                                    DX::ConvertToMatrix3x2F(matrix), native.Get());
 
-        KGE_THROW_IF_FAILED(hr, "ID2D1Geometry::CombineWithGeometry failed");
-    }
-#else
-    // not supported
+            KGE_THROW_IF_FAILED(hr, "ID2D1Geometry::CombineWithGeometry failed");
+        }
 #endif
 
+        if (auto native = graphics::software::SoftwarePolicy::Get<graphics::software::Geometry>(maker.shape_))
+        {
+            auto geo_a = graphics::software::SoftwarePolicy::Get<graphics::software::Geometry>(shape_a);
+            auto geo_b = graphics::software::SoftwarePolicy::Get<graphics::software::Geometry>(shape_b);
+
+            auto combined = graphics::software::Geometry::Combine(*geo_a, *geo_b, mode, matrix);
+            native->Append(*combined, nullptr);
+        }
+    }
+
     maker.CloseStream();
     return maker.GetShape();
 }
@@ -177,8 +224,7 @@ void ShapeMaker::OpenStream()
     Renderer::GetInstance().CreateShapeSink(*this);
 
 #if KGE_RENDER_ENGINE == KGE_RENDER_ENGINE_DIRECTX
-    auto geometry = ComPolicy::Get<ID2D1PathGeometry>(shape_);
-    if (geometry)
+    if (auto geometry = ComPolicy::Get<ID2D1PathGeometry>(shape_))
     {
         ComPtr<ID2D1GeometrySink> native;
 
@@ -189,9 +235,12 @@ void ShapeMaker::OpenStream()
         }
         KGE_THROW_IF_FAILED(hr, "ID2D1PathGeometry::Open failed");
     }
-#else
-    // not supported
 #endif
+
+    if (auto geometry = graphics::software::SoftwarePolicy::Get<graphics::software::Geometry>(shape_))
+    {
+        graphics::software::SoftwarePolicy::Set(this, MakePtr<graphics::software::GeometrySink>(geometry));
+    }
 }
 
 void ShapeMaker::CloseStream()
@@ -200,15 +249,19 @@ void ShapeMaker::CloseStream()
         return;
 
 #if KGE_RENDER_ENGINE == KGE_RENDER_ENGINE_DIRECTX
-    auto native = ComPolicy::Get<ID2D1GeometrySink>(this);
+    if (auto native = ComPolicy::Get<ID2D1GeometrySink>(this))
+    {
+        HRESULT hr = native->Close();
+        KGE_THROW_IF_FAILED(hr, "ID2D1PathGeometry::Close failed");
+    }
+#endif
 
-    HRESULT hr = native->Close();
-    KGE_THROW_IF_FAILED(hr, "ID2D1PathGeometry::Close failed");
+    if (auto native = graphics::software::SoftwarePolicy::Get<graphics::software::GeometrySink>(this))
+    {
+        native->Close();
+    }
 
     ResetNative();
-#else
-    return;  // not supported
-#endif
 }
 
 void ShapeMaker::SetShape(RefPtr<Shape> shape)
@@ -0,0 +1,540 @@
+// Copyright (c) 2016-2019 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <cstdlib>
+#include <cstring>
+#include <kiwano/render/Software/Bitmap.h>
+#include <kiwano/render/Software/Inflate.h>
+
+namespace kiwano
+{
+namespace graphics
+{
+namespace software
+{
+
+namespace
+{
+
+inline uint32_t ReadUInt16(const uint8_t* data)
+{
+    return uint32_t(data[0]) | (uint32_t(data[1]) << 8);
+}
+
+inline uint32_t ReadUInt32(const uint8_t* data)
+{
+    return uint32_t(data[0]) | (uint32_t(data[1]) << 8) | (uint32_t(data[2]) << 16) | (uint32_t(data[3]) << 24);
+}
+
+inline Pixel Premultiply(uint32_t r, uint32_t g, uint32_t b, uint32_t a)
+{
+    return MakePixel(Div255(r * a), Div255(g * a), Div255(b * a), a);
+}
+
+bool DecodeBmp(const uint8_t* input, size_t length, PixelSize& size, Vector<uint8_t>& pixels)
+{
+    if (length < 54 || input[0] != 'B' || input[1] != 'M')
+        return false;
+
+    const uint32_t offset      = ReadUInt32(input + 10);
+    const int32_t  width       = int32_t(ReadUInt32(input + 18));
+    const int32_t  height      = int32_t(ReadUInt32(input + 22));
+    const uint32_t bpp         = ReadUInt16(input + 28);
+    const uint32_t compression = ReadUInt32(input + 30);
+
+    // Only BI_RGB, and BI_BITFIELDS with the default BGRA masks, are supported
+    if (width <= 0 || height == 0 || (bpp != 24 && bpp != 32) || (compression != 0 && compression != 3))
+        return false;
+
+    const bool     top_down = height < 0;
+    const uint32_t w        = uint32_t(width);
+    const uint32_t h        = uint32_t(top_down ? -height : height);
+    const uint32_t stride   = ((bpp * w + 31) / 32) * 4;
+
+    if (size_t(offset) + size_t(stride) * h > length)
+        return false;
+
+    // 32-bit bitmaps written without alpha leave the channel empty
+    bool has_alpha = false;
+    if (bpp == 32)
+    {
+        for (uint32_t y = 0; y < h && !has_alpha; ++y)
+        {
+            const uint8_t* row = input + offset + size_t(y) * stride;
+            for (uint32_t x = 0; x < w; ++x)
+            {
+                if (row[x * 4 + 3] != 0)
+                {
+                    has_alpha = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    pixels.resize(size_t(w) * h * 4);
+    for (uint32_t y = 0; y < h; ++y)
+    {
+        const uint8_t* row  = input + offset + size_t(top_down ? y : h - 1 - y) * stride;
+        uint8_t*       dest = pixels.data() + size_t(y) * w * 4;
+        for (uint32_t x = 0; x < w; ++x, dest += 4)
+        {
+            const uint8_t* p = row + x * (bpp / 8);
+            dest[0]          = p[0];
+            dest[1]          = p[1];
+            dest[2]          = p[2];
+            dest[3]          = (bpp == 32 && has_alpha) ? p[3] : 255;
+        }
+    }
+
+    size = PixelSize(w, h);
+    return true;
+}
+
+inline uint32_t ReadUInt32BE(const uint8_t* data)
+{
+    return (uint32_t(data[0]) << 24) | (uint32_t(data[1]) << 16) | (uint32_t(data[2]) << 8) | uint32_t(data[3]);
+}
+
+inline uint8_t PaethPredictor(int a, int b, int c)
+{
+    const int p  = a + b - c;
+    const int pa = std::abs(p - a);
+    const int pb = std::abs(p - b);
+    const int pc = std::abs(p - c);
+    if (pa <= pb && pa <= pc)
+        return uint8_t(a);
+    if (pb <= pc)
+        return uint8_t(b);
+    return uint8_t(c);
+}
+
+bool UnfilterRow(uint8_t filter, uint8_t* row, const uint8_t* prev, size_t stride, size_t bpp)
+{
+    switch (filter)
+    {
+    case 0:
+        return true;
+    case 1:
+        for (size_t i = bpp; i < stride; ++i)
+            row[i] += row[i - bpp];
+        return true;
+    case 2:
+        for (size_t i = 0; i < stride; ++i)
+            row[i] += prev[i];
+        return true;
+    case 3:
+        for (size_t i = 0; i < stride; ++i)
+            row[i] += uint8_t(((i >= bpp ? row[i - bpp] : 0) + prev[i]) / 2);
+        return true;
+    case 4:
+        for (size_t i = 0; i < stride; ++i)
+        {
+            const int left    = i >= bpp ? row[i - bpp] : 0;
+            const int up_left = i >= bpp ? prev[i - bpp] : 0;
+            row[i] += PaethPredictor(left, prev[i], up_left);
+        }
+        return true;
+    default:
+        return false;
+    }
+}
+
+struct PngHeader
+{
+    uint32_t width;
+    uint32_t height;
+    uint32_t depth;
+    uint32_t color_type;
+    uint32_t channels;
+    bool     interlaced;
+};
+
+// Bytes of one filtered scanline, without the filter type byte
+inline size_t GetPngStride(const PngHeader& header, uint32_t width)
+{
+    return (size_t(width) * header.channels * header.depth + 7) / 8;
+}
+
+bool DecodePng(const uint8_t* input, size_t length, PixelSize& size, Vector<uint8_t>& pixels)
+{
+    static const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    if (length < 8 || std::memcmp(input, signature, 8) != 0)
+        return false;
+
+    PngHeader       header   = {};
+    uint8_t         palette[256 * 4];
+    uint32_t        palette_size = 0;
+    bool            has_key      = false;
+    uint32_t        key[3]       = {};
+    Vector<uint8_t> compressed;
+
+    // Opaque palette by default, tRNS may add alpha later
+    std::memset(palette, 255, sizeof(palette));
+
+    bool   ended = false;
+    size_t pos   = 8;
+    while (!ended)
+    {
+        if (pos + 12 > length)
+            return false;
+
+        const uint32_t chunk_size = ReadUInt32BE(input + pos);
+        const uint8_t* type       = input + pos + 4;
+        const uint8_t* chunk      = input + pos + 8;
+        if (chunk_size > length - pos - 12)
+            return false;
+
+        const bool first = (pos == 8);
+        pos += size_t(chunk_size) + 12;
+
+        if (std::memcmp(type, "IHDR", 4) == 0)
+        {
+            if (!first || chunk_size < 13)
+                return false;
+
+            header.width      = ReadUInt32BE(chunk);
+            header.height     = ReadUInt32BE(chunk + 4);
+            header.depth      = chunk[8];
+            header.color_type = chunk[9];
+            header.interlaced = chunk[12] == 1;
+            if (chunk[10] != 0 || chunk[11] != 0 || chunk[12] > 1)
+                return false;
+
+            // Sample depths allowed for each color type
+            switch (header.color_type)
+            {
+            case 0:
+                header.channels = 1;
+                if (header.depth != 1 && header.depth != 2 && header.depth != 4 && header.depth != 8
+                    && header.depth != 16)
+                    return false;
+                break;
+            case 2:
+                header.channels = 3;
+                if (header.depth != 8 && header.depth != 16)
+                    return false;
+                break;
+            case 3:
+                header.channels = 1;
+                if (header.depth != 1 && header.depth != 2 && header.depth != 4 && header.depth != 8)
+                    return false;
+                break;
+            case 4:
+                header.channels = 2;
+                if (header.depth != 8 && header.depth != 16)
+                    return false;
+                break;
+            case 6:
+                header.channels = 4;
+                if (header.depth != 8 && header.depth != 16)
+                    return false;
+                break;
+            default:
+                return false;
+            }
+
+            // Keeps the decoded image below the BinaryData size limit
+            if (header.width == 0 || header.height == 0 || header.width > 0x4000 || header.height > 0x4000)
+                return false;
+        }
+        else if (header.width == 0)
+        {
+            // Every other chunk has to come after IHDR
+            return false;
+        }
+        else if (std::memcmp(type, "PLTE", 4) == 0)
+        {
+            if (chunk_size % 3 != 0 || chunk_size > 256 * 3)
+                return false;
+
+            palette_size = chunk_size / 3;
+            for (uint32_t i = 0; i < palette_size; ++i)
+            {
+                palette[i * 4]     = chunk[i * 3];
+                palette[i * 4 + 1] = chunk[i * 3 + 1];
+                palette[i * 4 + 2] = chunk[i * 3 + 2];
+            }
+        }
+        else if (std::memcmp(type, "tRNS", 4) == 0)
+        {
+            if (header.color_type == 3)
+            {
+                for (uint32_t i = 0; i < chunk_size && i < 256; ++i)
+                    palette[i * 4 + 3] = chunk[i];
+            }
+            else if (header.color_type == 0 && chunk_size >= 2)
+            {
+                has_key = true;
+                key[0]  = (uint32_t(chunk[0]) << 8) | chunk[1];
+            }
+            else if (header.color_type == 2 && chunk_size >= 6)
+            {
+                has_key = true;
+                for (int i = 0; i < 3; ++i)
+                    key[i] = (uint32_t(chunk[i * 2]) << 8) | chunk[i * 2 + 1];
+            }
+        }
+        else if (std::memcmp(type, "IDAT", 4) == 0)
+        {
+            compressed.insert(compressed.end(), chunk, chunk + chunk_size);
+        }
+        else if (std::memcmp(type, "IEND", 4) == 0)
+        {
+            ended = true;
+        }
+        else if ((type[0] & 0x20) == 0)
+        {
+            // Unknown critical chunk
+            return false;
+        }
+    }
+
+    if (header.color_type == 3 && palette_size == 0)
+        return false;
+
+    // The seven passes of Adam7 interlacing: first column, first row, column step and row step
+    static const uint32_t adam7[7][4] = { { 0, 0, 8, 8 }, { 4, 0, 8, 8 }, { 0, 4, 4, 8 }, { 2, 0, 4, 4 },
+                                          { 0, 2, 2, 4 }, { 1, 0, 2, 2 }, { 0, 1, 1, 2 } };
+    static const uint32_t single_pass[1][4] = { { 0, 0, 1, 1 } };
+
+    const auto passes     = header.interlaced ? adam7 : single_pass;
+    const int  pass_count = header.interlaced ? 7 : 1;
+
+    size_t expected = 0;
+    for (int p = 0; p < pass_count; ++p)
+    {
+        const uint32_t pass_width  = (header.width - passes[p][0] + passes[p][2] - 1) / passes[p][2];
+        const uint32_t pass_height = (header.height - passes[p][1] + passes[p][3] - 1) / passes[p][3];
+        if (pass_width && pass_height)
+            expected += (GetPngStride(header, pass_width) + 1) * pass_height;
+    }
+
+    Vector<uint8_t> filtered;
+    filtered.reserve(expected);
+    if (!Inflate(compressed.data(), compressed.size(), filtered) || filtered.size() < expected)
+        return false;
+
+    const uint32_t depth    = header.depth;
+    const uint32_t channels = header.channels;
+    const uint32_t max      = (1u << depth) - 1;
+    const size_t   bpp      = std::max<size_t>(1, channels * depth / 8);
+
+    // Reads the sample of the given index in a scanline, at its original depth
+    auto read_sample = [&](const uint8_t* row, size_t index) -> uint32_t {
+        if (depth == 8)
+            return row[index];
+        if (depth == 16)
+            return (uint32_t(row[index * 2]) << 8) | row[index * 2 + 1];
+
+        const size_t bit = index * depth;
+        return (row[bit / 8] >> (8 - depth - bit % 8)) & max;
+    };
+
+    auto to_8bit = [&](uint32_t sample) -> uint8_t {
+        if (depth == 16)
+            return uint8_t(sample >> 8);
+        return uint8_t(sample * 255 / max);
+    };
+
+    pixels.resize(size_t(header.width) * header.height * 4);
+
+    uint8_t* data = filtered.data();
+    for (int p = 0; p < pass_count; ++p)
+    {
+        const uint32_t pass_width  = (header.width - passes[p][0] + passes[p][2] - 1) / passes[p][2];
+        const uint32_t pass_height = (header.height - passes[p][1] + passes[p][3] - 1) / passes[p][3];
+        if (pass_width == 0 || pass_height == 0)
+            continue;
+
+        const size_t    stride = GetPngStride(header, pass_width);
+        Vector<uint8_t> zeros(stride, 0);
+
+        const uint8_t* prev = zeros.data();
+        for (uint32_t y = 0; y < pass_height; ++y, data += stride + 1)
+        {
+            uint8_t* row = data + 1;
+            if (!UnfilterRow(data[0], row, prev, stride, bpp))
+                return false;
+            prev = row;
+
+            const uint32_t dest_y = passes[p][1] + y * passes[p][3];
+            for (uint32_t x = 0; x < pass_width; ++x)
+            {
+                const uint32_t dest_x = passes[p][0] + x * passes[p][2];
+                uint8_t*       dest   = &pixels[(size_t(dest_y) * header.width + dest_x) * 4];
+
+                const size_t index = size_t(x) * channels;
+                switch (header.color_type)
+                {
+                case 0:
+                {
+                    const uint32_t gray = read_sample(row, index);
+                    dest[0] = dest[1] = dest[2] = to_8bit(gray);
+                    dest[3]                     = (has_key && gray == key[0]) ? 0 : 255;
+                    break;
+                }
+                case 2:
+                {
+                    const uint32_t r = read_sample(row, index);
+                    const uint32_t g = read_sample(row, index + 1);
+                    const uint32_t b = read_sample(row, index + 2);
+                    dest[0]          = to_8bit(b);
+                    dest[1]          = to_8bit(g);
+                    dest[2]          = to_8bit(r);
+                    dest[3]          = (has_key && r == key[0] && g == key[1] && b == key[2]) ? 0 : 255;
+                    break;
+                }
+                case 3:
+                {
+                    const uint32_t entry = read_sample(row, index);
+                    if (entry >= palette_size)
+                        return false;
+                    dest[0] = palette[entry * 4 + 2];
+                    dest[1] = palette[entry * 4 + 1];
+                    dest[2] = palette[entry * 4];
+                    dest[3] = palette[entry * 4 + 3];
+                    break;
+                }
+                case 4:
+                    dest[0] = dest[1] = dest[2] = to_8bit(read_sample(row, index));
+                    dest[3]                     = to_8bit(read_sample(row, index + 1));
+                    break;
+                case 6:
+                    dest[0] = to_8bit(read_sample(row, index + 2));
+                    dest[1] = to_8bit(read_sample(row, index + 1));
+                    dest[2] = to_8bit(read_sample(row, index));
+                    dest[3] = to_8bit(read_sample(row, index + 3));
+                    break;
+                }
+            }
+        }
+    }
+
+    size = PixelSize(header.width, header.height);
+    return true;
+}
+
+}  // namespace
+
+Bitmap::Bitmap(uint32_t width, uint32_t height)
+    : width_(0)
+    , height_(0)
+{
+    Resize(width, height);
+}
+
+void Bitmap::Clear(Pixel color)
+{
+    std::fill(pixels_.begin(), pixels_.end(), color);
+}
+
+void Bitmap::Resize(uint32_t width, uint32_t height)
+{
+    width_  = width;
+    height_ = height;
+    pixels_.assign(size_t(width) * size_t(height), 0);
+}
+
+void Bitmap::CopyFrom(const Bitmap& other, const PixelRect& src_rect, int dest_x, int dest_y)
+{
+    PixelRect src = src_rect.Intersect(PixelRect(0, 0, int(other.width_), int(other.height_)));
+
+    // Clip the destination and shrink the source accordingly
+    const PixelRect dest = PixelRect(dest_x + src.left - src_rect.left, dest_y + src.top - src_rect.top, 0, 0);
+    PixelRect       target(dest.left, dest.top, dest.left + src.GetWidth(), dest.top + src.GetHeight());
+    target = target.Intersect(PixelRect(0, 0, int(width_), int(height_)));
+    if (target.IsEmpty())
+        return;
+
+    src.left += target.left - dest.left;
+    src.top += target.top - dest.top;
+
+    for (int y = 0; y < target.GetHeight(); ++y)
+    {
+        const Pixel* from = other.GetRow(uint32_t(src.top + y)) + src.left;
+        Pixel*       to   = GetRow(uint32_t(target.top + y)) + target.left;
+        std::copy(from, from + target.GetWidth(), to);
+    }
+}
+
+Vector<uint8_t> Bitmap::ExportRGBA() const
+{
+    Vector<uint8_t> output(pixels_.size() * 4);
+    for (size_t i = 0; i < pixels_.size(); ++i)
+    {
+        const Pixel    pixel = pixels_[i];
+        const uint32_t a     = PixelAlpha(pixel);
+        uint8_t*       dest  = &output[i * 4];
+        for (uint32_t c = 0; c < 3; ++c)
+        {
+            const uint32_t value = (pixel >> (c * 8)) & 0xFF;
+            dest[c]              = a ? uint8_t(std::min(255U, (value * 255 + a / 2) / a)) : 0;
+        }
+        dest[3] = uint8_t(a);
+    }
+    return output;
+}
+
+RefPtr<Bitmap> Bitmap::FromPixels(const PixelSize& size, const BinaryData& data, PixelFormat format)
+{
+    if (!data.IsValid() || size_t(data.size) < size_t(size.x) * size_t(size.y) * 4)
+        return nullptr;
+
+    RefPtr<Bitmap> output = MakePtr<Bitmap>(size.x, size.y);
+
+    const uint8_t* input = reinterpret_cast<const uint8_t*>(data.buffer);
+    for (uint32_t y = 0; y < size.y; ++y)
+    {
+        Pixel* row = output->GetRow(y);
+        for (uint32_t x = 0; x < size.x; ++x, input += 4)
+        {
+            if (format == PixelFormat::Bpp32BGRA)
+                row[x] = Premultiply(input[2], input[1], input[0], input[3]);
+            else
+                row[x] = Premultiply(input[0], input[1], input[2], input[3]);
+        }
+    }
+    return output;
+}
+
+RefPtr<Bitmap> Bitmap::Decode(const BinaryData& data)
+{
+    PixelSize       size;
+    Vector<uint8_t> pixels;
+    if (!DecodePixels(data, size, pixels))
+        return nullptr;
+    return FromPixels(size, BinaryData(pixels.data(), uint32_t(pixels.size())), PixelFormat::Bpp32BGRA);
+}
+
+bool Bitmap::DecodePixels(const BinaryData& data, PixelSize& size, Vector<uint8_t>& pixels)
+{
+    if (!data.IsValid())
+        return false;
+
+    const uint8_t* input = reinterpret_cast<const uint8_t*>(data.buffer);
+    if (DecodePng(input, data.size, size, pixels))
+        return true;
+    return DecodeBmp(input, data.size, size, pixels);
+}
+
+}  // namespace software
+}  // namespace graphics
+}  // namespace kiwano
@@ -0,0 +1,121 @@
+// Copyright (c) 2016-2019 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <kiwano/base/RefObject.h>
+#include <kiwano/core/BinaryData.h>
+#include <kiwano/render/Texture.h>
+#include <kiwano/render/Software/Rasterizer.h>
+
+namespace kiwano
+{
+namespace graphics
+{
+namespace software
+{
+
+/// \~chinese
+/// @brief ڴλͼظʽΪԤ Alpha  RGBA
+class KGE_API Bitmap : public RefObject
+{
+public:
+    Bitmap(uint32_t width, uint32_t height);
+
+    uint32_t GetWidth() const;
+
+    uint32_t GetHeight() const;
+
+    PixelSize GetSizeInPixels() const;
+
+    Pixel* GetRow(uint32_t y);
+
+    const Pixel* GetRow(uint32_t y) const;
+
+    Pixel GetPixel(int x, int y) const;
+
+    /// \~chinese
+    /// @brief ʹôɫλͼ
+    void Clear(Pixel color);
+
+    /// \~chinese
+    /// @brief λͼСݻᱻ
+    void Resize(uint32_t width, uint32_t height);
+
+    /// \~chinese
+    /// @brief λͼ
+    void CopyFrom(const Bitmap& other, const PixelRect& src_rect, int dest_x, int dest_y);
+
+    /// \~chinese
+    /// @brief ԷԤ˵ RGBA ʽ
+    Vector<uint8_t> ExportRGBA() const;
+
+    /// \~chinese
+    /// @brief ӷԤ˵ݴλͼ
+    static RefPtr<Bitmap> FromPixels(const PixelSize& size, const BinaryData& data, PixelFormat format);
+
+    /// \~chinese
+    /// @brief ͼƬ
+    /// @details ֧ PNG ͼƬԼδѹ 24 λ 32 λ BMP ͼƬ
+    static RefPtr<Bitmap> Decode(const BinaryData& data);
+
+    /// \~chinese
+    /// @brief ͼƬΪԤ˵ BGRA 
+    /// @details λͼں̵̨߳
+    static bool DecodePixels(const BinaryData& data, PixelSize& size, Vector<uint8_t>& pixels);
+
+private:
+    uint32_t      width_;
+    uint32_t      height_;
+    Vector<Pixel> pixels_;
+};
+
+inline uint32_t Bitmap::GetWidth() const
+{
+    return width_;
+}
+
+inline uint32_t Bitmap::GetHeight() const
+{
+    return height_;
+}
+
+inline PixelSize Bitmap::GetSizeInPixels() const
+{
+    return PixelSize(width_, height_);
+}
+
+inline Pixel* Bitmap::GetRow(uint32_t y)
+{
+    return &pixels_[size_t(y) * width_];
+}
+
+inline const Pixel* Bitmap::GetRow(uint32_t y) const
+{
+    return &pixels_[size_t(y) * width_];
+}
+
+inline Pixel Bitmap::GetPixel(int x, int y) const
+{
+    return pixels_[size_t(y) * width_ + size_t(x)];
+}
+
+}  // namespace software
+}  // namespace graphics
+}  // namespace kiwano
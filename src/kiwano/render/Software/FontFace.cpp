@@ -0,0 +1,688 @@
+// Copyright (c) 2016-2019 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <kiwano/render/Software/FontFace.h>
+
+namespace kiwano
+{
+namespace graphics
+{
+namespace software
+{
+
+namespace
+{
+
+// Composite glyph flags
+const uint16_t arg_1_and_2_are_words    = 0x0001;
+const uint16_t args_are_xy_values       = 0x0002;
+const uint16_t we_have_a_scale          = 0x0008;
+const uint16_t more_components          = 0x0020;
+const uint16_t we_have_an_x_and_y_scale = 0x0040;
+const uint16_t we_have_a_two_by_two     = 0x0080;
+
+// Composite glyphs may reference each other, deeper nesting is treated as broken data
+const int max_composite_depth = 8;
+
+inline uint32_t MakeTag(const char* tag)
+{
+    return (uint32_t(uint8_t(tag[0])) << 24) | (uint32_t(uint8_t(tag[1])) << 16) | (uint32_t(uint8_t(tag[2])) << 8)
+           | uint32_t(uint8_t(tag[3]));
+}
+
+void AppendUTF8(String& output, uint32_t ch)
+{
+    if (ch < 0x80)
+    {
+        output.push_back(char(ch));
+    }
+    else if (ch < 0x800)
+    {
+        output.push_back(char(0xC0 | (ch >> 6)));
+        output.push_back(char(0x80 | (ch & 0x3F)));
+    }
+    else if (ch < 0x10000)
+    {
+        output.push_back(char(0xE0 | (ch >> 12)));
+        output.push_back(char(0x80 | ((ch >> 6) & 0x3F)));
+        output.push_back(char(0x80 | (ch & 0x3F)));
+    }
+    else
+    {
+        output.push_back(char(0xF0 | (ch >> 18)));
+        output.push_back(char(0x80 | ((ch >> 12) & 0x3F)));
+        output.push_back(char(0x80 | ((ch >> 6) & 0x3F)));
+        output.push_back(char(0x80 | (ch & 0x3F)));
+    }
+}
+
+bool ReadFontFile(const String& file_path, Vector<uint8_t>& output)
+{
+    std::ifstream ifs(file_path.c_str(), std::ios::binary | std::ios::ate);
+    if (!ifs.is_open())
+        return false;
+
+    const std::streamsize size = ifs.tellg();
+    if (size <= 0)
+        return false;
+
+    output.resize(size_t(size));
+    ifs.seekg(0, std::ios::beg);
+    return bool(ifs.read(reinterpret_cast<char*>(output.data()), size));
+}
+
+// Flattens a quadratic curve, the number of segments keeps the error below a tenth of a unit of the target space
+void AddQuadratic(Vector<Point>& output, const Point& p0, const Point& p1, const Point& p2)
+{
+    const Vec2  d     = p0 - p1 * 2.0f + p2;
+    const float error = std::sqrt(d.x * d.x + d.y * d.y) / 8.0f;
+    const int   count = std::min(32, std::max(1, int(std::ceil(std::sqrt(error / 0.1f)))));
+    for (int i = 1; i <= count; ++i)
+    {
+        const float t = float(i) / float(count);
+        const float u = 1.0f - t;
+        output.push_back(p0 * (u * u) + p1 * (2.0f * u * t) + p2 * (t * t));
+    }
+}
+
+}  // namespace
+
+FontFace::FontFace()
+    : weight_(400)
+    , italic_(false)
+    , units_per_em_(1000)
+    , ascent_(0)
+    , descent_(0)
+    , line_gap_(0)
+    , glyph_count_(0)
+    , metric_count_(0)
+    , long_offsets_(false)
+    , cmap_(0)
+    , loca_(0)
+    , glyf_(0)
+    , hmtx_(0)
+{
+}
+
+RefPtr<FontFace> FontFace::Load(const BinaryData& data, uint32_t index)
+{
+    if (!data.IsValid())
+        return nullptr;
+
+    RefPtr<FontFace> face = MakePtr<FontFace>();
+
+    const uint8_t* input = reinterpret_cast<const uint8_t*>(data.buffer);
+    face->data_.assign(input, input + data.size);
+    if (!face->Parse(index))
+        return nullptr;
+    return face;
+}
+
+uint32_t FontFace::GetFaceCount(const BinaryData& data)
+{
+    const uint8_t* input = reinterpret_cast<const uint8_t*>(data.buffer);
+    if (!data.IsValid() || data.size < 12)
+        return 0;
+
+    if (std::memcmp(input, "ttcf", 4) == 0)
+        return (uint32_t(input[8]) << 24) | (uint32_t(input[9]) << 16) | (uint32_t(input[10]) << 8) | input[11];
+    return 1;
+}
+
+const Vector<RefPtr<FontFace>>& FontFace::GetSystemFaces()
+{
+    struct SystemFaces
+    {
+        Vector<RefPtr<FontFace>> faces;
+
+        SystemFaces()
+        {
+            // Latin fonts come first, the CJK font covers the characters they miss
+            const char* file_names[] = {
+                "segoeui.ttf", "arial.ttf", "msyh.ttc", "DejaVuSans.ttf", "Arial.ttf", "LiberationSans-Regular.ttf",
+            };
+
+            Vector<String> directories;
+            if (const char* windir = std::getenv("WINDIR"))
+                directories.push_back(String(windir) + "\\Fonts\\");
+            directories.push_back("/usr/share/fonts/truetype/dejavu/");
+            directories.push_back("/usr/share/fonts/TTF/");
+            directories.push_back("/usr/share/fonts/truetype/liberation/");
+            directories.push_back("/Library/Fonts/");
+            directories.push_back("/System/Library/Fonts/Supplemental/");
+
+            Vector<uint8_t> data;
+            for (const char* file_name : file_names)
+            {
+                for (const auto& directory : directories)
+                {
+                    if (!ReadFontFile(directory + file_name, data))
+                        continue;
+
+                    if (auto face = FontFace::Load(BinaryData(data.data(), uint32_t(data.size()))))
+                    {
+                        faces.push_back(face);
+                        break;
+                    }
+                }
+            }
+        }
+    };
+
+    static const SystemFaces system_faces;
+    return system_faces.faces;
+}
+
+uint32_t FontFace::GetGlyphIndex(uint32_t codepoint) const
+{
+    const uint16_t format = ReadUInt16(cmap_);
+    if (format == 4)
+    {
+        if (codepoint > 0xFFFF)
+            return 0;
+
+        const size_t seg_count   = ReadUInt16(cmap_ + 6) / 2;
+        const size_t end_codes   = cmap_ + 14;
+        const size_t start_codes = end_codes + seg_count * 2 + 2;
+        const size_t deltas      = start_codes + seg_count * 2;
+        const size_t offsets     = deltas + seg_count * 2;
+
+        // Segments are sorted by their end code
+        size_t low  = 0;
+        size_t high = seg_count;
+        while (low < high)
+        {
+            const size_t mid = (low + high) / 2;
+            if (ReadUInt16(end_codes + mid * 2) < codepoint)
+                low = mid + 1;
+            else
+                high = mid;
+        }
+        if (low >= seg_count)
+            return 0;
+
+        const uint32_t start = ReadUInt16(start_codes + low * 2);
+        if (codepoint < start)
+            return 0;
+
+        const uint32_t delta        = ReadUInt16(deltas + low * 2);
+        const uint32_t range_offset = ReadUInt16(offsets + low * 2);
+        if (range_offset == 0)
+            return (codepoint + delta) & 0xFFFF;
+
+        const uint32_t glyph = ReadUInt16(offsets + low * 2 + range_offset + (codepoint - start) * 2);
+        return glyph ? ((glyph + delta) & 0xFFFF) : 0;
+    }
+
+    if (format == 12)
+    {
+        const uint32_t group_count = ReadUInt32(cmap_ + 12);
+
+        size_t low  = 0;
+        size_t high = group_count;
+        while (low < high)
+        {
+            const size_t   mid   = (low + high) / 2;
+            const size_t   group = cmap_ + 16 + mid * 12;
+            const uint32_t start = ReadUInt32(group);
+            const uint32_t end   = ReadUInt32(group + 4);
+            if (codepoint < start)
+                high = mid;
+            else if (codepoint > end)
+                low = mid + 1;
+            else
+                return ReadUInt32(group + 8) + (codepoint - start);
+        }
+    }
+    return 0;
+}
+
+float FontFace::GetAdvance(uint32_t glyph) const
+{
+    if (metric_count_ == 0)
+        return 0.0f;
+
+    // Glyphs after the last metric share its advance
+    const uint32_t metric = std::min(glyph, metric_count_ - 1);
+    return float(ReadUInt16(hmtx_ + metric * 4)) / float(units_per_em_);
+}
+
+void FontFace::AddGlyph(PathBuffer& path, uint32_t glyph, const Matrix3x2& transform) const
+{
+    Vector<Point>   points;
+    Vector<uint8_t> on_curve;
+    Vector<size_t>  contour_ends;
+
+    const float     scale  = 1.0f / float(units_per_em_);
+    const Matrix3x2 matrix = Matrix3x2::Scaling(Vec2(scale, scale)) * transform;
+    if (!LoadGlyph(glyph, matrix, points, on_curve, contour_ends, 0))
+        return;
+
+    Vector<Point> vertices;
+    for (size_t begin = 0, c = 0; c < contour_ends.size(); ++c)
+    {
+        const size_t end   = contour_ends[c];
+        const size_t count = end - begin;
+        if (count < 2)
+        {
+            begin = end;
+            continue;
+        }
+
+        // Start on a point on the curve, or between two control points if there is none
+        size_t first = 0;
+        while (first < count && !on_curve[begin + first])
+            ++first;
+
+        Point start;
+        if (first < count)
+        {
+            start = points[begin + first];
+        }
+        else
+        {
+            start = (points[begin] + points[end - 1]) * 0.5f;
+            first = count - 1;
+        }
+
+        vertices.clear();
+        vertices.push_back(start);
+
+        Point current = start;
+        Point control;
+        bool  has_control = false;
+        for (size_t n = 1; n <= count; ++n)
+        {
+            const size_t index = begin + (first + n) % count;
+            const Point& point = points[index];
+            if (on_curve[index])
+            {
+                if (has_control)
+                    AddQuadratic(vertices, current, control, point);
+                else
+                    vertices.push_back(point);
+                current     = point;
+                has_control = false;
+            }
+            else
+            {
+                if (has_control)
+                {
+                    // Two control points in a row imply a point on the curve between them
+                    const Point middle = (control + point) * 0.5f;
+                    AddQuadratic(vertices, current, control, middle);
+                    current = middle;
+                }
+                control     = point;
+                has_control = true;
+            }
+        }
+
+        if (has_control)
+            AddQuadratic(vertices, current, control, start);
+
+        path.AddContour(vertices.data(), vertices.size(), Matrix3x2());
+        begin = end;
+    }
+}
+
+bool FontFace::Parse(uint32_t index)
+{
+    size_t offset = 0;
+    if (data_.size() >= 12 && std::memcmp(data_.data(), "ttcf", 4) == 0)
+    {
+        if (index >= ReadUInt32(8))
+            return false;
+        offset = ReadUInt32(12 + size_t(index) * 4);
+    }
+    else if (index != 0)
+    {
+        return false;
+    }
+
+    // Only TrueType outlines are supported, 'OTTO' fonts use CFF
+    const uint32_t version = ReadUInt32(offset);
+    if (version != 0x00010000 && version != MakeTag("true"))
+        return false;
+
+    size_t head = 0, hhea = 0, maxp = 0, cmap = 0, name = 0, os2 = 0;
+
+    const uint32_t table_count = ReadUInt16(offset + 4);
+    for (uint32_t i = 0; i < table_count; ++i)
+    {
+        const size_t   record       = offset + 12 + size_t(i) * 16;
+        const uint32_t tag          = ReadUInt32(record);
+        const uint32_t table_offset = ReadUInt32(record + 8);
+        const uint32_t table_length = ReadUInt32(record + 12);
+        if (size_t(table_offset) + table_length > data_.size())
+            return false;
+
+        if (tag == MakeTag("head"))
+            head = table_offset;
+        else if (tag == MakeTag("hhea"))
+            hhea = table_offset;
+        else if (tag == MakeTag("maxp"))
+            maxp = table_offset;
+        else if (tag == MakeTag("cmap"))
+            cmap = table_offset;
+        else if (tag == MakeTag("loca"))
+            loca_ = table_offset;
+        else if (tag == MakeTag("glyf"))
+            glyf_ = table_offset;
+        else if (tag == MakeTag("hmtx"))
+            hmtx_ = table_offset;
+        else if (tag == MakeTag("name"))
+            name = table_offset;
+        else if (tag == MakeTag("OS/2"))
+            os2 = table_offset;
+    }
+
+    if (!head || !hhea || !maxp || !cmap || !loca_ || !glyf_ || !hmtx_)
+        return false;
+
+    units_per_em_ = ReadUInt16(head + 18);
+    long_offsets_ = ReadInt16(head + 50) != 0;
+    italic_       = (ReadUInt16(head + 44) & 0x02) != 0;
+    ascent_       = ReadInt16(hhea + 4);
+    descent_      = ReadInt16(hhea + 6);
+    line_gap_     = ReadInt16(hhea + 8);
+    metric_count_ = ReadUInt16(hhea + 34);
+    glyph_count_  = ReadUInt16(maxp + 4);
+    if (units_per_em_ == 0)
+        return false;
+
+    if (os2)
+        weight_ = ReadUInt16(os2 + 4);
+
+    // Prefer the full Unicode mapping, then the Basic Multilingual Plane one
+    int            best           = 0;
+    const uint32_t subtable_count = ReadUInt16(cmap + 2);
+    for (uint32_t i = 0; i < subtable_count; ++i)
+    {
+        const size_t   record   = cmap + 4 + size_t(i) * 8;
+        const uint16_t platform = ReadUInt16(record);
+        const uint16_t encoding = ReadUInt16(record + 2);
+        const size_t   subtable = cmap + ReadUInt32(record + 4);
+        const uint16_t format   = ReadUInt16(subtable);
+
+        int score = 0;
+        if (format == 12 && (platform == 0 || (platform == 3 && encoding == 10)))
+            score = 3;
+        else if (format == 4 && (platform == 0 || (platform == 3 && encoding == 1)))
+            score = 2;
+        else if (format == 4 && platform == 3 && encoding == 0)
+            score = 1;
+
+        if (score > best)
+        {
+            best  = score;
+            cmap_ = subtable;
+        }
+    }
+    if (best == 0)
+        return false;
+
+    // Family name, English names from the Windows platform first
+    if (name)
+    {
+        const uint32_t record_count = ReadUInt16(name + 2);
+        const size_t   storage      = name + ReadUInt16(name + 4);
+        int            name_score   = 0;
+        for (uint32_t i = 0; i < record_count; ++i)
+        {
+            const size_t   record   = name + 6 + size_t(i) * 12;
+            const uint16_t platform = ReadUInt16(record);
+            const uint16_t language = ReadUInt16(record + 4);
+            const uint16_t name_id  = ReadUInt16(record + 6);
+            const uint16_t length   = ReadUInt16(record + 8);
+            const size_t   string   = storage + ReadUInt16(record + 10);
+            if (name_id != 1 || string + length > data_.size())
+                continue;
+
+            int score = 0;
+            if (platform == 3 && language == 0x0409)
+                score = 3;
+            else if (platform == 3)
+                score = 2;
+            else if (platform == 1)
+                score = 1;
+            if (score <= name_score)
+                continue;
+
+            name_score = score;
+            family_name_.clear();
+            if (platform == 3)
+            {
+                for (size_t c = 0; c + 1 < length; c += 2)
+                {
+                    uint32_t ch = ReadUInt16(string + c);
+                    if (ch >= 0xD800 && ch < 0xDC00 && c + 3 < length)
+                    {
+                        const uint32_t low = ReadUInt16(string + c + 2);
+                        ch                 = 0x10000 + ((ch - 0xD800) << 10) + (low - 0xDC00);
+                        c += 2;
+                    }
+                    AppendUTF8(family_name_, ch);
+                }
+            }
+            else
+            {
+                family_name_.assign(reinterpret_cast<const char*>(&data_[string]), length);
+            }
+        }
+    }
+    return true;
+}
+
+uint16_t FontFace::ReadUInt16(size_t offset) const
+{
+    if (offset + 2 > data_.size())
+        return 0;
+    return uint16_t((data_[offset] << 8) | data_[offset + 1]);
+}
+
+uint32_t FontFace::ReadUInt32(size_t offset) const
+{
+    if (offset + 4 > data_.size())
+        return 0;
+    return (uint32_t(data_[offset]) << 24) | (uint32_t(data_[offset + 1]) << 16) | (uint32_t(data_[offset + 2]) << 8)
+           | uint32_t(data_[offset + 3]);
+}
+
+int16_t FontFace::ReadInt16(size_t offset) const
+{
+    return int16_t(ReadUInt16(offset));
+}
+
+bool FontFace::LoadGlyph(uint32_t glyph, const Matrix3x2& transform, Vector<Point>& points, Vector<uint8_t>& on_curve,
+                         Vector<size_t>& contour_ends, int depth) const
+{
+    if (glyph >= glyph_count_ || depth > max_composite_depth)
+        return false;
+
+    size_t begin = 0;
+    size_t end   = 0;
+    if (long_offsets_)
+    {
+        begin = ReadUInt32(loca_ + size_t(glyph) * 4);
+        end   = ReadUInt32(loca_ + size_t(glyph) * 4 + 4);
+    }
+    else
+    {
+        begin = size_t(ReadUInt16(loca_ + size_t(glyph) * 2)) * 2;
+        end   = size_t(ReadUInt16(loca_ + size_t(glyph) * 2 + 2)) * 2;
+    }
+
+    // Glyphs without outline, such as spaces
+    if (end <= begin)
+        return true;
+
+    const size_t  offset        = glyf_ + begin;
+    const int16_t contour_count = ReadInt16(offset);
+    if (offset + (end - begin) > data_.size())
+        return false;
+
+    if (contour_count >= 0)
+    {
+        const size_t end_points = offset + 10;
+        const size_t point_count =
+            contour_count > 0 ? size_t(ReadUInt16(end_points + size_t(contour_count - 1) * 2)) + 1 : 0;
+
+        size_t pos = end_points + size_t(contour_count) * 2;
+        pos += 2 + ReadUInt16(pos);  // skip instructions
+
+        // Flags, with repeat counts
+        Vector<uint8_t> flags;
+        flags.reserve(point_count);
+        while (flags.size() < point_count)
+        {
+            if (pos >= data_.size())
+                return false;
+
+            const uint8_t flag = data_[pos++];
+            flags.push_back(flag);
+            if (flag & 0x08)
+            {
+                if (pos >= data_.size())
+                    return false;
+                for (uint8_t repeat = data_[pos++]; repeat > 0 && flags.size() < point_count; --repeat)
+                    flags.push_back(flag);
+            }
+        }
+
+        // Coordinates are stored as deltas, either in a byte with a separate sign or in a 16-bit integer
+        Vector<Point> coords(point_count);
+        for (int axis = 0; axis < 2; ++axis)
+        {
+            const uint8_t short_flag = axis == 0 ? 0x02 : 0x04;
+            const uint8_t same_flag  = axis == 0 ? 0x10 : 0x20;
+
+            int value = 0;
+            for (size_t i = 0; i < point_count; ++i)
+            {
+                if (flags[i] & short_flag)
+                {
+                    if (pos >= data_.size())
+                        return false;
+                    const int delta = data_[pos++];
+                    value += (flags[i] & same_flag) ? delta : -delta;
+                }
+                else if (!(flags[i] & same_flag))
+                {
+                    value += ReadInt16(pos);
+                    pos += 2;
+                }
+
+                if (axis == 0)
+                    coords[i].x = float(value);
+                else
+                    coords[i].y = float(value);
+            }
+        }
+
+        const size_t base = points.size();
+        for (size_t i = 0; i < point_count; ++i)
+        {
+            points.push_back(transform.Transform(coords[i]));
+            on_curve.push_back(flags[i] & 0x01);
+        }
+        size_t last_end = 0;
+        for (int16_t c = 0; c < contour_count; ++c)
+        {
+            const size_t contour_end = size_t(ReadUInt16(end_points + size_t(c) * 2)) + 1;
+            if (contour_end < last_end || contour_end > point_count)
+                return false;
+            contour_ends.push_back(base + contour_end);
+            last_end = contour_end;
+        }
+        return true;
+    }
+
+    // Composite glyph, made of other glyphs placed with their own transforms
+    size_t   pos   = offset + 10;
+    uint16_t flags = 0;
+    do
+    {
+        if (pos + 4 > offset + (end - begin))
+            return false;
+
+        flags                = ReadUInt16(pos);
+        const uint32_t child = ReadUInt16(pos + 2);
+        pos += 4;
+
+        float dx = 0.0f;
+        float dy = 0.0f;
+        if (flags & arg_1_and_2_are_words)
+        {
+            dx = float(ReadInt16(pos));
+            dy = float(ReadInt16(pos + 2));
+            pos += 4;
+        }
+        else
+        {
+            const uint16_t args = ReadUInt16(pos);
+            dx                  = float(int8_t(args >> 8));
+            dy                  = float(int8_t(args & 0xFF));
+            pos += 2;
+        }
+
+        // Components aligned by matching points are placed without offset
+        if (!(flags & args_are_xy_values))
+        {
+            dx = 0.0f;
+            dy = 0.0f;
+        }
+
+        Matrix3x2 local;
+        if (flags & we_have_a_scale)
+        {
+            local._11 = local._22 = float(ReadInt16(pos)) / 16384.0f;
+            pos += 2;
+        }
+        else if (flags & we_have_an_x_and_y_scale)
+        {
+            local._11 = float(ReadInt16(pos)) / 16384.0f;
+            local._22 = float(ReadInt16(pos + 2)) / 16384.0f;
+            pos += 4;
+        }
+        else if (flags & we_have_a_two_by_two)
+        {
+            local._11 = float(ReadInt16(pos)) / 16384.0f;
+            local._12 = float(ReadInt16(pos + 2)) / 16384.0f;
+            local._21 = float(ReadInt16(pos + 4)) / 16384.0f;
+            local._22 = float(ReadInt16(pos + 6)) / 16384.0f;
+            pos += 8;
+        }
+        local._31 = dx;
+        local._32 = dy;
+
+        if (!LoadGlyph(child, local * transform, points, on_curve, contour_ends, depth + 1))
+            return false;
+    } while (flags & more_components);
+    return true;
+}
+
+}  // namespace software
+}  // namespace graphics
+}  // namespace kiwano
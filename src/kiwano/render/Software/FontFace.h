@@ -0,0 +1,176 @@
+// Copyright (c) 2016-2019 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <kiwano/base/RefObject.h>
+#include <kiwano/core/BinaryData.h>
+#include <kiwano/render/Software/Rasterizer.h>
+
+namespace kiwano
+{
+namespace graphics
+{
+namespace software
+{
+
+/// \~chinese
+/// @brief TrueType 
+/// @details ֧ TTF  TTC ļʹ glyf 壬֧ CFF ΢ָ
+class KGE_API FontFace : public RefObject
+{
+public:
+    FontFace();
+
+    /// \~chinese
+    /// @brief 
+    /// @param data ļݣᱻ
+    /// @param index TTC ļе
+    /// @return Чʽ֧ʱؿָ
+    static RefPtr<FontFace> Load(const BinaryData& data, uint32_t index = 0);
+
+    /// \~chinese
+    /// @brief ȡļе
+    static uint32_t GetFaceCount(const BinaryData& data);
+
+    /// \~chinese
+    /// @brief ȡϵͳ
+    /// @details ״εʱϵͳĿ¼س壬ûָȱε
+    static const Vector<RefPtr<FontFace>>& GetSystemFaces();
+
+    const String& GetFamilyName() const;
+
+    uint32_t GetWeight() const;
+
+    bool IsItalic() const;
+
+    /// \~chinese
+    /// @brief ȡϵĸ߶ȣλΪ em
+    float GetAscent() const;
+
+    /// \~chinese
+    /// @brief ȡµȣλΪ em
+    float GetDescent() const;
+
+    /// \~chinese
+    /// @brief ȡм࣬λΪ em
+    float GetLineGap() const;
+
+    /// \~chinese
+    /// @brief ȡַӦţûиַʱ 0
+    uint32_t GetGlyphIndex(uint32_t codepoint) const;
+
+    /// \~chinese
+    /// @brief ȡεĲȣλΪ em
+    float GetAdvance(uint32_t glyph) const;
+
+    /// \~chinese
+    /// @brief תΪ
+    /// @param path λ
+    /// @param glyph 
+    /// @param transform  em ϵy ϣԭڻϣĿϵı任
+    void AddGlyph(PathBuffer& path, uint32_t glyph, const Matrix3x2& transform) const;
+
+private:
+    bool Parse(uint32_t index);
+
+    uint16_t ReadUInt16(size_t offset) const;
+
+    uint32_t ReadUInt32(size_t offset) const;
+
+    int16_t ReadInt16(size_t offset) const;
+
+    bool LoadGlyph(uint32_t glyph, const Matrix3x2& transform, Vector<Point>& points, Vector<uint8_t>& on_curve,
+                   Vector<size_t>& contour_ends, int depth) const;
+
+private:
+    Vector<uint8_t> data_;
+    String          family_name_;
+    uint32_t        weight_;
+    bool            italic_;
+    uint32_t        units_per_em_;
+    int16_t         ascent_;
+    int16_t         descent_;
+    int16_t         line_gap_;
+    uint32_t        glyph_count_;
+    uint32_t        metric_count_;
+    bool            long_offsets_;
+    size_t          cmap_;
+    size_t          loca_;
+    size_t          glyf_;
+    size_t          hmtx_;
+};
+
+/// \~chinese
+/// @brief 弯
+class KGE_API FontFaceCollection : public RefObject
+{
+public:
+    void AddFace(RefPtr<FontFace> face);
+
+    const Vector<RefPtr<FontFace>>& GetFaces() const;
+
+private:
+    Vector<RefPtr<FontFace>> faces_;
+};
+
+inline const String& FontFace::GetFamilyName() const
+{
+    return family_name_;
+}
+
+inline uint32_t FontFace::GetWeight() const
+{
+    return weight_;
+}
+
+inline bool FontFace::IsItalic() const
+{
+    return italic_;
+}
+
+inline float FontFace::GetAscent() const
+{
+    return float(ascent_) / float(units_per_em_);
+}
+
+inline float FontFace::GetDescent() const
+{
+    return float(-descent_) / float(units_per_em_);
+}
+
+inline float FontFace::GetLineGap() const
+{
+    return float(line_gap_) / float(units_per_em_);
+}
+
+inline void FontFaceCollection::AddFace(RefPtr<FontFace> face)
+{
+    if (face)
+        faces_.push_back(face);
+}
+
+inline const Vector<RefPtr<FontFace>>& FontFaceCollection::GetFaces() const
+{
+    return faces_;
+}
+
+}  // namespace software
+}  // namespace graphics
+}  // namespace kiwano
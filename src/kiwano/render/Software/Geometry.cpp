@@ -0,0 +1,703 @@
+// Copyright (c) 2016-2019 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <algorithm>
+#include <cmath>
+#include <kiwano/render/Software/Geometry.h>
+
+namespace kiwano
+{
+namespace graphics
+{
+namespace software
+{
+
+namespace
+{
+
+inline int GetSegmentCount(float length, int min_count, int max_count)
+{
+    return std::min(std::max(int(std::ceil(length / 4.0f)), min_count), max_count);
+}
+
+inline float GetVectorAngle(float ux, float uy, float vx, float vy)
+{
+    return std::atan2(ux * vy - uy * vx, ux * vx + uy * vy);
+}
+
+void AddEllipseArc(Vector<Point>& points, const Point& center, const Vec2& radius, float start, float sweep)
+{
+    const float perimeter = std::abs(sweep) * std::max(radius.x, radius.y);
+    const int   segments  = GetSegmentCount(perimeter, 4, 256);
+    for (int i = 1; i <= segments; ++i)
+    {
+        const float angle = start + sweep * float(i) / float(segments);
+        points.push_back(Point(center.x + radius.x * std::cos(angle), center.y + radius.y * std::sin(angle)));
+    }
+}
+
+// Edges of both operands of a boolean operation, figures are treated as closed
+struct CombineEdge
+{
+    Point p;
+    Point q;
+    int   owner;
+};
+
+struct CombineSplit
+{
+    double t;
+    Point  point;
+};
+
+inline double Cross(double ax, double ay, double bx, double by)
+{
+    return ax * by - ay * bx;
+}
+
+void CollectEdges(Vector<CombineEdge>& edges, const Geometry& geometry, const Matrix3x2* transform, int owner)
+{
+    for (const auto& figure : geometry.GetFigures())
+    {
+        const size_t count = figure.points.size();
+        for (size_t i = 0; i < count; ++i)
+        {
+            Point p = figure.points[i];
+            Point q = figure.points[(i + 1) % count];
+            if (transform)
+            {
+                p = transform->Transform(p);
+                q = transform->Transform(q);
+            }
+            if (p != q)
+                edges.push_back(CombineEdge{ p, q, owner });
+        }
+    }
+}
+
+// Parameter of point on the line of an edge, the point is expected to lie on the line
+double ProjectOnEdge(const CombineEdge& edge, const Point& point)
+{
+    const double dx = double(edge.q.x) - edge.p.x;
+    const double dy = double(edge.q.y) - edge.p.y;
+    return ((double(point.x) - edge.p.x) * dx + (double(point.y) - edge.p.y) * dy) / (dx * dx + dy * dy);
+}
+
+// Finds where two edges cross or touch, and records the points on the edges that have to be split there.
+// The same point is recorded on both edges, so that the pieces meet exactly
+void IntersectEdges(const CombineEdge& e1, const CombineEdge& e2, Vector<CombineSplit>& s1, Vector<CombineSplit>& s2)
+{
+    const double eps = 1e-6;
+
+    const double rx = double(e1.q.x) - e1.p.x, ry = double(e1.q.y) - e1.p.y;
+    const double sx = double(e2.q.x) - e2.p.x, sy = double(e2.q.y) - e2.p.y;
+    const double wx = double(e2.p.x) - e1.p.x, wy = double(e2.p.y) - e1.p.y;
+
+    const double denom = Cross(rx, ry, sx, sy);
+    const double scale = std::sqrt((rx * rx + ry * ry) * (sx * sx + sy * sy));
+    if (std::abs(denom) > eps * scale)
+    {
+        const double t = Cross(wx, wy, sx, sy) / denom;
+        const double u = Cross(wx, wy, rx, ry) / denom;
+        if (t < -eps || t > 1 + eps || u < -eps || u > 1 + eps)
+            return;
+
+        const bool t_inner = t > eps && t < 1 - eps;
+        const bool u_inner = u > eps && u < 1 - eps;
+        if (t_inner && u_inner)
+        {
+            const Point point(float(e1.p.x + rx * t), float(e1.p.y + ry * t));
+            s1.push_back(CombineSplit{ t, point });
+            s2.push_back(CombineSplit{ u, point });
+        }
+        else if (t_inner)
+        {
+            // An end of the second edge touches the first one
+            s1.push_back(CombineSplit{ t, u < 0.5 ? e2.p : e2.q });
+        }
+        else if (u_inner)
+        {
+            s2.push_back(CombineSplit{ u, t < 0.5 ? e1.p : e1.q });
+        }
+        return;
+    }
+
+    // Parallel edges only interact when they overlap on the same line
+    if (std::abs(Cross(wx, wy, rx, ry)) > eps * (rx * rx + ry * ry))
+        return;
+
+    for (const Point& end : { e2.p, e2.q })
+    {
+        const double t = ProjectOnEdge(e1, end);
+        if (t > eps && t < 1 - eps)
+            s1.push_back(CombineSplit{ t, end });
+    }
+    for (const Point& end : { e1.p, e1.q })
+    {
+        const double u = ProjectOnEdge(e2, end);
+        if (u > eps && u < 1 - eps)
+            s2.push_back(CombineSplit{ u, end });
+    }
+}
+
+bool IsInside(const Vector<CombineEdge>& edges, int owner, double x, double y)
+{
+    int winding = 0;
+    for (const auto& edge : edges)
+    {
+        if (edge.owner != owner)
+            continue;
+
+        const double ax = edge.p.x, ay = edge.p.y;
+        const double bx = edge.q.x, by = edge.q.y;
+
+        const double side = Cross(bx - ax, by - ay, x - ax, y - ay);
+        if (ay <= y)
+        {
+            if (by > y && side > 0)
+                ++winding;
+        }
+        else if (by <= y && side < 0)
+        {
+            --winding;
+        }
+    }
+    return winding != 0;
+}
+
+bool ApplyCombineMode(CombineMode mode, bool in_a, bool in_b)
+{
+    switch (mode)
+    {
+    case CombineMode::Union:
+        return in_a || in_b;
+    case CombineMode::Intersect:
+        return in_a && in_b;
+    case CombineMode::Xor:
+        return in_a != in_b;
+    case CombineMode::Exclude:
+        return in_a && !in_b;
+    default:
+        return false;
+    }
+}
+
+}  // namespace
+
+Geometry::Geometry() {}
+
+void Geometry::AddFigure(Figure&& figure)
+{
+    if (!figure.points.empty())
+    {
+        figures_.push_back(std::move(figure));
+    }
+}
+
+void Geometry::Append(const Geometry& other, const Matrix3x2* transform)
+{
+    for (const auto& figure : other.figures_)
+    {
+        Figure copy = figure;
+        if (transform)
+        {
+            for (auto& point : copy.points)
+                point = transform->Transform(point);
+        }
+        figures_.push_back(std::move(copy));
+    }
+}
+
+RefPtr<Geometry> Geometry::Combine(const Geometry& a, const Geometry& b, CombineMode mode, const Matrix3x2* transform)
+{
+    // The edges of both operands are split where they meet, and each piece is kept if the result is filled on
+    // exactly one side of it. The kept pieces are then joined into closed figures.
+    Vector<CombineEdge> edges;
+    CollectEdges(edges, a, nullptr, 0);
+    CollectEdges(edges, b, transform, 1);
+
+    RefPtr<Geometry> output = MakePtr<Geometry>();
+    if (edges.empty())
+        return output;
+
+    Vector<Vector<CombineSplit>> splits(edges.size());
+    for (size_t i = 0; i < edges.size(); ++i)
+    {
+        for (size_t j = i + 1; j < edges.size(); ++j)
+        {
+            IntersectEdges(edges[i], edges[j], splits[i], splits[j]);
+        }
+    }
+
+    float extent = 0.0f;
+    for (const auto& edge : edges)
+    {
+        extent = std::max({ extent, std::abs(edge.p.x), std::abs(edge.p.y), std::abs(edge.q.x), std::abs(edge.q.y) });
+    }
+
+    // Sample points are moved off the pieces by a distance far below a pixel
+    const double offset = 1e-4 * std::max(1.0, double(extent));
+
+    Vector<CombineEdge> kept;
+    for (size_t i = 0; i < edges.size(); ++i)
+    {
+        auto& points = splits[i];
+        std::sort(points.begin(), points.end(),
+                  [](const CombineSplit& lhs, const CombineSplit& rhs) { return lhs.t < rhs.t; });
+
+        Point start = edges[i].p;
+        for (size_t k = 0; k <= points.size(); ++k)
+        {
+            const Point end = (k < points.size()) ? points[k].point : edges[i].q;
+            if (end == start)
+                continue;
+
+            const double dx  = double(end.x) - start.x;
+            const double dy  = double(end.y) - start.y;
+            const double len = std::sqrt(dx * dx + dy * dy);
+            const double d   = std::min(offset, len * 0.25);
+            const double nx  = -dy / len * d;
+            const double ny  = dx / len * d;
+            const double mx  = (double(start.x) + end.x) * 0.5;
+            const double my  = (double(start.y) + end.y) * 0.5;
+
+            const bool left  = ApplyCombineMode(mode, IsInside(edges, 0, mx + nx, my + ny), IsInside(edges, 1, mx + nx, my + ny));
+            const bool right = ApplyCombineMode(mode, IsInside(edges, 0, mx - nx, my - ny), IsInside(edges, 1, mx - nx, my - ny));
+            if (left != right)
+            {
+                // Orient the piece so that the filled side is always on its left
+                if (left)
+                    kept.push_back(CombineEdge{ start, end, 0 });
+                else
+                    kept.push_back(CombineEdge{ end, start, 0 });
+            }
+            start = end;
+        }
+    }
+
+    // Pieces shared by both operands are kept once
+    auto less = [](const CombineEdge& lhs, const CombineEdge& rhs) {
+        if (lhs.p.x != rhs.p.x)
+            return lhs.p.x < rhs.p.x;
+        if (lhs.p.y != rhs.p.y)
+            return lhs.p.y < rhs.p.y;
+        if (lhs.q.x != rhs.q.x)
+            return lhs.q.x < rhs.q.x;
+        return lhs.q.y < rhs.q.y;
+    };
+    std::sort(kept.begin(), kept.end(), less);
+    kept.erase(std::unique(kept.begin(), kept.end(),
+                           [](const CombineEdge& lhs, const CombineEdge& rhs) { return lhs.p == rhs.p && lhs.q == rhs.q; }),
+               kept.end());
+
+    // Join the pieces into figures, sorted by start point so that the next piece is found by binary search
+    Vector<bool> used(kept.size(), false);
+    for (size_t first = 0; first < kept.size(); ++first)
+    {
+        if (used[first])
+            continue;
+
+        Figure figure;
+        figure.closed = true;
+
+        size_t current = first;
+        while (true)
+        {
+            used[current] = true;
+            figure.points.push_back(kept[current].p);
+
+            const Point& end = kept[current].q;
+            if (end == kept[first].p)
+                break;
+
+            auto iter = std::lower_bound(kept.begin(), kept.end(), CombineEdge{ end, end, 0 },
+                                         [](const CombineEdge& lhs, const CombineEdge& rhs) {
+                                             if (lhs.p.x != rhs.p.x)
+                                                 return lhs.p.x < rhs.p.x;
+                                             return lhs.p.y < rhs.p.y;
+                                         });
+
+            size_t next = kept.size();
+            for (; iter != kept.end() && iter->p == end; ++iter)
+            {
+                const size_t index = size_t(iter - kept.begin());
+                if (!used[index])
+                {
+                    next = index;
+                    break;
+                }
+            }
+
+            // The figure can not be continued because of rounding, close it where it is
+            if (next == kept.size())
+                break;
+            current = next;
+        }
+
+        output->AddFigure(std::move(figure));
+    }
+    return output;
+}
+
+Rect Geometry::GetBounds(const Matrix3x2* transform) const
+{
+    bool  empty = true;
+    Point min, max;
+    for (const auto& figure : figures_)
+    {
+        for (const auto& point : figure.points)
+        {
+            const Point p = transform ? transform->Transform(point) : point;
+            if (empty)
+            {
+                min = max = p;
+                empty     = false;
+            }
+            else
+            {
+                min.x = std::min(min.x, p.x);
+                min.y = std::min(min.y, p.y);
+                max.x = std::max(max.x, p.x);
+                max.y = std::max(max.y, p.y);
+            }
+        }
+    }
+    return empty ? Rect() : Rect(min, max);
+}
+
+float Geometry::ComputeLength() const
+{
+    float length = 0.0f;
+    for (const auto& figure : figures_)
+    {
+        const size_t count = figure.points.size();
+        for (size_t i = 1; i < count; ++i)
+        {
+            length += (figure.points[i] - figure.points[i - 1]).Length();
+        }
+        if (figure.closed && count > 1)
+        {
+            length += (figure.points[0] - figure.points[count - 1]).Length();
+        }
+    }
+    return length;
+}
+
+float Geometry::ComputeArea() const
+{
+    // Overlapping figures and holes are resolved first, the outlines of the filled area all turn the same way
+    RefPtr<Geometry> outline = Combine(*this, Geometry(), CombineMode::Union, nullptr);
+
+    double area = 0.0;
+    for (const auto& figure : outline->figures_)
+    {
+        const size_t count = figure.points.size();
+        for (size_t i = 0; i < count; ++i)
+        {
+            const Point& a = figure.points[i];
+            const Point& b = figure.points[(i + 1) % count];
+            area += double(a.x) * b.y - double(b.x) * a.y;
+        }
+    }
+    return float(std::abs(area) * 0.5);
+}
+
+bool Geometry::ComputePointAtLength(float length, Point& point, Vec2& tangent) const
+{
+    const Point* last_point = nullptr;
+    Vec2         last_tangent;
+
+    for (const auto& figure : figures_)
+    {
+        const size_t count    = figure.points.size();
+        const size_t segments = figure.closed ? count : count - 1;
+        for (size_t i = 0; i < segments; ++i)
+        {
+            const Point& p = figure.points[i];
+            const Point& q = figure.points[(i + 1) % count];
+
+            const float segment_length = (q - p).Length();
+            if (segment_length <= 0.0f)
+                continue;
+
+            last_point   = &q;
+            last_tangent = (q - p) / segment_length;
+            if (length <= segment_length)
+            {
+                point   = p + last_tangent * std::max(length, 0.0f);
+                tangent = last_tangent;
+                return true;
+            }
+            length -= segment_length;
+        }
+    }
+
+    // Clamp to the end of the path
+    if (last_point)
+    {
+        point   = *last_point;
+        tangent = last_tangent;
+        return true;
+    }
+    return false;
+}
+
+bool Geometry::FillContainsPoint(const Point& point, const Matrix3x2* transform) const
+{
+    Point p = point;
+    if (transform)
+    {
+        if (!transform->IsInvertible())
+            return false;
+        p = transform->Invert().Transform(point);
+    }
+
+    int winding = 0;
+    for (const auto& figure : figures_)
+    {
+        const size_t count = figure.points.size();
+        for (size_t i = 0; i < count; ++i)
+        {
+            const Point& a = figure.points[i];
+            const Point& b = figure.points[(i + 1) % count];
+
+            const float side = (b.x - a.x) * (p.y - a.y) - (p.x - a.x) * (b.y - a.y);
+            if (a.y <= p.y)
+            {
+                if (b.y > p.y && side > 0.0f)
+                    ++winding;
+            }
+            else if (b.y <= p.y && side < 0.0f)
+            {
+                --winding;
+            }
+        }
+    }
+    return winding != 0;
+}
+
+void Geometry::Fill(PathBuffer& output, const Matrix3x2& transform) const
+{
+    for (const auto& figure : figures_)
+    {
+        // Open figures are filled as if they were closed
+        output.AddContour(figure.points.data(), figure.points.size(), transform);
+    }
+}
+
+void Geometry::Stroke(PathBuffer& output, float width, const StrokeStyle* style, const Matrix3x2& transform) const
+{
+    for (const auto& figure : figures_)
+    {
+        StrokePolyline(output, figure.points.data(), figure.points.size(), figure.closed, width, style, transform);
+    }
+}
+
+RefPtr<Geometry> Geometry::CreateLine(const Point& begin, const Point& end)
+{
+    RefPtr<Geometry> output = MakePtr<Geometry>();
+    output->AddFigure(Figure{ { begin, end }, false });
+    return output;
+}
+
+RefPtr<Geometry> Geometry::CreateRect(const Rect& rect)
+{
+    RefPtr<Geometry> output = MakePtr<Geometry>();
+    output->AddFigure(
+        Figure{ { rect.GetLeftTop(), rect.GetRightTop(), rect.GetRightBottom(), rect.GetLeftBottom() }, true });
+    return output;
+}
+
+RefPtr<Geometry> Geometry::CreateRoundedRect(const Rect& rect, const Vec2& radius)
+{
+    const float rx = std::min(std::abs(radius.x), rect.GetWidth() * 0.5f);
+    const float ry = std::min(std::abs(radius.y), rect.GetHeight() * 0.5f);
+    if (rx <= 0.0f || ry <= 0.0f)
+        return CreateRect(rect);
+
+    const float left   = rect.GetLeft();
+    const float top    = rect.GetTop();
+    const float right  = rect.GetRight();
+    const float bottom = rect.GetBottom();
+    const Vec2  r(rx, ry);
+
+    Figure figure;
+    figure.closed = true;
+    figure.points.push_back(Point(left + rx, top));
+    figure.points.push_back(Point(right - rx, top));
+    AddEllipseArc(figure.points, Point(right - rx, top + ry), r, -math::PI_F_2, math::PI_F_2);
+    figure.points.push_back(Point(right, bottom - ry));
+    AddEllipseArc(figure.points, Point(right - rx, bottom - ry), r, 0.0f, math::PI_F_2);
+    figure.points.push_back(Point(left + rx, bottom));
+    AddEllipseArc(figure.points, Point(left + rx, bottom - ry), r, math::PI_F_2, math::PI_F_2);
+    figure.points.push_back(Point(left, top + ry));
+    AddEllipseArc(figure.points, Point(left + rx, top + ry), r, math::PI_F, math::PI_F_2);
+
+    RefPtr<Geometry> output = MakePtr<Geometry>();
+    output->AddFigure(std::move(figure));
+    return output;
+}
+
+RefPtr<Geometry> Geometry::CreateEllipse(const Point& center, const Vec2& radius)
+{
+    Figure figure;
+    figure.closed = true;
+    figure.points.push_back(Point(center.x + radius.x, center.y));
+    AddEllipseArc(figure.points, center, radius, 0.0f, math::PI_F_X_2);
+    figure.points.pop_back();
+
+    RefPtr<Geometry> output = MakePtr<Geometry>();
+    output->AddFigure(std::move(figure));
+    return output;
+}
+
+GeometrySink::GeometrySink(RefPtr<Geometry> geometry)
+    : opened_(false)
+    , geometry_(geometry)
+{
+    current_.closed = false;
+}
+
+void GeometrySink::BeginFigure(const Point& begin_pos)
+{
+    if (opened_)
+        EndFigure(false);
+
+    opened_ = true;
+    current_.points.clear();
+    current_.points.push_back(begin_pos);
+}
+
+void GeometrySink::EndFigure(bool closed)
+{
+    if (!opened_)
+        return;
+
+    opened_         = false;
+    current_.closed = closed;
+    geometry_->AddFigure(std::move(current_));
+    current_ = Geometry::Figure{};
+}
+
+void GeometrySink::AddLine(const Point& point)
+{
+    current_.points.push_back(point);
+}
+
+void GeometrySink::AddLines(const Point* points, size_t count)
+{
+    current_.points.insert(current_.points.end(), points, points + count);
+}
+
+void GeometrySink::AddBezier(const Point& point1, const Point& point2, const Point& point3)
+{
+    KGE_ASSERT(!current_.points.empty());
+
+    const Point p0 = current_.points.back();
+
+    const float length = (point1 - p0).Length() + (point2 - point1).Length() + (point3 - point2).Length();
+    const int   segments = GetSegmentCount(length, 4, 64);
+    for (int i = 1; i <= segments; ++i)
+    {
+        const float t  = float(i) / float(segments);
+        const float mt = 1.0f - t;
+        const float a  = mt * mt * mt;
+        const float b  = 3.0f * mt * mt * t;
+        const float c  = 3.0f * mt * t * t;
+        const float d  = t * t * t;
+        current_.points.push_back(p0 * a + point1 * b + point2 * c + point3 * d);
+    }
+}
+
+void GeometrySink::AddArc(const Point& point, const Size& radius, float rotation, bool clockwise, bool is_small)
+{
+    KGE_ASSERT(!current_.points.empty());
+
+    // Endpoint to center parameterization, see SVG 1.1 implementation notes F.6.5
+    const Point p1 = current_.points.back();
+    const Point p2 = point;
+
+    float rx = std::abs(radius.x);
+    float ry = std::abs(radius.y);
+    if (rx == 0.0f || ry == 0.0f || p1 == p2)
+    {
+        current_.points.push_back(p2);
+        return;
+    }
+
+    const float phi     = rotation * math::PI_F / 180.0f;
+    const float cos_phi = std::cos(phi);
+    const float sin_phi = std::sin(phi);
+
+    const float dx  = (p1.x - p2.x) * 0.5f;
+    const float dy  = (p1.y - p2.y) * 0.5f;
+    const float x1p = cos_phi * dx + sin_phi * dy;
+    const float y1p = -sin_phi * dx + cos_phi * dy;
+
+    // Scale up the radius if there is no solution
+    const float lambda = (x1p * x1p) / (rx * rx) + (y1p * y1p) / (ry * ry);
+    if (lambda > 1.0f)
+    {
+        rx *= std::sqrt(lambda);
+        ry *= std::sqrt(lambda);
+    }
+
+    const float num  = rx * rx * ry * ry - rx * rx * y1p * y1p - ry * ry * x1p * x1p;
+    const float den  = rx * rx * y1p * y1p + ry * ry * x1p * x1p;
+    const float sign = ((!is_small) != clockwise) ? 1.0f : -1.0f;
+    const float coef = sign * std::sqrt(std::max(0.0f, num / den));
+
+    const float cxp = coef * rx * y1p / ry;
+    const float cyp = -coef * ry * x1p / rx;
+    const float cx  = cos_phi * cxp - sin_phi * cyp + (p1.x + p2.x) * 0.5f;
+    const float cy  = sin_phi * cxp + cos_phi * cyp + (p1.y + p2.y) * 0.5f;
+
+    const float ux = (x1p - cxp) / rx;
+    const float uy = (y1p - cyp) / ry;
+    const float vx = (-x1p - cxp) / rx;
+    const float vy = (-y1p - cyp) / ry;
+
+    const float start = GetVectorAngle(1.0f, 0.0f, ux, uy);
+    float       sweep = GetVectorAngle(ux, uy, vx, vy);
+    if (!clockwise && sweep > 0.0f)
+        sweep -= math::PI_F_X_2;
+    else if (clockwise && sweep < 0.0f)
+        sweep += math::PI_F_X_2;
+
+    const int segments = GetSegmentCount(std::abs(sweep) * std::max(rx, ry), 4, 256);
+    for (int i = 1; i < segments; ++i)
+    {
+        const float angle = start + sweep * float(i) / float(segments);
+        const float ex    = rx * std::cos(angle);
+        const float ey    = ry * std::sin(angle);
+        current_.points.push_back(Point(cos_phi * ex - sin_phi * ey + cx, sin_phi * ex + cos_phi * ey + cy));
+    }
+    current_.points.push_back(p2);
+}
+
+void GeometrySink::Close()
+{
+    if (opened_)
+        EndFigure(false);
+}
+
+}  // namespace software
+}  // namespace graphics
+}  // namespace kiwano
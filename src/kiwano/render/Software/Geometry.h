@@ -0,0 +1,130 @@
+// Copyright (c) 2016-2019 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <kiwano/base/RefObject.h>
+#include <kiwano/render/ShapeMaker.h>
+#include <kiwano/render/Software/Rasterizer.h>
+
+namespace kiwano
+{
+namespace graphics
+{
+namespace software
+{
+
+/// \~chinese
+/// @brief ͼΣڴʱչΪ
+class KGE_API Geometry : public RefObject
+{
+public:
+    struct Figure
+    {
+        Vector<Point> points;
+        bool          closed;
+    };
+
+    Geometry();
+
+    const Vector<Figure>& GetFigures() const;
+
+    void AddFigure(Figure&& figure);
+
+    /// \~chinese
+    /// @brief ϲһͼεͼ
+    void Append(const Geometry& other, const Matrix3x2* transform);
+
+    /// \~chinese
+    /// @brief ͼεв
+    /// @details ͼΰպͼδһ£ͬһ
+    /// @param a ͼA
+    /// @param b ͼB
+    /// @param mode ϲʽ
+    /// @param transform ӦõͼBϵĶά任
+    static RefPtr<Geometry> Combine(const Geometry& a, const Geometry& b, CombineMode mode,
+                                    const Matrix3x2* transform);
+
+    Rect GetBounds(const Matrix3x2* transform) const;
+
+    float ComputeLength() const;
+
+    float ComputeArea() const;
+
+    bool ComputePointAtLength(float length, Point& point, Vec2& tangent) const;
+
+    /// \~chinese
+    /// @brief ʹ÷㻷ƹжϵǷͼ
+    bool FillContainsPoint(const Point& point, const Matrix3x2* transform) const;
+
+    /// \~chinese
+    /// @brief 
+    void Fill(PathBuffer& output, const Matrix3x2& transform) const;
+
+    /// \~chinese
+    /// @brief ߶
+    void Stroke(PathBuffer& output, float width, const StrokeStyle* style, const Matrix3x2& transform) const;
+
+    static RefPtr<Geometry> CreateLine(const Point& begin, const Point& end);
+
+    static RefPtr<Geometry> CreateRect(const Rect& rect);
+
+    static RefPtr<Geometry> CreateRoundedRect(const Rect& rect, const Vec2& radius);
+
+    static RefPtr<Geometry> CreateEllipse(const Point& center, const Vec2& radius);
+
+private:
+    Vector<Figure> figures_;
+};
+
+/// \~chinese
+/// @brief ͼ
+class KGE_API GeometrySink : public RefObject
+{
+public:
+    GeometrySink(RefPtr<Geometry> geometry);
+
+    void BeginFigure(const Point& begin_pos);
+
+    void EndFigure(bool closed);
+
+    void AddLine(const Point& point);
+
+    void AddLines(const Point* points, size_t count);
+
+    void AddBezier(const Point& point1, const Point& point2, const Point& point3);
+
+    void AddArc(const Point& point, const Size& radius, float rotation, bool clockwise, bool is_small);
+
+    void Close();
+
+private:
+    bool             opened_;
+    Geometry::Figure current_;
+    RefPtr<Geometry> geometry_;
+};
+
+inline const Vector<Geometry::Figure>& Geometry::GetFigures() const
+{
+    return figures_;
+}
+
+}  // namespace software
+}  // namespace graphics
+}  // namespace kiwano
@@ -0,0 +1,434 @@
+// Copyright (c) 2016-2019 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <algorithm>
+#include <cstring>
+#include <kiwano/render/Software/Inflate.h>
+
+namespace kiwano
+{
+namespace graphics
+{
+namespace software
+{
+
+namespace
+{
+
+// Codes up to this length are decoded with a single table lookup
+const int fast_bits = 9;
+
+const uint16_t length_base[29]  = { 3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+                                   31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+const uint8_t  length_extra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+const uint16_t dist_base[30]    = { 1,   2,   3,   4,   5,   7,    9,    13,   17,   25,   33,   49,   65,    97,    129,
+                                 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+const uint8_t  dist_extra[30]   = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+struct Huffman
+{
+    uint16_t fast[1 << fast_bits];  // symbol << 4 | code length, 0 for longer codes
+    uint16_t count[16];             // number of codes of each length
+    uint16_t symbol[288];           // symbols ordered by code
+};
+
+// Reads bits starting from the least significant bit of each byte. Reading past the end yields zeros, which is
+// detected afterwards with Overrun()
+class BitReader
+{
+public:
+    BitReader(const uint8_t* data, size_t size)
+        : data_(data)
+        , size_(size)
+        , pos_(0)
+        , buffer_(0)
+        , count_(0)
+    {
+    }
+
+    inline void Fill(int bits)
+    {
+        while (count_ < bits)
+        {
+            const uint64_t byte = (pos_ < size_) ? data_[pos_] : 0;
+            ++pos_;
+            buffer_ |= byte << count_;
+            count_ += 8;
+        }
+    }
+
+    inline uint32_t Peek(int bits) const
+    {
+        return uint32_t(buffer_ & ((uint64_t(1) << bits) - 1));
+    }
+
+    inline void Drop(int bits)
+    {
+        buffer_ >>= bits;
+        count_ -= bits;
+    }
+
+    inline uint32_t Bits(int bits)
+    {
+        Fill(bits);
+        const uint32_t value = Peek(bits);
+        Drop(bits);
+        return value;
+    }
+
+    inline void AlignToByte()
+    {
+        Drop(count_ % 8);
+    }
+
+    inline size_t GetBytePosition() const
+    {
+        return pos_ - size_t(count_ / 8);
+    }
+
+    inline void SetBytePosition(size_t pos)
+    {
+        pos_    = pos;
+        buffer_ = 0;
+        count_  = 0;
+    }
+
+    inline bool Overrun() const
+    {
+        return pos_ * 8 - size_t(count_) > size_ * 8;
+    }
+
+private:
+    const uint8_t* data_;
+    size_t         size_;
+    size_t         pos_;
+    uint64_t       buffer_;
+    int            count_;
+};
+
+inline uint32_t ReverseBits(uint32_t code, int length)
+{
+    uint32_t result = 0;
+    for (int i = 0; i < length; ++i, code >>= 1)
+        result = (result << 1) | (code & 1);
+    return result;
+}
+
+bool BuildHuffman(Huffman& huffman, const uint8_t* lengths, int n)
+{
+    std::memset(huffman.fast, 0, sizeof(huffman.fast));
+    std::memset(huffman.count, 0, sizeof(huffman.count));
+    for (int i = 0; i < n; ++i)
+        ++huffman.count[lengths[i]];
+    huffman.count[0] = 0;
+
+    // Over-subscribed code lengths can not be decoded, incomplete ones are allowed
+    int left = 1;
+    for (int len = 1; len < 16; ++len)
+    {
+        left <<= 1;
+        left -= huffman.count[len];
+        if (left < 0)
+            return false;
+    }
+
+    uint16_t offsets[16] = {};
+    uint32_t next_code[16] = {};
+    for (int len = 1; len < 15; ++len)
+    {
+        offsets[len + 1]   = offsets[len] + huffman.count[len];
+        next_code[len + 1] = (next_code[len] + huffman.count[len]) << 1;
+    }
+
+    for (int i = 0; i < n; ++i)
+    {
+        const int len = lengths[i];
+        if (len == 0)
+            continue;
+
+        huffman.symbol[offsets[len]++] = uint16_t(i);
+
+        const uint32_t code = next_code[len]++;
+        if (len <= fast_bits)
+        {
+            const uint16_t entry = uint16_t((i << 4) | len);
+            for (uint32_t r = ReverseBits(code, len); r < (1u << fast_bits); r += (1u << len))
+                huffman.fast[r] = entry;
+        }
+    }
+    return true;
+}
+
+int DecodeSymbol(BitReader& reader, const Huffman& huffman)
+{
+    reader.Fill(16);
+
+    const uint16_t entry = huffman.fast[reader.Peek(fast_bits)];
+    if (entry)
+    {
+        reader.Drop(entry & 15);
+        return entry >> 4;
+    }
+
+    // Canonical decoding, one bit at a time
+    int code  = 0;
+    int first = 0;
+    int index = 0;
+    for (int len = 1; len < 16; ++len)
+    {
+        code |= int(reader.Bits(1));
+
+        const int count = huffman.count[len];
+        if (code - count < first)
+            return huffman.symbol[index + (code - first)];
+
+        index += count;
+        first += count;
+        first <<= 1;
+        code <<= 1;
+    }
+    return -1;
+}
+
+bool InflateCodes(BitReader& reader, Vector<uint8_t>& output, size_t base, const Huffman& lengths,
+                  const Huffman& distances)
+{
+    while (true)
+    {
+        const int symbol = DecodeSymbol(reader, lengths);
+        if (symbol < 0 || reader.Overrun())
+            return false;
+
+        if (symbol < 256)
+        {
+            output.push_back(uint8_t(symbol));
+            continue;
+        }
+
+        if (symbol == 256)
+            return true;
+
+        const int length_index = symbol - 257;
+        if (length_index >= 29)
+            return false;
+
+        const size_t length = length_base[length_index] + reader.Bits(length_extra[length_index]);
+
+        const int dist_index = DecodeSymbol(reader, distances);
+        if (dist_index < 0 || dist_index >= 30)
+            return false;
+
+        const size_t distance = dist_base[dist_index] + reader.Bits(dist_extra[dist_index]);
+        if (distance > output.size() - base)
+            return false;
+
+        // The source may overlap the bytes being written
+        const size_t from = output.size() - distance;
+        for (size_t i = 0; i < length; ++i)
+        {
+            const uint8_t byte = output[from + i];
+            output.push_back(byte);
+        }
+    }
+}
+
+bool InflateStored(BitReader& reader, const uint8_t* data, size_t size, Vector<uint8_t>& output)
+{
+    reader.AlignToByte();
+
+    const size_t pos = reader.GetBytePosition();
+    if (pos + 4 > size)
+        return false;
+
+    const uint32_t length = uint32_t(data[pos]) | (uint32_t(data[pos + 1]) << 8);
+    const uint32_t nlength = uint32_t(data[pos + 2]) | (uint32_t(data[pos + 3]) << 8);
+    if (length != (~nlength & 0xFFFF) || pos + 4 + length > size)
+        return false;
+
+    output.insert(output.end(), data + pos + 4, data + pos + 4 + length);
+    reader.SetBytePosition(pos + 4 + length);
+    return true;
+}
+
+bool InflateFixed(BitReader& reader, Vector<uint8_t>& output, size_t base)
+{
+    struct FixedTables
+    {
+        Huffman lengths;
+        Huffman distances;
+
+        FixedTables()
+        {
+            uint8_t code_lengths[288];
+            std::memset(code_lengths, 8, 144);
+            std::memset(code_lengths + 144, 9, 112);
+            std::memset(code_lengths + 256, 7, 24);
+            std::memset(code_lengths + 280, 8, 8);
+            BuildHuffman(lengths, code_lengths, 288);
+
+            std::memset(code_lengths, 5, 30);
+            BuildHuffman(distances, code_lengths, 30);
+        }
+    };
+
+    // Images may be decoded on several threads, the tables are built once under the static initialization guard
+    static const FixedTables tables;
+    return InflateCodes(reader, output, base, tables.lengths, tables.distances);
+}
+
+bool InflateDynamic(BitReader& reader, Vector<uint8_t>& output, size_t base)
+{
+    static const uint8_t order[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+    const int nlen  = int(reader.Bits(5)) + 257;
+    const int ndist = int(reader.Bits(5)) + 1;
+    const int ncode = int(reader.Bits(4)) + 4;
+    if (nlen > 286 || ndist > 30)
+        return false;
+
+    uint8_t code_lengths[286 + 30] = {};
+    for (int i = 0; i < ncode; ++i)
+        code_lengths[order[i]] = uint8_t(reader.Bits(3));
+
+    Huffman code_huffman;
+    if (!BuildHuffman(code_huffman, code_lengths, 19))
+        return false;
+
+    std::memset(code_lengths, 0, sizeof(code_lengths));
+    for (int i = 0; i < nlen + ndist;)
+    {
+        const int symbol = DecodeSymbol(reader, code_huffman);
+        if (symbol < 0 || reader.Overrun())
+            return false;
+
+        if (symbol < 16)
+        {
+            code_lengths[i++] = uint8_t(symbol);
+            continue;
+        }
+
+        uint8_t value  = 0;
+        int     repeat = 0;
+        if (symbol == 16)
+        {
+            if (i == 0)
+                return false;
+            value  = code_lengths[i - 1];
+            repeat = 3 + int(reader.Bits(2));
+        }
+        else if (symbol == 17)
+        {
+            repeat = 3 + int(reader.Bits(3));
+        }
+        else
+        {
+            repeat = 11 + int(reader.Bits(7));
+        }
+
+        if (i + repeat > nlen + ndist)
+            return false;
+        while (repeat--)
+            code_lengths[i++] = value;
+    }
+
+    // A block without the end-of-block code can never finish
+    if (code_lengths[256] == 0)
+        return false;
+
+    Huffman lengths;
+    Huffman distances;
+    if (!BuildHuffman(lengths, code_lengths, nlen) || !BuildHuffman(distances, code_lengths + nlen, ndist))
+        return false;
+    return InflateCodes(reader, output, base, lengths, distances);
+}
+
+uint32_t Adler32(const uint8_t* data, size_t size)
+{
+    uint32_t a = 1;
+    uint32_t b = 0;
+    while (size > 0)
+    {
+        // 5552 bytes is the largest run that can not overflow before the modulo
+        const size_t run = std::min(size, size_t(5552));
+        for (size_t i = 0; i < run; ++i)
+        {
+            a += data[i];
+            b += a;
+        }
+        a %= 65521;
+        b %= 65521;
+        data += run;
+        size -= run;
+    }
+    return (b << 16) | a;
+}
+
+}  // namespace
+
+bool Inflate(const uint8_t* data, size_t size, Vector<uint8_t>& output)
+{
+    // zlib header: deflate method, no preset dictionary
+    if (!data || size < 6 || (data[0] & 0x0F) != 8 || (data[1] & 0x20) != 0
+        || ((uint32_t(data[0]) << 8) | data[1]) % 31 != 0)
+        return false;
+
+    const size_t base = output.size();
+
+    BitReader reader(data + 2, size - 2);
+
+    bool final_block = false;
+    while (!final_block)
+    {
+        final_block = reader.Bits(1) != 0;
+
+        bool result = false;
+        switch (reader.Bits(2))
+        {
+        case 0:
+            result = InflateStored(reader, data + 2, size - 2, output);
+            break;
+        case 1:
+            result = InflateFixed(reader, output, base);
+            break;
+        case 2:
+            result = InflateDynamic(reader, output, base);
+            break;
+        default:
+            break;
+        }
+
+        if (!result || reader.Overrun())
+            return false;
+    }
+
+    reader.AlignToByte();
+
+    const size_t pos = 2 + reader.GetBytePosition();
+    if (pos + 4 > size)
+        return false;
+
+    const uint32_t checksum = (uint32_t(data[pos]) << 24) | (uint32_t(data[pos + 1]) << 16)
+                              | (uint32_t(data[pos + 2]) << 8) | uint32_t(data[pos + 3]);
+    return checksum == Adler32(output.data() + base, output.size() - base);
+}
+
+}  // namespace software
+}  // namespace graphics
+}  // namespace kiwano
@@ -0,0 +1,233 @@
+// Copyright (c) 2016-2019 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <cmath>
+#include <kiwano/render/Software/Paint.h>
+
+namespace kiwano
+{
+namespace graphics
+{
+namespace software
+{
+
+namespace
+{
+
+const int gradient_table_size = 256;
+
+inline Pixel LerpChannels(Pixel a, Pixel b, uint32_t weight)
+{
+    return ScalePixel(a, 255 - weight) + ScalePixel(b, weight);
+}
+
+}  // namespace
+
+Paint::Paint(const Color& color)
+    : type_(Brush::Type::SolidColor)
+    , color_(MakePixel(color))
+    , extend_mode_(GradientExtendMode::Clamp)
+    , interpolation_(InterpolationMode::Linear)
+{
+}
+
+Paint::Paint(const LinearGradientStyle& style)
+    : type_(Brush::Type::LinearGradient)
+    , color_(0)
+    , begin_(style.begin)
+    , axis_(style.end - style.begin)
+    , extend_mode_(style.extend_mode)
+    , interpolation_(InterpolationMode::Linear)
+{
+    BuildGradientTable(style.stops);
+}
+
+Paint::Paint(const RadialGradientStyle& style)
+    : type_(Brush::Type::RadialGradient)
+    , color_(0)
+    , begin_(style.center)
+    , radius_(style.radius)
+    , extend_mode_(style.extend_mode)
+    , interpolation_(InterpolationMode::Linear)
+{
+    if (radius_.x > 0.0f && radius_.y > 0.0f)
+    {
+        // The gradient origin in the unit circle of the ellipse, kept inside so that every ray leaves the circle once
+        focus_ = Vec2(style.offset.x / radius_.x, style.offset.y / radius_.y);
+
+        const float length = focus_.Length();
+        if (length > 0.999f)
+            focus_ = focus_ * (0.999f / length);
+    }
+    BuildGradientTable(style.stops);
+}
+
+Paint::Paint(RefPtr<Bitmap> bitmap, InterpolationMode mode)
+    : type_(Brush::Type::Texture)
+    , color_(0)
+    , extend_mode_(GradientExtendMode::Clamp)
+    , interpolation_(mode)
+    , bitmap_(bitmap)
+{
+}
+
+Pixel Paint::Sample(const Point& point) const
+{
+    switch (type_)
+    {
+    case Brush::Type::SolidColor:
+        return color_;
+    case Brush::Type::LinearGradient:
+    {
+        const float length = axis_.x * axis_.x + axis_.y * axis_.y;
+        if (length <= 0.0f)
+            return SampleGradient(0.0f);
+
+        const Vec2 offset = point - begin_;
+        return SampleGradient((offset.x * axis_.x + offset.y * axis_.y) / length);
+    }
+    case Brush::Type::RadialGradient:
+    {
+        if (radius_.x <= 0.0f || radius_.y <= 0.0f)
+            return SampleGradient(1.0f);
+
+        // Distance from the origin divided by the distance from the origin to the ellipse along the same ray
+        const Vec2  offset = point - begin_;
+        const Vec2  dir    = Vec2(offset.x / radius_.x, offset.y / radius_.y) - focus_;
+        const float a      = dir.x * dir.x + dir.y * dir.y;
+        if (a <= 0.0f)
+            return SampleGradient(0.0f);
+
+        const float b = focus_.x * dir.x + focus_.y * dir.y;
+        const float c = focus_.x * focus_.x + focus_.y * focus_.y - 1.0f;
+        const float s = (-b + std::sqrt(b * b - a * c)) / a;
+        return SampleGradient(1.0f / s);
+    }
+    case Brush::Type::Texture:
+        if (bitmap_)
+            return SampleBitmap(*bitmap_, point, interpolation_,
+                                PixelRect(0, 0, int(bitmap_->GetWidth()), int(bitmap_->GetHeight())));
+        return 0;
+    default:
+        return 0;
+    }
+}
+
+void Paint::BuildGradientTable(const Vector<GradientStop>& stops)
+{
+    gradient_table_.resize(gradient_table_size);
+    if (stops.empty())
+    {
+        std::fill(gradient_table_.begin(), gradient_table_.end(), 0);
+        return;
+    }
+
+    Vector<GradientStop> sorted = stops;
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [](const GradientStop& lhs, const GradientStop& rhs) { return lhs.offset < rhs.offset; });
+
+    size_t next = 0;
+    for (int i = 0; i < gradient_table_size; ++i)
+    {
+        const float t = float(i) / float(gradient_table_size - 1);
+        while (next < sorted.size() && sorted[next].offset < t)
+            ++next;
+
+        Color color;
+        if (next == 0)
+        {
+            color = sorted.front().color;
+        }
+        else if (next == sorted.size())
+        {
+            color = sorted.back().color;
+        }
+        else
+        {
+            const GradientStop& prev  = sorted[next - 1];
+            const GradientStop& stop  = sorted[next];
+            const float         range = stop.offset - prev.offset;
+            const float         w     = range > 0.0f ? (t - prev.offset) / range : 1.0f;
+
+            // Colors are interpolated before premultiplication, as Direct2D does
+            color = Color(prev.color.r + (stop.color.r - prev.color.r) * w,
+                          prev.color.g + (stop.color.g - prev.color.g) * w,
+                          prev.color.b + (stop.color.b - prev.color.b) * w,
+                          prev.color.a + (stop.color.a - prev.color.a) * w);
+        }
+        gradient_table_[i] = MakePixel(color);
+    }
+}
+
+Pixel Paint::SampleGradient(float t) const
+{
+    switch (extend_mode_)
+    {
+    case GradientExtendMode::Wrap:
+        t -= std::floor(t);
+        break;
+    case GradientExtendMode::Mirror:
+        t = std::fmod(std::abs(t), 2.0f);
+        if (t > 1.0f)
+            t = 2.0f - t;
+        break;
+    default:
+        t = Saturate(t);
+        break;
+    }
+    return gradient_table_[int(Saturate(t) * float(gradient_table_size - 1) + 0.5f)];
+}
+
+Pixel SampleBitmap(const Bitmap& bitmap, const Point& point, InterpolationMode mode, const PixelRect& bounds)
+{
+    const PixelRect area = bounds.Intersect(PixelRect(0, 0, int(bitmap.GetWidth()), int(bitmap.GetHeight())));
+    if (area.IsEmpty())
+        return 0;
+
+    auto clamp_x = [&](int x) { return std::min(std::max(x, area.left), area.right - 1); };
+    auto clamp_y = [&](int y) { return std::min(std::max(y, area.top), area.bottom - 1); };
+
+    if (mode == InterpolationMode::Nearest)
+    {
+        return bitmap.GetPixel(clamp_x(int(std::floor(point.x))), clamp_y(int(std::floor(point.y))));
+    }
+
+    // Bilinear filtering between the four nearest pixel centers
+    const float fx = point.x - 0.5f;
+    const float fy = point.y - 0.5f;
+    const float x0 = std::floor(fx);
+    const float y0 = std::floor(fy);
+
+    const uint32_t wx = uint32_t((fx - x0) * 255.0f + 0.5f);
+    const uint32_t wy = uint32_t((fy - y0) * 255.0f + 0.5f);
+
+    const int left   = clamp_x(int(x0));
+    const int top    = clamp_y(int(y0));
+    const int right  = clamp_x(int(x0) + 1);
+    const int bottom = clamp_y(int(y0) + 1);
+
+    const Pixel upper = LerpChannels(bitmap.GetPixel(left, top), bitmap.GetPixel(right, top), wx);
+    const Pixel lower = LerpChannels(bitmap.GetPixel(left, bottom), bitmap.GetPixel(right, bottom), wx);
+    return LerpChannels(upper, lower, wy);
+}
+
+}  // namespace software
+}  // namespace graphics
+}  // namespace kiwano
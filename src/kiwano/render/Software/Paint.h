@@ -0,0 +1,102 @@
+// Copyright (c) 2016-2019 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <kiwano/render/Brush.h>
+#include <kiwano/render/Software/Bitmap.h>
+
+namespace kiwano
+{
+namespace graphics
+{
+namespace software
+{
+
+/// \~chinese
+/// @brief ˢɫ
+class KGE_API Paint : public RefObject
+{
+public:
+    Paint(const Color& color);
+
+    Paint(const LinearGradientStyle& style);
+
+    Paint(const RadialGradientStyle& style);
+
+    Paint(RefPtr<Bitmap> bitmap, InterpolationMode mode);
+
+    bool IsSolid() const;
+
+    Pixel GetSolidPixel() const;
+
+    const Matrix3x2& GetTransform() const;
+
+    void SetTransform(const Matrix3x2& transform);
+
+    /// \~chinese
+    /// @brief ȡˢϵĳһɫ
+    Pixel Sample(const Point& point) const;
+
+private:
+    void BuildGradientTable(const Vector<GradientStop>& stops);
+
+    Pixel SampleGradient(float t) const;
+
+private:
+    Brush::Type        type_;
+    Pixel              color_;
+    Point              begin_;
+    Vec2               axis_;
+    Vec2               radius_;
+    Vec2               focus_;
+    GradientExtendMode extend_mode_;
+    InterpolationMode  interpolation_;
+    RefPtr<Bitmap>     bitmap_;
+    Matrix3x2          transform_;
+    Vector<Pixel>      gradient_table_;
+};
+
+/// \~chinese
+/// @brief λͼָвĲʹñ߽
+Pixel SampleBitmap(const Bitmap& bitmap, const Point& point, InterpolationMode mode, const PixelRect& bounds);
+
+inline bool Paint::IsSolid() const
+{
+    return type_ == Brush::Type::SolidColor;
+}
+
+inline Pixel Paint::GetSolidPixel() const
+{
+    return color_;
+}
+
+inline const Matrix3x2& Paint::GetTransform() const
+{
+    return transform_;
+}
+
+inline void Paint::SetTransform(const Matrix3x2& transform)
+{
+    transform_ = transform;
+}
+
+}  // namespace software
+}  // namespace graphics
+}  // namespace kiwano
@@ -0,0 +1,607 @@
+// Copyright (c) 2016-2019 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <cmath>
+#include <kiwano/render/Software/Rasterizer.h>
+
+namespace kiwano
+{
+namespace graphics
+{
+namespace software
+{
+
+namespace
+{
+
+inline Pixel LerpPixel(Pixel dest, Pixel src, uint32_t coverage)
+{
+    if (coverage >= 255)
+        return src;
+    return ScalePixel(src, coverage) + ScalePixel(dest, 255 - coverage);
+}
+
+inline Pixel PerChannel(Pixel a, Pixel b, const uint8_t& (*op)(const uint8_t&, const uint8_t&))
+{
+    Pixel result = 0;
+    for (uint32_t shift = 0; shift < 32; shift += 8)
+    {
+        const uint8_t ca = uint8_t(a >> shift);
+        const uint8_t cb = uint8_t(b >> shift);
+        result |= Pixel(op(ca, cb)) << shift;
+    }
+    return result;
+}
+
+inline Pixel AddSaturate(Pixel a, Pixel b)
+{
+    Pixel result = 0;
+    for (uint32_t shift = 0; shift < 32; shift += 8)
+    {
+        const uint32_t sum = ((a >> shift) & 0xFF) + ((b >> shift) & 0xFF);
+        result |= std::min(sum, 255U) << shift;
+    }
+    return result;
+}
+
+// Signed area of a polygon, negative for the winding produced by StrokePolyline
+float SignedArea(const Point* vertices, size_t count)
+{
+    float area = 0.0f;
+    for (size_t i = 0; i < count; ++i)
+    {
+        const Point& a = vertices[i];
+        const Point& b = vertices[(i + 1) % count];
+        area += a.x * b.y - b.x * a.y;
+    }
+    return area;
+}
+
+// All the polygons of a stroke must share one winding, otherwise overlapping parts cancel each other out
+void AddOrientedContour(PathBuffer& output, Point* vertices, size_t count, const Matrix3x2& transform)
+{
+    if (SignedArea(vertices, count) > 0.0f)
+    {
+        std::reverse(vertices, vertices + count);
+    }
+    output.AddContour(vertices, count, transform);
+}
+
+void AddDisc(PathBuffer& output, const Point& center, float radius, const Matrix3x2& transform)
+{
+    const int segments = 16;
+
+    Point vertices[segments];
+    for (int i = 0; i < segments; ++i)
+    {
+        const float angle = math::PI_F_X_2 * float(i) / float(segments);
+        vertices[i]       = Point(center.x + radius * std::cos(angle), center.y + radius * std::sin(angle));
+    }
+    AddOrientedContour(output, vertices, segments, transform);
+}
+
+inline Vec2 Normalize(const Vec2& v)
+{
+    const float length = v.Length();
+    if (length > 0.0f)
+        return v / length;
+    return Vec2();
+}
+
+inline Vec2 LeftNormal(const Vec2& dir)
+{
+    return Vec2(-dir.y, dir.x);
+}
+
+void AddCap(PathBuffer& output, const Point& point, const Vec2& dir, float half_width, CapStyle cap,
+            const Matrix3x2& transform)
+{
+    const Vec2 normal = LeftNormal(dir) * half_width;
+    switch (cap)
+    {
+    case CapStyle::Square:
+    {
+        const Point back     = point - dir * half_width;
+        Point       quad[4] = { back + normal, point + normal, point - normal, back - normal };
+        AddOrientedContour(output, quad, 4, transform);
+        break;
+    }
+    case CapStyle::Round:
+    {
+        AddDisc(output, point, half_width, transform);
+        break;
+    }
+    case CapStyle::Triangle:
+    {
+        Point triangle[3] = { point + normal, point - dir * half_width, point - normal };
+        AddOrientedContour(output, triangle, 3, transform);
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+void AddJoin(PathBuffer& output, const Point& point, const Vec2& dir_in, const Vec2& dir_out, float half_width,
+             LineJoinStyle join, const Matrix3x2& transform)
+{
+    const float cross = dir_in.x * dir_out.y - dir_in.y * dir_out.x;
+    if (std::abs(cross) < 1e-6f)
+        return;
+
+    if (join == LineJoinStyle::Round)
+    {
+        AddDisc(output, point, half_width, transform);
+        return;
+    }
+
+    // The outer side of the turn is opposite to the turning direction
+    const float side       = cross > 0.0f ? -1.0f : 1.0f;
+    const Vec2  normal_in  = LeftNormal(dir_in) * side;
+    const Vec2  normal_out = LeftNormal(dir_out) * side;
+
+    if (join == LineJoinStyle::Miter)
+    {
+        const Vec2  miter_dir = Normalize(normal_in + normal_out);
+        const float cos_half  = miter_dir.x * normal_in.x + miter_dir.y * normal_in.y;
+
+        // Same miter limit as Direct2D's default stroke properties
+        const float miter_limit = 10.0f;
+        if (cos_half > 1.0f / miter_limit)
+        {
+            Point quad[4] = { point, point + normal_in * half_width, point + miter_dir * (half_width / cos_half),
+                              point + normal_out * half_width };
+            AddOrientedContour(output, quad, 4, transform);
+            return;
+        }
+    }
+
+    Point triangle[3] = { point, point + normal_in * half_width, point + normal_out * half_width };
+    AddOrientedContour(output, triangle, 3, transform);
+}
+
+void StrokeSolidPolyline(PathBuffer& output, const Point* vertices, size_t count, bool closed, float half_width,
+                         CapStyle cap, LineJoinStyle join, const Matrix3x2& transform)
+{
+    if (count == 0)
+        return;
+
+    const size_t segments = closed ? count : count - 1;
+
+    Vec2 first_dir, last_dir;
+    bool has_dir = false;
+    for (size_t i = 0; i < segments; ++i)
+    {
+        const Point& p   = vertices[i];
+        const Point& q   = vertices[(i + 1) % count];
+        const Vec2   dir = Normalize(q - p);
+        if (dir.x == 0.0f && dir.y == 0.0f)
+            continue;
+
+        if (has_dir)
+        {
+            AddJoin(output, p, last_dir, dir, half_width, join, transform);
+        }
+        else
+        {
+            first_dir = dir;
+            has_dir   = true;
+        }
+
+        const Vec2 normal  = LeftNormal(dir) * half_width;
+        Point      quad[4] = { p + normal, q + normal, q - normal, p - normal };
+        AddOrientedContour(output, quad, 4, transform);
+
+        last_dir = dir;
+    }
+
+    if (!has_dir)
+        return;
+
+    if (closed)
+    {
+        AddJoin(output, vertices[0], last_dir, first_dir, half_width, join, transform);
+    }
+    else
+    {
+        AddCap(output, vertices[0], first_dir, half_width, cap, transform);
+        AddCap(output, vertices[count - 1], -last_dir, half_width, cap, transform);
+    }
+}
+
+}  // namespace
+
+Pixel BlendPixel(Pixel src, Pixel dest, uint32_t coverage, BlendMode mode)
+{
+    if (coverage == 0)
+        return dest;
+
+    switch (mode)
+    {
+    case BlendMode::SourceOver:
+    {
+        const Pixel    scaled = ScalePixel(src, coverage);
+        const uint32_t alpha  = PixelAlpha(scaled);
+        if (alpha == 255)
+            return scaled;
+        if (alpha == 0)
+            return dest;
+        return scaled + ScalePixel(dest, 255 - alpha);
+    }
+    case BlendMode::Copy:
+        return LerpPixel(dest, src, coverage);
+    case BlendMode::Min:
+        return LerpPixel(dest, PerChannel(src, dest, &std::min<uint8_t>), coverage);
+    case BlendMode::Add:
+        return AddSaturate(ScalePixel(src, coverage), dest);
+    case BlendMode::Max:
+        return LerpPixel(dest, PerChannel(src, dest, &std::max<uint8_t>), coverage);
+    default:
+        return dest;
+    }
+}
+
+PixelRect PixelRect::Enclose(const Rect& rect)
+{
+    // Keep the rectangle inside the range of int
+    const float limit = 1 << 24;
+
+    const float left   = std::max(std::floor(rect.GetLeft()), -limit);
+    const float top    = std::max(std::floor(rect.GetTop()), -limit);
+    const float right  = std::min(std::ceil(rect.GetRight()), limit);
+    const float bottom = std::min(std::ceil(rect.GetBottom()), limit);
+    return PixelRect(int(left), int(top), int(right), int(bottom));
+}
+
+PixelRect PixelRect::Snap(const Rect& rect)
+{
+    const float limit = 1 << 24;
+
+    const float left   = std::max(std::floor(rect.GetLeft() + 0.5f), -limit);
+    const float top    = std::max(std::floor(rect.GetTop() + 0.5f), -limit);
+    const float right  = std::min(std::floor(rect.GetRight() + 0.5f), limit);
+    const float bottom = std::min(std::floor(rect.GetBottom() + 0.5f), limit);
+    return PixelRect(int(left), int(top), int(right), int(bottom));
+}
+
+void PathBuffer::Clear()
+{
+    points.clear();
+    contour_ends.clear();
+}
+
+bool PathBuffer::IsEmpty() const
+{
+    return contour_ends.empty();
+}
+
+void PathBuffer::AddContour(const Point* vertices, size_t count, const Matrix3x2& transform)
+{
+    if (count < 2)
+        return;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        points.push_back(transform.Transform(vertices[i]));
+    }
+    contour_ends.push_back(uint32_t(points.size()));
+}
+
+void PathBuffer::AddRect(const Rect& rect, const Matrix3x2& transform)
+{
+    const Point vertices[4] = { rect.GetLeftTop(), rect.GetRightTop(), rect.GetRightBottom(), rect.GetLeftBottom() };
+    AddContour(vertices, 4, transform);
+}
+
+Rect PathBuffer::GetBounds() const
+{
+    if (points.empty())
+        return Rect();
+
+    Rect bounds(points[0], points[0]);
+    for (const auto& point : points)
+    {
+        bounds.left_top.x     = std::min(bounds.left_top.x, point.x);
+        bounds.left_top.y     = std::min(bounds.left_top.y, point.y);
+        bounds.right_bottom.x = std::max(bounds.right_bottom.x, point.x);
+        bounds.right_bottom.y = std::max(bounds.right_bottom.y, point.y);
+    }
+    return bounds;
+}
+
+Rasterizer::Rasterizer() {}
+
+bool Rasterizer::Rasterize(const PathBuffer& path, const PixelRect& clip, bool antialias)
+{
+    bounds_ = PixelRect();
+    if (path.IsEmpty())
+        return false;
+
+    bounds_ = PixelRect::Enclose(path.GetBounds()).Intersect(clip);
+    if (bounds_.IsEmpty())
+    {
+        bounds_ = PixelRect();
+        return false;
+    }
+
+    const int    width  = bounds_.GetWidth();
+    const int    height = bounds_.GetHeight();
+    const size_t stride = size_t(width) + 2;
+
+    accumulation_.assign(stride * size_t(height), 0.0f);
+
+    uint32_t begin = 0;
+    for (auto end : path.contour_ends)
+    {
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            const uint32_t next = (i + 1 < end) ? i + 1 : begin;
+            AccumulateLine(path.points[i], path.points[next]);
+        }
+        begin = end;
+    }
+
+    coverage_.resize(size_t(width) * size_t(height));
+
+    bool covered = false;
+    for (int y = 0; y < height; ++y)
+    {
+        const float* row    = &accumulation_[size_t(y) * stride];
+        uint8_t*     output = &coverage_[size_t(y) * size_t(width)];
+
+        float sum = 0.0f;
+        for (int x = 0; x < width; ++x)
+        {
+            sum += row[x];
+
+            const float area = std::min(std::abs(sum), 1.0f);
+            if (antialias)
+            {
+                output[x] = uint8_t(area * 255.0f + 0.5f);
+            }
+            else
+            {
+                output[x] = area >= 0.5f ? 255 : 0;
+            }
+            covered |= (output[x] != 0);
+        }
+    }
+    return covered;
+}
+
+void Rasterizer::Intersect(const Rasterizer& other)
+{
+    for (int y = bounds_.top; y < bounds_.bottom; ++y)
+    {
+        uint8_t* row = &coverage_[size_t(y - bounds_.top) * size_t(bounds_.GetWidth())];
+        for (int x = bounds_.left; x < bounds_.right; ++x)
+        {
+            uint8_t& coverage = row[x - bounds_.left];
+            coverage          = uint8_t(Div255(uint32_t(coverage) * other.GetCoverage(x, y)));
+        }
+    }
+}
+
+void Rasterizer::AccumulateLine(const Point& p0, const Point& p1)
+{
+    // Signed area accumulation, see https://github.com/raphlinus/font-rs
+    const int    width  = bounds_.GetWidth();
+    const int    height = bounds_.GetHeight();
+    const size_t stride = size_t(width) + 2;
+
+    float x0 = p0.x - float(bounds_.left);
+    float y0 = p0.y - float(bounds_.top);
+    float x1 = p1.x - float(bounds_.left);
+    float y1 = p1.y - float(bounds_.top);
+
+    if (y0 == y1)
+        return;
+
+    float dir = 1.0f;
+    if (y0 > y1)
+    {
+        std::swap(x0, x1);
+        std::swap(y0, y1);
+        dir = -1.0f;
+    }
+
+    if (y1 <= 0.0f || y0 >= float(height))
+        return;
+
+    const float dxdy = (x1 - x0) / (y1 - y0);
+
+    float x = x0;
+    if (y0 < 0.0f)
+    {
+        x -= y0 * dxdy;
+    }
+
+    const int y_begin = std::max(0, int(std::floor(y0)));
+    const int y_end   = std::min(height, int(std::ceil(y1)));
+    const float x_max = float(width);
+
+    for (int y = y_begin; y < y_end; ++y)
+    {
+        float* row = &accumulation_[size_t(y) * stride];
+
+        const float dy    = std::min(float(y + 1), y1) - std::max(float(y), y0);
+        const float xnext = x + dxdy * dy;
+        const float d     = dy * dir;
+
+        // Parts of the edge outside the horizontal bounds behave like a vertical edge on the border
+        const float xa = std::min(std::max(std::min(x, xnext), 0.0f), x_max);
+        const float xb = std::min(std::max(std::max(x, xnext), 0.0f), x_max);
+
+        const float x0floor = std::floor(xa);
+        const int   x0i     = int(x0floor);
+        const float x1ceil  = std::ceil(xb);
+        const int   x1i     = int(x1ceil);
+
+        if (x1i <= x0i + 1)
+        {
+            const float xmf = 0.5f * (xa + xb) - x0floor;
+            row[x0i] += d - d * xmf;
+            row[x0i + 1] += d * xmf;
+        }
+        else
+        {
+            const float s   = 1.0f / (xb - xa);
+            const float x0f = xa - x0floor;
+            const float a0  = 0.5f * s * (1.0f - x0f) * (1.0f - x0f);
+            const float x1f = xb - x1ceil + 1.0f;
+            const float am  = 0.5f * s * x1f * x1f;
+
+            row[x0i] += d * a0;
+            if (x1i == x0i + 2)
+            {
+                row[x0i + 1] += d * (1.0f - a0 - am);
+            }
+            else
+            {
+                const float a1 = s * (1.5f - x0f);
+                row[x0i + 1] += d * (a1 - a0);
+                for (int xi = x0i + 2; xi < x1i - 1; ++xi)
+                {
+                    row[xi] += d * s;
+                }
+                const float a2 = a1 + float(x1i - x0i - 3) * s;
+                row[x1i - 1] += d * (1.0f - a2 - am);
+            }
+            row[x1i] += d * am;
+        }
+        x = xnext;
+    }
+}
+
+void StrokePolyline(PathBuffer& output, const Point* vertices, size_t count, bool closed, float width,
+                    const StrokeStyle* style, const Matrix3x2& transform)
+{
+    if (count == 0 || width <= 0.0f)
+        return;
+
+    const float         half_width = width * 0.5f;
+    const CapStyle      cap        = style ? style->GetCapStyle() : CapStyle::Flat;
+    const LineJoinStyle join       = style ? style->GetLineJoinStyle() : LineJoinStyle::Miter;
+
+    if (!style || style->GetDashArray().empty())
+    {
+        StrokeSolidPolyline(output, vertices, count, closed, half_width, cap, join, transform);
+        return;
+    }
+
+    // Dash lengths are in units of the stroke width
+    const auto& dashes       = style->GetDashArray();
+    float       pattern_size = 0.0f;
+    for (auto dash : dashes)
+    {
+        pattern_size += dash * width;
+    }
+    if (pattern_size <= 0.0f)
+        return;
+
+    size_t dash_index = 0;
+    float  dash_left  = dashes[0] * width;
+
+    // Apply the dash offset
+    float offset = std::fmod(style->GetDashOffset() * width, pattern_size);
+    if (offset < 0.0f)
+        offset += pattern_size;
+    while (offset > 0.0f)
+    {
+        if (offset < dash_left)
+        {
+            dash_left -= offset;
+            break;
+        }
+        offset -= dash_left;
+        dash_index = (dash_index + 1) % dashes.size();
+        dash_left  = dashes[dash_index] * width;
+    }
+
+    // Zero-length dashes still need a direction for their caps
+    const float min_dash = 1e-3f;
+
+    Vector<Point> dash;
+    auto          flush_dash = [&]()
+    {
+        if (dash.size() == 1)
+        {
+            dash.push_back(dash[0]);
+        }
+        if (dash.size() > 1)
+        {
+            if (dash.front() == dash.back() && dash.size() == 2)
+                dash.back() = dash.front() + Vec2(min_dash, 0.0f);
+            StrokeSolidPolyline(output, dash.data(), dash.size(), false, half_width, cap, join, transform);
+        }
+        dash.clear();
+    };
+
+    const size_t segments = closed ? count : count - 1;
+    for (size_t i = 0; i < segments; ++i)
+    {
+        const Point& p      = vertices[i];
+        const Point& q      = vertices[(i + 1) % count];
+        const float  length = (q - p).Length();
+        if (length <= 0.0f)
+            continue;
+
+        const Vec2 dir = (q - p) / length;
+
+        float walked = 0.0f;
+        while (walked < length)
+        {
+            const bool  is_on = (dash_index % 2) == 0;
+            const float step  = std::min(dash_left, length - walked);
+
+            if (is_on)
+            {
+                if (dash.empty())
+                    dash.push_back(p + dir * walked);
+
+                if (dash_left == 0.0f)
+                {
+                    dash.push_back(p + dir * (walked + min_dash));
+                }
+                else
+                {
+                    dash.push_back(p + dir * (walked + step));
+                }
+            }
+
+            walked += step;
+            dash_left -= step;
+
+            if (dash_left <= 0.0f)
+            {
+                if (is_on)
+                    flush_dash();
+
+                dash_index = (dash_index + 1) % dashes.size();
+                dash_left  = dashes[dash_index] * width;
+            }
+        }
+    }
+    flush_dash();
+}
+
+}  // namespace software
+}  // namespace graphics
+}  // namespace kiwano
@@ -0,0 +1,245 @@
+// Copyright (c) 2016-2019 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <algorithm>
+#include <kiwano/core/Common.h>
+#include <kiwano/math/Math.h>
+#include <kiwano/render/Color.h>
+#include <kiwano/render/StrokeStyle.h>
+#include <kiwano/render/RenderContext.h>
+
+namespace kiwano
+{
+namespace graphics
+{
+namespace software
+{
+
+// Pixels are stored as premultiplied RGBA, 8 bits per channel, R in the lowest byte
+typedef uint32_t Pixel;
+
+inline float Saturate(float value)
+{
+    return std::min(std::max(value, 0.0f), 1.0f);
+}
+
+inline uint32_t Div255(uint32_t value)
+{
+    value += 128;
+    return (value + (value >> 8)) >> 8;
+}
+
+inline Pixel MakePixel(uint32_t r, uint32_t g, uint32_t b, uint32_t a)
+{
+    return r | (g << 8) | (b << 16) | (a << 24);
+}
+
+inline Pixel MakePixel(const Color& color, float opacity = 1.0f)
+{
+    const float alpha = Saturate(color.a * opacity);
+
+    const uint32_t a = uint32_t(alpha * 255.0f + 0.5f);
+    const uint32_t r = uint32_t(Saturate(color.r) * alpha * 255.0f + 0.5f);
+    const uint32_t g = uint32_t(Saturate(color.g) * alpha * 255.0f + 0.5f);
+    const uint32_t b = uint32_t(Saturate(color.b) * alpha * 255.0f + 0.5f);
+    return MakePixel(r, g, b, a);
+}
+
+inline uint32_t PixelAlpha(Pixel pixel)
+{
+    return pixel >> 24;
+}
+
+/// \~chinese
+/// @brief ɫ [0, 255] Χڵϵ
+inline Pixel ScalePixel(Pixel pixel, uint32_t scale)
+{
+    if (scale >= 255)
+        return pixel;
+
+    const uint32_t rb = (pixel & 0x00FF00FF) * scale + 0x00800080;
+    const uint32_t ga = ((pixel >> 8) & 0x00FF00FF) * scale + 0x00800080;
+    return (((rb + ((rb >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF)
+           | ((ga + ((ga >> 8) & 0x00FF00FF)) & 0xFF00FF00);
+}
+
+/// \~chinese
+/// @brief Դذָģʽ͸дĿ
+Pixel BlendPixel(Pixel src, Pixel dest, uint32_t coverage, BlendMode mode);
+
+/// \~chinese
+/// @brief ؾ±߽粻
+struct PixelRect
+{
+    int left;
+    int top;
+    int right;
+    int bottom;
+
+    PixelRect();
+
+    PixelRect(int left, int top, int right, int bottom);
+
+    bool IsEmpty() const;
+
+    int GetWidth() const;
+
+    int GetHeight() const;
+
+    PixelRect Intersect(const PixelRect& other) const;
+
+    /// \~chinese
+    /// @brief ȡǸεС
+    static PixelRect Enclose(const Rect& rect);
+
+    /// \~chinese
+    /// @brief ȡڸڵ
+    static PixelRect Snap(const Rect& rect);
+};
+
+/// \~chinese
+/// @brief λ壬洢
+struct PathBuffer
+{
+    Vector<Point>    points;
+    Vector<uint32_t> contour_ends;
+
+    void Clear();
+
+    bool IsEmpty() const;
+
+    void AddContour(const Point* vertices, size_t count, const Matrix3x2& transform);
+
+    void AddRect(const Rect& rect, const Matrix3x2& transform);
+
+    Rect GetBounds() const;
+};
+
+/// \~chinese
+/// @brief ɨ߹դתΪ 8 λɰ
+/// @details ʹôۼӵķʽ㾫ȷʣֻ룬ͬƽ̨һ
+class KGE_API Rasterizer
+{
+public:
+    Rasterizer();
+
+    /// \~chinese
+    /// @brief դ
+    /// @param path 豸ϵµĶ
+    /// @param clip ü
+    /// @param antialias Ƿ񿹾
+    /// @return Ϊʱ true
+    bool Rasterize(const PathBuffer& path, const PixelRect& clip, bool antialias);
+
+    /// \~chinese
+    /// @brief һɰˣĽ
+    void Intersect(const Rasterizer& other);
+
+    /// \~chinese
+    /// @brief ȡ
+    const PixelRect& GetBounds() const;
+
+    /// \~chinese
+    /// @brief ȡĳһеĸʣ±Ӹ߽翪ʼ
+    const uint8_t* GetCoverage(int y) const;
+
+    /// \~chinese
+    /// @brief ȡĳһĸ
+    uint8_t GetCoverage(int x, int y) const;
+
+private:
+    void AccumulateLine(const Point& p0, const Point& p1);
+
+private:
+    PixelRect       bounds_;
+    Vector<float>   accumulation_;
+    Vector<uint8_t> coverage_;
+};
+
+/// \~chinese
+/// @brief תΪ
+/// @param[out] output 
+/// @param[in] vertices ߶
+/// @param[in] count 
+/// @param[in] closed Ƿպ
+/// @param[in] width 
+/// @param[in] style ʽΪʱʹĬʽ
+/// @param[in] transform ά任
+void StrokePolyline(PathBuffer& output, const Point* vertices, size_t count, bool closed, float width,
+                    const StrokeStyle* style, const Matrix3x2& transform);
+
+inline const PixelRect& Rasterizer::GetBounds() const
+{
+    return bounds_;
+}
+
+inline const uint8_t* Rasterizer::GetCoverage(int y) const
+{
+    return &coverage_[size_t(y - bounds_.top) * size_t(bounds_.GetWidth())];
+}
+
+inline uint8_t Rasterizer::GetCoverage(int x, int y) const
+{
+    if (x < bounds_.left || x >= bounds_.right || y < bounds_.top || y >= bounds_.bottom)
+        return 0;
+    return GetCoverage(y)[x - bounds_.left];
+}
+
+inline PixelRect::PixelRect()
+    : left(0)
+    , top(0)
+    , right(0)
+    , bottom(0)
+{
+}
+
+inline PixelRect::PixelRect(int left, int top, int right, int bottom)
+    : left(left)
+    , top(top)
+    , right(right)
+    , bottom(bottom)
+{
+}
+
+inline bool PixelRect::IsEmpty() const
+{
+    return right <= left || bottom <= top;
+}
+
+inline int PixelRect::GetWidth() const
+{
+    return right - left;
+}
+
+inline int PixelRect::GetHeight() const
+{
+    return bottom - top;
+}
+
+inline PixelRect PixelRect::Intersect(const PixelRect& other) const
+{
+    return PixelRect(std::max(left, other.left), std::max(top, other.top), std::min(right, other.right),
+                     std::min(bottom, other.bottom));
+}
+
+}  // namespace software
+}  // namespace graphics
+}  // namespace kiwano
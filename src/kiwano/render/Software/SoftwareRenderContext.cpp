@@ -0,0 +1,609 @@
+// Copyright (c) 2016-2019 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <kiwano/render/Software/SoftwareRenderContext.h>
+#include <kiwano/render/Software/Geometry.h>
+#include <kiwano/render/Software/TextBlock.h>
+#include <kiwano/render/Software/helper.h>
+#include <kiwano/render/Renderer.h>
+#include <kiwano/utils/Logger.h>
+
+namespace kiwano
+{
+namespace graphics
+{
+namespace software
+{
+
+namespace
+{
+
+inline uint32_t ToAlpha(float opacity)
+{
+    return uint32_t(Saturate(opacity) * 255.0f + 0.5f);
+}
+
+template <typename _Shader>
+void Composite(Bitmap& dest, const Rasterizer& coverage, BlendMode mode, uint32_t opacity, _Shader&& shader)
+{
+    const PixelRect& bounds = coverage.GetBounds();
+    for (int y = bounds.top; y < bounds.bottom; ++y)
+    {
+        const uint8_t* cov = coverage.GetCoverage(y);
+        Pixel*         row = dest.GetRow(uint32_t(y));
+        for (int x = bounds.left; x < bounds.right; ++x)
+        {
+            const uint8_t c = cov[x - bounds.left];
+            if (c)
+            {
+                const Pixel src = ScalePixel(shader(Point(float(x) + 0.5f, float(y) + 0.5f)), opacity);
+                row[x]          = BlendPixel(src, row[x], c, mode);
+            }
+        }
+    }
+}
+
+}  // namespace
+
+SoftwareRenderContext::SoftwareRenderContext(RefPtr<Bitmap> target)
+    : blend_(BlendMode::SourceOver)
+    , target_(target)
+{
+    KGE_ASSERT(target_);
+
+    Resize(Size(float(target_->GetWidth()), float(target_->GetHeight())));
+}
+
+SoftwareRenderContext::~SoftwareRenderContext() {}
+
+void SoftwareRenderContext::BeginDraw()
+{
+    RenderContext::BeginDraw();
+
+    clip_stack_.clear();
+    layers_.clear();
+}
+
+void SoftwareRenderContext::EndDraw()
+{
+    KGE_ASSERT(clip_stack_.empty() && "PushClipRect and PopClipRect do not match");
+    KGE_ASSERT(layers_.empty() && "PushLayer and PopLayer do not match");
+
+    FlushSprites();
+
+    RenderContext::EndDraw();
+}
+
+void SoftwareRenderContext::CreateTexture(Texture& texture, const PixelSize& size)
+{
+    RefPtr<Bitmap> bitmap = MakePtr<Bitmap>(size.x, size.y);
+    SoftwarePolicy::Set(texture, bitmap);
+
+    texture.SetSize(Size(float(size.x), float(size.y)));
+    texture.SetSizeInPixels(size);
+}
+
+void SoftwareRenderContext::DrawTexture(const Texture& texture, const Rect* src_rect, const Rect* dest_rect)
+{
+    KGE_ASSERT(target_ && "Render target has not been initialized!");
+
+    FlushSprites();
+
+    auto bitmap = SoftwarePolicy::Get<Bitmap>(texture);
+    if (!bitmap)
+        return;
+
+    const Rect src  = src_rect ? *src_rect : Rect(Point(), texture.GetSize());
+    const Rect dest = dest_rect ? *dest_rect : Rect(Point(), src.GetSize());
+    if (DrawBitmap(*bitmap, texture.GetBitmapInterpolationMode(), src, dest, transform_, brush_opacity_,
+                   GetCurrentClip()))
+    {
+        IncreasePrimitivesCount();
+    }
+}
+
+void SoftwareRenderContext::DrawTextureBatch(const Texture& texture, const SpriteQuad* quads, size_t count)
+{
+    KGE_ASSERT(target_ && "Render target has not been initialized!");
+
+    auto bitmap = SoftwarePolicy::Get<Bitmap>(texture);
+    if (!bitmap || count == 0)
+        return;
+
+    // Texture lookup and clip are shared by the whole batch
+    const auto      mode = texture.GetBitmapInterpolationMode();
+    const PixelRect clip = GetCurrentClip();
+
+    uint32_t drawn = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        const SpriteQuad& quad = quads[i];
+
+        transform_ = fast_global_transform_ ? quad.transform : Matrix3x2(quad.transform * global_transform_);
+        if (DrawBitmap(*bitmap, mode, quad.src_rect, quad.dest_rect, transform_, quad.opacity, clip))
+        {
+            ++drawn;
+        }
+    }
+
+    brush_opacity_ = quads[count - 1].opacity;
+    IncreasePrimitivesCount(drawn);
+}
+
+void SoftwareRenderContext::DrawTextLayout(const TextLayout& layout, const Point& offset,
+                                           RefPtr<Brush> current_outline_brush)
+{
+    KGE_ASSERT(target_ && "Render target has not been initialized!");
+
+    FlushSprites();
+
+    auto block = SoftwarePolicy::Get<TextBlock>(layout);
+    if (!block)
+        return;
+
+    Vector<Rect> decorations;
+    path_.Clear();
+    block->BuildGeometry(path_, decorations, offset, transform_);
+    for (const auto& rect : decorations)
+    {
+        path_.AddRect(rect, transform_);
+    }
+
+    const bool antialias = text_antialias_ != TextAntialiasMode::None;
+
+    auto outline_paint = SoftwarePolicy::Get<Paint>(current_outline_brush);
+    if (outline_paint && current_stroke_)
+    {
+        PathBuffer outline;
+        for (size_t begin = 0, i = 0; i < path_.contour_ends.size(); ++i)
+        {
+            const uint32_t end = path_.contour_ends[i];
+            StrokePolyline(outline, &path_.points[begin], end - begin, true, GetStrokeWidth(), current_stroke_.Get(),
+                           Matrix3x2());
+            begin = end;
+        }
+
+        if (rasterizer_.Rasterize(outline, GetCurrentClip(), antialias))
+        {
+            FillCoverage(rasterizer_, *outline_paint, brush_opacity_);
+        }
+    }
+
+    FillPath(path_, antialias);
+
+    IncreasePrimitivesCount(1 + uint32_t(decorations.size()));
+}
+
+void SoftwareRenderContext::DrawShape(const Shape& shape)
+{
+    KGE_ASSERT(target_ && "Render target has not been initialized!");
+    KGE_ASSERT(current_brush_ && "The brush used for rendering has not been set!");
+
+    FlushSprites();
+
+    auto geometry = SoftwarePolicy::Get<Geometry>(shape);
+    if (geometry)
+    {
+        path_.Clear();
+        geometry->Stroke(path_, GetStrokeWidth(), current_stroke_.Get(), transform_);
+        FillPath(path_, antialias_);
+
+        IncreasePrimitivesCount();
+    }
+}
+
+void SoftwareRenderContext::DrawLine(const Point& point1, const Point& point2)
+{
+    KGE_ASSERT(target_ && "Render target has not been initialized!");
+    KGE_ASSERT(current_brush_ && "The brush used for rendering has not been set!");
+
+    FlushSprites();
+
+    const Point vertices[] = { point1, point2 };
+
+    path_.Clear();
+    StrokePolyline(path_, vertices, 2, false, GetStrokeWidth(), current_stroke_.Get(), transform_);
+    FillPath(path_, antialias_);
+
+    IncreasePrimitivesCount();
+}
+
+void SoftwareRenderContext::DrawRectangle(const Rect& rect)
+{
+    KGE_ASSERT(target_ && "Render target has not been initialized!");
+    KGE_ASSERT(current_brush_ && "The brush used for rendering has not been set!");
+
+    FlushSprites();
+
+    const Point vertices[] = { rect.GetLeftTop(), rect.GetRightTop(), rect.GetRightBottom(), rect.GetLeftBottom() };
+
+    path_.Clear();
+    StrokePolyline(path_, vertices, 4, true, GetStrokeWidth(), current_stroke_.Get(), transform_);
+    FillPath(path_, antialias_);
+
+    IncreasePrimitivesCount();
+}
+
+void SoftwareRenderContext::DrawRoundedRectangle(const Rect& rect, const Vec2& radius)
+{
+    KGE_ASSERT(target_ && "Render target has not been initialized!");
+    KGE_ASSERT(current_brush_ && "The brush used for rendering has not been set!");
+
+    FlushSprites();
+
+    path_.Clear();
+    Geometry::CreateRoundedRect(rect, radius)->Stroke(path_, GetStrokeWidth(), current_stroke_.Get(), transform_);
+    FillPath(path_, antialias_);
+
+    IncreasePrimitivesCount();
+}
+
+void SoftwareRenderContext::DrawEllipse(const Point& center, const Vec2& radius)
+{
+    KGE_ASSERT(target_ && "Render target has not been initialized!");
+    KGE_ASSERT(current_brush_ && "The brush used for rendering has not been set!");
+
+    FlushSprites();
+
+    path_.Clear();
+    Geometry::CreateEllipse(center, radius)->Stroke(path_, GetStrokeWidth(), current_stroke_.Get(), transform_);
+    FillPath(path_, antialias_);
+
+    IncreasePrimitivesCount();
+}
+
+void SoftwareRenderContext::FillShape(const Shape& shape)
+{
+    KGE_ASSERT(target_ && "Render target has not been initialized!");
+    KGE_ASSERT(current_brush_ && "The brush used for rendering has not been set!");
+
+    FlushSprites();
+
+    auto geometry = SoftwarePolicy::Get<Geometry>(shape);
+    if (geometry)
+    {
+        path_.Clear();
+        geometry->Fill(path_, transform_);
+        FillPath(path_, antialias_);
+
+        IncreasePrimitivesCount();
+    }
+}
+
+void SoftwareRenderContext::FillRectangle(const Rect& rect)
+{
+    KGE_ASSERT(target_ && "Render target has not been initialized!");
+    KGE_ASSERT(current_brush_ && "The brush used for rendering has not been set!");
+
+    FlushSprites();
+
+    path_.Clear();
+    path_.AddRect(rect, transform_);
+    FillPath(path_, antialias_);
+
+    IncreasePrimitivesCount();
+}
+
+void SoftwareRenderContext::FillRoundedRectangle(const Rect& rect, const Vec2& radius)
+{
+    KGE_ASSERT(target_ && "Render target has not been initialized!");
+    KGE_ASSERT(current_brush_ && "The brush used for rendering has not been set!");
+
+    FlushSprites();
+
+    path_.Clear();
+    Geometry::CreateRoundedRect(rect, radius)->Fill(path_, transform_);
+    FillPath(path_, antialias_);
+
+    IncreasePrimitivesCount();
+}
+
+void SoftwareRenderContext::FillEllipse(const Point& center, const Vec2& radius)
+{
+    KGE_ASSERT(target_ && "Render target has not been initialized!");
+    KGE_ASSERT(current_brush_ && "The brush used for rendering has not been set!");
+
+    FlushSprites();
+
+    path_.Clear();
+    Geometry::CreateEllipse(center, radius)->Fill(path_, transform_);
+    FillPath(path_, antialias_);
+
+    IncreasePrimitivesCount();
+}
+
+void SoftwareRenderContext::PushClipRect(const Rect& clip_rect)
+{
+    KGE_ASSERT(target_ && "Render target has not been initialized!");
+
+    FlushSprites();
+
+    // Like Direct2D, the clip is the axis-aligned bounds of the transformed rectangle
+    clip_stack_.push_back(GetCurrentClip().Intersect(GetDeviceBounds(clip_rect)));
+}
+
+void SoftwareRenderContext::PopClipRect()
+{
+    KGE_ASSERT(!clip_stack_.empty());
+
+    FlushSprites();
+    clip_stack_.pop_back();
+}
+
+void SoftwareRenderContext::PushLayer(Layer& layer)
+{
+    KGE_ASSERT(target_ && "Render target has not been initialized!");
+
+    FlushSprites();
+
+    LayerState state;
+    state.bitmap   = MakePtr<Bitmap>(target_->GetWidth(), target_->GetHeight());
+    state.bounds   = GetCurrentClip().Intersect(GetDeviceBounds(layer.bounds));
+    state.opacity  = ToAlpha(layer.opacity);
+    state.has_mask = false;
+
+    auto mask = SoftwarePolicy::Get<Geometry>(layer.mask);
+    if (mask)
+    {
+        PathBuffer mask_path;
+        mask->Fill(mask_path, Matrix3x2(layer.mask_transform * transform_));
+
+        state.has_mask = true;
+        state.mask.Rasterize(mask_path, state.bounds, antialias_);
+    }
+
+    layers_.push_back(std::move(state));
+}
+
+void SoftwareRenderContext::PopLayer()
+{
+    KGE_ASSERT(!layers_.empty());
+
+    FlushSprites();
+
+    LayerState state = std::move(layers_.back());
+    layers_.pop_back();
+
+    Bitmap&         dest   = GetCurrentBitmap();
+    const PixelRect bounds = state.bounds.Intersect(PixelRect(0, 0, int(dest.GetWidth()), int(dest.GetHeight())));
+    for (int y = bounds.top; y < bounds.bottom; ++y)
+    {
+        const Pixel* src = state.bitmap->GetRow(uint32_t(y));
+        Pixel*       row = dest.GetRow(uint32_t(y));
+        for (int x = bounds.left; x < bounds.right; ++x)
+        {
+            uint32_t coverage = state.opacity;
+            if (state.has_mask)
+            {
+                coverage = Div255(coverage * state.mask.GetCoverage(x, y));
+            }
+            row[x] = BlendPixel(src[x], row[x], coverage, BlendMode::SourceOver);
+        }
+    }
+}
+
+void SoftwareRenderContext::Clear()
+{
+    FlushSprites();
+
+    Clear(Color::Transparent);
+}
+
+void SoftwareRenderContext::Clear(const Color& clear_color)
+{
+    KGE_ASSERT(target_ && "Render target has not been initialized!");
+
+    FlushSprites();
+
+    Bitmap&         dest  = GetCurrentBitmap();
+    const PixelRect clip  = GetCurrentClip();
+    const Pixel     color = MakePixel(clear_color);
+
+    if (clip.GetWidth() == int(dest.GetWidth()) && clip.GetHeight() == int(dest.GetHeight()))
+    {
+        dest.Clear(color);
+        return;
+    }
+
+    for (int y = clip.top; y < clip.bottom; ++y)
+    {
+        Pixel* row = dest.GetRow(uint32_t(y));
+        std::fill(row + clip.left, row + clip.right, color);
+    }
+}
+
+Size SoftwareRenderContext::GetSize() const
+{
+    if (target_)
+    {
+        return Size(float(target_->GetWidth()), float(target_->GetHeight()));
+    }
+    return Size();
+}
+
+Matrix3x2 SoftwareRenderContext::GetTransform() const
+{
+    return transform_;
+}
+
+void SoftwareRenderContext::SetTransform(const Matrix3x2& matrix)
+{
+    FlushSprites();
+
+    if (fast_global_transform_)
+    {
+        transform_ = matrix;
+    }
+    else
+    {
+        transform_ = matrix * global_transform_;
+    }
+}
+
+void SoftwareRenderContext::SetBlendMode(BlendMode blend)
+{
+    FlushSprites();
+
+    blend_ = blend;
+}
+
+void SoftwareRenderContext::SetAntialiasMode(bool enabled)
+{
+    FlushSprites();
+
+    antialias_ = enabled;
+}
+
+void SoftwareRenderContext::SetTextAntialiasMode(TextAntialiasMode mode)
+{
+    FlushSprites();
+
+    text_antialias_ = mode;
+}
+
+bool SoftwareRenderContext::CheckVisibility(const Rect& bounds, const Matrix3x2& transform)
+{
+    if (fast_global_transform_)
+    {
+        return visible_size_.Intersects(transform.Transform(bounds));
+    }
+    return visible_size_.Intersects(Matrix3x2(transform * global_transform_).Transform(bounds));
+}
+
+void SoftwareRenderContext::Resize(const Size& size)
+{
+    visible_size_ = Rect(Point(), size);
+}
+
+RefPtr<Texture> SoftwareRenderContext::GetTarget() const
+{
+    KGE_ASSERT(target_ && "Render target has not been initialized!");
+
+    RefPtr<Texture> ptr = MakePtr<Texture>();
+    SoftwarePolicy::Set(*ptr, target_);
+
+    ptr->SetSize(GetSize());
+    ptr->SetSizeInPixels(target_->GetSizeInPixels());
+    return ptr;
+}
+
+bool SoftwareRenderContext::DrawBitmap(const Bitmap& bitmap, InterpolationMode mode, const Rect& src,
+                                       const Rect& dest, const Matrix3x2& transform, float opacity,
+                                       const PixelRect& clip)
+{
+    if (src.GetWidth() <= 0 || src.GetHeight() <= 0 || dest.GetWidth() <= 0 || dest.GetHeight() <= 0)
+        return false;
+
+    if (!transform.IsInvertible())
+        return false;
+
+    path_.Clear();
+    path_.AddRect(dest, transform);
+    if (!rasterizer_.Rasterize(path_, clip, antialias_))
+        return false;
+
+    // Map device pixels back to the source rectangle
+    const Matrix3x2 to_local = transform.Invert();
+    const Vec2      scale(src.GetWidth() / dest.GetWidth(), src.GetHeight() / dest.GetHeight());
+    const PixelRect src_bounds = PixelRect::Enclose(src);
+
+    Composite(GetCurrentBitmap(), rasterizer_, blend_, ToAlpha(opacity),
+              [&](const Point& point)
+              {
+                  const Point local = to_local.Transform(point);
+                  const Point pos(src.GetLeft() + (local.x - dest.GetLeft()) * scale.x,
+                                  src.GetTop() + (local.y - dest.GetTop()) * scale.y);
+                  return SampleBitmap(bitmap, pos, mode, src_bounds);
+              });
+    return true;
+}
+
+Bitmap& SoftwareRenderContext::GetCurrentBitmap()
+{
+    if (!layers_.empty())
+        return *layers_.back().bitmap;
+    return *target_;
+}
+
+PixelRect SoftwareRenderContext::GetCurrentClip() const
+{
+    PixelRect clip(0, 0, int(target_->GetWidth()), int(target_->GetHeight()));
+    if (!layers_.empty())
+        clip = clip.Intersect(layers_.back().bounds);
+    if (!clip_stack_.empty())
+        clip = clip.Intersect(clip_stack_.back());
+    return clip;
+}
+
+PixelRect SoftwareRenderContext::GetDeviceBounds(const Rect& rect) const
+{
+    // Infinite rectangles can not be transformed
+    if (rect.GetWidth() >= math::FLOAT_MAX || rect.GetHeight() >= math::FLOAT_MAX)
+        return PixelRect(0, 0, int(target_->GetWidth()), int(target_->GetHeight()));
+    return PixelRect::Snap(transform_.Transform(rect));
+}
+
+RefPtr<Paint> SoftwareRenderContext::GetCurrentPaint() const
+{
+    return SoftwarePolicy::Get<Paint>(current_brush_);
+}
+
+float SoftwareRenderContext::GetStrokeWidth() const
+{
+    return current_stroke_ ? current_stroke_->GetWidth() : 1.0f;
+}
+
+void SoftwareRenderContext::FillPath(const PathBuffer& path, bool antialias)
+{
+    auto paint = GetCurrentPaint();
+    if (!paint)
+        return;
+
+    if (rasterizer_.Rasterize(path, GetCurrentClip(), antialias))
+    {
+        FillCoverage(rasterizer_, *paint, brush_opacity_);
+    }
+}
+
+void SoftwareRenderContext::FillCoverage(const Rasterizer& coverage, const Paint& paint, float opacity)
+{
+    Bitmap&        dest  = GetCurrentBitmap();
+    const uint32_t alpha = ToAlpha(opacity);
+
+    if (paint.IsSolid())
+    {
+        const Pixel color = paint.GetSolidPixel();
+        Composite(dest, coverage, blend_, alpha, [=](const Point&) { return color; });
+        return;
+    }
+
+    // Map device pixels back to the brush space
+    const Matrix3x2 brush_to_device = paint.GetTransform() * transform_;
+    if (!brush_to_device.IsInvertible())
+        return;
+
+    const Matrix3x2 device_to_brush = brush_to_device.Invert();
+    Composite(dest, coverage, blend_, alpha,
+              [&](const Point& point) { return paint.Sample(device_to_brush.Transform(point)); });
+}
+
+}  // namespace software
+}  // namespace graphics
+}  // namespace kiwano
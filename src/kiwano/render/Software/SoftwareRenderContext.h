@@ -0,0 +1,159 @@
+// Copyright (c) 2016-2019 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <kiwano/render/RenderContext.h>
+#include <kiwano/render/Software/Bitmap.h>
+#include <kiwano/render/Software/Paint.h>
+#include <kiwano/render/Software/Rasterizer.h>
+
+namespace kiwano
+{
+namespace graphics
+{
+namespace software
+{
+
+/// \~chinese
+/// @brief Ⱦģƽڴλͼ
+class KGE_API SoftwareRenderContext : public RenderContext
+{
+public:
+    SoftwareRenderContext(RefPtr<Bitmap> target);
+
+    virtual ~SoftwareRenderContext();
+
+    /// \~chinese
+    /// @brief ȡλͼ
+    RefPtr<Bitmap> GetTargetBitmap() const;
+
+    void BeginDraw() override;
+
+    void EndDraw() override;
+
+    void CreateTexture(Texture& texture, const PixelSize& size) override;
+
+    void DrawTexture(const Texture& texture, const Rect* src_rect, const Rect* dest_rect) override;
+
+    void DrawTextLayout(const TextLayout& layout, const Point& offset, RefPtr<Brush> outline_brush) override;
+
+    void DrawShape(const Shape& shape) override;
+
+    void DrawLine(const Point& point1, const Point& point2) override;
+
+    void DrawRectangle(const Rect& rect) override;
+
+    void DrawRoundedRectangle(const Rect& rect, const Vec2& radius) override;
+
+    void DrawEllipse(const Point& center, const Vec2& radius) override;
+
+    void FillShape(const Shape& shape) override;
+
+    void FillRectangle(const Rect& rect) override;
+
+    void FillRoundedRectangle(const Rect& rect, const Vec2& radius) override;
+
+    void FillEllipse(const Point& center, const Vec2& radius) override;
+
+    void PushClipRect(const Rect& clip_rect) override;
+
+    void PopClipRect() override;
+
+    void PushLayer(Layer& layer) override;
+
+    void PopLayer() override;
+
+    void Clear() override;
+
+    void Clear(const Color& clear_color) override;
+
+    Size GetSize() const override;
+
+    Matrix3x2 GetTransform() const override;
+
+    void SetTransform(const Matrix3x2& matrix) override;
+
+    void SetBlendMode(BlendMode blend) override;
+
+    void SetAntialiasMode(bool enabled) override;
+
+    void SetTextAntialiasMode(TextAntialiasMode mode) override;
+
+    bool CheckVisibility(const Rect& bounds, const Matrix3x2& transform) override;
+
+    void Resize(const Size& size) override;
+
+    RefPtr<Texture> GetTarget() const override;
+
+protected:
+    void DrawTextureBatch(const Texture& texture, const SpriteQuad* quads, size_t count) override;
+
+private:
+    struct LayerState
+    {
+        RefPtr<Bitmap> bitmap;
+        PixelRect      bounds;
+        uint32_t       opacity;
+        bool           has_mask;
+        Rasterizer     mask;
+    };
+
+    /// \~chinese
+    /// @brief λͼԴƵĿ
+    /// @return Ƿر
+    bool DrawBitmap(const Bitmap& bitmap, InterpolationMode mode, const Rect& src, const Rect& dest,
+                    const Matrix3x2& transform, float opacity, const PixelRect& clip);
+
+    Bitmap& GetCurrentBitmap();
+
+    PixelRect GetCurrentClip() const;
+
+    PixelRect GetDeviceBounds(const Rect& rect) const;
+
+    RefPtr<Paint> GetCurrentPaint() const;
+
+    float GetStrokeWidth() const;
+
+    /// \~chinese
+    /// @brief õǰˢ
+    void FillPath(const PathBuffer& path, bool antialias);
+
+    /// \~chinese
+    /// @brief ûˢ串
+    void FillCoverage(const Rasterizer& coverage, const Paint& paint, float opacity);
+
+private:
+    BlendMode          blend_;
+    Matrix3x2          transform_;
+    RefPtr<Bitmap>     target_;
+    Vector<PixelRect>  clip_stack_;
+    Vector<LayerState> layers_;
+    Rasterizer         rasterizer_;
+    PathBuffer         path_;
+};
+
+inline RefPtr<Bitmap> SoftwareRenderContext::GetTargetBitmap() const
+{
+    return target_;
+}
+
+}  // namespace software
+}  // namespace graphics
+}  // namespace kiwano
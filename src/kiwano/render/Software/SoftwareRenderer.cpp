@@ -0,0 +1,364 @@
+// Copyright (c) 2016-2019 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <fstream>
+#include <kiwano/render/Software/SoftwareRenderer.h>
+#include <kiwano/render/Software/FontFace.h>
+#include <kiwano/render/Software/Geometry.h>
+#include <kiwano/render/Software/TextBlock.h>
+#include <kiwano/render/Software/helper.h>
+#include <kiwano/render/ShapeMaker.h>
+#include <kiwano/platform/FileSystem.h>
+#include <kiwano/utils/Logger.h>
+
+namespace kiwano
+{
+
+using namespace kiwano::graphics::software;
+
+namespace
+{
+
+bool ReadFileData(StringView file_path, Vector<char>& output)
+{
+    String full_path = FileSystem::GetInstance().GetFullPathForFile(file_path);
+
+    std::ifstream ifs(full_path.c_str(), std::ios::binary | std::ios::ate);
+    if (!ifs.is_open())
+        return false;
+
+    const std::streamsize size = ifs.tellg();
+    if (size <= 0)
+        return false;
+
+    output.resize(size_t(size));
+    ifs.seekg(0, std::ios::beg);
+    return bool(ifs.read(output.data(), size));
+}
+
+}  // namespace
+
+SoftwareRenderer& SoftwareRenderer::GetInstance()
+{
+    static SoftwareRenderer instance;
+    return instance;
+}
+
+SoftwareRenderer::SoftwareRenderer() {}
+
+void SoftwareRenderer::MakeContextForWindow(RefPtr<Window> window)
+{
+    KGE_ASSERT(window);
+
+    Resolution resolution = window->GetCurrentResolution();
+    MakeOffscreenContext(PixelSize(resolution.width, resolution.height));
+
+    window_ = window;
+}
+
+void SoftwareRenderer::MakeOffscreenContext(const PixelSize& size)
+{
+    output_size_ = Size{ float(size.x), float(size.y) };
+    target_      = MakePtr<Bitmap>(size.x, size.y);
+    render_ctx_  = MakePtr<SoftwareRenderContext>(target_);
+}
+
+void SoftwareRenderer::Destroy()
+{
+    Renderer::Destroy();
+
+    render_ctx_.Reset();
+    target_.Reset();
+    window_.Reset();
+}
+
+void SoftwareRenderer::Clear()
+{
+    KGE_ASSERT(target_);
+
+    target_->Clear(MakePixel(clear_color_));
+}
+
+void SoftwareRenderer::Present()
+{
+    // Frames are rendered to the output bitmap directly, only a window needs a copy of it
+#if defined(KGE_PLATFORM_WINDOWS)
+    if (!window_ || !target_)
+        return;
+
+    const uint32_t width  = target_->GetWidth();
+    const uint32_t height = target_->GetHeight();
+
+    // GDI takes BGRA rows
+    present_buffer_.resize(size_t(width) * height);
+    for (uint32_t y = 0; y < height; ++y)
+    {
+        const Pixel* src  = target_->GetRow(y);
+        uint32_t*    dest = &present_buffer_[size_t(y) * width];
+        for (uint32_t x = 0; x < width; ++x)
+        {
+            const Pixel pixel = src[x];
+            dest[x]           = (pixel & 0xFF00FF00) | ((pixel & 0xFF) << 16) | ((pixel >> 16) & 0xFF);
+        }
+    }
+
+    BITMAPINFO info              = {};
+    info.bmiHeader.biSize        = sizeof(BITMAPINFOHEADER);
+    info.bmiHeader.biWidth       = LONG(width);
+    info.bmiHeader.biHeight      = -LONG(height);  // top-down rows
+    info.bmiHeader.biPlanes      = 1;
+    info.bmiHeader.biBitCount    = 32;
+    info.bmiHeader.biCompression = BI_RGB;
+
+    HWND hwnd = window_->GetHandle();
+    HDC  hdc  = ::GetDC(hwnd);
+    if (hdc)
+    {
+        ::SetDIBitsToDevice(hdc, 0, 0, width, height, 0, 0, 0, height, present_buffer_.data(), &info,
+                            DIB_RGB_COLORS);
+        ::ReleaseDC(hwnd, hdc);
+    }
+#endif
+}
+
+void SoftwareRenderer::Resize(uint32_t width, uint32_t height)
+{
+    if (!target_)
+        return;
+
+    output_size_ = Size{ float(width), float(height) };
+    target_->Resize(width, height);
+    render_ctx_->Resize(output_size_);
+}
+
+void SoftwareRenderer::CreateTexture(Texture& texture, StringView file_path)
+{
+    if (!FileSystem::GetInstance().IsFileExists(file_path))
+    {
+        texture.Fail(strings::Format("%s failed: Texture file '%s' not found!", __FUNCTION__, file_path.data()));
+        return;
+    }
+
+    Vector<char> data;
+    if (!ReadFileData(file_path, data))
+    {
+        texture.Fail(strings::Format("%s failed: Read texture file '%s' failed", __FUNCTION__, file_path.data()));
+        return;
+    }
+
+    CreateTexture(texture, BinaryData(data.data(), uint32_t(data.size())));
+}
+
+void SoftwareRenderer::CreateTexture(Texture& texture, const BinaryData& data)
+{
+    RefPtr<Bitmap> bitmap = Bitmap::Decode(data);
+    if (!bitmap)
+    {
+        texture.Fail(strings::Format("%s failed: Unsupported image format", __FUNCTION__));
+        return;
+    }
+
+    SoftwarePolicy::Set(texture, bitmap);
+
+    texture.SetSize({ float(bitmap->GetWidth()), float(bitmap->GetHeight()) });
+    texture.SetSizeInPixels(bitmap->GetSizeInPixels());
+}
+
+void SoftwareRenderer::CreateTexture(Texture& texture, const PixelSize& size, const BinaryData& data,
+                                     PixelFormat format)
+{
+    RefPtr<Bitmap> bitmap = Bitmap::FromPixels(size, data, format);
+    if (!bitmap)
+    {
+        texture.Fail(strings::Format("%s failed: Invalid pixel data", __FUNCTION__));
+        return;
+    }
+
+    SoftwarePolicy::Set(texture, bitmap);
+
+    texture.SetSize({ float(size.x), float(size.y) });
+    texture.SetSizeInPixels(size);
+}
+
+bool SoftwareRenderer::DecodeImage(const BinaryData& data, PixelSize& size, Vector<uint8_t>& pixels)
+{
+    return Bitmap::DecodePixels(data, size, pixels);
+}
+
+void SoftwareRenderer::CreateGifImage(GifImage& gif, StringView file_path)
+{
+    KGE_NOT_USED(file_path);
+    gif.Fail(strings::Format("%s failed: GIF is not supported by the software renderer", __FUNCTION__));
+}
+
+void SoftwareRenderer::CreateGifImage(GifImage& gif, const BinaryData& data)
+{
+    KGE_NOT_USED(data);
+    gif.Fail(strings::Format("%s failed: GIF is not supported by the software renderer", __FUNCTION__));
+}
+
+void SoftwareRenderer::CreateGifImageFrame(GifImage::Frame& frame, const GifImage& gif, size_t frame_index)
+{
+    KGE_NOT_USED(frame);
+    KGE_NOT_USED(gif);
+    KGE_NOT_USED(frame_index);
+}
+
+void SoftwareRenderer::CreateFontCollection(FontCollection& collection, Vector<String>& family_names,
+                                            const Vector<String>& file_paths)
+{
+    Vector<Vector<char>> files(file_paths.size());
+    Vector<BinaryData>   datas;
+    for (size_t i = 0; i < file_paths.size(); ++i)
+    {
+        if (!ReadFileData(file_paths[i], files[i]))
+        {
+            collection.Fail(
+                strings::Format("%s failed: Read font file '%s' failed", __FUNCTION__, file_paths[i].c_str()));
+            return;
+        }
+        datas.emplace_back(files[i].data(), uint32_t(files[i].size()));
+    }
+
+    CreateFontCollection(collection, family_names, datas);
+}
+
+void SoftwareRenderer::CreateFontCollection(FontCollection& collection, Vector<String>& family_names,
+                                            const Vector<BinaryData>& datas)
+{
+    RefPtr<FontFaceCollection> faces = MakePtr<FontFaceCollection>();
+    for (const auto& data : datas)
+    {
+        // Every face of a font collection file is loaded
+        const uint32_t count = FontFace::GetFaceCount(data);
+        for (uint32_t index = 0; index < count; ++index)
+        {
+            faces->AddFace(FontFace::Load(data, index));
+        }
+    }
+
+    if (faces->GetFaces().empty())
+    {
+        collection.Fail(strings::Format("%s failed: No TrueType font found", __FUNCTION__));
+        return;
+    }
+
+    for (const auto& face : faces->GetFaces())
+    {
+        const String& name = face->GetFamilyName();
+        if (std::find(family_names.begin(), family_names.end(), name) == family_names.end())
+            family_names.push_back(name);
+    }
+
+    SoftwarePolicy::Set(collection, faces);
+}
+
+void SoftwareRenderer::CreateTextLayout(TextLayout& layout, StringView content, const TextStyle& style)
+{
+    if (content.empty())
+    {
+        layout.Clear();
+        layout.SetDirtyFlag(TextLayout::DirtyFlag::Dirty);
+        return;
+    }
+
+    SoftwarePolicy::Set(layout, MakePtr<TextBlock>(content, style));
+    layout.SetDirtyFlag(TextLayout::DirtyFlag::Dirty);
+}
+
+void SoftwareRenderer::CreateLineShape(Shape& shape, const Point& begin_pos, const Point& end_pos)
+{
+    SoftwarePolicy::Set(shape, Geometry::CreateLine(begin_pos, end_pos));
+}
+
+void SoftwareRenderer::CreateRectShape(Shape& shape, const Rect& rect)
+{
+    SoftwarePolicy::Set(shape, Geometry::CreateRect(rect));
+}
+
+void SoftwareRenderer::CreateRoundedRectShape(Shape& shape, const Rect& rect, const Vec2& radius)
+{
+    SoftwarePolicy::Set(shape, Geometry::CreateRoundedRect(rect, radius));
+}
+
+void SoftwareRenderer::CreateEllipseShape(Shape& shape, const Point& center, const Vec2& radius)
+{
+    SoftwarePolicy::Set(shape, Geometry::CreateEllipse(center, radius));
+}
+
+void SoftwareRenderer::CreateShapeSink(ShapeMaker& maker)
+{
+    RefPtr<Shape> shape = MakePtr<Shape>();
+    SoftwarePolicy::Set(shape, MakePtr<Geometry>());
+
+    maker.SetShape(shape);
+}
+
+void SoftwareRenderer::CreateBrush(Brush& brush, const Color& color)
+{
+    SoftwarePolicy::Set(brush, MakePtr<Paint>(color));
+}
+
+void SoftwareRenderer::CreateBrush(Brush& brush, const LinearGradientStyle& style)
+{
+    SoftwarePolicy::Set(brush, MakePtr<Paint>(style));
+}
+
+void SoftwareRenderer::CreateBrush(Brush& brush, const RadialGradientStyle& style)
+{
+    SoftwarePolicy::Set(brush, MakePtr<Paint>(style));
+}
+
+void SoftwareRenderer::CreateBrush(Brush& brush, RefPtr<Texture> texture)
+{
+    auto bitmap = SoftwarePolicy::Get<Bitmap>(texture);
+    if (!bitmap)
+    {
+        brush.Fail(strings::Format("%s failed: Invalid texture", __FUNCTION__));
+        return;
+    }
+
+    SoftwarePolicy::Set(brush, MakePtr<Paint>(bitmap, texture->GetBitmapInterpolationMode()));
+}
+
+void SoftwareRenderer::CreateStrokeStyle(StrokeStyle& stroke_style)
+{
+    // Stroke properties are read from the StrokeStyle directly when stroking
+    KGE_NOT_USED(stroke_style);
+}
+
+RefPtr<RenderContext> SoftwareRenderer::CreateTextureRenderContext(RefPtr<Texture> texture,
+                                                                   const PixelSize& desired_size)
+{
+    if (texture == nullptr)
+    {
+        KGE_THROW("Create render context failed: invalid texture");
+        return nullptr;
+    }
+
+    RefPtr<Bitmap> output = MakePtr<Bitmap>(desired_size.x, desired_size.y);
+    SoftwarePolicy::Set(texture, output);
+
+    texture->SetSize({ float(desired_size.x), float(desired_size.y) });
+    texture->SetSizeInPixels(desired_size);
+    return MakePtr<SoftwareRenderContext>(output);
+}
+
+}  // namespace kiwano
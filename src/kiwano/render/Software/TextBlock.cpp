@@ -0,0 +1,454 @@
+// Copyright (c) 2016-2019 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <cctype>
+#include <cmath>
+#include <kiwano/render/Software/TextBlock.h>
+#include <kiwano/render/Software/helper.h>
+
+namespace kiwano
+{
+namespace graphics
+{
+namespace software
+{
+
+namespace
+{
+
+// Metrics of the box glyph drawn when no font has the character, in ems
+const float box_ascent  = 0.8f;
+const float box_descent = 0.2f;
+
+const float underline_position   = 0.1f;
+const float strikethrough_offset = 0.3f;
+const float decoration_thickness = 0.0625f;
+
+// Slant of the synthesized oblique style, about 12 degrees
+const float oblique_slant = 0.21f;
+
+inline bool IsSpace(uint32_t ch)
+{
+    return ch == ' ' || ch == '\t' || ch == 0x3000;
+}
+
+Vector<uint32_t> DecodeUTF8(StringView content)
+{
+    Vector<uint32_t> output;
+    output.reserve(content.size());
+
+    size_t i = 0;
+    while (i < content.size())
+    {
+        const uint8_t lead  = uint8_t(content[i]);
+        size_t        extra = 0;
+        uint32_t      ch    = lead;
+        if (lead >= 0xF0)
+        {
+            extra = 3;
+            ch    = lead & 0x07;
+        }
+        else if (lead >= 0xE0)
+        {
+            extra = 2;
+            ch    = lead & 0x0F;
+        }
+        else if (lead >= 0xC0)
+        {
+            extra = 1;
+            ch    = lead & 0x1F;
+        }
+
+        ++i;
+        for (size_t n = 0; n < extra && i < content.size(); ++n, ++i)
+        {
+            ch = (ch << 6) | (uint8_t(content[i]) & 0x3F);
+        }
+
+        if (ch != '\r')
+            output.push_back(ch);
+    }
+    return output;
+}
+
+bool EqualsIgnoreCase(const String& lhs, const String& rhs)
+{
+    if (lhs.size() != rhs.size())
+        return false;
+
+    for (size_t i = 0; i < lhs.size(); ++i)
+    {
+        if (std::tolower(uint8_t(lhs[i])) != std::tolower(uint8_t(rhs[i])))
+            return false;
+    }
+    return true;
+}
+
+// Lower is better, a wrong posture weighs more than any weight difference
+int GetMatchScore(const FontFace& face, const Font& font)
+{
+    int score = std::abs(int(face.GetWeight()) - int(font.weight));
+    if (face.IsItalic() != (font.posture != FontPosture::Normal))
+        score += 1000;
+    return score;
+}
+
+RefPtr<FontFace> FindFace(const Vector<RefPtr<FontFace>>& faces, const String& family_name, const Font& font)
+{
+    RefPtr<FontFace> best;
+    int              best_score = 0;
+    for (const auto& face : faces)
+    {
+        if (!EqualsIgnoreCase(face->GetFamilyName(), family_name))
+            continue;
+
+        const int score = GetMatchScore(*face, font);
+        if (!best || score < best_score)
+        {
+            best       = face;
+            best_score = score;
+        }
+    }
+    return best;
+}
+
+// The requested face first, then the system faces for the characters it misses
+Vector<RefPtr<FontFace>> SelectFaces(const Font& font)
+{
+    Vector<RefPtr<FontFace>> faces;
+    if (auto collection = SoftwarePolicy::Get<FontFaceCollection>(font.collection))
+    {
+        const auto& collection_faces = collection->GetFaces();
+        if (!collection_faces.empty())
+        {
+            const String& family_name =
+                font.family_name.empty() ? collection_faces[0]->GetFamilyName() : font.family_name;
+            if (auto face = FindFace(collection_faces, family_name, font))
+                faces.push_back(face);
+        }
+    }
+
+    const auto& system_faces = FontFace::GetSystemFaces();
+    if (faces.empty() && !font.family_name.empty())
+    {
+        if (auto face = FindFace(system_faces, font.family_name, font))
+            faces.push_back(face);
+    }
+
+    for (const auto& face : system_faces)
+    {
+        if (faces.empty() || faces[0] != face)
+            faces.push_back(face);
+    }
+    return faces;
+}
+
+}  // namespace
+
+TextBlock::TextBlock(StringView content, const TextStyle& style)
+    : codepoints_(DecodeUTF8(content))
+    , oblique_(false)
+    , font_size_(style.font.size)
+    , wrap_width_(style.wrap_width)
+    , line_spacing_(style.line_spacing)
+    , alignment_(style.alignment)
+    , underline_(style.show_underline)
+    , strikethrough_(style.show_strikethrough)
+    , dirty_(true)
+{
+    SetFont(style.font);
+}
+
+void TextBlock::SetFont(const Font& font)
+{
+    faces_     = SelectFaces(font);
+    font_size_ = font.size;
+    oblique_   = font.posture != FontPosture::Normal && (faces_.empty() || !faces_[0]->IsItalic());
+    dirty_     = true;
+}
+
+void TextBlock::SetAlignment(TextAlign align)
+{
+    alignment_ = align;
+    dirty_     = true;
+}
+
+void TextBlock::SetWrapWidth(float wrap_width)
+{
+    wrap_width_ = wrap_width;
+    dirty_      = true;
+}
+
+void TextBlock::SetLineSpacing(float line_spacing)
+{
+    line_spacing_ = line_spacing;
+    dirty_        = true;
+}
+
+void TextBlock::SetUnderline(bool enable)
+{
+    underline_ = enable;
+}
+
+void TextBlock::SetStrikethrough(bool enable)
+{
+    strikethrough_ = enable;
+}
+
+uint32_t TextBlock::GetLineCount() const
+{
+    UpdateIfDirty();
+    return uint32_t(lines_.size());
+}
+
+Size TextBlock::GetSize() const
+{
+    UpdateIfDirty();
+    return size_;
+}
+
+void TextBlock::BuildGeometry(PathBuffer& glyphs, Vector<Rect>& decorations, const Point& offset,
+                              const Matrix3x2& transform) const
+{
+    UpdateIfDirty();
+
+    // Outlines are cached in layout space
+    const Matrix3x2 matrix = Matrix3x2::Translation(offset) * transform;
+    for (size_t begin = 0, i = 0; i < outline_.contour_ends.size(); ++i)
+    {
+        const uint32_t end = outline_.contour_ends[i];
+        glyphs.AddContour(&outline_.points[begin], end - begin, matrix);
+        begin = end;
+    }
+
+    if (!underline_ && !strikethrough_)
+        return;
+
+    const float em          = font_size_;
+    const float line_height = GetLineHeight();
+    const float thickness   = std::max(1.0f, em * decoration_thickness);
+
+    float top = offset.y;
+    for (const auto& line : lines_)
+    {
+        const float left     = offset.x + line.left;
+        const float baseline = top + GetBaseline();
+
+        if (underline_ && line.width > 0.0f)
+        {
+            const float y = baseline + em * underline_position;
+            decorations.push_back(Rect(left, y, left + line.width, y + thickness));
+        }
+
+        if (strikethrough_ && line.width > 0.0f)
+        {
+            const float y = baseline - em * strikethrough_offset;
+            decorations.push_back(Rect(left, y, left + line.width, y + thickness));
+        }
+        top += line_height;
+    }
+}
+
+void TextBlock::UpdateIfDirty() const
+{
+    if (!dirty_)
+        return;
+
+    dirty_ = false;
+    lines_.clear();
+    glyphs_.clear();
+    outline_.Clear();
+
+    const float em = font_size_;
+
+    // Pick the first face that has each character
+    glyphs_.reserve(codepoints_.size());
+    for (uint32_t ch : codepoints_)
+    {
+        Glyph glyph = { nullptr, 0, 0.0f };
+        if (ch >= 0x20)
+        {
+            const uint32_t lookup = (ch == '\t') ? uint32_t(' ') : ch;
+            for (const auto& face : faces_)
+            {
+                glyph.index = face->GetGlyphIndex(lookup);
+                if (glyph.index)
+                {
+                    glyph.face = face.Get();
+                    break;
+                }
+            }
+
+            // Missing characters use the .notdef glyph of the main face
+            if (!glyph.face && !faces_.empty())
+                glyph.face = faces_[0].Get();
+
+            glyph.advance = glyph.face ? glyph.face->GetAdvance(glyph.index) * em : em;
+        }
+        glyphs_.push_back(glyph);
+    }
+
+    // Trailing whitespaces are not counted for alignment
+    float max_width = 0.0f;
+    auto  add_line  = [&](size_t begin, size_t end)
+    {
+        size_t visible_end = end;
+        while (visible_end > begin && IsSpace(codepoints_[visible_end - 1]))
+            --visible_end;
+
+        float width = 0.0f;
+        for (size_t i = begin; i < visible_end; ++i)
+            width += glyphs_[i].advance;
+
+        lines_.push_back(Line{ begin, end, width, 0.0f });
+        max_width = std::max(max_width, width);
+    };
+
+    size_t paragraph = 0;
+    while (paragraph <= codepoints_.size())
+    {
+        size_t paragraph_end = paragraph;
+        while (paragraph_end < codepoints_.size() && codepoints_[paragraph_end] != '\n')
+            ++paragraph_end;
+
+        size_t begin = paragraph;
+        if (wrap_width_ <= 0 || begin == paragraph_end)
+        {
+            add_line(begin, paragraph_end);
+        }
+        else
+        {
+            while (begin < paragraph_end)
+            {
+                // Whitespaces may hang over the edge, other glyphs start a new line when they do not fit.
+                // Break after the last whitespace, or inside the word if there is none
+                float  width      = 0.0f;
+                size_t end        = begin;
+                size_t last_break = begin;
+                for (; end < paragraph_end; ++end)
+                {
+                    const float advance = glyphs_[end].advance;
+                    if (IsSpace(codepoints_[end]))
+                    {
+                        last_break = end + 1;
+                    }
+                    else if (end > begin && width + advance > wrap_width_ + 1e-3f)
+                    {
+                        break;
+                    }
+                    width += advance;
+                }
+
+                if (end < paragraph_end && last_break > begin)
+                    end = last_break;
+
+                add_line(begin, end);
+                begin = end;
+            }
+        }
+
+        paragraph = paragraph_end + 1;
+    }
+
+    const float height = float(lines_.size()) * GetLineHeight();
+    if (wrap_width_ > 0)
+    {
+        size_ = Size(wrap_width_, height);
+    }
+    else
+    {
+        size_ = Size(max_width, height);
+    }
+
+    // Line positions and glyph outlines
+    const float     line_height = GetLineHeight();
+    const Matrix3x2 slant(1.0f, 0.0f, oblique_ ? -oblique_slant : 0.0f, 1.0f, 0.0f, 0.0f);
+
+    float top = 0.0f;
+    for (auto& line : lines_)
+    {
+        switch (alignment_)
+        {
+        case TextAlign::Right:
+            line.left = size_.x - line.width;
+            break;
+        case TextAlign::Center:
+            line.left = (size_.x - line.width) * 0.5f;
+            break;
+        default:
+            line.left = 0.0f;
+            break;
+        }
+
+        const float baseline = top + GetBaseline();
+
+        float x = line.left;
+        for (size_t i = line.begin; i < line.end; ++i)
+        {
+            const Glyph& glyph = glyphs_[i];
+            if (!IsSpace(codepoints_[i]) && glyph.advance > 0.0f)
+            {
+                // Glyphs are placed with their origin on the baseline
+                const Matrix3x2 origin = slant * Matrix3x2::Translation(Point(x, baseline));
+                if (glyph.face)
+                {
+                    glyph.face->AddGlyph(outline_, glyph.index, Matrix3x2(Matrix3x2::Scaling(Vec2(em, -em)) * origin));
+                }
+                else
+                {
+                    outline_.AddRect(Rect(0.0f, -em * box_ascent, em, em * box_descent), origin);
+                }
+            }
+            x += glyph.advance;
+        }
+        top += line_height;
+    }
+}
+
+float TextBlock::GetLineHeight() const
+{
+    if (line_spacing_ > 0)
+        return line_spacing_;
+
+    if (faces_.empty())
+        return font_size_ * (box_ascent + box_descent);
+
+    const FontFace& face = *faces_[0];
+    return font_size_ * (face.GetAscent() + face.GetDescent() + face.GetLineGap());
+}
+
+float TextBlock::GetBaseline() const
+{
+    float ascent = box_ascent;
+    float height = box_ascent + box_descent;
+    if (!faces_.empty())
+    {
+        const FontFace& face = *faces_[0];
+        ascent               = face.GetAscent();
+        height               = face.GetAscent() + face.GetDescent() + face.GetLineGap();
+    }
+
+    // Extra line spacing is shared above and below in proportion to the font metrics
+    return height > 0.0f ? GetLineHeight() * ascent / height : 0.0f;
+}
+
+}  // namespace software
+}  // namespace graphics
+}  // namespace kiwano
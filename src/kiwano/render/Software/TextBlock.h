@@ -0,0 +1,106 @@
+// Copyright (c) 2016-2019 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <kiwano/base/RefObject.h>
+#include <kiwano/render/TextStyle.h>
+#include <kiwano/render/Software/FontFace.h>
+#include <kiwano/render/Software/Rasterizer.h>
+
+namespace kiwano
+{
+namespace graphics
+{
+namespace software
+{
+
+/// \~chinese
+/// @brief ı
+/// @details ʹ弯е TrueType ֣ȱٵַϵͳвң
+/// ϵͳҲҲʱַΪһֺ߳ŵķ
+class KGE_API TextBlock : public RefObject
+{
+public:
+    TextBlock(StringView content, const TextStyle& style);
+
+    void SetFont(const Font& font);
+
+    void SetAlignment(TextAlign align);
+
+    void SetWrapWidth(float wrap_width);
+
+    void SetLineSpacing(float line_spacing);
+
+    void SetUnderline(bool enable);
+
+    void SetStrikethrough(bool enable);
+
+    uint32_t GetLineCount() const;
+
+    Size GetSize() const;
+
+    /// \~chinese
+    /// @brief ζΣԼ»ߺɾڵľ
+    void BuildGeometry(PathBuffer& glyphs, Vector<Rect>& decorations, const Point& offset,
+                       const Matrix3x2& transform) const;
+
+private:
+    struct Line
+    {
+        size_t begin;
+        size_t end;
+        float  width;
+        float  left;
+    };
+
+    struct Glyph
+    {
+        const FontFace* face;  // nullptr for the box glyph
+        uint32_t        index;
+        float           advance;
+    };
+
+    void UpdateIfDirty() const;
+
+    float GetLineHeight() const;
+
+    float GetBaseline() const;
+
+private:
+    Vector<uint32_t>         codepoints_;
+    Vector<RefPtr<FontFace>> faces_;
+    bool                     oblique_;
+    float                    font_size_;
+    float                    wrap_width_;
+    float                    line_spacing_;
+    TextAlign                alignment_;
+    bool                     underline_;
+    bool                     strikethrough_;
+
+    mutable bool          dirty_;
+    mutable Size          size_;
+    mutable Vector<Line>  lines_;
+    mutable Vector<Glyph> glyphs_;
+    mutable PathBuffer    outline_;
+};
+
+}  // namespace software
+}  // namespace graphics
+}  // namespace kiwano
@@ -0,0 +1,90 @@
+// Copyright (c) 2016-2019 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <kiwano/base/RefPtr.h>
+#include <kiwano/platform/NativeObject.hpp>
+
+namespace kiwano
+{
+namespace graphics
+{
+namespace software
+{
+
+/// \~chinese
+/// @brief ȾԴ NativeObject еĴȡ
+struct SoftwarePolicy
+{
+    template <typename _Ty, typename = typename std::enable_if<std::is_base_of<RefObject, _Ty>::value, int>::type>
+    static inline RefPtr<_Ty> Get(const NativeObject* object)
+    {
+        if (object)
+        {
+            const auto& native = object->GetNative();
+            if (native.HasValue())
+            {
+                auto ptr = native.CastPtr<RefPtr<RefObject>>();
+                if (ptr && *ptr)
+                {
+                    return RefPtr<_Ty>(dynamic_cast<_Ty*>(ptr->Get()));
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    template <typename _Ty, typename = typename std::enable_if<std::is_base_of<RefObject, _Ty>::value, int>::type>
+    static inline RefPtr<_Ty> Get(const NativeObject& object)
+    {
+        return SoftwarePolicy::Get<_Ty>(&object);
+    }
+
+    template <typename _Ty, typename = typename std::enable_if<std::is_base_of<RefObject, _Ty>::value, int>::type>
+    static inline RefPtr<_Ty> Get(RefPtr<NativeObject> object)
+    {
+        return SoftwarePolicy::Get<_Ty>(object.Get());
+    }
+
+    static inline void Set(NativeObject* object, RefPtr<RefObject> ptr)
+    {
+        if (object)
+        {
+            if (ptr)
+                object->SetNative(Any{ ptr });
+            else
+                object->ResetNative();
+        }
+    }
+
+    static inline void Set(NativeObject& object, RefPtr<RefObject> ptr)
+    {
+        SoftwarePolicy::Set(&object, ptr);
+    }
+
+    static inline void Set(RefPtr<NativeObject> object, RefPtr<RefObject> ptr)
+    {
+        SoftwarePolicy::Set(object.Get(), ptr);
+    }
+};
+
+}  // namespace software
+}  // namespace graphics
+}  // namespace kiwano
@@ -0,0 +1,45 @@
+// Copyright (c) 2016-2019 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <kiwano/render/SpriteBatch.h>
+
+namespace kiwano
+{
+
+SpriteBatch::SpriteBatch() {}
+
+void SpriteBatch::Add(Texture& texture, const Rect& src_rect, const Rect& dest_rect, const Matrix3x2& transform,
+                      float opacity)
+{
+    KGE_ASSERT(IsCompatible(texture));
+
+    // Held until the flush, so that no other texture can take its address in between
+    if (quads_.empty())
+        texture_ = &texture;
+    quads_.push_back(SpriteQuad{ src_rect, dest_rect, transform, opacity });
+}
+
+void SpriteBatch::Clear()
+{
+    texture_ = nullptr;
+    quads_.clear();
+}
+
+}  // namespace kiwano
@@ -0,0 +1,110 @@
+// Copyright (c) 2016-2019 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <kiwano/render/Texture.h>
+
+namespace kiwano
+{
+
+/**
+ * \addtogroup Render
+ * @{
+ */
+
+/// \~chinese
+/// @brief еĵͼԪ
+struct SpriteQuad
+{
+    Rect      src_rect;   ///< Դü
+    Rect      dest_rect;  ///< ƵĿ
+    Matrix3x2 transform;  ///< ά任
+    float     opacity;    ///< ͸
+};
+
+/**
+ * \~chinese
+ * @brief 
+ * @details ռʹͬһĻԱȾ״̬ıʱһύ
+ * @note γãύǰᱻͷ
+ */
+class KGE_API SpriteBatch : Noncopyable
+{
+public:
+    SpriteBatch();
+
+    /// \~chinese
+    /// @brief ȡʹõ
+    const Texture* GetTexture() const;
+
+    /// \~chinese
+    /// @brief ȡеͼԪ
+    const Vector<SpriteQuad>& GetQuads() const;
+
+    /// \~chinese
+    /// @brief ǷΪ
+    bool IsEmpty() const;
+
+    /// \~chinese
+    /// @brief жܷϲǰ
+    bool IsCompatible(const Texture& texture) const;
+
+    /// \~chinese
+    /// @brief ͼԪ
+    /// @param texture 뵱ǰμ
+    /// @param src_rect Դü
+    /// @param dest_rect ƵĿ
+    /// @param transform ά任
+    /// @param opacity ͸
+    void Add(Texture& texture, const Rect& src_rect, const Rect& dest_rect, const Matrix3x2& transform,
+             float opacity);
+
+    /// \~chinese
+    /// @brief Σѷڴ
+    void Clear();
+
+private:
+    RefPtr<Texture>    texture_;
+    Vector<SpriteQuad> quads_;
+};
+
+/** @} */
+
+inline const Texture* SpriteBatch::GetTexture() const
+{
+    return texture_.Get();
+}
+
+inline const Vector<SpriteQuad>& SpriteBatch::GetQuads() const
+{
+    return quads_;
+}
+
+inline bool SpriteBatch::IsEmpty() const
+{
+    return quads_.empty();
+}
+
+inline bool SpriteBatch::IsCompatible(const Texture& texture) const
+{
+    return quads_.empty() || texture_.Get() == &texture;
+}
+
+}  // namespace kiwano
@@ -21,6 +21,9 @@
 #include <kiwano/render/Renderer.h>
 #include <kiwano/render/TextLayout.h>
 
+#include <kiwano/render/Software/TextBlock.h>
+#include <kiwano/render/Software/helper.h>
+
 #if KGE_RENDER_ENGINE == KGE_RENDER_ENGINE_DIRECTX
 #include <kiwano/render/DirectX/helper.h>
 #endif
@@ -86,10 +89,7 @@ uint32_t TextLayout::GetLineCount() const
 void TextLayout::SetFont(const Font& font)
 {
 #if KGE_RENDER_ENGINE == KGE_RENDER_ENGINE_DIRECTX
-    auto native = ComPolicy::Get<IDWriteTextLayout>((const NativeObject*)(this));
-    KGE_ASSERT(native);
-
-    if (native)
+    if (auto native = ComPolicy::Get<IDWriteTextLayout>(this))
     {
         HRESULT hr = S_OK;
 
@@ -139,56 +139,56 @@ void TextLayout::SetFont(const Font& font)
             KGE_THROW_IF_FAILED(hr, "IDWriteTextLayout::SetFontStretch failed");
         }
     }
-#else
-    // not supported
 #endif
 
+    if (auto native = graphics::software::SoftwarePolicy::Get<graphics::software::TextBlock>(this))
+    {
+        native->SetFont(font);
+    }
+
     SetDirtyFlag(DirtyFlag::Dirty);
 }
 
 void TextLayout::SetUnderline(bool enable)
 {
 #if KGE_RENDER_ENGINE == KGE_RENDER_ENGINE_DIRECTX
-    auto native = ComPolicy::Get<IDWriteTextLayout>(this);
-    KGE_ASSERT(native);
-
-    if (native)
+    if (auto native = ComPolicy::Get<IDWriteTextLayout>(this))
     {
         HRESULT hr = native->SetUnderline(enable, { 0, content_length_ });
         KGE_THROW_IF_FAILED(hr, "IDWriteTextLayout::SetUnderline failed");
     }
-#else
-    // not supported
 #endif
 
+    if (auto native = graphics::software::SoftwarePolicy::Get<graphics::software::TextBlock>(this))
+    {
+        native->SetUnderline(enable);
+    }
+
     SetDirtyFlag(DirtyFlag::Dirty);
 }
 
 void TextLayout::SetStrikethrough(bool enable)
 {
 #if KGE_RENDER_ENGINE == KGE_RENDER_ENGINE_DIRECTX
-    auto native = ComPolicy::Get<IDWriteTextLayout>(this);
-    KGE_ASSERT(native);
-
-    if (native)
+    if (auto native = ComPolicy::Get<IDWriteTextLayout>(this))
     {
         HRESULT hr = native->SetStrikethrough(enable, { 0, content_length_ });
         KGE_THROW_IF_FAILED(hr, "IDWriteTextLayout::SetStrikethrough failed");
     }
-#else
-    // not supported
 #endif
 
+    if (auto native = graphics::software::SoftwarePolicy::Get<graphics::software::TextBlock>(this))
+    {
+        native->SetStrikethrough(enable);
+    }
+
     SetDirtyFlag(DirtyFlag::Dirty);
 }
 
 void TextLayout::SetAlignment(TextAlign align)
 {
 #if KGE_RENDER_ENGINE == KGE_RENDER_ENGINE_DIRECTX
-    auto native = ComPolicy::Get<IDWriteTextLayout>(this);
-    KGE_ASSERT(native);
-
-    if (native)
+    if (auto native = ComPolicy::Get<IDWriteTextLayout>(this))
     {
         DWRITE_TEXT_ALIGNMENT alignment = DWRITE_TEXT_ALIGNMENT();
         switch (align)
@@ -210,20 +210,20 @@ void TextLayout::SetAlignment(TextAlign align)
         HRESULT hr = native->SetTextAlignment(alignment);
         KGE_THROW_IF_FAILED(hr, "IDWriteTextLayout::SetTextAlignment failed");
     }
-#else
-    // not supported
 #endif
 
+    if (auto native = graphics::software::SoftwarePolicy::Get<graphics::software::TextBlock>(this))
+    {
+        native->SetAlignment(align);
+    }
+
     SetDirtyFlag(DirtyFlag::Dirty);
 }
 
 void TextLayout::SetWrapWidth(float wrap_width)
 {
 #if KGE_RENDER_ENGINE == KGE_RENDER_ENGINE_DIRECTX
-    auto native = ComPolicy::Get<IDWriteTextLayout>(this);
-    KGE_ASSERT(native);
-
-    if (native)
+    if (auto native = ComPolicy::Get<IDWriteTextLayout>(this))
     {
         HRESULT hr = S_OK;
         if (wrap_width > 0)
@@ -240,20 +240,20 @@ void TextLayout::SetWrapWidth(float wrap_width)
         }
         KGE_THROW_IF_FAILED(hr, "IDWriteTextLayout::SetWordWrapping failed");
     }
-#else
-    // not supported
 #endif
 
+    if (auto native = graphics::software::SoftwarePolicy::Get<graphics::software::TextBlock>(this))
+    {
+        native->SetWrapWidth(wrap_width);
+    }
+
     SetDirtyFlag(DirtyFlag::Dirty);
 }
 
 void TextLayout::SetLineSpacing(float line_spacing)
 {
 #if KGE_RENDER_ENGINE == KGE_RENDER_ENGINE_DIRECTX
-    auto native = ComPolicy::Get<IDWriteTextLayout>(this);
-    KGE_ASSERT(native);
-
-    if (native)
+    if (auto native = ComPolicy::Get<IDWriteTextLayout>(this))
     {
         HRESULT hr = S_OK;
 
@@ -268,16 +268,18 @@ void TextLayout::SetLineSpacing(float line_spacing)
         }
         KGE_THROW_IF_FAILED(hr, "IDWriteTextLayout::SetLineSpacing failed");
     }
-#else
-    // not supported
 #endif
 
+    if (auto native = graphics::software::SoftwarePolicy::Get<graphics::software::TextBlock>(this))
+    {
+        native->SetLineSpacing(line_spacing);
+    }
+
     SetDirtyFlag(DirtyFlag::Dirty);
 }
 
 bool TextLayout::UpdateIfDirty()
 {
-#if KGE_RENDER_ENGINE == KGE_RENDER_ENGINE_DIRECTX
     if (dirty_flag_ == DirtyFlag::Dirty)
     {
         SetDirtyFlag(DirtyFlag::Clean);
@@ -285,47 +287,55 @@ bool TextLayout::UpdateIfDirty()
         line_count_ = 0;
         size_       = Size();
 
-        auto native = ComPolicy::Get<IDWriteTextLayout>(this);
-        if (content_length_ == 0 || !native)
+        if (content_length_ == 0)
             return true;
 
-        HRESULT hr = S_OK;
-
-        DWRITE_TEXT_METRICS metrics;
-        hr = native->GetMetrics(&metrics);
-        if (SUCCEEDED(hr))
+#if KGE_RENDER_ENGINE == KGE_RENDER_ENGINE_DIRECTX
+        if (auto native = ComPolicy::Get<IDWriteTextLayout>(this))
         {
-            if (native->GetWordWrapping() == DWRITE_WORD_WRAPPING_NO_WRAP)
+            HRESULT hr = S_OK;
+
+            DWRITE_TEXT_METRICS metrics;
+            hr = native->GetMetrics(&metrics);
+            if (SUCCEEDED(hr))
             {
-                // Fix the layout width when the text does not wrap
-                hr = native->SetMaxWidth(metrics.widthIncludingTrailingWhitespace);
-                if (SUCCEEDED(hr))
+                if (native->GetWordWrapping() == DWRITE_WORD_WRAPPING_NO_WRAP)
                 {
-                    hr = native->GetMetrics(&metrics);
+                    // Fix the layout width when the text does not wrap
+                    hr = native->SetMaxWidth(metrics.widthIncludingTrailingWhitespace);
+                    if (SUCCEEDED(hr))
+                    {
+                        hr = native->GetMetrics(&metrics);
+                    }
                 }
             }
-        }
-
-        if (SUCCEEDED(hr))
-        {
-            line_count_ = metrics.lineCount;
 
-            if (metrics.layoutWidth > 0)
-            {
-                size_ = Size(metrics.layoutWidth, metrics.height);
-            }
-            else
+            if (SUCCEEDED(hr))
             {
-                size_ = Size(metrics.widthIncludingTrailingWhitespace, metrics.height);
+                line_count_ = metrics.lineCount;
+
+                if (metrics.layoutWidth > 0)
+                {
+                    size_ = Size(metrics.layoutWidth, metrics.height);
+                }
+                else
+                {
+                    size_ = Size(metrics.widthIncludingTrailingWhitespace, metrics.height);
+                }
             }
+
+            KGE_THROW_IF_FAILED(hr, "IDWriteTextLayout::GetMetrics failed");
+            return true;
         }
+#endif
 
-        KGE_THROW_IF_FAILED(hr, "IDWriteTextLayout::GetMetrics failed");
+        if (auto native = graphics::software::SoftwarePolicy::Get<graphics::software::TextBlock>(this))
+        {
+            line_count_ = native->GetLineCount();
+            size_       = native->GetSize();
+        }
         return true;
     }
-#else
-    // not supported
-#endif
     return false;
 }
 
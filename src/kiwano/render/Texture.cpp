@@ -22,6 +22,9 @@
 #include <kiwano/render/Texture.h>
 #include <functional>  // std::hash
 
+#include <kiwano/render/Software/Bitmap.h>
+#include <kiwano/render/Software/helper.h>
+
 #if KGE_RENDER_ENGINE == KGE_RENDER_ENGINE_DIRECTX
 #include <kiwano/render/DirectX/helper.h>
 #endif
@@ -79,27 +82,40 @@ bool Texture::Load(const PixelSize& size, const BinaryData& data, PixelFormat fo
 
 void Texture::CopyFrom(RefPtr<Texture> copy_from)
 {
+    if (!IsValid() || !copy_from)
+        return;
+
 #if KGE_RENDER_ENGINE == KGE_RENDER_ENGINE_DIRECTX
-    if (IsValid() && copy_from)
+    if (auto native = ComPolicy::Get<ID2D1Bitmap>(this))
     {
-        auto native         = ComPolicy::Get<ID2D1Bitmap>(this);
         auto native_to_copy = ComPolicy::Get<ID2D1Bitmap>(copy_from);
 
         HRESULT hr = native->CopyFromBitmap(nullptr, native_to_copy.Get(), nullptr);
 
         KGE_THROW_IF_FAILED(hr, "Copy texture data failed");
+        return;
     }
-#else
-    return;  // not supported
 #endif
+
+    auto native         = graphics::software::SoftwarePolicy::Get<graphics::software::Bitmap>(this);
+    auto native_to_copy = graphics::software::SoftwarePolicy::Get<graphics::software::Bitmap>(copy_from);
+    if (native && native_to_copy)
+    {
+        native->CopyFrom(*native_to_copy,
+                         graphics::software::PixelRect(0, 0, int(native_to_copy->GetWidth()),
+                                                       int(native_to_copy->GetHeight())),
+                         0, 0);
+    }
 }
 
 void Texture::CopyFrom(RefPtr<Texture> copy_from, const Rect& src_rect, const Point& dest_point)
 {
+    if (!IsValid() || !copy_from)
+        return;
+
 #if KGE_RENDER_ENGINE == KGE_RENDER_ENGINE_DIRECTX
-    if (IsValid() && copy_from)
+    if (auto native = ComPolicy::Get<ID2D1Bitmap>(this))
     {
-        auto native         = ComPolicy::Get<ID2D1Bitmap>(this);
         auto native_to_copy = ComPolicy::Get<ID2D1Bitmap>(copy_from);
 
         HRESULT hr =
@@ -108,10 +124,19 @@ void Texture::CopyFrom(RefPtr<Texture> copy_from, const Rect& src_rect, const Po
                                                 uint32_t(src_rect.GetRight()), uint32_t(src_rect.GetBottom())));
 
         KGE_THROW_IF_FAILED(hr, "Copy texture data failed");
+        return;
     }
-#else
-    return;  // not supported
 #endif
+
+    auto native         = graphics::software::SoftwarePolicy::Get<graphics::software::Bitmap>(this);
+    auto native_to_copy = graphics::software::SoftwarePolicy::Get<graphics::software::Bitmap>(copy_from);
+    if (native && native_to_copy)
+    {
+        native->CopyFrom(*native_to_copy,
+                         graphics::software::PixelRect(int(src_rect.GetLeft()), int(src_rect.GetTop()),
+                                                       int(src_rect.GetRight()), int(src_rect.GetBottom())),
+                         int(dest_point.x), int(dest_point.y));
+    }
 }
 
 void Texture::SetInterpolationMode(InterpolationMode mode)
@@ -18,7 +18,13 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 // THE SOFTWARE.
 
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <ctime>
+#include <exception>
 #include <ios>
 #include <fstream>
 #include <iostream>
@@ -545,11 +551,52 @@ LogBuffer::pos_type LogBuffer::seekoff(off_type offset, std::ios_base::seekdir w
 //
 // Logger
 //
+namespace
+{
+
+// Message bodies of async records are built in a buffer owned by the logging thread
+struct AsyncRecordBuilder
+{
+    AsyncRecordBuilder()
+        : buffer(0)
+        , stream(&buffer)
+        , size(0)
+    {
+    }
+
+    LogBuffer    buffer;
+    std::ostream stream;
+    size_t       size;
+};
+
+thread_local AsyncRecordBuilder record_builder;
+
+std::terminate_handler previous_terminate = nullptr;
+
+#if defined(KGE_PLATFORM_WINDOWS)
+LPTOP_LEVEL_EXCEPTION_FILTER previous_exception_filter = nullptr;
+#endif
+
+}  // namespace
+
 Logger::Logger()
     : enabled_(true)
     , level_(LogLevel::Debug)
     , buffer_(1024)
+    , buffer_size_(1024)
     , stream_(&buffer_)
+    , async_(false)
+    , async_producers_(0)
+    , overflow_policy_(LogOverflowPolicy::Block)
+    , record_mask_(0)
+    , enqueue_pos_(0)
+    , dequeue_pos_(0)
+    , dropped_count_(0)
+    , reported_drops_(0)
+    , writer_running_(false)
+    , writer_sleeping_(false)
+    , flush_requests_(0)
+    , flushed_requests_(0)
 {
     RefPtr<LogFormater> formater = MakePtr<TextFormater>();
     SetFormater(formater);
@@ -558,7 +605,7 @@ Logger::Logger()
     AddProvider(provider);
 }
 
-std::iostream& Logger::GetFormatedStream(LogLevel level, LogBuffer* buffer)
+std::iostream& Logger::GetFormatedStream(LogLevel level, ClockTime time, LogBuffer* buffer)
 {
     // reset buffer
     buffer->Reset();
@@ -568,12 +615,15 @@ std::iostream& Logger::GetFormatedStream(LogLevel level, LogBuffer* buffer)
 
     if (formater_)
     {
-        formater_->FormatHeader(stream_, level, ClockTime::Now());
+        formater_->FormatHeader(stream_, level, time);
     }
     return stream_;
 }
 
-Logger::~Logger() {}
+Logger::~Logger()
+{
+    DisableAsync();
+}
 
 void Logger::Logf(LogLevel level, const char* format, ...)
 {
@@ -583,13 +633,47 @@ void Logger::Logf(LogLevel level, const char* format, ...)
     if (level < level_)
         return;
 
+    AsyncScope async_scope(this);
+    if (async_scope.IsEntered())
+    {
+        size_t       pos    = 0;
+        AsyncRecord* record = this->AcquireAsyncRecord(level, pos);
+        if (!record)
+            return;
+
+        va_list args = nullptr;
+        va_start(args, format);
+
+        // Format straight into the claimed slot, the writer waits for it to be published
+        va_list retry_args;
+        va_copy(retry_args, args);
+
+        record->text[0] = ' ';
+        const int len   = format ? std::vsnprintf(record->text + 1, AsyncRecord::TextSize - 1, format, args) : 0;
+
+        record->length = 1 + size_t(std::max(len, 0));
+        if (record->length >= AsyncRecord::TextSize)
+        {
+            record->long_text.resize(record->length + 1);
+            record->long_text[0] = ' ';
+            std::vsnprintf(&record->long_text[1], record->length, format, retry_args);
+            record->long_text.resize(record->length);
+        }
+
+        va_end(retry_args);
+        va_end(args);
+
+        this->PublishAsyncRecord(record, pos);
+        return;
+    }
+
     std::lock_guard<std::mutex> lock(mutex_);
 
     va_list args = nullptr;
     va_start(args, format);
 
     // build message
-    auto& stream = this->GetFormatedStream(level, &buffer_);
+    auto& stream = this->GetFormatedStream(level, ClockTime::Now(), &buffer_);
     stream << ' ' << strings::FormatArgs(format, args);
 
     va_end(args);
@@ -603,12 +687,81 @@ void Logger::Flush()
     if (!enabled_)
         return;
 
+    if (async_)
+    {
+        // Records pushed before the ticket are written by the time the writer hands it back
+        std::unique_lock<std::mutex> lock(writer_mutex_);
+
+        const size_t ticket = ++flush_requests_;
+        writer_cond_.notify_one();
+        flush_cond_.wait(lock, [=]() { return flushed_requests_ >= ticket || !writer_running_; });
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
     for (auto provider : providers_)
     {
         provider->Flush();
     }
 }
 
+void Logger::EnableAsync(size_t capacity, LogOverflowPolicy policy)
+{
+    std::lock_guard<std::mutex> lock(async_mutex_);
+    StopAsync();
+
+    size_t size = 2;
+    while (size < capacity)
+        size <<= 1;
+
+    records_.reset(new AsyncRecord[size]);
+    for (size_t i = 0; i < size; ++i)
+    {
+        records_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    record_mask_     = size - 1;
+    enqueue_pos_     = 0;
+    dequeue_pos_     = 0;
+    reported_drops_  = dropped_count_;
+    overflow_policy_ = policy;
+
+    InstallCrashHandlers();
+
+    writer_running_ = true;
+    writer_         = std::thread(&Logger::WriterMain, this);
+    async_          = true;
+}
+
+void Logger::DisableAsync()
+{
+    std::lock_guard<std::mutex> lock(async_mutex_);
+    StopAsync();
+}
+
+void Logger::StopAsync()
+{
+    if (!async_)
+        return;
+
+    // Producers that entered before the switch push into the ring, wait for them while the writer runs
+    async_ = false;
+    while (async_producers_ != 0)
+    {
+        std::this_thread::yield();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(writer_mutex_);
+        writer_running_ = false;
+    }
+    writer_cond_.notify_one();
+    flush_cond_.notify_all();
+
+    // The writer drains the remaining records before it exits
+    writer_.join();
+}
+
 void Logger::SetLevel(LogLevel level)
 {
     level_ = level;
@@ -618,6 +771,8 @@ void Logger::AddProvider(RefPtr<LogProvider> provider)
 {
     if (provider)
     {
+        std::lock_guard<std::mutex> lock(mutex_);
+
         provider->Init();
         providers_.push_back(provider);
     }
@@ -630,7 +785,11 @@ RefPtr<LogFormater> Logger::GetFormater()
 
 void Logger::ResizeBuffer(size_t buffer_size)
 {
+    std::lock_guard<std::mutex> lock(mutex_);
+
     buffer_.Resize(buffer_size);
+    if (buffer_size_ < buffer_size)
+        buffer_size_ = buffer_size;
 }
 
 void Logger::WriteToProviders(LogLevel level, LogBuffer* buffer)
@@ -649,6 +808,259 @@ void Logger::WriteToProviders(LogLevel level, LogBuffer* buffer)
     }
 }
 
+bool Logger::EnterAsync()
+{
+    // Pairs with StopAsync, either it sees this producer or the producer sees async mode off
+    ++async_producers_;
+    if (async_)
+        return true;
+
+    --async_producers_;
+    return false;
+}
+
+void Logger::LeaveAsync()
+{
+    --async_producers_;
+}
+
+std::ostream& Logger::BeginAsyncRecord()
+{
+    // Thread buffers follow ResizeBuffer lazily
+    auto&        builder = record_builder;
+    const size_t size    = buffer_size_;
+    if (builder.size < size)
+    {
+        builder.buffer.Resize(size);
+        builder.size = size;
+    }
+
+    builder.buffer.Reset();
+    builder.stream.clear();
+    return builder.stream;
+}
+
+void Logger::EndAsyncRecord(LogLevel level)
+{
+    const char*  msg  = record_builder.buffer.GetRaw();
+    const size_t size = std::strlen(msg);
+
+    size_t       pos    = 0;
+    AsyncRecord* record = AcquireAsyncRecord(level, pos);
+    if (!record)
+        return;
+
+    if (size < AsyncRecord::TextSize)
+    {
+        std::memcpy(record->text, msg, size + 1);
+    }
+    else
+    {
+        record->long_text.assign(msg, size);
+    }
+    record->length = size;
+
+    PublishAsyncRecord(record, pos);
+}
+
+Logger::AsyncRecord* Logger::AcquireAsyncRecord(LogLevel level, size_t& pos)
+{
+    const ClockTime time   = ClockTime::Now();
+    AsyncRecord*    record = nullptr;
+    while (!(record = TryAcquireAsyncRecord(pos)))
+    {
+        if (overflow_policy_ != LogOverflowPolicy::Block)
+        {
+            ++dropped_count_;
+            if (overflow_policy_ == LogOverflowPolicy::DropAndReport)
+                WakeWriter();
+            return nullptr;
+        }
+
+        // Wait for the writer to release a slot
+        WakeWriter();
+        std::this_thread::yield();
+    }
+
+    record->level = level;
+    record->time  = time;
+    return record;
+}
+
+Logger::AsyncRecord* Logger::TryAcquireAsyncRecord(size_t& pos)
+{
+    pos = enqueue_pos_.load(std::memory_order_relaxed);
+    while (true)
+    {
+        AsyncRecord* record = &records_[pos & record_mask_];
+
+        const size_t   seq  = record->sequence.load(std::memory_order_acquire);
+        const intptr_t diff = intptr_t(seq) - intptr_t(pos);
+        if (diff == 0)
+        {
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                return record;
+        }
+        else if (diff < 0)
+        {
+            // The slot still holds a record from the previous lap, the ring is full
+            return nullptr;
+        }
+        else
+        {
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void Logger::PublishAsyncRecord(AsyncRecord* record, size_t pos)
+{
+    record->sequence.store(pos + 1, std::memory_order_release);
+
+    // Pairs with the fence in WriterMain, either the writer sees the record or we see it sleeping
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (writer_sleeping_.load(std::memory_order_relaxed))
+        WakeWriter();
+}
+
+void Logger::WakeWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(writer_mutex_);
+    }
+    writer_cond_.notify_one();
+}
+
+void Logger::WriterMain()
+{
+    auto has_work = [this]() {
+        const auto& record = records_[dequeue_pos_ & record_mask_];
+        return !writer_running_ || record.sequence.load(std::memory_order_acquire) == dequeue_pos_ + 1
+               || flush_requests_ != flushed_requests_ || dropped_count_ != reported_drops_;
+    };
+
+    while (writer_running_)
+    {
+        const size_t requested = flush_requests_;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            DrainAsyncRecords();
+
+            if (requested != flushed_requests_)
+            {
+                // Producers that claimed a slot before the request may still be formatting their message
+                const size_t end = enqueue_pos_;
+                while (dequeue_pos_ < end)
+                {
+                    std::this_thread::yield();
+                    DrainAsyncRecords();
+                }
+
+                for (auto provider : providers_)
+                {
+                    provider->Flush();
+                }
+            }
+        }
+
+        std::unique_lock<std::mutex> lock(writer_mutex_);
+        if (requested != flushed_requests_)
+        {
+            flushed_requests_ = requested;
+            flush_cond_.notify_all();
+        }
+
+        writer_sleeping_ = true;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        // The timeout only guards against a producer that skipped the wakeup while the writer was busy
+        writer_cond_.wait_for(lock, std::chrono::milliseconds(100), has_work);
+        writer_sleeping_ = false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    DrainAsyncRecords();
+    for (auto provider : providers_)
+    {
+        provider->Flush();
+    }
+}
+
+void Logger::DrainAsyncRecords()
+{
+    while (true)
+    {
+        auto& record = records_[dequeue_pos_ & record_mask_];
+        if (record.sequence.load(std::memory_order_acquire) != dequeue_pos_ + 1)
+            break;
+
+        auto& stream = this->GetFormatedStream(record.level, record.time, &buffer_);
+        stream.write(record.GetText(), std::streamsize(record.length));
+        this->WriteToProviders(record.level, &buffer_);
+
+        // Hand the slot back to producers for the next lap
+        record.sequence.store(dequeue_pos_ + record_mask_ + 1, std::memory_order_release);
+        ++dequeue_pos_;
+    }
+
+    if (overflow_policy_ == LogOverflowPolicy::DropAndReport)
+    {
+        const size_t dropped = dropped_count_;
+        if (dropped != reported_drops_)
+        {
+            auto& stream = this->GetFormatedStream(LogLevel::Warning, ClockTime::Now(), &buffer_);
+            stream << ' ' << (dropped - reported_drops_) << " log messages were dropped because the queue was full";
+            this->WriteToProviders(LogLevel::Warning, &buffer_);
+
+            reported_drops_ = dropped;
+        }
+    }
+}
+
+void Logger::FlushOnCrash()
+{
+    if (!async_)
+        return;
+
+    // The crashing thread may be holding the lock, give up rather than hang the crash
+    std::unique_lock<std::mutex> lock(mutex_, std::defer_lock);
+    for (int i = 0; i < 50 && !lock.try_lock(); ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    if (!lock.owns_lock())
+        return;
+
+    DrainAsyncRecords();
+    for (auto provider : providers_)
+    {
+        provider->Flush();
+    }
+}
+
+void Logger::InstallCrashHandlers()
+{
+    static std::once_flag once;
+    std::call_once(once, []() {
+        previous_terminate = std::set_terminate([]() {
+            Logger::GetInstance().FlushOnCrash();
+            if (previous_terminate)
+                previous_terminate();
+            std::abort();
+        });
+
+#if defined(KGE_PLATFORM_WINDOWS)
+        previous_exception_filter = ::SetUnhandledExceptionFilter([](EXCEPTION_POINTERS* info) -> LONG {
+            Logger::GetInstance().FlushOnCrash();
+            if (previous_exception_filter)
+                return previous_exception_filter(info);
+            return EXCEPTION_CONTINUE_SEARCH;
+        });
+#endif
+    });
+}
+
 }  // namespace kiwano
 
 #if defined(KGE_PLATFORM_WINDOWS)
@@ -19,7 +19,11 @@
 // THE SOFTWARE.
 
 #pragma once
+#include <atomic>
+#include <condition_variable>
+#include <memory>
 #include <mutex>
+#include <thread>
 #include <iomanip>
 #include <streambuf>
 #include <fstream>
@@ -129,6 +133,17 @@ enum class LogLevel
     Error,    ///< 
 };
 
+/**
+ * \~chinese
+ * @brief 첽־ʱĴʽ
+ */
+enum class LogOverflowPolicy
+{
+    Block,          ///< ȴд߳ڳռ
+    Drop,           ///< ־
+    DropAndReport,  ///< ־д߳
+};
+
 /**
  * \~chinese
  * @brief ־ʽ
@@ -273,8 +288,30 @@ public:
 
     /// \~chinese
     /// @brief ˢ־
+    /// @details 첽ģʽ»ȴǰ־ȫд־
     void Flush();
 
+    /// \~chinese
+    /// @brief 첽־
+    /// @details ӡ־߳̽־ֱӸʽζеĲλУɺ̨д߳־ͷд־ߣ
+    /// ʱʣ־ᱻд롣лģʽʱȴде߳
+    /// @param capacity ȡΪ 2 
+    /// @param policy ʱĴʽ
+    void EnableAsync(size_t capacity = 4096, LogOverflowPolicy policy = LogOverflowPolicy::Block);
+
+    /// \~chinese
+    /// @brief 첽־
+    /// @details ȴе־ȫдֹͣд߳
+    void DisableAsync();
+
+    /// \~chinese
+    /// @brief Ƿ첽־
+    bool IsAsync() const;
+
+    /// \~chinese
+    /// @brief ȡ־
+    size_t GetDroppedCount() const;
+
     /// \~chinese
     /// @brief ־
     void Enable();
@@ -316,18 +353,99 @@ public:
 private:
     Logger();
 
-    std::iostream& GetFormatedStream(LogLevel level, LogBuffer* buffer);
+    std::iostream& GetFormatedStream(LogLevel level, ClockTime time, LogBuffer* buffer);
 
     void WriteToProviders(LogLevel level, LogBuffer* buffer);
 
+    void StopAsync();
+
+    bool EnterAsync();
+
+    void LeaveAsync();
+
+    std::ostream& BeginAsyncRecord();
+
+    void EndAsyncRecord(LogLevel level);
+
+    struct AsyncRecord;
+
+    AsyncRecord* AcquireAsyncRecord(LogLevel level, size_t& pos);
+
+    AsyncRecord* TryAcquireAsyncRecord(size_t& pos);
+
+    void PublishAsyncRecord(AsyncRecord* record, size_t pos);
+
+    void WakeWriter();
+
+    void WriterMain();
+
+    void DrainAsyncRecords();
+
+    void FlushOnCrash();
+
+    static void InstallCrashHandlers();
+
 private:
+    // Short messages are formatted straight into the slot, longer ones spill into a string that keeps
+    // its capacity between laps
+    struct AsyncRecord
+    {
+        static const size_t TextSize = 256;
+
+        std::atomic<size_t> sequence;
+        LogLevel            level;
+        ClockTime           time;
+        size_t              length;
+        char                text[TextSize];
+        String              long_text;
+
+        const char* GetText() const;
+    };
+
+    // Leaves DisableAsync waiting until the record being pushed is published
+    class AsyncScope
+    {
+    public:
+        AsyncScope(Logger* logger);
+
+        ~AsyncScope();
+
+        bool IsEntered() const;
+
+    private:
+        Logger* logger_;
+        bool    entered_;
+    };
+
     bool                        enabled_;
     LogLevel                    level_;
     RefPtr<LogFormater>         formater_;
     LogBuffer                   buffer_;
+    std::atomic<size_t>         buffer_size_;
     std::iostream               stream_;
     Vector<RefPtr<LogProvider>> providers_;
     std::mutex                  mutex_;
+
+    // Bounded MPSC ring, producers claim slots with a CAS and the writer releases them in order
+    std::atomic<bool>              async_;
+    std::atomic<size_t>            async_producers_;
+    std::mutex                     async_mutex_;
+    LogOverflowPolicy              overflow_policy_;
+    std::unique_ptr<AsyncRecord[]> records_;
+    size_t                         record_mask_;
+    std::atomic<size_t>            enqueue_pos_;
+    size_t                         dequeue_pos_;
+    std::atomic<size_t>            dropped_count_;
+    size_t                         reported_drops_;
+
+    std::thread             writer_;
+    std::atomic<bool>       writer_running_;
+    std::atomic<bool>       writer_sleeping_;
+    std::mutex              writer_mutex_;
+    std::condition_variable writer_cond_;
+    std::condition_variable flush_cond_;
+    std::atomic<size_t>     flush_requests_;
+    std::atomic<size_t>     flushed_requests_;
 };
 
 inline void Logger::Enable()
@@ -345,6 +463,38 @@ inline void Logger::SetFormater(RefPtr<LogFormater> formater)
     formater_ = formater;
 }
 
+inline bool Logger::IsAsync() const
+{
+    return async_;
+}
+
+inline size_t Logger::GetDroppedCount() const
+{
+    return dropped_count_;
+}
+
+inline const char* Logger::AsyncRecord::GetText() const
+{
+    return length < TextSize ? text : long_text.c_str();
+}
+
+inline Logger::AsyncScope::AsyncScope(Logger* logger)
+    : logger_(logger)
+    , entered_(logger->EnterAsync())
+{
+}
+
+inline Logger::AsyncScope::~AsyncScope()
+{
+    if (entered_)
+        logger_->LeaveAsync();
+}
+
+inline bool Logger::AsyncScope::IsEntered() const
+{
+    return entered_;
+}
+
 template <typename... _Args>
 inline void Logger::Log(LogLevel level, _Args&&... args)
 {
@@ -354,10 +504,20 @@ inline void Logger::Log(LogLevel level, _Args&&... args)
     if (level < level_)
         return;
 
+    AsyncScope async_scope(this);
+    if (async_scope.IsEntered())
+    {
+        // only the message body is built on the calling thread, the writer adds the header
+        auto& stream = this->BeginAsyncRecord();
+        (void)std::initializer_list<int>{ ((stream << ' ' << args), 0)... };
+        this->EndAsyncRecord(level);
+        return;
+    }
+
     std::lock_guard<std::mutex> lock(mutex_);
 
     // build message
-    auto& stream = this->GetFormatedStream(level, &this->buffer_);
+    auto& stream = this->GetFormatedStream(level, ClockTime::Now(), &this->buffer_);
     (void)std::initializer_list<int>{ ((stream << ' ' << args), 0)... };
 
     // write message
@@ -45,6 +45,20 @@ bool ResourceCache::LoadFromXmlFile(StringView file_path)
     return IsValid();
 }
 
+bool ResourceCache::LoadFromJsonFileAsync(StringView file_path, const LoadProgressCallback& progress,
+                                          const LoadCompleteCallback& complete)
+{
+    ResourceLoader loader(*this);
+    return loader.LoadFromJsonFileAsync(file_path, progress, complete);
+}
+
+bool ResourceCache::LoadFromXmlFileAsync(StringView file_path, const LoadProgressCallback& progress,
+                                         const LoadCompleteCallback& complete)
+{
+    ResourceLoader loader(*this);
+    return loader.LoadFromXmlFileAsync(file_path, progress, complete);
+}
+
 void ResourceCache::AddObject(StringView id, RefPtr<ObjectBase> obj)
 {
     object_cache_[id] = obj;
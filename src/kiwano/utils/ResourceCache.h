@@ -44,6 +44,40 @@ public:
     /// @param file_path XMLļ·
     bool LoadFromXmlFile(StringView file_path);
 
+    /// \~chinese
+    /// @brief 첽ؽȻص
+    /// @details ΪɵԴԴ
+    using LoadProgressCallback = Function<void(size_t /* loaded */, size_t /* total */)>;
+
+    /// \~chinese
+    /// @brief 첽ɻص
+    /// @details ʾǷԴسɹ
+    using LoadCompleteCallback = Function<void(bool /* succeeded */)>;
+
+    /// \~chinese
+    /// @brief  JSON ļ첽Դ
+    /// @details ԴϢڵ߳̽ͼƬļں̶̨߳ȡͽ룬õԴ̷߳뻺档
+    /// priority ֵϴԴȼ
+    /// @param file_path JSONļ·
+    /// @param progress ؽȻص̵߳
+    /// @param complete ɻص̵߳
+    /// @return ԴϢǷɹ
+    /// @note ڼ仺治ᱻüУҪ
+    bool LoadFromJsonFileAsync(StringView file_path, const LoadProgressCallback& progress,
+                               const LoadCompleteCallback& complete);
+
+    /// \~chinese
+    /// @brief  XML ļ첽Դ
+    /// @details ԴϢڵ߳̽ͼƬļں̶̨߳ȡͽ룬õԴ̷߳뻺档
+    /// priority ֵϴԴȼ
+    /// @param file_path XMLļ·
+    /// @param progress ؽȻص̵߳
+    /// @param complete ɻص̵߳
+    /// @return ԴϢǷɹ
+    /// @note ڼ仺治ᱻüУҪ
+    bool LoadFromXmlFileAsync(StringView file_path, const LoadProgressCallback& progress,
+                              const LoadCompleteCallback& complete);
+
     /// \~chinese
     /// @brief ȡԴ
     /// @param id ID
@@ -19,36 +19,359 @@
 // THE SOFTWARE.
 
 #include <fstream>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <kiwano/platform/Application.h>
 #include <kiwano/platform/FileSystem.h>
 #include <kiwano/utils/Logger.h>
 #include <kiwano/utils/ResourceLoader.h>
 #include <kiwano/utils/ResourceCache.h>
+#include <kiwano/render/Renderer.h>
 #include <kiwano/render/Font.h>
 #include <kiwano/render/GifImage.h>
 #include <kiwano/2d/SpriteFrame.h>
 #include <kiwano/2d/animation/FrameSequence.h>
 
+#if defined(KGE_PLATFORM_WINDOWS)
+#include <objbase.h>
+#endif
+
 namespace kiwano
 {
+namespace details
+{
+
+struct ResourceEntry
+{
+    enum class Type
+    {
+        Texture,
+        GifImage,
+        FrameSequence,  // One file for each frame
+        SlicedFrames,   // One file split into frames
+        FontCollection,
+    };
+
+    Type           type = Type::Texture;
+    String         id;
+    Vector<String> files;
+    int            rows      = 0;
+    int            cols      = 0;
+    int            max_num   = -1;
+    float          padding_x = 0;
+    float          padding_y = 0;
+    int            priority  = 0;
+};
+
+}  // namespace details
+
 namespace resource_cache_01
 {
 
-void LoadJsonData(ResourceCache* cache, const Json& json_data);
-void LoadXmlData(ResourceCache* cache, const XmlNode& elem);
+void ParseJsonData(const Json& json_data, Vector<details::ResourceEntry>& entries);
+void ParseXmlData(const XmlNode& elem, Vector<details::ResourceEntry>& entries);
 
 }  // namespace resource_cache_01
 
 namespace
 {
 
-Map<String, Function<void(ResourceCache*, const Json&)>> load_json_funcs = {
-    { "latest", resource_cache_01::LoadJsonData },
-    { "0.1", resource_cache_01::LoadJsonData },
+Map<String, Function<void(const Json&, Vector<details::ResourceEntry>&)>> parse_json_funcs = {
+    { "latest", resource_cache_01::ParseJsonData },
+    { "0.1", resource_cache_01::ParseJsonData },
 };
 
-Map<String, Function<void(ResourceCache*, const XmlNode&)>> load_xml_funcs = {
-    { "latest", resource_cache_01::LoadXmlData },
-    { "0.1", resource_cache_01::LoadXmlData },
+Map<String, Function<void(const XmlNode&, Vector<details::ResourceEntry>&)>> parse_xml_funcs = {
+    { "latest", resource_cache_01::ParseXmlData },
+    { "0.1", resource_cache_01::ParseXmlData },
+};
+
+struct DecodedImage
+{
+    PixelSize       size;
+    Vector<uint8_t> pixels;
+};
+
+RefPtr<Texture> CreateTexture(const details::ResourceEntry& entry, size_t index, const Vector<DecodedImage>* images)
+{
+    RefPtr<Texture> texture = MakePtr<Texture>();
+    if (images)
+    {
+        const DecodedImage& image = (*images)[index];
+        if (image.pixels.empty())
+            return nullptr;
+
+        BinaryData data(const_cast<uint8_t*>(image.pixels.data()), uint32_t(image.pixels.size()));
+        texture->Load(image.size, data, PixelFormat::Bpp32BGRA);
+    }
+    else
+    {
+        texture->Load(entry.files[index]);
+    }
+    return texture->IsValid() ? texture : nullptr;
+}
+
+RefPtr<ObjectBase> CreateResource(const details::ResourceEntry& entry, const Vector<DecodedImage>* images)
+{
+    using Type = details::ResourceEntry::Type;
+
+    if (entry.files.empty())
+        return nullptr;
+
+    switch (entry.type)
+    {
+    case Type::Texture:
+    {
+        if (entry.files[0].empty())
+            return nullptr;
+        return CreateTexture(entry, 0, images);
+    }
+    case Type::GifImage:
+    {
+        // Frames of GIF images are decoded lazily, so only the header is read here
+        RefPtr<GifImage> gif = MakePtr<GifImage>();
+        if (gif && gif->Load(entry.files[0]))
+            return gif;
+        return nullptr;
+    }
+    case Type::FrameSequence:
+    {
+        Vector<SpriteFrame> frames;
+        frames.reserve(entry.files.size());
+        for (size_t i = 0; i < entry.files.size(); ++i)
+        {
+            if (RefPtr<Texture> texture = CreateTexture(entry, i, images))
+            {
+                frames.push_back(SpriteFrame(texture));
+            }
+        }
+
+        if (frames.empty())
+            return nullptr;
+        return MakePtr<FrameSequence>(frames);
+    }
+    case Type::SlicedFrames:
+    {
+        RefPtr<Texture> texture = CreateTexture(entry, 0, images);
+        if (!texture)
+            return nullptr;
+
+        SpriteFrame            frame(texture);
+        RefPtr<FrameSequence> frame_seq = MakePtr<FrameSequence>();
+        frame_seq->AddFrames(frame.Split(entry.cols, entry.rows, entry.max_num, entry.padding_x, entry.padding_y));
+        return frame_seq;
+    }
+    case Type::FontCollection:
+    {
+        RefPtr<FontCollection> collection = FontCollection::Preload(entry.files);
+        if (collection && collection->IsValid())
+            return collection;
+        return nullptr;
+    }
+    }
+    return nullptr;
+}
+
+bool ReadFileData(const String& full_path, Vector<uint8_t>& output)
+{
+    std::ifstream ifs(full_path.c_str(), std::ios::binary | std::ios::ate);
+    if (!ifs.is_open())
+        return false;
+
+    const std::streamsize size = ifs.tellg();
+    if (size <= 0)
+        return false;
+
+    output.resize(size_t(size));
+    ifs.seekg(0, std::ios::beg);
+    return bool(ifs.read(reinterpret_cast<char*>(output.data()), size));
+}
+
+struct AsyncLoadBatch
+{
+    // Not owned, the cache may live on the stack or in a member and must outlive the batch
+    ResourceCache*                      cache = nullptr;
+    ResourceCache::LoadProgressCallback progress;
+    ResourceCache::LoadCompleteCallback complete;
+    size_t                              total     = 0;
+    size_t                              loaded    = 0;
+    bool                                succeeded = true;
+};
+
+struct AsyncLoadTask
+{
+    // The batch is only touched on the main thread, workers just carry it along
+    std::shared_ptr<AsyncLoadBatch> batch;
+    details::ResourceEntry          entry;
+    uint64_t                        sequence = 0;
+};
+
+void FinishAsyncLoadTask(AsyncLoadBatch& batch, const details::ResourceEntry& entry,
+                         const Vector<DecodedImage>* images)
+{
+    RefPtr<ObjectBase> object = CreateResource(entry, images);
+    if (object)
+    {
+        batch.cache->AddObject(entry.id, object);
+    }
+    else
+    {
+        batch.succeeded = false;
+        batch.cache->Fail(strings::Format("ResourceLoader failed: cannot load resource [%s]", entry.id.c_str()));
+    }
+
+    ++batch.loaded;
+    if (batch.progress)
+    {
+        batch.progress(batch.loaded, batch.total);
+    }
+
+    if (batch.loaded == batch.total && batch.complete)
+    {
+        batch.complete(batch.succeeded);
+    }
+}
+
+class AsyncLoadQueue : Noncopyable
+{
+public:
+    static AsyncLoadQueue& GetInstance()
+    {
+        static AsyncLoadQueue instance;
+        return instance;
+    }
+
+    ~AsyncLoadQueue()
+    {
+        Stop();
+    }
+
+    void Stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopped_ = true;
+            tasks_.clear();
+        }
+
+        for (auto& worker : workers_)
+        {
+            worker.join();
+        }
+        workers_.clear();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopped_ = false;
+        running_ = 0;
+    }
+
+    void Push(Vector<AsyncLoadTask>& tasks)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& task : tasks)
+        {
+            task.sequence = next_sequence_++;
+            tasks_.push_back(std::move(task));
+            std::push_heap(tasks_.begin(), tasks_.end(), &AsyncLoadQueue::IsLowerPriority);
+        }
+
+        if (running_ == 0)
+        {
+            // Workers quit once the queue is drained, reap them before starting new ones
+            for (auto& worker : workers_)
+            {
+                worker.join();
+            }
+            workers_.clear();
+
+            const uint32_t count = std::min(std::max(std::thread::hardware_concurrency(), 2u) - 1, 4u);
+
+            running_ = count;
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                workers_.emplace_back(&AsyncLoadQueue::WorkerMain, this);
+            }
+        }
+    }
+
+private:
+    AsyncLoadQueue()
+        : stopped_(false)
+        , running_(0)
+        , next_sequence_(0)
+    {
+    }
+
+    static bool IsLowerPriority(const AsyncLoadTask& lhs, const AsyncLoadTask& rhs)
+    {
+        if (lhs.entry.priority != rhs.entry.priority)
+            return lhs.entry.priority < rhs.entry.priority;
+        return lhs.sequence > rhs.sequence;
+    }
+
+    void WorkerMain()
+    {
+#if defined(KGE_PLATFORM_WINDOWS)
+        // Image decoders are COM objects
+        HRESULT hr = ::CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+#endif
+
+        while (true)
+        {
+            AsyncLoadTask task;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (stopped_ || tasks_.empty())
+                {
+                    --running_;
+                    break;
+                }
+
+                std::pop_heap(tasks_.begin(), tasks_.end(), &AsyncLoadQueue::IsLowerPriority);
+                task = std::move(tasks_.back());
+                tasks_.pop_back();
+            }
+
+            Vector<DecodedImage> images;
+            if (task.entry.type != details::ResourceEntry::Type::GifImage
+                && task.entry.type != details::ResourceEntry::Type::FontCollection)
+            {
+                images.resize(task.entry.files.size());
+                for (size_t i = 0; i < task.entry.files.size(); ++i)
+                {
+                    Vector<uint8_t> data;
+                    if (ReadFileData(task.entry.files[i], data))
+                    {
+                        BinaryData binary(data.data(), uint32_t(data.size()));
+                        Renderer::GetInstance().DecodeImage(binary, images[i].size, images[i].pixels);
+                    }
+                }
+            }
+
+            // Textures must be created on the main thread, which owns the render device
+            Application::GetInstance().PerformInMainThread(
+                [batch = std::move(task.batch), entry = std::move(task.entry), images = std::move(images)]() {
+                    FinishAsyncLoadTask(*batch, entry, images.empty() ? nullptr : &images);
+                });
+        }
+
+#if defined(KGE_PLATFORM_WINDOWS)
+        if (SUCCEEDED(hr))
+        {
+            ::CoUninitialize();
+        }
+#endif
+    }
+
+private:
+    std::mutex            mutex_;
+    bool                  stopped_;
+    uint32_t              running_;
+    uint64_t              next_sequence_;
+    Vector<AsyncLoadTask> tasks_;
+    Vector<std::thread>   workers_;
 };
 
 }  // namespace
@@ -58,12 +381,75 @@ ResourceLoader::ResourceLoader(ResourceCache& cache)
 {
 }
 
+void ResourceLoader::StopAsyncLoading()
+{
+    AsyncLoadQueue::GetInstance().Stop();
+}
+
 void ResourceLoader::LoadFromJsonFile(StringView file_path)
+{
+    Vector<details::ResourceEntry> entries;
+    if (ParseJsonFile(file_path, entries))
+    {
+        LoadEntries(entries);
+    }
+}
+
+void ResourceLoader::LoadFromJson(const Json& json_data)
+{
+    Vector<details::ResourceEntry> entries;
+    if (ParseJson(json_data, entries))
+    {
+        LoadEntries(entries);
+    }
+}
+
+void ResourceLoader::LoadFromXmlFile(StringView file_path)
+{
+    Vector<details::ResourceEntry> entries;
+    if (ParseXmlFile(file_path, entries))
+    {
+        LoadEntries(entries);
+    }
+}
+
+void ResourceLoader::LoadFromXml(const XmlDocument& doc)
+{
+    Vector<details::ResourceEntry> entries;
+    if (ParseXml(doc, entries))
+    {
+        LoadEntries(entries);
+    }
+}
+
+bool ResourceLoader::LoadFromJsonFileAsync(StringView file_path, const ResourceCache::LoadProgressCallback& progress,
+                                           const ResourceCache::LoadCompleteCallback& complete)
+{
+    Vector<details::ResourceEntry> entries;
+    if (!ParseJsonFile(file_path, entries))
+        return false;
+
+    LoadEntriesAsync(entries, progress, complete);
+    return true;
+}
+
+bool ResourceLoader::LoadFromXmlFileAsync(StringView file_path, const ResourceCache::LoadProgressCallback& progress,
+                                          const ResourceCache::LoadCompleteCallback& complete)
+{
+    Vector<details::ResourceEntry> entries;
+    if (!ParseXmlFile(file_path, entries))
+        return false;
+
+    LoadEntriesAsync(entries, progress, complete);
+    return true;
+}
+
+bool ResourceLoader::ParseJsonFile(StringView file_path, Vector<details::ResourceEntry>& entries)
 {
     if (!FileSystem::GetInstance().IsFileExists(file_path))
     {
         cache_.Fail(strings::Format("ResourceLoader::LoadFromJsonFile failed: [%s] file not found.", file_path.data()));
-        return;
+        return false;
     }
 
     Json json_data;
@@ -82,50 +468,53 @@ void ResourceLoader::LoadFromJsonFile(StringView file_path)
     {
         cache_.Fail(strings::Format("ResourceLoader::LoadFromJsonFile failed: cannot open file [%s]. %s",
                                     file_path.data(), e.what()));
-        return;
+        return false;
     }
     catch (Json::exception& e)
     {
         cache_.Fail(strings::Format("ResourceLoader::LoadFromJsonFile failed: Json file [%s] parsed with errors: %s",
                                     file_path.data(), e.what()));
-        return;
+        return false;
     }
 
-    LoadFromJson(json_data);
+    return ParseJson(json_data, entries);
 }
 
-void ResourceLoader::LoadFromJson(const Json& json_data)
+bool ResourceLoader::ParseJson(const Json& json_data, Vector<details::ResourceEntry>& entries)
 {
     try
     {
         String version = json_data["version"];
 
-        auto load = load_json_funcs.find(version);
-        if (load != load_json_funcs.end())
+        auto parse = parse_json_funcs.find(version);
+        if (parse != parse_json_funcs.end())
         {
-            load->second(&cache_, json_data);
+            parse->second(json_data, entries);
         }
         else if (version.empty())
         {
-            load_json_funcs["latest"](&cache_, json_data);
+            parse_json_funcs["latest"](json_data, entries);
         }
         else
         {
             cache_.Fail("ResourceLoader::LoadFromJson failed: unknown resource data version");
+            return false;
         }
     }
     catch (Json::exception& e)
     {
         cache_.Fail(String("ResourceLoader::LoadFromJson failed: ") + e.what());
+        return false;
     }
+    return true;
 }
 
-void ResourceLoader::LoadFromXmlFile(StringView file_path)
+bool ResourceLoader::ParseXmlFile(StringView file_path, Vector<details::ResourceEntry>& entries)
 {
     if (!FileSystem::GetInstance().IsFileExists(file_path))
     {
         cache_.Fail(strings::Format("ResourceLoader::LoadFromXmlFile failed: [%s] file not found.", file_path.data()));
-        return;
+        return false;
     }
 
     String full_path = FileSystem::GetInstance().GetFullPathForFile(file_path);
@@ -133,18 +522,16 @@ void ResourceLoader::LoadFromXmlFile(StringView file_path)
     XmlDocument doc;
 
     auto result = doc.load_file(full_path.c_str());
-    if (result)
-    {
-        LoadFromXml(doc);
-    }
-    else
+    if (!result)
     {
         cache_.Fail(strings::Format("ResourceLoader::LoadFromXmlFile failed: XML file [%s] parsed with errors: %s",
                                     file_path.data(), result.description()));
+        return false;
     }
+    return ParseXml(doc, entries);
 }
 
-void ResourceLoader::LoadFromXml(const XmlDocument& doc)
+bool ResourceLoader::ParseXml(const XmlDocument& doc, Vector<details::ResourceEntry>& entries)
 {
     if (XmlNode root = doc.child("resources"))
     {
@@ -152,147 +539,127 @@ void ResourceLoader::LoadFromXml(const XmlDocument& doc)
         if (auto version_node = root.child("version"))
             version = version_node.child_value();
 
-        auto load = load_xml_funcs.find(version);
-        if (load != load_xml_funcs.end())
+        auto parse = parse_xml_funcs.find(version);
+        if (parse != parse_xml_funcs.end())
         {
-            load->second(&cache_, root);
+            parse->second(root, entries);
         }
         else if (version.empty())
         {
-            load_xml_funcs["latest"](&cache_, root);
+            parse_xml_funcs["latest"](root, entries);
         }
         else
         {
             cache_.Fail("ResourceLoader::LoadFromXml failed: unknown resource data version");
+            return false;
         }
     }
     else
     {
         cache_.Fail("ResourceLoader::LoadFromXml failed: unknown file format");
+        return false;
     }
+    return true;
 }
 
-}  // namespace kiwano
-
-namespace kiwano
+void ResourceLoader::LoadEntries(const Vector<details::ResourceEntry>& entries)
 {
-namespace resource_cache_01
-{
-struct GlobalData
-{
-    String path;
-};
-
-void LoadTexturesFromData(ResourceCache* cache, GlobalData* gdata, StringView id, StringView type, StringView file)
-{
-    if (type == "gif")
+    for (const auto& entry : entries)
     {
-        // GIF image
-        RefPtr<GifImage> gif = MakePtr<GifImage>();
-        if (gif && gif->Load(gdata->path + file.data()))
+        RefPtr<ObjectBase> object = CreateResource(entry, nullptr);
+        if (object)
         {
-            cache->AddObject(id, gif);
-            return;
+            cache_.AddObject(entry.id, object);
         }
-    }
-    else if (!file.empty())
-    {
-        // Simple image
-        RefPtr<Texture> texture = MakePtr<Texture>();
-        if (texture && texture->Load(gdata->path + file.data()))
+        else
         {
-            cache->AddObject(id, texture);
-            return;
+            cache_.Fail(strings::Format("ResourceLoader failed: cannot load resource [%s]", entry.id.c_str()));
         }
     }
-
-    cache->Fail(strings::Format("%s failed", __FUNCTION__));
 }
 
-void LoadTexturesFromData(ResourceCache* cache, GlobalData* gdata, StringView id, const Vector<String>& files)
+void ResourceLoader::LoadEntriesAsync(Vector<details::ResourceEntry>& entries,
+                                      const ResourceCache::LoadProgressCallback& progress,
+                                      const ResourceCache::LoadCompleteCallback& complete)
 {
-    if (files.empty())
-        return;
+    auto batch      = std::make_shared<AsyncLoadBatch>();
+    batch->cache    = &cache_;
+    batch->progress = progress;
+    batch->complete = complete;
+    batch->total    = entries.size();
 
-    // Frames
-    Vector<SpriteFrame> frames;
-    frames.reserve(files.size());
-    for (const auto& file : files)
+    if (entries.empty())
     {
-        SpriteFrame frame;
-        if (frame.Load(gdata->path + file))
-        {
-            frames.push_back(frame);
-        }
+        Application::GetInstance().PerformInMainThread([batch]() {
+            if (batch->complete)
+                batch->complete(true);
+        });
+        return;
     }
 
-    if (!frames.empty())
+    Vector<AsyncLoadTask> tasks;
+    tasks.reserve(entries.size());
+    for (auto& entry : entries)
     {
-        RefPtr<FrameSequence> frame_seq = MakePtr<FrameSequence>(frames);
-        if (frame_seq)
+        // FileSystem is not thread-safe, so paths are resolved before leaving the main thread
+        for (auto& file : entry.files)
         {
-            cache->AddObject(id, frame_seq);
-            return;
+            file = FileSystem::GetInstance().GetFullPathForFile(file);
         }
-    }
 
-    cache->Fail(strings::Format("%s failed", __FUNCTION__));
+        AsyncLoadTask task;
+        task.batch = batch;
+        task.entry = std::move(entry);
+        tasks.push_back(std::move(task));
+    }
+    AsyncLoadQueue::GetInstance().Push(tasks);
 }
 
-void LoadTexturesFromData(ResourceCache* cache, GlobalData* gdata, StringView id, StringView file, int rows, int cols,
-                          int max_num, float padding_x, float padding_y)
-{
-    if (!file.empty())
-    {
-        if (rows || cols)
-        {
-            // KeyFrame slices
-            SpriteFrame frame;
-            if (frame.Load(gdata->path + file.data()))
-            {
-                RefPtr<FrameSequence> frame_seq = MakePtr<FrameSequence>();
-                if (frame_seq)
-                {
-                    frame_seq->AddFrames(frame.Split(cols, rows, max_num, padding_x, padding_y));
-                    cache->AddObject(id, frame_seq);
-                    return;
-                }
-            }
-        }
-        else
-        {
-            // Simple image
-            RefPtr<Texture> texture = MakePtr<Texture>();
-            if (texture && texture->Load(gdata->path + file.data()))
-            {
-                cache->AddObject(id, texture);
-                return;
-            }
-        }
-    }
+}  // namespace kiwano
 
-    cache->Fail(strings::Format("%s failed", __FUNCTION__));
-}
+namespace kiwano
+{
+namespace resource_cache_01
+{
+struct GlobalData
+{
+    String path;
+};
 
-void LoadFontsFromData(ResourceCache* cache, GlobalData* gdata, StringView id, const Vector<String>& files)
+void ParseImageData(GlobalData* gdata, details::ResourceEntry& entry, StringView type, StringView file,
+                    const Vector<String>* files, Vector<details::ResourceEntry>& entries)
 {
-    Vector<String> full_paths;
-    full_paths.reserve(files.size());
-    for (const auto& file : files)
+    using Type = details::ResourceEntry::Type;
+
+    if (entry.rows || entry.cols)
     {
-        full_paths.emplace_back(file);
+        // KeyFrame slices
+        entry.type = Type::SlicedFrames;
+        entry.files.push_back(gdata->path + file.data());
     }
+    else if (files)
+    {
+        // Frames
+        if (files->empty())
+            return;
 
-    RefPtr<FontCollection> collection = FontCollection::Preload(full_paths);
-    if (collection)
+        entry.type = Type::FrameSequence;
+        entry.files.reserve(files->size());
+        for (const auto& file : *files)
+        {
+            entry.files.push_back(gdata->path + file);
+        }
+    }
+    else
     {
-        cache->AddObject(id, collection);
-        return;
+        // GIF image or simple image
+        entry.type = (type == "gif") ? Type::GifImage : Type::Texture;
+        entry.files.push_back(file.empty() ? String() : gdata->path + file.data());
     }
-    cache->Fail(strings::Format("%s failed", __FUNCTION__));
+    entries.push_back(std::move(entry));
 }
 
-void LoadJsonData(ResourceCache* cache, const Json& json_data)
+void ParseJsonData(const Json& json_data, Vector<details::ResourceEntry>& entries)
 {
     GlobalData global_data;
     if (json_data.count("path"))
@@ -304,32 +671,27 @@ void LoadJsonData(ResourceCache* cache, const Json& json_data)
     {
         for (const auto& image : json_data["images"])
         {
-            String id, type, file;
-            int    rows = 0, cols = 0, max_num = -1;
+            details::ResourceEntry entry;
+            String                 type, file;
 
             if (image.count("id"))
-                id = image["id"].get<String>();
+                entry.id = image["id"].get<String>();
             if (image.count("type"))
                 type = image["type"].get<String>();
             if (image.count("file"))
                 file = image["file"].get<String>();
             if (image.count("rows"))
-                rows = image["rows"].get<int>();
+                entry.rows = image["rows"].get<int>();
             if (image.count("cols"))
-                cols = image["cols"].get<int>();
+                entry.cols = image["cols"].get<int>();
             if (image.count("max_num"))
-                max_num = image["max_num"].get<int>();
-
-            if (rows || cols)
-            {
-                float padding_x = 0, padding_y = 0;
-                if (image.count("padding-x"))
-                    padding_x = image["padding-x"].get<float>();
-                if (image.count("padding-y"))
-                    padding_y = image["padding-y"].get<float>();
-
-                LoadTexturesFromData(cache, &global_data, id, file, rows, cols, max_num, padding_x, padding_y);
-            }
+                entry.max_num = image["max_num"].get<int>();
+            if (image.count("padding-x"))
+                entry.padding_x = image["padding-x"].get<float>();
+            if (image.count("padding-y"))
+                entry.padding_y = image["padding-y"].get<float>();
+            if (image.count("priority"))
+                entry.priority = image["priority"].get<int>();
 
             if (image.count("files"))
             {
@@ -339,11 +701,11 @@ void LoadJsonData(ResourceCache* cache, const Json& json_data)
                 {
                     files.push_back(file.get<String>());
                 }
-                LoadTexturesFromData(cache, &global_data, id, files);
+                ParseImageData(&global_data, entry, type, file, &files, entries);
             }
             else
             {
-                LoadTexturesFromData(cache, &global_data, id, type, file);
+                ParseImageData(&global_data, entry, type, file, nullptr, entries);
             }
         }
     }
@@ -352,25 +714,28 @@ void LoadJsonData(ResourceCache* cache, const Json& json_data)
     {
         for (const auto& font : json_data["fonts"])
         {
-            String id;
+            details::ResourceEntry entry;
+            entry.type = details::ResourceEntry::Type::FontCollection;
+
             if (font.count("id"))
-                id = font["id"].get<String>();
+                entry.id = font["id"].get<String>();
+            if (font.count("priority"))
+                entry.priority = font["priority"].get<int>();
 
             if (font.count("files"))
             {
-                Vector<String> files;
-                files.reserve(font["files"].size());
+                entry.files.reserve(font["files"].size());
                 for (const auto& file : font["files"])
                 {
-                    files.push_back(file.get<String>());
+                    entry.files.push_back(file.get<String>());
                 }
-                LoadFontsFromData(cache, &global_data, id, files);
+                entries.push_back(std::move(entry));
             }
         }
     }
 }
 
-void LoadXmlData(ResourceCache* cache, const XmlNode& elem)
+void ParseXmlData(const XmlNode& elem, Vector<details::ResourceEntry>& entries)
 {
     GlobalData global_data;
     if (auto path = elem.child("path"))
@@ -382,32 +747,27 @@ void LoadXmlData(ResourceCache* cache, const XmlNode& elem)
     {
         for (auto image : images.children())
         {
-            String id, type, file;
-            int    rows = 0, cols = 0, max_num = -1;
+            details::ResourceEntry entry;
+            String                 type, file;
 
             if (auto attr = image.attribute("id"))
-                id = attr.value();
+                entry.id = attr.value();
             if (auto attr = image.attribute("type"))
                 type = attr.value();
             if (auto attr = image.attribute("file"))
                 file = attr.value();
             if (auto attr = image.attribute("rows"))
-                rows = attr.as_int(0);
+                entry.rows = attr.as_int(0);
             if (auto attr = image.attribute("cols"))
-                cols = attr.as_int(0);
+                entry.cols = attr.as_int(0);
             if (auto attr = image.attribute("max_num"))
-                max_num = attr.as_int(-1);
-
-            if (rows || cols)
-            {
-                float padding_x = 0, padding_y = 0;
-                if (auto attr = image.attribute("padding-x"))
-                    padding_x = attr.as_float(0.0f);
-                if (auto attr = image.attribute("padding-y"))
-                    padding_y = attr.as_float(0.0f);
-
-                LoadTexturesFromData(cache, &global_data, id, file, rows, cols, max_num, padding_x, padding_y);
-            }
+                entry.max_num = attr.as_int(-1);
+            if (auto attr = image.attribute("padding-x"))
+                entry.padding_x = attr.as_float(0.0f);
+            if (auto attr = image.attribute("padding-y"))
+                entry.padding_y = attr.as_float(0.0f);
+            if (auto attr = image.attribute("priority"))
+                entry.priority = attr.as_int(0);
 
             if (file.empty() && !image.empty())
             {
@@ -419,11 +779,11 @@ void LoadXmlData(ResourceCache* cache, const XmlNode& elem)
                         files_arr.push_back(path.value());
                     }
                 }
-                LoadTexturesFromData(cache, &global_data, id, files_arr);
+                ParseImageData(&global_data, entry, type, file, &files_arr, entries);
             }
             else
             {
-                LoadTexturesFromData(cache, &global_data, id, type, file);
+                ParseImageData(&global_data, entry, type, file, nullptr, entries);
             }
         }
     }
@@ -432,18 +792,21 @@ void LoadXmlData(ResourceCache* cache, const XmlNode& elem)
     {
         for (auto font : fonts.children())
         {
-            String id;
+            details::ResourceEntry entry;
+            entry.type = details::ResourceEntry::Type::FontCollection;
+
             if (auto attr = font.attribute("id"))
-                id = attr.value();
+                entry.id = attr.value();
+            if (auto attr = font.attribute("priority"))
+                entry.priority = attr.as_int(0);
 
             if (auto files_node = font.child("files"))
             {
-                Vector<String> files;
                 for (auto file_node : files_node.children())
                 {
-                    files.push_back(file_node.value());
+                    entry.files.push_back(file_node.value());
                 }
-                LoadFontsFromData(cache, &global_data, id, files);
+                entries.push_back(std::move(entry));
             }
         }
     }
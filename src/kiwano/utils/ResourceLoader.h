@@ -22,11 +22,15 @@
 #include <kiwano/core/Common.h>
 #include <kiwano/utils/Json.h>
 #include <kiwano/utils/Xml.h>
+#include <kiwano/utils/ResourceCache.h>
 
 namespace kiwano
 {
 
-class ResourceCache;
+namespace details
+{
+struct ResourceEntry;
+}
 
 /// \~chinese
 /// @brief Դ
@@ -55,6 +59,43 @@ public:
     /// @param doc XMLĵ
     void LoadFromXml(const XmlDocument& doc);
 
+    /// \~chinese
+    /// @brief  JSON ļ첽Դ
+    /// @param file_path JSONļ·
+    /// @param progress ؽȻص
+    /// @param complete ɻص
+    /// @return ԴϢǷɹ
+    bool LoadFromJsonFileAsync(StringView file_path, const ResourceCache::LoadProgressCallback& progress,
+                               const ResourceCache::LoadCompleteCallback& complete);
+
+    /// \~chinese
+    /// @brief  XML ļ첽Դ
+    /// @param file_path XMLļ·
+    /// @param progress ؽȻص
+    /// @param complete ɻص
+    /// @return ԴϢǷɹ
+    bool LoadFromXmlFileAsync(StringView file_path, const ResourceCache::LoadProgressCallback& progress,
+                              const ResourceCache::LoadCompleteCallback& complete);
+
+    /// \~chinese
+    /// @brief ֹ̨ͣ߳
+    /// @details δʼļᱻڼصԴ߳˳
+    static void StopAsyncLoading();
+
+private:
+    bool ParseJsonFile(StringView file_path, Vector<details::ResourceEntry>& entries);
+
+    bool ParseJson(const Json& json_data, Vector<details::ResourceEntry>& entries);
+
+    bool ParseXmlFile(StringView file_path, Vector<details::ResourceEntry>& entries);
+
+    bool ParseXml(const XmlDocument& doc, Vector<details::ResourceEntry>& entries);
+
+    void LoadEntries(const Vector<details::ResourceEntry>& entries);
+
+    void LoadEntriesAsync(Vector<details::ResourceEntry>& entries, const ResourceCache::LoadProgressCallback& progress,
+                          const ResourceCache::LoadCompleteCallback& complete);
+
 private:
     ResourceCache& cache_;
 };
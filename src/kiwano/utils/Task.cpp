@@ -19,14 +19,18 @@
 // THE SOFTWARE.
 
 #include <kiwano/utils/Task.h>
+#include <kiwano/utils/TaskScheduler.h>
 
 namespace kiwano
 {
 Task::Task(const Callback& cb, RefPtr<Ticker> ticker)
     : running_(true)
     , removeable_(false)
+    , use_interval_ticker_(false)
     , callback_(cb)
     , ticker_(ticker)
+    , scheduler_(nullptr)
+    , last_time_(0)
 {
 }
 
@@ -39,9 +43,12 @@ Task::Task(StringView name, const Callback& cb, RefPtr<Ticker> ticker)
 Task::Task(const Callback& cb, Duration interval, int times)
     : running_(true)
     , removeable_(false)
+    , use_interval_ticker_(true)
+    , interval_ticker_(interval, times)
     , callback_(cb)
+    , scheduler_(nullptr)
+    , last_time_(0)
 {
-    ticker_ = MakePtr<Ticker>(interval, times);
 }
 
 Task::Task(StringView name, const Callback& cb, Duration interval, int times)
@@ -53,7 +60,10 @@ Task::Task(StringView name, const Callback& cb, Duration interval, int times)
 Task::Task()
     : running_(true)
     , removeable_(false)
+    , use_interval_ticker_(false)
     , callback_()
+    , scheduler_(nullptr)
+    , last_time_(0)
 {
 }
 
@@ -62,8 +72,10 @@ void Task::Start()
     if (!running_)
     {
         running_ = true;
-        if (ticker_)
-            ticker_->Resume();
+        if (auto ticker = GetActiveTicker())
+            ticker->Resume();
+        if (scheduler_)
+            scheduler_->ResumeTask(this);
     }
 }
 
@@ -72,9 +84,53 @@ void Task::Stop()
     if (running_)
     {
         running_ = false;
-        if (ticker_)
+        if (auto ticker = GetActiveTicker())
+            ticker->Pause();
+        if (scheduler_)
+            scheduler_->SuspendTask(this);
+    }
+}
+
+void Task::Remove()
+{
+    if (!removeable_)
+    {
+        removeable_ = true;
+        if (scheduler_)
+            scheduler_->WakeTask(this);
+    }
+}
+
+RefPtr<Ticker> Task::GetTicker() const
+{
+    if (!ticker_ && use_interval_ticker_)
+    {
+        // The inline ticker can not be shared, hand out a ticker that carries on counting from where it is
+        ticker_ = MakePtr<Ticker>();
+        ticker_->CopyFrom(interval_ticker_);
+    }
+    return ticker_;
+}
+
+void Task::SetTicker(RefPtr<Ticker> ticker)
+{
+    use_interval_ticker_ = false;
+
+    ticker_ = ticker;
+    if (ticker_)
+    {
+        if (running_)
+            ticker_->Resume();
+        else
             ticker_->Pause();
     }
+
+    if (scheduler_ && running_)
+    {
+        // The new ticker starts counting from now on
+        accrued_time_ = 0;
+        scheduler_->ResumeTask(this);
+    }
 }
 
 void Task::Update(Duration dt)
@@ -82,26 +138,38 @@ void Task::Update(Duration dt)
     if (!running_ || removeable_)
         return;
 
-    if (!ticker_ || ticker_->GetTotalTickCount() == 0)
+    Ticker* ticker = GetActiveTicker();
+    if (!ticker || ticker->GetTotalTickCount() == 0)
     {
         Remove();
         return;
     }
 
-    if (ticker_->Tick(dt))
+    if (ticker->Tick(dt))
     {
         if (callback_)
-            callback_(this, ticker_->GetDeltaTime());
+            callback_(this, ticker->GetDeltaTime());
 
-        if (ticker_->GetTickedCount() == ticker_->GetTotalTickCount())
+        // The callback may have replaced the ticker
+        ticker = GetActiveTicker();
+        if (ticker && ticker->GetTickedCount() == ticker->GetTotalTickCount())
             Remove();
     }
 }
 
 void Task::Reset()
+{
+    if (auto ticker = GetActiveTicker())
+        ticker->Reset();
+}
+
+Ticker* Task::GetActiveTicker()
 {
     if (ticker_)
-        ticker_->Reset();
+        return ticker_.Get();
+    if (use_interval_ticker_)
+        return &interval_ticker_;
+    return nullptr;
 }
 
 }  // namespace kiwano
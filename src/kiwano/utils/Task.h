@@ -21,6 +21,7 @@
 #pragma once
 #include <kiwano/utils/Ticker.h>
 #include <kiwano/core/IntrusiveList.hpp>
+#include <kiwano/core/TimingWheel.h>
 
 namespace kiwano
 {
@@ -32,6 +33,7 @@ class TaskScheduler;
 class KGE_API Task
     : public ObjectBase
     , protected IntrusiveListValue<RefPtr<Task>>
+    , protected TimingWheelNode
 {
     friend class TaskScheduler;
     friend IntrusiveList<RefPtr<Task>>;
@@ -105,6 +107,7 @@ public:
 
     /// \~chinese
     /// @brief ȡıʱ
+    /// @details ʱڲʱһλȡʱŻᴴʱ
     RefPtr<Ticker> GetTicker() const;
 
     /// \~chinese
@@ -120,18 +123,23 @@ private:
     /// @brief 
     void Reset();
 
+    /// \~chinese
+    /// @brief ȡڼʱıʱ
+    Ticker* GetActiveTicker();
+
 private:
-    bool           running_;
-    bool           removeable_;
-    RefPtr<Ticker> ticker_;
-    Callback       callback_;
+    bool                   running_;
+    bool                   removeable_;
+    bool                   use_interval_ticker_;
+    Ticker                 interval_ticker_;
+    mutable RefPtr<Ticker> ticker_;
+    Callback               callback_;
+
+    TaskScheduler* scheduler_;
+    int64_t        last_time_;
+    Duration       accrued_time_;
 };
 
-inline void Task::Remove()
-{
-    removeable_ = true;
-}
-
 inline bool Task::IsRunning() const
 {
     return running_;
@@ -142,23 +150,6 @@ inline bool Task::IsRemoveable() const
     return removeable_;
 }
 
-inline RefPtr<Ticker> Task::GetTicker() const
-{
-    return ticker_;
-}
-
-inline void Task::SetTicker(RefPtr<Ticker> ticker)
-{
-    ticker_ = ticker;
-    if (ticker_)
-    {
-        if (running_)
-            ticker_->Resume();
-        else
-            ticker_->Pause();
-    }
-}
-
 inline Task::Callback Task::GetCallback() const
 {
     return callback_;
@@ -24,31 +24,124 @@
 namespace kiwano
 {
 
+TaskScheduler::TaskScheduler() {}
+
+TaskScheduler::~TaskScheduler()
+{
+    RemoveAllTasks();
+}
+
 void TaskScheduler::Update(Duration dt)
 {
     if (tasks_.IsEmpty())
         return;
 
-    RefPtr<Task> next;
-    for (auto task = tasks_.GetFirst(); task; task = next)
+    const int64_t now = wheel_.GetCurrentTime() + dt.GetMilliseconds();
+    wheel_.Advance(now, expired_);
+    if (expired_.empty())
+        return;
+
+    // Callbacks may add tasks that expire immediately, keep them for the next update
+    Vector<TimingWheelNode*> expired;
+    expired.swap(expired_);
+
+    TaskList::TraversalGuard guard(tasks_);
+
+    for (auto node : expired)
     {
-        next = task->GetNext();
+        Task* task = static_cast<Task*>(node);
+        if (task->scheduler_ != this || node->IsScheduled())
+        {
+            // Removed or rescheduled by a previous callback
+            continue;
+        }
 
-        task->Update(dt);
+        if (!task->removeable_ && task->running_)
+        {
+            Duration elapsed    = task->accrued_time_ + Duration(now - task->last_time_);
+            task->accrued_time_ = 0;
+            task->last_time_    = now;
+
+            task->Update(elapsed);
+        }
+
+        if (task->scheduler_ != this)
+            continue;
 
         if (task->IsRemoveable())
-            tasks_.Remove(task);
+        {
+            RefPtr<Task> removed = task;
+            DetachTask(task);
+            tasks_.Remove(removed);
+        }
+        else if (task->running_ && !node->IsScheduled())
+        {
+            ScheduleTask(task);
+        }
     }
+
+    // Reuse the storage in the next update
+    expired.clear();
+    if (expired_.empty())
+        expired_.swap(expired);
+}
+
+void TaskScheduler::ScheduleTask(Task* task)
+{
+    // Tasks whose tickers can not tell when they fire next are updated every frame
+    int64_t delay = 0;
+
+    Duration remaining;
+    Ticker*  ticker = task->GetActiveTicker();
+    if (ticker && ticker->GetTimeToNextTick(remaining))
+    {
+        delay = std::max<int64_t>((remaining - task->accrued_time_).GetMilliseconds(), 0);
+    }
+    wheel_.Schedule(task, task->last_time_ + delay);
+}
+
+void TaskScheduler::ResumeTask(Task* task)
+{
+    task->last_time_ = wheel_.GetCurrentTime();
+    if (!task->removeable_)
+        ScheduleTask(task);
+}
+
+void TaskScheduler::SuspendTask(Task* task)
+{
+    const int64_t now = wheel_.GetCurrentTime();
+    task->accrued_time_ += Duration(now - task->last_time_);
+    task->last_time_ = now;
+
+    wheel_.Cancel(task);
+}
+
+void TaskScheduler::WakeTask(Task* task)
+{
+    wheel_.Schedule(task, wheel_.GetCurrentTime());
+}
+
+void TaskScheduler::DetachTask(Task* task)
+{
+    wheel_.Cancel(task);
+    task->scheduler_ = nullptr;
 }
 
 Task* TaskScheduler::AddTask(RefPtr<Task> task)
 {
     KGE_ASSERT(task && "AddTask failed, NULL pointer exception");
+    KGE_ASSERT((!task || !task->scheduler_) && "AddTask failed, the task belongs to another scheduler");
 
     if (task)
     {
         task->Reset();
         tasks_.PushBack(task);
+
+        task->scheduler_    = this;
+        task->accrued_time_ = 0;
+        task->last_time_    = wheel_.GetCurrentTime();
+        if (task->running_ || task->removeable_)
+            ScheduleTask(task.Get());
     }
     return task.Get();
 }
@@ -143,6 +236,10 @@ void TaskScheduler::StartAllTasks()
 
 void TaskScheduler::RemoveAllTasks()
 {
+    for (auto task = tasks_.GetFirstPtr(); task; task = TaskList::GetNextPtr(task))
+    {
+        DetachTask(task);
+    }
     tasks_.Clear();
 }
 
@@ -31,10 +31,19 @@ typedef IntrusiveList<RefPtr<Task>> TaskList;
 /**
  * \~chinese
  * @brief 
+ * @details ´αʱʱ䱣ʱУÿθֻڵӡֹͣƳĸӶΪ O(1)
+ * ʹԶ屨ʱʱΪ 0 ÿ֡һ
+ * @note ֱ޸ʱʱһαʱЧ
  */
 class KGE_API TaskScheduler : Noncopyable
 {
+    friend class Task;
+
 public:
+    TaskScheduler();
+
+    ~TaskScheduler();
+
     /// \~chinese
     /// @brief 
     Task* AddTask(RefPtr<Task> task);
@@ -100,7 +109,30 @@ public:
     void Update(Duration dt);
 
 private:
-    TaskList tasks_;
+    /// \~chinese
+    /// @brief ʱ״̬ʱ
+    void ScheduleTask(Task* task);
+
+    /// \~chinese
+    /// @brief ʱ¿ʼʱ
+    void ResumeTask(Task* task);
+
+    /// \~chinese
+    /// @brief ֹͣʱۼƵʱ
+    void SuspendTask(Task* task);
+
+    /// \~chinese
+    /// @brief ʹ´θʱ
+    void WakeTask(Task* task);
+
+    /// \~chinese
+    /// @brief Ƴ
+    void DetachTask(Task* task);
+
+private:
+    TaskList                 tasks_;
+    TimingWheel              wheel_;
+    Vector<TimingWheelNode*> expired_;
 };
 
 }  // namespace kiwano
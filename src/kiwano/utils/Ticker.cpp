@@ -81,6 +81,15 @@ bool Ticker::Tick(Duration dt)
     return false;
 }
 
+bool Ticker::GetTimeToNextTick(Duration& remaining) const
+{
+    if (is_paused_ || interval_.IsZero())
+        return false;
+
+    remaining = interval_ - error_time_ - elapsed_time_;
+    return true;
+}
+
 void Ticker::Pause()
 {
     is_paused_ = true;
@@ -110,6 +119,18 @@ void Ticker::SetTimer(RefPtr<Timer> timer)
     timer_ = timer;
 }
 
+void Ticker::CopyFrom(const Ticker& other)
+{
+    is_paused_        = other.is_paused_;
+    ticked_count_     = other.ticked_count_;
+    total_tick_count_ = other.total_tick_count_;
+    interval_         = other.interval_;
+    elapsed_time_     = other.elapsed_time_;
+    delta_time_       = other.delta_time_;
+    error_time_       = other.error_time_;
+    timer_            = other.timer_;
+}
+
 void Ticker::Reset()
 {
     if (timer_)
@@ -28,6 +28,8 @@ namespace kiwano
 /// @brief ʱ
 class KGE_API Ticker : public ObjectBase
 {
+    friend class Task;
+
 public:
     /// \~chinese
     /// @brief ʱ
@@ -48,6 +50,14 @@ public:
     /// @return Ƿﵽʱʱ
     virtual bool Tick(Duration dt);
 
+    /// \~chinese
+    /// @brief ȡ´αʱʱ
+    /// @details ݴƳٸд Tick ı䱨ʱҲҪдú
+    /// ޷Ԥ֪ʱ falseÿθʱʱ
+    /// @param[out] remaining ´αʱʱ
+    /// @return ܷԤ֪´αʱʱ
+    virtual bool GetTimeToNextTick(Duration& remaining) const;
+
     /// \~chinese
     /// @brief ȡʱ
     Duration GetDeltaTime();
@@ -88,6 +98,10 @@ public:
     /// @brief ȡʱ
     Duration GetErrorTime() const;
 
+    /// \~chinese
+    /// @brief ȡϴαʱۼƵʱ
+    Duration GetElapsedTime() const;
+
     /// \~chinese
     /// @brief ȡʱ
     RefPtr<Timer> GetTimer();
@@ -100,6 +114,9 @@ public:
     /// @brief ñʱ
     void Reset();
 
+private:
+    void CopyFrom(const Ticker& other);
+
 private:
     bool          is_paused_;
     int           ticked_count_;
@@ -146,4 +163,9 @@ inline Duration Ticker::GetErrorTime() const
     return error_time_;
 }
 
+inline Duration Ticker::GetElapsedTime() const
+{
+    return elapsed_time_;
+}
+
 }  // namespace kiwano